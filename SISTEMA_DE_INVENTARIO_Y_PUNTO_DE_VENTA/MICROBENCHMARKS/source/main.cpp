@@ -0,0 +1,435 @@
+﻿/**
+ * @file main.cpp
+ * @brief Microbenchmarks de las rutas principales de inventario, archivos y tickets.
+ *
+ * Cada medición repite la operación hasta juntar un tiempo mínimo y reporta
+ * nanosegundos por operación. El resultado se emite como JSON para comparar
+ * corridas y detectar regresiones:
+ *
+ * ```json
+ * { "contexto": { "fecha": "...", "compilador": "...", "depuracion": false },
+ *   "resultados": [ { "nombre": "Inventario/venderProducto/1000",
+ *                     "iteraciones": 123, "ns_por_op": 45.6,
+ *                     "ops_por_s": 21929824.5, "bytes": 0 } ] }
+ * ```
+ *
+ * Uso:
+ * `MICROBENCHMARKS [--skus 1000,10000,...] [--archivos 1000,10000,...]
+ *  [--filtro texto] [--tiempo segundos] [--salida archivo.json] [--carpeta DIR]`
+ *
+ * Los archivos de prueba se generan con GeneradorCarga en la carpeta de
+ * trabajo (por omisión `Microbenchmarks/`).
+ *
+ * @date 2026-10-19
+ * @version 1.0
+ * @author Ari
+ */
+#include "ProgrammingPatterns/carga/GeneradorCarga.h"
+#include "ProgrammingPatterns/modelos/Inventario.h"
+#include "ProgrammingPatterns/factory/ProductoFactory.h"
+#include "ProgrammingPatterns/gasolinera/Gasolinera.h"
+#include "ProgrammingPatterns/metricas/MetricasEtapas.h"
+#include "ProgrammingPatterns/tickets/ArchivoTickets.h"
+#include "ProgrammingPatterns/tickets/EscritorTickets.h"
+#include "ProgrammingPatterns/tickets/GeneradorTickets.h"
+#include "ProgrammingPatterns/tiempo/Reloj.h"
+#include "nlohmann/json.hpp"
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+
+using json = nlohmann::json;
+using Cronometro = std::chrono::steady_clock;
+
+/**
+ * @struct Parametros
+ * @brief Opciones de la línea de comandos.
+ */
+struct
+Parametros {
+    std::vector<size_t> skus = { 1000, 10000, 100000, 1000000, 10000000 };
+    std::vector<size_t> archivos = { 1000, 10000, 100000 };
+    std::string filtro;
+    double tiempoMinimo = 0.5;
+    std::string salida;
+    std::string carpeta = "Microbenchmarks";
+};
+
+/**
+ * @brief Convierte "1000,10000" en una lista de tamaños.
+ */
+static bool leerLista(const char* texto, std::vector<size_t>& lista) {
+    lista.clear();
+    while (*texto != '\0') {
+        char* fin = nullptr;
+        unsigned long long n = std::strtoull(texto, &fin, 10);
+        if (fin == texto || n == 0) {
+            return false;
+        }
+        lista.push_back(static_cast<size_t>(n));
+        texto = (*fin == ',') ? fin + 1 : fin;
+    }
+    return !lista.empty();
+}
+
+/**
+ * @brief Lee las opciones; devuelve false si alguna no es válida.
+ */
+static bool leerParametros(int argc, char* argv[], Parametros& p) {
+    for (int i = 1; i < argc; i++) {
+        const char* opcion = argv[i];
+        if (i + 1 >= argc) {
+            std::cerr << "Falta el valor de " << opcion << "\n";
+            return false;
+        }
+        const char* valor = argv[++i];
+        bool valido = true;
+        if (std::strcmp(opcion, "--skus") == 0) {
+            valido = leerLista(valor, p.skus);
+        }
+        else if (std::strcmp(opcion, "--archivos") == 0) {
+            valido = leerLista(valor, p.archivos);
+        }
+        else if (std::strcmp(opcion, "--filtro") == 0) {
+            p.filtro = valor;
+        }
+        else if (std::strcmp(opcion, "--tiempo") == 0) {
+            p.tiempoMinimo = std::strtod(valor, nullptr);
+            valido = p.tiempoMinimo > 0.0;
+        }
+        else if (std::strcmp(opcion, "--salida") == 0) {
+            p.salida = valor;
+        }
+        else if (std::strcmp(opcion, "--carpeta") == 0) {
+            p.carpeta = valor;
+        }
+        else {
+            std::cerr << "Opcion desconocida: " << opcion << "\n";
+            return false;
+        }
+        if (!valido) {
+            std::cerr << "Valor invalido para " << opcion << ": " << valor << "\n";
+            return false;
+        }
+    }
+    return true;
+}
+
+/**
+ * @class Medidor
+ * @brief Repite operaciones hasta un tiempo mínimo y acumula los resultados.
+ */
+class
+Medidor {
+private:
+    const Parametros& parametros;
+    json resultados = json::array();
+
+public:
+    explicit Medidor(const Parametros& parametros) : parametros(parametros) {}
+
+    /**
+     * @brief Indica si un grupo de mediciones pasa el filtro.
+     */
+    bool activo(const std::string& nombre) const {
+        return parametros.filtro.empty() || nombre.find(parametros.filtro) != std::string::npos;
+    }
+
+    /**
+     * @brief Mide una operación.
+     *
+     * `operacion(n)` debe ejecutar n repeticiones. El número de repeticiones
+     * crece hasta que una corrida tarda al menos el tiempo mínimo.
+     *
+     * @param nombre Nombre del resultado (grupo/operacion/tamaño).
+     * @param operacion Función que ejecuta n repeticiones.
+     * @param bytes Bytes procesados por repetición (0 si no aplica).
+     */
+    template <typename Operacion>
+    void medir(const std::string& nombre, Operacion&& operacion, size_t bytes = 0) {
+        if (!activo(nombre)) {
+            return;
+        }
+        size_t iteraciones = 1;
+        double segundos = 0.0;
+        while (true) {
+            auto inicio = Cronometro::now();
+            operacion(iteraciones);
+            segundos = std::chrono::duration<double>(Cronometro::now() - inicio).count();
+            if (segundos >= parametros.tiempoMinimo || iteraciones >= (size_t(1) << 40)) {
+                break;
+            }
+            // Se estima cuántas repeticiones llenan el tiempo mínimo (con margen)
+            double factor = segundos > 0.0 ? parametros.tiempoMinimo * 1.2 / segundos : 100.0;
+            iteraciones = static_cast<size_t>(static_cast<double>(iteraciones) * std::clamp(factor, 2.0, 100.0));
+        }
+
+        double ns = segundos * 1e9 / static_cast<double>(iteraciones);
+        json r = {
+            {"nombre", nombre},
+            {"iteraciones", iteraciones},
+            {"ns_por_op", ns},
+            {"ops_por_s", 1e9 / ns},
+            {"bytes", bytes}
+        };
+        if (bytes > 0) {
+            r["mb_por_s"] = static_cast<double>(bytes) * 1e3 / ns;
+        }
+        std::cerr << nombre << ": " << ns << " ns/op (" << iteraciones << " iteraciones)\n";
+        resultados.push_back(std::move(r));
+    }
+
+    const json& getResultados() const { return resultados; }
+};
+
+/**
+ * @class ObservadorContador
+ * @brief Observador mínimo: solo cuenta las notificaciones.
+ */
+class
+ObservadorContador : public Observador {
+public:
+    size_t avisos = 0;
+
+    void actualizar(const std::string& mensaje) override {
+        avisos += mensaje.size();
+    }
+};
+
+/// Destino de resultados que el compilador no debe descartar.
+static volatile long long sumidero = 0;
+
+/**
+ * @brief Tamaño de un archivo en bytes (0 si no existe).
+ */
+static size_t tamanoArchivo(const std::string& archivo) {
+    std::error_code error;
+    auto n = std::filesystem::file_size(archivo, error);
+    return error ? 0 : static_cast<size_t>(n);
+}
+
+/**
+ * @brief Venta y búsqueda de productos con catálogos de distintos tamaños.
+ *
+ * El inventario se arma con `agregarProducto` (sin pasar por JSON) para poder
+ * llegar a 10 millones de productos; los códigos consultados son aleatorios.
+ */
+static void medirInventario(Medidor& medidor, const Parametros& p) {
+    for (size_t n : p.skus) {
+        std::string sufijo = "/" + std::to_string(n);
+        if (!medidor.activo("Inventario/venderProducto" + sufijo) &&
+            !medidor.activo("Inventario/obtenerPrecioProducto" + sufijo)) {
+            continue;
+        }
+
+        std::cerr << "Armando inventario de " << n << " productos...\n";
+        Inventario inventario;
+        std::mt19937_64 generador(n);
+        for (size_t i = 0; i < n; i++) {
+            inventario.agregarProducto(ProductoFactory::crearProducto(GeneradorCarga::codigoProducto(i),
+                "Producto de prueba " + std::to_string(i), Dinero::desdeCentavos(100 + generador() % 100000), 1000000000));
+        }
+
+        std::vector<std::string> codigos(1024);
+        for (auto& codigo : codigos) {
+            codigo = GeneradorCarga::codigoProducto(generador() % n);
+        }
+
+        medidor.medir("Inventario/venderProducto" + sufijo, [&](size_t iteraciones) {
+            for (size_t i = 0; i < iteraciones; i++) {
+                inventario.venderProducto(codigos[i & 1023], 1);
+            }
+        });
+        medidor.medir("Inventario/obtenerPrecioProducto" + sufijo, [&](size_t iteraciones) {
+            Dinero suma;
+            for (size_t i = 0; i < iteraciones; i++) {
+                suma += inventario.obtenerPrecioProducto(codigos[i & 1023]);
+            }
+            sumidero = suma.getCentavos();
+        });
+    }
+}
+
+/**
+ * @brief Carga y guardado de `Productos.json` y de `HistorialGas.json`.
+ */
+static void medirArchivos(Medidor& medidor, const Parametros& p) {
+    for (size_t n : p.archivos) {
+        std::string sufijo = "/" + std::to_string(n);
+
+        if (medidor.activo("Inventario/cargarDesdeJson" + sufijo) || medidor.activo("Inventario/guardarAJson" + sufijo)) {
+            ConfiguracionCatalogo config;
+            config.productos = n;
+            std::string archivo = "Productos_" + std::to_string(n) + ".json";
+            GeneradorCarga::generarCatalogo(config, archivo);
+            size_t bytes = tamanoArchivo(archivo);
+
+            medidor.medir("Inventario/cargarDesdeJson" + sufijo, [&](size_t iteraciones) {
+                for (size_t i = 0; i < iteraciones; i++) {
+                    Inventario inventario;
+                    inventario.cargarDesdeJson(archivo);
+                }
+            }, bytes);
+
+            Inventario inventario;
+            inventario.cargarDesdeJson(archivo);
+            std::string copia = "Guardado_" + std::to_string(n) + ".json";
+            medidor.medir("Inventario/guardarAJson" + sufijo, [&](size_t iteraciones) {
+                for (size_t i = 0; i < iteraciones; i++) {
+                    inventario.guardarAJson(copia);
+                }
+            }, bytes);
+        }
+
+        if (medidor.activo("Gasolinera/cargarHistorialJson" + sufijo)) {
+            std::string archivo = "HistorialGas_" + std::to_string(n) + ".json";
+            GeneradorCarga::generarHistorialGas(n, 42, archivo);
+            Gasolinera gasolinera;
+            medidor.medir("Gasolinera/cargarHistorialJson" + sufijo, [&](size_t iteraciones) {
+                for (size_t i = 0; i < iteraciones; i++) {
+                    gasolinera.cargarHistorialJson(archivo);
+                }
+            }, tamanoArchivo(archivo));
+        }
+    }
+}
+
+/**
+ * @brief Generación de tickets: escritura en línea y con el hilo escritor.
+ */
+static void medirTickets(Medidor& medidor) {
+    if (!medidor.activo("GeneradorTickets/generarTicket")) {
+        return;
+    }
+    ArchivoTickets::instancia().abrir("Tickets");
+    Dinero precio = Dinero::desdeCentavos(1999);
+
+    // Sin hilo escritor: renderizado + archivo de tickets + ticket_compra.txt
+    medidor.medir("GeneradorTickets/generarTicket/en_linea", [&](size_t iteraciones) {
+        for (size_t i = 0; i < iteraciones; i++) {
+            GeneradorTickets::generarTicket("Producto de prueba", 3, precio, precio * 3, "Efectivo");
+        }
+    });
+
+    // Con hilo escritor: lo que paga la caja es renderizar y encolar
+    EscritorTickets::instancia().iniciar();
+    medidor.medir("GeneradorTickets/generarTicket/escritor", [&](size_t iteraciones) {
+        for (size_t i = 0; i < iteraciones; i++) {
+            GeneradorTickets::generarTicket("Producto de prueba", 3, precio, precio * 3, "Efectivo");
+        }
+    });
+    EscritorTickets::instancia().detener();
+}
+
+/**
+ * @brief Costo de `notificar` según el número de observadores.
+ */
+static void medirObservadores(Medidor& medidor) {
+    for (size_t k : { 1, 8, 64 }) {
+        std::string nombre = "Inventario/notificar/" + std::to_string(k);
+        if (!medidor.activo(nombre)) {
+            continue;
+        }
+        Inventario inventario;
+        std::vector<ObservadorContador> observadores(k);
+        for (auto& obs : observadores) {
+            inventario.agregarObservador(&obs);
+        }
+        medidor.medir(nombre, [&](size_t iteraciones) {
+            for (size_t i = 0; i < iteraciones; i++) {
+                inventario.notificar("Stock bajo de Producto de prueba");
+            }
+        });
+    }
+}
+
+/**
+ * @brief Costo de una medición por etapa (dos lecturas del reloj y el histograma del hilo).
+ */
+static void medirMetricas(Medidor& medidor) {
+    medidor.medir("MetricasEtapas/medicion", [&](size_t iteraciones) {
+        for (size_t i = 0; i < iteraciones; i++) {
+            MedicionEtapa medicion(Etapa::VentaInventario);
+        }
+    });
+    medidor.medir("RelojCiclos/ahora", [&](size_t iteraciones) {
+        std::uint64_t suma = 0;
+        for (size_t i = 0; i < iteraciones; i++) {
+            suma += RelojCiclos::ahora();
+        }
+        sumidero = sumidero + static_cast<long long>(suma);
+    });
+}
+
+/**
+ * @brief Función principal de los microbenchmarks.
+ *
+ * @param argc Número de argumentos.
+ * @param argv Argumentos de la línea de comandos.
+ * @return int 0 si terminó, 1 si los parámetros, la carpeta o la salida no son válidos.
+ */
+int main(int argc, char* argv[]) {
+    Parametros p;
+    if (!leerParametros(argc, argv, p)) {
+        return 1;
+    }
+
+    std::error_code error;
+    std::filesystem::path salida = p.salida.empty() ? std::filesystem::path() : std::filesystem::absolute(p.salida);
+    std::filesystem::create_directories(p.carpeta, error);
+    std::filesystem::current_path(p.carpeta, error);
+    if (error) {
+        std::cerr << "No se pudo usar la carpeta " << p.carpeta << "\n";
+        return 1;
+    }
+
+    // Los mensajes del sistema no se muestran (el avance va por std::cerr)
+    std::streambuf* consola = std::cout.rdbuf();
+    std::cout.rdbuf(nullptr);
+
+    Medidor medidor(p);
+    medirInventario(medidor, p);
+    medirArchivos(medidor, p);
+    medirTickets(medidor);
+    medirObservadores(medidor);
+    medirMetricas(medidor);
+
+    std::cout.rdbuf(consola);
+    std::cout.clear();
+
+    json reporte = {
+        {"contexto", {
+            {"fecha", Reloj::local().textoIso},
+#if defined(_MSC_VER)
+            {"compilador", "MSVC " + std::to_string(_MSC_VER)},
+#elif defined(__VERSION__)
+            {"compilador", __VERSION__},
+#else
+            {"compilador", "desconocido"},
+#endif
+#ifdef NDEBUG
+            {"depuracion", false},
+#else
+            {"depuracion", true},
+#endif
+            {"tiempo_minimo_s", p.tiempoMinimo}
+        }},
+        {"resultados", medidor.getResultados()}
+    };
+
+    if (salida.empty()) {
+        std::cout << reporte.dump(2) << "\n";
+        return 0;
+    }
+    std::ofstream archivo(salida);
+    if (!archivo) {
+        std::cerr << "No se pudo escribir " << salida.string() << "\n";
+        return 1;
+    }
+    archivo << reporte.dump(2) << "\n";
+    return 0;
+}
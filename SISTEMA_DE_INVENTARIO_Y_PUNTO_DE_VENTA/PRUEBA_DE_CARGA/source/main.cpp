@@ -0,0 +1,461 @@
+﻿/**
+ * @file main.cpp
+ * @brief Prueba de carga de punta a punta del punto de venta.
+ *
+ * Genera un catálogo y un historial de gasolinera sintéticos, los carga con el
+ * código de producción y ejecuta desde N hilos un flujo de ventas, reposiciones
+ * y cargas de gasolina cuya popularidad de productos sigue una Zipf. Al final
+ * informa el rendimiento y la latencia p50/p99/p999 por tipo de transacción.
+ *
+ * Uso:
+ * `PRUEBA_DE_CARGA [--productos N] [--historial N] [--operaciones N] [--hilos N]
+ *  [--zipf S] [--mezcla V,R,C] [--semilla N] [--carpeta DIR]`
+ *
+ * Todos los archivos (catálogo, tickets, facturas, diarios) se escriben en la
+ * carpeta de trabajo (por omisión `PruebaCarga/`), nunca en los del sistema.
+ *
+ * Con `--servidor DIRECCION` el flujo se envía a un `ServidorPOS` en lugar de
+ * ejecutarse en este proceso: cada hilo es una caja con su propia conexión. El
+ * servidor debe haberse iniciado en una carpeta preparada por una ejecución
+ * local con el mismo `--productos` y `--semilla` (catálogo y tanques):
+ *
+ *     PRUEBA_DE_CARGA --productos 100000 --operaciones 0
+ *     cd PruebaCarga && SISTEMA_DE_INVENTARIO_Y_PUNTO_DE_VENTA --servidor unix:/tmp/pos.sock
+ *     PRUEBA_DE_CARGA --productos 100000 --servidor unix:/tmp/pos.sock
+ *
+ * @date 2026-10-19
+ * @version 1.0
+ * @author Ari
+ */
+#include "ProgrammingPatterns/carga/GeneradorCarga.h"
+#include "ProgrammingPatterns/modelos/Inventario.h"
+#include "ProgrammingPatterns/observer/AlertaStockBajo.h"
+#include "ProgrammingPatterns/gasolinera/Gasolinera.h"
+#include "ProgrammingPatterns/facade/SistemaFacade.h"
+#include "ProgrammingPatterns/facade/SistemaGasolineraFacade.h"
+#include "ProgrammingPatterns/pagos/MotorComisiones.h"
+#include "ProgrammingPatterns/pagos/Liquidaciones.h"
+#include "ProgrammingPatterns/tickets/ArchivoTickets.h"
+#include "ProgrammingPatterns/tickets/EscritorTickets.h"
+#include "ProgrammingPatterns/facturas/RegistroVentas.h"
+#include "ProgrammingPatterns/servidor/ClientePOS.h"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+#include <filesystem>
+#include <iomanip>
+#include <iostream>
+#include <mutex>
+#include <thread>
+
+using Cronometro = std::chrono::steady_clock;
+
+/**
+ * @struct Parametros
+ * @brief Opciones de la línea de comandos.
+ */
+struct
+Parametros {
+    ConfiguracionCatalogo catalogo;
+    size_t historial = 10000;
+    size_t operaciones = 200000;
+    unsigned hilos = 0;
+    double zipf = 1.0;
+    MezclaOperaciones mezcla;
+    std::string carpeta = "PruebaCarga";
+    std::string servidor;
+};
+
+/**
+ * @brief Lee las opciones; devuelve false si alguna no es válida.
+ */
+static bool leerParametros(int argc, char* argv[], Parametros& p) {
+    for (int i = 1; i < argc; i++) {
+        const char* opcion = argv[i];
+        if (i + 1 >= argc) {
+            std::cout << "Falta el valor de " << opcion << "\n";
+            return false;
+        }
+        const char* valor = argv[++i];
+        if (std::strcmp(opcion, "--productos") == 0) {
+            p.catalogo.productos = std::strtoull(valor, nullptr, 10);
+        }
+        else if (std::strcmp(opcion, "--historial") == 0) {
+            p.historial = std::strtoull(valor, nullptr, 10);
+        }
+        else if (std::strcmp(opcion, "--operaciones") == 0) {
+            p.operaciones = std::strtoull(valor, nullptr, 10);
+        }
+        else if (std::strcmp(opcion, "--hilos") == 0) {
+            p.hilos = static_cast<unsigned>(std::strtoul(valor, nullptr, 10));
+        }
+        else if (std::strcmp(opcion, "--zipf") == 0) {
+            p.zipf = std::strtod(valor, nullptr);
+        }
+        else if (std::strcmp(opcion, "--mezcla") == 0) {
+            if (std::sscanf(valor, "%lf,%lf,%lf", &p.mezcla.ventas, &p.mezcla.reposiciones, &p.mezcla.cargas) != 3) {
+                std::cout << "La mezcla debe ser V,R,C (por ejemplo 0.7,0.1,0.2)\n";
+                return false;
+            }
+        }
+        else if (std::strcmp(opcion, "--semilla") == 0) {
+            p.catalogo.semilla = std::strtoull(valor, nullptr, 10);
+        }
+        else if (std::strcmp(opcion, "--carpeta") == 0) {
+            p.carpeta = valor;
+        }
+        else if (std::strcmp(opcion, "--servidor") == 0) {
+            p.servidor = valor;
+        }
+        else {
+            std::cout << "Opcion desconocida: " << opcion << "\n";
+            return false;
+        }
+    }
+    if (p.catalogo.productos == 0 || p.catalogo.productos > 0xFFFFFFFFu || p.zipf < 0.0) {
+        std::cout << "Parametros invalidos.\n";
+        return false;
+    }
+    if (p.hilos == 0) {
+        p.hilos = std::max(1u, std::thread::hardware_concurrency());
+    }
+    return true;
+}
+
+/**
+ * @struct Latencias
+ * @brief Latencias (ns) de un hilo, separadas por tipo de transacción.
+ */
+struct
+Latencias {
+    std::vector<std::uint64_t> porTipo[3];
+};
+
+/**
+ * @brief Muestra conteo, percentiles y máximo de una serie de latencias.
+ *
+ * @param nombre Etiqueta de la fila.
+ * @param ns Latencias en nanosegundos (se ordenan).
+ */
+static void imprimirFila(const char* nombre, std::vector<std::uint64_t>& ns) {
+    std::cout << std::left << std::setw(14) << nombre << std::right << std::setw(10) << ns.size();
+    if (ns.empty()) {
+        std::cout << "\n";
+        return;
+    }
+    std::sort(ns.begin(), ns.end());
+    auto percentil = [&ns](double p) {
+        size_t i = static_cast<size_t>(p * static_cast<double>(ns.size() - 1) + 0.5);
+        return ns[i] / 1000.0;
+    };
+    std::cout << std::fixed << std::setprecision(1)
+        << std::setw(12) << percentil(0.50)
+        << std::setw(12) << percentil(0.99)
+        << std::setw(12) << percentil(0.999)
+        << std::setw(12) << ns.back() / 1000.0 << "\n";
+}
+
+/**
+ * @brief Tiempo transcurrido en segundos.
+ */
+static double segundosDesde(Cronometro::time_point inicio) {
+    return std::chrono::duration<double>(Cronometro::now() - inicio).count();
+}
+
+/**
+ * @brief Envía el flujo de cada hilo a un servidor, una solicitud a la vez.
+ *
+ * @param p Parámetros (dirección del servidor).
+ * @param flujos Operaciones de cada hilo.
+ * @param latencias Salida: latencias de cada hilo.
+ * @param rechazadas Salida: respuestas con estado distinto de Ok.
+ * @return double Segundos del flujo, o -1 si algún hilo no pudo conectarse.
+ */
+static double ejecutarContraServidor(const Parametros& p, const std::vector<std::vector<OperacionCarga>>& flujos,
+    std::vector<Latencias>& latencias, std::atomic<unsigned long long>& rechazadas) {
+
+    std::atomic<bool> arrancar{ false };
+    std::atomic<unsigned> listos{ 0 };
+    std::atomic<bool> fallo{ false };
+    std::vector<std::thread> hilos;
+
+    for (unsigned h = 0; h < p.hilos; h++) {
+        hilos.emplace_back([&, h]() {
+            ClientePOS caja;
+            bool conectado = caja.conectar(p.servidor);
+            if (!conectado) {
+                fallo.store(true);
+            }
+            Latencias& mias = latencias[h];
+            for (auto& serie : mias.porTipo) {
+                serie.reserve(flujos[h].size());
+            }
+            listos.fetch_add(1);
+            while (!arrancar.load(std::memory_order_acquire)) {
+                std::this_thread::yield();
+            }
+            if (!conectado) {
+                return;
+            }
+
+            SolicitudPOS solicitud;
+            RespuestaPOS respuesta;
+            unsigned long long noOk = 0;
+            for (const OperacionCarga& op : flujos[h]) {
+                solicitud.id++;
+                solicitud.pago = static_cast<std::uint8_t>(op.pago);
+                switch (op.tipo) {
+                case OperacionCarga::Venta:
+                    solicitud.tipo = TipoSolicitud::Venta;
+                    solicitud.cantidad = op.cantidad;
+                    solicitud.texto = GeneradorCarga::codigoProducto(op.producto);
+                    break;
+                case OperacionCarga::Reposicion:
+                    solicitud.tipo = TipoSolicitud::Reposicion;
+                    solicitud.cantidad = op.cantidad;
+                    solicitud.texto = GeneradorCarga::codigoProducto(op.producto);
+                    break;
+                case OperacionCarga::Carga:
+                    solicitud.tipo = TipoSolicitud::Carga;
+                    solicitud.cantidad = static_cast<std::int32_t>(op.litros * 1000.0 + 0.5);
+                    solicitud.texto = GeneradorCarga::kCombustibles[op.combustible];
+                    break;
+                }
+                auto t0 = Cronometro::now();
+                if (!caja.solicitar(solicitud, respuesta)) {
+                    fallo.store(true);
+                    break;
+                }
+                auto ns = std::chrono::duration_cast<std::chrono::nanoseconds>(Cronometro::now() - t0).count();
+                mias.porTipo[op.tipo].push_back(static_cast<std::uint64_t>(ns));
+                if (respuesta.estado != EstadoRespuesta::Ok) {
+                    noOk++;
+                }
+            }
+            rechazadas.fetch_add(noOk);
+        });
+    }
+
+    while (listos.load() < p.hilos) {
+        std::this_thread::yield();
+    }
+    auto inicio = Cronometro::now();
+    arrancar.store(true, std::memory_order_release);
+    for (auto& hilo : hilos) {
+        hilo.join();
+    }
+    double segundos = segundosDesde(inicio);
+    if (fallo.load()) {
+        std::cout << "Se perdio la conexion con el servidor " << p.servidor << "\n";
+        return -1.0;
+    }
+    return segundos;
+}
+
+/**
+ * @brief Imprime la tabla de latencias por tipo de transacción.
+ */
+static void imprimirLatencias(std::vector<Latencias>& latencias, size_t operaciones) {
+    std::cout << "\n" << std::left << std::setw(14) << "Latencia (us)" << std::right << std::setw(10) << "n"
+        << std::setw(12) << "p50" << std::setw(12) << "p99" << std::setw(12) << "p999" << std::setw(12) << "max" << "\n";
+
+    static const char* const kNombres[3] = { "Ventas", "Reposiciones", "Cargas" };
+    std::vector<std::uint64_t> todas;
+    todas.reserve(operaciones);
+    for (int t = 0; t < 3; t++) {
+        std::vector<std::uint64_t> serie;
+        for (auto& l : latencias) {
+            serie.insert(serie.end(), l.porTipo[t].begin(), l.porTipo[t].end());
+            std::vector<std::uint64_t>().swap(l.porTipo[t]);
+        }
+        todas.insert(todas.end(), serie.begin(), serie.end());
+        imprimirFila(kNombres[t], serie);
+    }
+    imprimirFila("Total", todas);
+}
+
+/**
+ * @brief Función principal de la prueba de carga.
+ *
+ * @param argc Número de argumentos.
+ * @param argv Argumentos de la línea de comandos.
+ * @return int 0 si terminó, 1 si los parámetros o la carpeta no son válidos.
+ */
+int main(int argc, char* argv[]) {
+    Parametros p;
+    if (!leerParametros(argc, argv, p)) {
+        return 1;
+    }
+
+    std::error_code error;
+    std::filesystem::create_directories(p.carpeta, error);
+    std::filesystem::current_path(p.carpeta, error);
+    if (error) {
+        std::cout << "No se pudo usar la carpeta " << p.carpeta << "\n";
+        return 1;
+    }
+
+    std::cout << "Productos: " << p.catalogo.productos << "  Historial: " << p.historial
+        << "  Operaciones: " << p.operaciones << "  Hilos: " << p.hilos << "  Zipf: " << p.zipf << "\n";
+
+    // Contra un servidor: solo el flujo, el servidor ya tiene su catálogo
+    if (!p.servidor.empty()) {
+        std::vector<std::vector<OperacionCarga>> flujos(p.hilos);
+        for (unsigned h = 0; h < p.hilos; h++) {
+            size_t parte = p.operaciones / p.hilos + (h < p.operaciones % p.hilos ? 1 : 0);
+            flujos[h] = GeneradorCarga::generarOperaciones(parte, p.catalogo.productos, p.zipf, p.mezcla,
+                p.catalogo.semilla + 1 + h);
+        }
+        std::vector<Latencias> latencias(p.hilos);
+        std::atomic<unsigned long long> rechazadas{ 0 };
+        double segFlujo = ejecutarContraServidor(p, flujos, latencias, rechazadas);
+        if (segFlujo < 0.0) {
+            return 1;
+        }
+        std::cout << std::fixed << std::setprecision(3);
+        std::cout << "\n===== PRUEBA DE CARGA (servidor " << p.servidor << ") =====\n";
+        std::cout << "Flujo de transacciones: " << segFlujo << " s\n";
+        std::cout << "Respuestas no Ok:      " << rechazadas.load() << "\n";
+        if (segFlujo > 0.0) {
+            std::cout << std::setprecision(0) << "Rendimiento: " << p.operaciones / segFlujo << " solicitudes/s\n";
+        }
+        imprimirLatencias(latencias, p.operaciones);
+        return 0;
+    }
+
+    // 1. Datos sintéticos
+    auto inicio = Cronometro::now();
+    if (!GeneradorCarga::generarCatalogo(p.catalogo, "Productos.json") ||
+        !GeneradorCarga::generarHistorialGas(p.historial, p.catalogo.semilla, "HistorialGas.json")) {
+        std::cout << "No se pudieron escribir los archivos sinteticos.\n";
+        return 1;
+    }
+    double segGenerar = segundosDesde(inicio);
+
+    std::vector<std::vector<OperacionCarga>> flujos(p.hilos);
+    for (unsigned h = 0; h < p.hilos; h++) {
+        size_t parte = p.operaciones / p.hilos + (h < p.operaciones % p.hilos ? 1 : 0);
+        flujos[h] = GeneradorCarga::generarOperaciones(parte, p.catalogo.productos, p.zipf, p.mezcla,
+            p.catalogo.semilla + 1 + h);
+    }
+
+    // 2. Sistema: igual que en main, pero sin mensajes en consola
+    std::streambuf* consola = std::cout.rdbuf();
+    std::cout.rdbuf(nullptr);
+
+    Inventario inventario;
+    AlertaStockBajo alerta;
+    inventario.agregarObservador(&alerta);
+
+    Gasolinera gasolinera;
+    // Tanques sin límite práctico para que la prueba no se quede sin combustible
+    for (const char* tipo : GeneradorCarga::kCombustibles) {
+        gasolinera.agregarTanque(tipo, 1e12, 1e12, 0);
+    }
+    // Los mismos tanques para un servidor que se inicie en esta carpeta
+    gasolinera.guardarTanquesJson("Tanques.json");
+    time_t ahora = time(nullptr);
+    gasolinera.getTablaPrecios().programarCambio({ "Magna", Dinero::desdeCentavos(2350), ahora });
+    gasolinera.getTablaPrecios().programarCambio({ "Premium", Dinero::desdeCentavos(2590), ahora });
+    gasolinera.getTablaPrecios().programarCambio({ "Diesel", Dinero::desdeCentavos(2530), ahora });
+
+    MotorComisiones::instancia().cargarJson("Comisiones.json");
+    RegistroLiquidaciones::instancia().abrir("Liquidaciones.dat");
+    ArchivoTickets::instancia().abrir("Tickets");
+    EscritorTickets::instancia().iniciar();
+    RegistroVentas::instancia().abrir("Ventas.dat");
+
+    inicio = Cronometro::now();
+    inventario.cargarDesdeJson("Productos.json");
+    double segCatalogo = segundosDesde(inicio);
+
+    inicio = Cronometro::now();
+    gasolinera.cargarHistorialJson("HistorialGas.json");
+    double segHistorial = segundosDesde(inicio);
+
+    // 3. Flujo de transacciones desde N hilos.
+    // Inventario y Gasolinera no son seguros entre hilos (búsqueda y vector sin
+    // candado), así que cada uno se protege con su propio mutex; los servicios
+    // compartidos (folios, tickets, facturas, liquidaciones) ya lo son.
+    std::mutex mutexTienda;
+    std::mutex mutexGasolinera;
+    std::atomic<bool> arrancar{ false };
+    std::vector<Latencias> latencias(p.hilos);
+    std::vector<std::thread> hilos;
+
+    for (unsigned h = 0; h < p.hilos; h++) {
+        hilos.emplace_back([&, h]() {
+            SistemaFacade facade;
+            SistemaGasolineraFacade gasFacade;
+            Latencias& mias = latencias[h];
+            for (auto& serie : mias.porTipo) {
+                serie.reserve(flujos[h].size());
+            }
+            while (!arrancar.load(std::memory_order_acquire)) {
+                std::this_thread::yield();
+            }
+
+            for (const OperacionCarga& op : flujos[h]) {
+                auto t0 = Cronometro::now();
+                switch (op.tipo) {
+                case OperacionCarga::Venta: {
+                    std::string codigo = GeneradorCarga::codigoProducto(op.producto);
+                    PagoVariante pago = crearPago(op.pago);
+                    std::lock_guard<std::mutex> lock(mutexTienda);
+                    facade.procesarVenta(inventario, codigo, op.cantidad, pago);
+                    break;
+                }
+                case OperacionCarga::Reposicion: {
+                    std::string codigo = GeneradorCarga::codigoProducto(op.producto);
+                    std::lock_guard<std::mutex> lock(mutexTienda);
+                    inventario.comprarProducto(codigo, op.cantidad);
+                    break;
+                }
+                case OperacionCarga::Carga: {
+                    PagoVariante pago = crearPago(op.pago);
+                    std::lock_guard<std::mutex> lock(mutexGasolinera);
+                    gasFacade.procesarCarga(gasolinera, op.litros, GeneradorCarga::kCombustibles[op.combustible],
+                        &comoMetodoPago(pago));
+                    break;
+                }
+                }
+                auto ns = std::chrono::duration_cast<std::chrono::nanoseconds>(Cronometro::now() - t0).count();
+                mias.porTipo[op.tipo].push_back(static_cast<std::uint64_t>(ns));
+            }
+        });
+    }
+
+    inicio = Cronometro::now();
+    arrancar.store(true, std::memory_order_release);
+    for (auto& hilo : hilos) {
+        hilo.join();
+    }
+    double segFlujo = segundosDesde(inicio);
+
+    // Terminar las escrituras en segundo plano antes de informar
+    inicio = Cronometro::now();
+    EscritorTickets::instancia().detener();
+    RegistroLiquidaciones::instancia().detener();
+    RegistroVentas::instancia().guardar();
+    double segVaciado = segundosDesde(inicio);
+
+    std::cout.rdbuf(consola);
+    std::cout.clear();
+
+    // 4. Informe
+    std::cout << std::fixed << std::setprecision(3);
+    std::cout << "\n===== PRUEBA DE CARGA =====\n";
+    std::cout << "Generar archivos:      " << segGenerar << " s\n";
+    std::cout << "Cargar catalogo:       " << segCatalogo << " s\n";
+    std::cout << "Cargar historial gas:  " << segHistorial << " s\n";
+    std::cout << "Flujo de transacciones: " << segFlujo << " s\n";
+    std::cout << "Vaciar escritores:     " << segVaciado << " s\n";
+    if (segFlujo > 0.0) {
+        std::cout << std::setprecision(0) << "Rendimiento: " << p.operaciones / segFlujo << " transacciones/s\n";
+    }
+
+    imprimirLatencias(latencias, p.operaciones);
+    return 0;
+}
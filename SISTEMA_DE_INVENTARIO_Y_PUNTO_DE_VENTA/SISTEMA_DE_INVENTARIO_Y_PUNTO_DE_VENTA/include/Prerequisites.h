@@ -2,10 +2,10 @@
 
 /**
  * @file Prerequisites.h
- * @brief Contiene las definiciones para la estructura Fecha y la enumeracin Estado,
- * utilizadas para la gestin de tareas o eventos.
+ * @brief Contiene las definiciones para la estructura Fecha y la enumeración Estado,
+ * utilizadas para la gestión de tareas o eventos.
  *
- * Este archivo proporciona herramientas bsicas para manejar fechas del sistema
+ * Este archivo proporciona herramientas básicas para manejar fechas del sistema
  * y clasificar el estado de un elemento.
  *
  * @author Ariana Moreno Jimenez
@@ -17,7 +17,9 @@
 #include <string>
 #include <vector>
 #include <ctime>
+#include <cstdio>
 #include <memory>
+#include "ProgrammingPatterns/tiempo/Reloj.h"
 
 
 
@@ -25,36 +27,46 @@
 
  /**
   * @struct Fecha
-  * @brief Estructura para almacenar y gestionar una fecha (da, mes, ao).
+  * @brief Estructura para almacenar y gestionar una fecha (día, mes, año).
+  *
+  * La fecha se guarda compacta como días desde 1970-01-01; día, mes y año se
+  * calculan al pedirlos. Comparar o restar fechas es comparar o restar enteros.
   */
 struct Fecha {
 
-	int dia;
-	int mes;
-	int anio;
+	/// Días desde 1970-01-01 (calendario local).
+	std::int32_t dias = 0;
 
 	/**
-	 * @brief Obtiene la fecha actual del sistema y la asigna a los miembros de la estructura.
-	 *
-	 * Internamente usa las funciones de tiempo de la biblioteca estndar de C (`time`, `localtime`).
+	 * @brief Crea una fecha a partir de día, mes y año.
+	 */
+	static Fecha
+		desdeCivil(int anio, int mes, int dia) {
+
+		Fecha f;
+		f.dias = diasDesdeCivil(anio, mes, dia);
+		return f;
+	}
+
+	/**
+	 * @brief Obtiene la fecha actual del sistema y la asigna a la estructura.
 	 *
-	 * @note Esta funcin tambin imprime la fecha obtenida en la consola (`std::cout`).
+	 * Usa la hora local en caché de `Reloj`, así que es segura entre hilos y no
+	 * imprime nada.
 	 * @return void
 	 */
 	void
 		getFecha() {
 
-		time_t t = time(0);
-		tm* now = localtime(&t);
-
-		dia = now->tm_mday;
-
-		mes = now->tm_mon + 1;
-		anio = now->tm_year + 1900;
+		dias = Reloj::local().diasDesdeEpoca;
+	}
 
+	int getDia() const { int a, m, d; civilDesdeDias(dias, a, m, d); return d; }
+	int getMes() const { int a, m, d; civilDesdeDias(dias, a, m, d); return m; }
+	int getAnio() const { int a, m, d; civilDesdeDias(dias, a, m, d); return a; }
 
-		std::cout << "Fecha actual: " << toString() << std::endl;
-	}
+	bool operator==(const Fecha& otra) const { return dias == otra.dias; }
+	bool operator<(const Fecha& otra) const { return dias < otra.dias; }
 
 	/**
 	 * @brief Convierte la fecha almacenada en un string con formato "DD/MM/AAAA".
@@ -63,7 +75,11 @@ struct Fecha {
 	 */
 	std::string toString() const {
 
-		return std::to_string(dia) + "/" + std::to_string(mes) + "/" + std::to_string(anio);
+		int anio, mes, dia;
+		civilDesdeDias(dias, anio, mes, dia);
+		char texto[32];
+		std::snprintf(texto, sizeof(texto), "%02d/%02d/%04d", dia, mes, anio);
+		return texto;
 	}
 
 
@@ -82,7 +98,7 @@ enum class Estado {
 };
 
 /**
- * @brief Convierte un valor de la enumeracin 'Estado' a su representacin en cadena de texto.
+ * @brief Convierte un valor de la enumeración 'Estado' a su representación en cadena de texto.
  *
  * @param estado El valor 'Estado' a convertir.
  * @return std::string La cadena de texto correspondiente al estado (ej. "Pendiente").
@@ -0,0 +1,211 @@
+﻿#pragma once
+#include "ProgrammingPatterns/modelos/Inventario.h"
+#include "ProgrammingPatterns/servidor/ClientePOS.h"
+#include <chrono>
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+/**
+ * @file CajaRemota.h
+ * @brief Caja que vende con una copia local del catálogo y sincroniza por lotes.
+ *
+ * La caja no depende de la conexión con el servidor para vender: busca precio,
+ * nombre y existencia en su copia del catálogo (`CatalogoCaja.json`, mismo
+ * formato que `Productos.json`), anota la venta en una cola local en disco y
+ * la envía al servidor después. La cola se envía en lotes de
+ * `kVentasPorLote` ventas sin esperar cada respuesta, así que con conexión
+ * también se ahorran viajes por venta.
+ *
+ * Cada venta lleva un número de la caja que no se repite y crece; la caja se
+ * identifica con su nombre y el servidor guarda en disco la respuesta de cada
+ * número, así que reenviar un lote cuya respuesta se perdió no vende dos
+ * veces, aunque el servidor se haya reiniciado entretanto.
+ *
+ * Conflictos: si otra caja vendió antes lo último del producto, el servidor
+ * contesta sin stock con lo que queda; la caja vende eso (una venta nueva por
+ * lo disponible) y anota el faltante. También se anotan los productos que ya
+ * no existen, los pagos rechazados y los totales que no coinciden con el
+ * precio del servidor. Los conflictos quedan en `ConflictosCaja.json` para la
+ * oficina.
+ *
+ * @date 2026-10-19
+ * @version 1.0
+ * @author Ari
+ */
+
+ /**
+  * @struct VentaPendiente
+  * @brief Venta anotada en la caja que aún no confirma el servidor (tamaño fijo).
+  */
+struct
+VentaPendiente {
+    std::uint32_t numero = 0;
+    std::int32_t cantidad = 0;
+    std::int64_t fecha = 0;
+
+    /// Precio unitario que cobró la caja (el de su catálogo).
+    std::int64_t precioCentavos = 0;
+
+    std::uint8_t pago = 1;
+    std::uint8_t marca = 0;
+    char codigo[30] = {};
+};
+
+/**
+ * @struct ConflictoVenta
+ * @brief Venta que el servidor no aceptó tal como la hizo la caja.
+ */
+struct
+ConflictoVenta {
+    std::uint32_t numero = 0;
+    std::string codigo;
+    std::int64_t fecha = 0;
+    int cantidad = 0;
+
+    /// Unidades que sí había en el servidor (se venden en una venta aparte).
+    int disponibles = 0;
+
+    Dinero totalCaja;
+    Dinero totalServidor;
+    std::string motivo;
+};
+
+/**
+ * @class CajaRemota
+ * @brief Catálogo local, cola de ventas y sincronización con `ServidorPOS`.
+ */
+class
+CajaRemota {
+public:
+
+    /// Ventas que se envían juntas.
+    static constexpr size_t kVentasPorLote = 64;
+
+    /// Solicitudes de catálogo que se envían juntas.
+    static constexpr size_t kVentanaCatalogo = 512;
+
+    /// Espera máxima del servidor antes de trabajar sin conexión.
+    static constexpr int kEsperaMs = 2000;
+
+    /**
+     * @struct ResumenSincronizacion
+     * @brief Resultado de enviar la cola.
+     */
+    struct ResumenSincronizacion {
+        size_t confirmadas = 0;
+        size_t conflictos = 0;
+
+        /// true si la cola quedó vacía.
+        bool completa = false;
+    };
+
+private:
+
+    std::string nombre;
+    std::string direccion;
+
+    ClientePOS cliente;
+    bool conectada = false;
+
+    /// Copia local del catálogo (precio, nombre y existencia conocida).
+    Inventario catalogo;
+
+    std::vector<VentaPendiente> cola;
+    std::uint32_t siguienteNumero = 1;
+    std::string archivoCola;
+
+    std::vector<ConflictoVenta> conflictos;
+    std::string archivoConflictos;
+
+    std::chrono::steady_clock::time_point ultimaSincronizacion;
+
+    /// Se conecta y se identifica si hace falta.
+    bool conectar();
+
+    void desconectar();
+
+    /// Reescribe la cola completa (encabezado con el siguiente número y ventas).
+    void guardarCola() const;
+
+    void guardarConflictos() const;
+
+    /**
+     * @brief Revisa la respuesta de una venta; puede agregar a la cola una venta por lo disponible.
+     *
+     * @param stockServidor Última existencia que informó el servidor, por código.
+     */
+    void revisarRespuesta(const VentaPendiente& venta, const RespuestaPOS& respuesta, ResumenSincronizacion& resumen,
+        std::unordered_map<std::string, int>& stockServidor);
+
+    /// Anota un conflicto.
+    void anotarConflicto(const VentaPendiente& venta, const RespuestaPOS& respuesta, const char* motivo);
+
+    /// Actualiza la existencia conocida de un producto.
+    void actualizarStock(const std::string& codigo, int stock);
+
+public:
+
+    /**
+     * @param nombre Nombre de la caja (identifica sus ventas en el servidor).
+     * @param direccion Dirección del servidor (ver `DireccionPOS`).
+     */
+    CajaRemota(const std::string& nombre, const std::string& direccion);
+
+    CajaRemota(const CajaRemota&) = delete;
+    CajaRemota& operator=(const CajaRemota&) = delete;
+
+    /**
+     * @brief Carga el catálogo, la cola y los conflictos guardados.
+     *
+     * @param archivoCatalogo Copia del catálogo (formato de `Productos.json`).
+     * @param archivoCola Cola binaria de ventas pendientes.
+     * @param archivoConflictos Conflictos anotados (JSON).
+     */
+    void abrir(const std::string& archivoCatalogo, const std::string& archivoCola, const std::string& archivoConflictos);
+
+    /**
+     * @brief Descarga el catálogo completo del servidor.
+     *
+     * La existencia de cada producto descuenta las ventas que siguen en la cola.
+     * Si la descarga falla se conserva la copia anterior.
+     *
+     * @param archivoCatalogo Donde se guarda la copia nueva.
+     * @return true si se descargó completo.
+     */
+    bool actualizarCatalogo(const std::string& archivoCatalogo);
+
+    /**
+     * @brief Vende con el catálogo local y anota la venta en la cola.
+     *
+     * Si la cola llena un lote se intenta enviar enseguida.
+     *
+     * @param codigo Código del producto.
+     * @param cantidad Unidades.
+     * @param pago 1-Efectivo 2-Debito 3-Credito.
+     * @param marca `MarcaTarjeta` (tarjetas).
+     * @return Total cobrado, o $0.00 si el producto no existe o no alcanza el stock.
+     */
+    Dinero vender(const std::string& codigo, int cantidad, std::uint8_t pago, std::uint8_t marca);
+
+    /**
+     * @brief Envía la cola al servidor por lotes.
+     */
+    ResumenSincronizacion sincronizar();
+
+    /**
+     * @brief Sincroniza si hay ventas pendientes y pasó `intervalo` desde el último intento.
+     */
+    void sincronizarSiToca(std::chrono::seconds intervalo);
+
+    const Inventario& getCatalogo() const { return catalogo; }
+
+    size_t pendientes() const { return cola.size(); }
+
+    bool enLinea() const { return conectada; }
+
+    const std::vector<ConflictoVenta>& getConflictos() const { return conflictos; }
+
+    const std::string& getNombre() const { return nombre; }
+};
@@ -0,0 +1,203 @@
+﻿#pragma once
+#include <cmath>
+#include <cstdint>
+#include <random>
+#include <string>
+#include <vector>
+
+/**
+ * @file GeneradorCarga.h
+ * @brief Datos sintéticos para pruebas de carga: catálogos, historial de
+ * gasolinera y flujos de transacciones con popularidad tipo Zipf.
+ *
+ * Los archivos se escriben con el mismo formato que `Productos.json` y
+ * `HistorialGas.json`, directo al archivo (sin armar el JSON en memoria), para
+ * poder generar catálogos de millones de productos.
+ *
+ * @date 2026-10-19
+ * @version 1.0
+ * @author Ari
+ */
+
+ /**
+  * @class DistribucionZipf
+  * @brief Muestreo Zipf en [0, n) por inversión con rechazo, sin tablas.
+  *
+  * El elemento k (desde 1) tiene probabilidad proporcional a 1 / k^s. Usa
+  * memoria constante, así que sirve igual para 1 000 que para 10 millones de
+  * productos (Hörmann y Derflinger, "Rejection-inversion to generate variates
+  * from monotone discrete distributions").
+  */
+class
+DistribucionZipf {
+private:
+    double n;
+    double s;
+    double hIntegralX1;
+    double hIntegralN;
+    double umbral;
+
+    static double auxiliar1(double x) {
+        return std::abs(x) > 1e-8 ? std::log1p(x) / x : 1.0 - x * (0.5 - x * (1.0 / 3.0 - 0.25 * x));
+    }
+
+    static double auxiliar2(double x) {
+        return std::abs(x) > 1e-8 ? std::expm1(x) / x : 1.0 + x * 0.5 * (1.0 + x * (1.0 / 3.0) * (1.0 + 0.25 * x));
+    }
+
+    double h(double x) const { return std::exp(-s * std::log(x)); }
+
+    double hIntegral(double x) const {
+        double logX = std::log(x);
+        return auxiliar2((1.0 - s) * logX) * logX;
+    }
+
+    double hIntegralInversa(double x) const {
+        double t = x * (1.0 - s);
+        if (t < -1.0) {
+            t = -1.0;
+        }
+        return std::exp(auxiliar1(t) * x);
+    }
+
+public:
+
+    /**
+     * @brief Constructor de la distribución.
+     *
+     * @param elementos Número de elementos (mayor que cero).
+     * @param exponente Exponente s (0 = uniforme, ~1 = catálogo típico).
+     */
+    DistribucionZipf(size_t elementos, double exponente)
+        : n(static_cast<double>(elementos)), s(exponente) {
+        hIntegralX1 = hIntegral(1.5) - 1.0;
+        hIntegralN = hIntegral(n + 0.5);
+        umbral = 2.0 - hIntegralInversa(hIntegral(2.5) - h(2.0));
+    }
+
+    /**
+     * @brief Toma una muestra.
+     *
+     * @param generador Generador aleatorio.
+     * @return size_t Índice en [0, n); el 0 es el más popular.
+     */
+    template <typename Generador>
+    size_t operator()(Generador& generador) const {
+        std::uniform_real_distribution<double> azar(0.0, 1.0);
+        while (true) {
+            double u = hIntegralN + azar(generador) * (hIntegralX1 - hIntegralN);
+            double x = hIntegralInversa(u);
+            double k = std::floor(x + 0.5);
+            if (k < 1.0) {
+                k = 1.0;
+            }
+            else if (k > n) {
+                k = n;
+            }
+            if (k - x <= umbral || u >= hIntegral(k + 0.5) - h(k)) {
+                return static_cast<size_t>(k) - 1;
+            }
+        }
+    }
+};
+
+/**
+ * @struct ConfiguracionCatalogo
+ * @brief Parámetros de un catálogo sintético.
+ */
+struct
+ConfiguracionCatalogo {
+    size_t productos = 1000;
+
+    /// Largo de los nombres: normal con esta media y desviación, recortada.
+    double largoMedio = 28.0;
+    double largoDesviacion = 10.0;
+    size_t largoMinimo = 6;
+    size_t largoMaximo = 80;
+
+    long long precioMinimoCentavos = 500;
+    long long precioMaximoCentavos = 250000;
+    int stockInicial = 1000;
+    std::uint64_t semilla = 42;
+};
+
+/**
+ * @struct OperacionCarga
+ * @brief Una transacción del flujo sintético.
+ */
+struct
+OperacionCarga {
+    enum Tipo : std::uint8_t { Venta, Reposicion, Carga };
+
+    Tipo tipo = Venta;
+
+    /// Opción de pago del menú (1-Efectivo 2-Debito 3-Credito).
+    std::uint8_t pago = 1;
+
+    /// Combustible (índice en `GeneradorCarga::kCombustibles`).
+    std::uint8_t combustible = 0;
+
+    std::int32_t cantidad = 1;
+    std::uint32_t producto = 0;
+    double litros = 0.0;
+};
+
+/**
+ * @struct MezclaOperaciones
+ * @brief Proporción de cada tipo de transacción (no necesitan sumar 1).
+ */
+struct
+MezclaOperaciones {
+    double ventas = 0.7;
+    double reposiciones = 0.1;
+    double cargas = 0.2;
+};
+
+/**
+ * @class GeneradorCarga
+ * @brief Genera archivos y flujos de transacciones sintéticos.
+ */
+class
+GeneradorCarga {
+public:
+
+    /// Combustibles de las cargas sintéticas.
+    static constexpr const char* kCombustibles[3] = { "Magna", "Premium", "Diesel" };
+
+    /**
+     * @brief Código de 13 dígitos del producto sintético i.
+     */
+    static std::string codigoProducto(size_t indice);
+
+    /**
+     * @brief Escribe un catálogo sintético con el formato de `Productos.json`.
+     *
+     * @param config Parámetros del catálogo.
+     * @param archivo Ruta de salida.
+     * @return true si se escribió completo.
+     */
+    static bool generarCatalogo(const ConfiguracionCatalogo& config, const std::string& archivo);
+
+    /**
+     * @brief Escribe un historial de cargas con el formato de `HistorialGas.json`.
+     *
+     * @param registros Número de cargas.
+     * @param semilla Semilla aleatoria.
+     * @param archivo Ruta de salida.
+     * @return true si se escribió completo.
+     */
+    static bool generarHistorialGas(size_t registros, std::uint64_t semilla, const std::string& archivo);
+
+    /**
+     * @brief Genera un flujo de transacciones; los productos siguen una Zipf.
+     *
+     * @param total Número de transacciones.
+     * @param productos Productos del catálogo.
+     * @param exponenteZipf Exponente de popularidad.
+     * @param mezcla Proporción de ventas, reposiciones y cargas.
+     * @param semilla Semilla aleatoria.
+     * @return std::vector<OperacionCarga> Transacciones en orden.
+     */
+    static std::vector<OperacionCarga> generarOperaciones(size_t total, size_t productos, double exponenteZipf,
+        const MezclaOperaciones& mezcla, std::uint64_t semilla);
+};
@@ -0,0 +1,148 @@
+﻿#pragma once
+#include "ProgrammingPatterns/correo/DestinoCorreo.h"
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <string_view>
+#include <thread>
+
+/**
+ * @file ColaCorreos.h
+ * @brief Cola de salida de correos con hilo de envío, reintentos y persistencia.
+ *
+ * La caja solo arma el mensaje y lo agrega a la cola en memoria; nunca espera al
+ * servidor. El hilo de envío toma los mensajes nuevos por lote, los guarda en
+ * `<carpeta>/cola/` (así sobreviven a un reinicio) y los entrega al
+ * `DestinoCorreo`. Un mensaje entregado se borra de la cola; uno que falla se
+ * reintenta con espera creciente y, tras `kMaxIntentos`, pasa a
+ * `<carpeta>/fallidos/`.
+ *
+ * @date 2026-10-19
+ * @version 1.0
+ * @author Ari
+ */
+
+ /**
+  * @class ColaCorreos
+  * @brief Correos de tickets pendientes de envío y su hilo de entrega.
+  *
+  * Existe una instancia compartida (`instancia()`). Mientras no se llame a
+  * `iniciar()`, `encolarTicket()` devuelve false.
+  */
+class
+ColaCorreos {
+public:
+
+    /// Intentos de entrega antes de apartar un mensaje en `fallidos/`.
+    static constexpr int kMaxIntentos = 6;
+
+    /// Espera antes del primer reintento (se duplica en cada fallo).
+    static constexpr std::chrono::seconds kEsperaBase{ 2 };
+
+    /// Espera máxima entre reintentos.
+    static constexpr std::chrono::seconds kEsperaMaxima{ 60 };
+
+private:
+
+    /// Servidor de salida.
+    std::unique_ptr<DestinoCorreo> destino;
+
+    /// Carpeta de la cola persistente.
+    std::string carpeta;
+
+    /// Mensajes nuevos que el hilo aún no toma.
+    std::deque<Correo> nuevos;
+
+    /// Mensajes guardados en disco que esperan entrega (solo los usa el hilo).
+    std::deque<Correo> pendientes;
+
+    /// Mensajes en cola o en reintento.
+    std::atomic<size_t> enEspera{ 0 };
+
+    /// Mensajes entregados desde el arranque.
+    std::atomic<size_t> entregados{ 0 };
+
+    /// Genera nombres únicos entre reinicios.
+    std::atomic<unsigned long long> secuencia{ 0 };
+
+    /// Protege nuevos y banderas.
+    std::mutex mutexCola;
+
+    /// Avisa al hilo que hay mensajes nuevos.
+    std::condition_variable hayCorreos;
+
+    /// Hilo de envío.
+    std::thread hilo;
+
+    bool activo = false;
+    bool detenerSolicitado = false;
+
+    /**
+     * @brief Bucle del hilo de envío.
+     */
+    void enviar();
+
+    /**
+     * @brief Intenta entregar un mensaje y lo reprograma o aparta si falla.
+     *
+     * @param correo Mensaje pendiente.
+     * @return true si ya no hay que reintentarlo (entregado o apartado).
+     */
+    bool intentar(Correo& correo);
+
+    /**
+     * @brief Lee los mensajes que quedaron en la cola de una ejecución anterior.
+     */
+    void recuperar();
+
+public:
+
+    ColaCorreos() = default;
+    ~ColaCorreos();
+
+    ColaCorreos(const ColaCorreos&) = delete;
+    ColaCorreos& operator=(const ColaCorreos&) = delete;
+
+    /**
+     * @brief Instancia compartida del sistema.
+     * @return ColaCorreos& Cola de correos.
+     */
+    static ColaCorreos& instancia();
+
+    /**
+     * @brief Recupera los mensajes pendientes y arranca el hilo de envío.
+     *
+     * @param carpeta Carpeta de la cola persistente.
+     * @param destino Servidor de salida (la cola se queda con él).
+     */
+    void iniciar(const std::string& carpeta, std::unique_ptr<DestinoCorreo> destino);
+
+    /**
+     * @brief Guarda los mensajes nuevos en disco y detiene el hilo.
+     *
+     * Lo que no se entregó se reintenta en el siguiente arranque.
+     */
+    void detener();
+
+    /**
+     * @brief Agrega a la cola el correo con el ticket de una venta.
+     *
+     * No bloquea: solo arma el mensaje en memoria.
+     *
+     * @param destinatario Dirección del cliente.
+     * @param folio Folio del ticket.
+     * @param ticket Texto del ticket.
+     * @return true si quedó en cola.
+     */
+    bool encolarTicket(const std::string& destinatario, unsigned long long folio, std::string_view ticket);
+
+    /**
+     * @brief Mensajes en cola o esperando reintento.
+     */
+    size_t totalPendientes() const { return enEspera.load(); }
+
+    /**
+     * @brief Mensajes entregados desde el arranque.
+     */
+    size_t totalEntregados() const { return entregados.load(); }
+};
@@ -0,0 +1,100 @@
+﻿#pragma once
+#include "Prerequisites.h"
+#include <chrono>
+#include <mutex>
+#include <random>
+
+/**
+ * @file DestinoCorreo.h
+ * @brief Interfaz del servidor de salida de correo y buzón local tipo maildir.
+ *
+ * `ColaCorreos` llama a `entregar()` desde su hilo de envío, nunca desde la caja,
+ * así que una implementación puede bloquear mientras el servidor responde.
+ *
+ * @date 2026-10-19
+ * @version 1.0
+ * @author Ari
+ */
+
+ /**
+  * @struct Correo
+  * @brief Mensaje en la cola de salida.
+  */
+struct
+Correo {
+    /// Nombre único del mensaje (también es su nombre de archivo).
+    std::string nombre;
+
+    /// Dirección del cliente.
+    std::string destinatario;
+
+    /// Mensaje completo: encabezados, línea vacía y cuerpo.
+    std::string mensaje;
+
+    /// Intentos de entrega fallidos.
+    int intentos = 0;
+
+    /// Momento a partir del cual se puede reintentar.
+    std::chrono::steady_clock::time_point proximoIntento;
+};
+
+/**
+ * @class DestinoCorreo
+ * @brief Interfaz de un servidor de salida (SMTP o equivalente).
+ */
+class
+DestinoCorreo {
+public:
+    virtual ~DestinoCorreo() = default;
+
+    /**
+     * @brief Entrega un mensaje. Puede bloquear.
+     *
+     * @param correo Mensaje a entregar.
+     * @return true si el servidor aceptó el mensaje.
+     */
+    virtual bool entregar(const Correo& correo) = 0;
+};
+
+/**
+ * @class BuzonMaildir
+ * @brief Sustituto local del servidor SMTP: entrega en una carpeta tipo maildir.
+ *
+ * Cada mensaje se escribe en `tmp/` y se renombra a `new/`, así un lector nunca
+ * ve un mensaje a medias. Con `tasaFallo` se simulan caídas del servidor para
+ * probar los reintentos.
+ */
+class
+BuzonMaildir : public DestinoCorreo {
+private:
+
+    /// Carpeta raíz del buzón.
+    std::string carpeta;
+
+    /// Probabilidad de fallo simulado (0.0 a 1.0).
+    double tasaFallo;
+
+    /// Generador para los fallos simulados.
+    std::mt19937 generador;
+
+    /// Protege al generador aleatorio.
+    std::mutex mutexGenerador;
+
+public:
+
+    /**
+     * @brief Constructor del buzón; crea `tmp/` y `new/` si no existen.
+     *
+     * @param carpeta Carpeta raíz del buzón.
+     * @param tasaFallo Probabilidad de que una entrega falle.
+     */
+    BuzonMaildir(const std::string& carpeta, double tasaFallo = 0.0);
+
+    /**
+     * @brief Escribe el mensaje en `tmp/` y lo mueve a `new/`.
+     *
+     * @param correo Mensaje a entregar.
+     * @return true si quedó en `new/`.
+     */
+    bool entregar(const Correo& correo) override;
+};
@@ -3,7 +3,12 @@
 #include "ProgrammingPatterns/strategy/PagoEfectivo.h"
 #include "ProgrammingPatterns/strategy/PagoDebito.h"
 #include "ProgrammingPatterns/strategy/PagoCredito.h"
+#include "ProgrammingPatterns/strategy/PagoVariante.h"
+#include "ProgrammingPatterns/pagos/AutorizadorPagos.h"
+#include "ProgrammingPatterns/pagos/Liquidaciones.h"
 #include "ProgrammingPatterns/tickets/GeneradorTickets.h"
+#include "ProgrammingPatterns/facturas/GeneradorFacturas.h"
+#include "ProgrammingPatterns/metricas/MetricasEtapas.h"
 #include <sstream>
 
 /**
@@ -16,7 +21,12 @@
  *  - Obtención de información del producto
  *  - Procesamiento del método de pago (Strategy)
  *  - Generación del ticket
- *  - Notificación simulada por correo
+ *  - Envío del ticket por correo (en segundo plano, con `ColaCorreos`)
+ *  - Autorización asíncrona de tarjetas (`procesarVentaAsincrona`)
+ *  - Registro de liquidación de cada cobro
+ *  - Pagos divididos entre varios métodos (`procesarVentaDividida`)
+ *
+ * Cada paso de la venta se mide por separado (ver `MetricasEtapas`).
  *
  * El objetivo es ocultar toda la complejidad interna de los subsistemas
  * (Inventario, Métodos de pago, Generador de tickets) mediante una interfaz simple.
@@ -32,7 +42,7 @@ public:
      * Esta función coordina todos los pasos necesarios para realizar una venta:
      *  1. Descontar cantidad en inventario.
      *  2. Recuperar información del producto.
-     *  3. Identificar el tipo de método de pago mediante dynamic_cast.
+     *  3. Identificar el tipo de método de pago mediante su etiqueta `TipoPago`.
      *  4. Generar un ticket con información detallada.
      *  5. Ejecutar la estrategia de pago correspondiente.
      *
@@ -40,38 +50,300 @@ public:
      * @param codigo Código único del producto a vender.
      * @param cantidad Cantidad de unidades que se desean vender.
      * @param metodo Estrategia de pago seleccionada por el cliente (Strategy).
+     * @param correo Correo del cliente para enviarle el ticket (vacío si no lo quiere).
+     * @return unsigned long long Folio del ticket, o 0 si la venta no se hizo.
      */
-    void procesarVenta(Inventario& inv, const std::string& codigo, int cantidad, MetodoPago* metodo) {
+    unsigned long long procesarVenta(Inventario& inv, const std::string& codigo, int cantidad, MetodoPago* metodo,
+        const std::string& correo = "") {
+        return procesarVentaCon(inv, codigo, cantidad, metodo->tipo(), MarcaTarjeta::Generica, correo,
+            [metodo](Dinero total) { return metodo->procesarPago(total); },
+            [metodo](Dinero total) { return metodo->pagar(total); });
+    }
 
-        double total = inv.venderProducto(codigo, cantidad);
+    /**
+     * @brief Procesa una venta con un método de pago conocido guardado por valor.
+     *
+     * Mismo flujo que la versión con `MetodoPago*`, pero sin `new`/`delete` ni
+     * llamadas virtuales: el pago se resuelve con `std::visit` sobre la variante.
+     *
+     * @param inv Referencia al inventario del sistema.
+     * @param codigo Código único del producto a vender.
+     * @param cantidad Cantidad de unidades que se desean vender.
+     * @param pago Método de pago seleccionado por el cliente.
+     * @param correo Correo del cliente para enviarle el ticket (vacío si no lo quiere).
+     * @return unsigned long long Folio del ticket, o 0 si la venta no se hizo.
+     */
+    unsigned long long procesarVenta(Inventario& inv, const std::string& codigo, int cantidad, PagoVariante& pago,
+        const std::string& correo = "") {
+        return procesarVentaCon(inv, codigo, cantidad, tipoDe(pago), marcaDe(pago), correo,
+            [&pago](Dinero total) { return procesarPago(pago, total); },
+            [&pago](Dinero total) { return pagar(pago, total); });
+    }
 
-        if (total <= 0) {
+    /**
+     * @brief Procesa una venta pagada con varios métodos (por ejemplo, parte en
+     * efectivo y parte con tarjeta).
+     *
+     * Los pagos se aplican en orden. Cada uno calcula su propia comisión y deja su
+     * propio registro de liquidación, pero se genera un solo ticket con el detalle
+     * de todos. Si el último pago trae monto cero, cubre el resto del total. Los
+     * montos se revisan contra el precio antes de tocar el stock: si no suman
+     * exactamente el total, la venta se cancela sin mover el inventario.
+     *
+     * @param inv Referencia al inventario del sistema.
+     * @param codigo Código único del producto a vender.
+     * @param cantidad Cantidad de unidades que se desean vender.
+     * @param pagos Pagos en el orden en que se aplican.
+     * @param correo Correo del cliente para enviarle el ticket (vacío si no lo quiere).
+     */
+    void procesarVentaDividida(Inventario& inv, const std::string& codigo, int cantidad, PagosVenta& pagos,
+        const std::string& correo = "") {
+
+        if (pagos.empty()) {
+            std::cout << "No se indicó ningún pago.\n";
+            return;
+        }
+
+        const Producto* producto = inv.buscarProducto(codigo);
+        if (producto == nullptr) {
+            std::cout << "Producto no encontrado.\n";
+            return;
+        }
+        if (producto->getCantidad() < cantidad) {
+            std::cout << "No hay suficiente stock.\n";
+            return;
+        }
+        Dinero total = inv.obtenerPrecioProducto(codigo) * cantidad;
+        if (total <= Dinero()) {
             std::cout << "No se puede procesar la venta.\n";
             return;
         }
 
-        // Obtener información real del producto
-        std::string nombre = inv.obtenerNombreProducto(codigo);
-        double precioUnitario = inv.obtenerPrecioProducto(codigo);
+        // Resolver el monto de cada pago (el último en cero cubre el resto)
+        Dinero asignado;
+        bool valido = true;
+        for (size_t i = 0; i < pagos.size(); i++) {
+            if (pagos[i].monto <= Dinero()) {
+                if (i + 1 != pagos.size()) {
+                    valido = false;
+                    break;
+                }
+                pagos[i].monto = total - asignado;
+            }
+            asignado += pagos[i].monto;
+        }
+        if (!valido || asignado != total || pagos.back().monto <= Dinero()) {
+            std::cout << "Los pagos ($" << asignado << ") no cubren exactamente el total ($" << total
+                << "). Venta cancelada.\n";
+            return;
+        }
+
+        // Los pagos cuadran: ahora sí se descuenta el stock
+        if (inv.venderProducto(codigo, cantidad) <= Dinero()) {
+            std::cout << "No se puede procesar la venta.\n";
+            return;
+        }
 
-        // Detectar el método de pago usando dynamic_cast
-        std::string tipoPago;
-        if (dynamic_cast<PagoEfectivo*>(metodo)) tipoPago = "Efectivo";
-        else if (dynamic_cast<PagoDebito*>(metodo)) tipoPago = "Debito";
-        else if (dynamic_cast<PagoCredito*>(metodo)) tipoPago = "Credito";
+        // Aplicar cada pago con su comisión; la factura lleva la forma del pago mayor
+        const PagoParcial* principal = &pagos[0];
+        std::string detalle = pagos.size() == 1 ? tipoPagoToString(tipoDe(pagos[0].pago)) : "Mixto";
+        for (auto& p : pagos) {
+            Dinero cobro = procesarPago(p.pago, p.monto);
+            std::cout << pagar(p.pago, p.monto) << "\n";
 
-        //  Generar ticket profesional con IVA
-        GeneradorTickets::generarTicket(
+            if (pagos.size() > 1) {
+                detalle += "\n  ";
+                detalle += tipoPagoToString(tipoDe(p.pago));
+                detalle += ": $" + p.monto.toString();
+                if (cobro != p.monto) {
+                    detalle += " (+ comision $" + (cobro - p.monto).toString() + ")";
+                }
+            }
+            RegistroLiquidaciones::instancia().registrar(tipoDe(p.pago), marcaDe(p.pago), cobro, cobro - p.monto);
+            if (principal->monto < p.monto) {
+                principal = &p;
+            }
+        }
+
+        std::string nombre = inv.obtenerNombreProducto(codigo);
+        Dinero precioUnitario = inv.obtenerPrecioProducto(codigo);
+        unsigned long long folio = GeneradorTickets::generarTicket(
             nombre,
             cantidad,
             precioUnitario,
             total,
-            tipoPago
+            detalle,
+            correo
         );
+        facturarVenta(folio, codigo, nombre, cantidad, precioUnitario, total, tipoDe(principal->pago));
+    }
+
+    /**
+     * @brief Procesa una venta sin esperar la autorización de la tarjeta.
+     *
+     * El stock se aparta de inmediato y la solicitud se envía al autorizador, así
+     * la caja puede capturar la siguiente venta mientras el banco responde. Cuando
+     * llega el resultado (dentro de `AutorizadorPagos::atenderCompletadas()`):
+     *  - Aprobada: se genera el ticket, se muestra el cobro y se envía el correo.
+     *  - Rechazada: se devuelve el stock apartado y se informa el motivo.
+     *
+     * El inventario debe seguir vivo hasta que se atiendan las autorizaciones.
+     *
+     * @param inv Referencia al inventario del sistema.
+     * @param codigo Código único del producto a vender.
+     * @param cantidad Cantidad de unidades que se desean vender.
+     * @param pago Método de pago (se copia para la finalización).
+     * @param autorizador Cola de autorizaciones de la caja.
+     * @param correo Correo del cliente para enviarle el ticket (vacío si no lo quiere).
+     */
+    void procesarVentaAsincrona(Inventario& inv, const std::string& codigo, int cantidad, PagoVariante pago,
+        AutorizadorPagos& autorizador, const std::string& correo = "") {
+
+        Dinero total = inv.venderProducto(codigo, cantidad);
+
+        if (total <= Dinero()) {
+            std::cout << "No se puede procesar la venta.\n";
+            return;
+        }
+
+        SolicitudAutorizacion solicitud;
+        solicitud.tipo = tipoDe(pago);
+        solicitud.marca = marcaDe(pago);
+        solicitud.monto = procesarPago(pago, total);
+
+        std::cout << "Autorizando " << tipoPagoToString(solicitud.tipo) << " por $" << solicitud.monto << "...\n";
+
+        autorizador.solicitar(solicitud,
+            [&inv, codigo, cantidad, total, solicitud, pago, correo](const ResultadoAutorizacion& r) mutable {
+                if (!r.aprobada) {
+                    inv.comprarProducto(codigo, cantidad);
+                    std::cout << "Pago rechazado (" << r.motivo << "). Venta de " << codigo << " cancelada.\n";
+                    return;
+                }
+                std::cout << "Pago autorizado (" << r.codigo << ") para la venta de " << codigo << ".\n";
+                emitirVenta(inv, codigo, cantidad, total, solicitud.monto, tipoDe(pago), solicitud.marca,
+                    pagar(pago, total), correo);
+            });
+    }
+
+private:
+
+    /**
+     * @brief Genera el ticket, muestra el cobro, pone el ticket en la cola de
+     * correo y registra la liquidación.
+     *
+     * @param inv Referencia al inventario del sistema.
+     * @param codigo Código del producto.
+     * @param cantidad Cantidad vendida.
+     * @param total Total de la venta.
+     * @param cobro Monto cobrado al cliente (total + comisión).
+     * @param tipo Etiqueta del método de pago.
+     * @param marca Marca de la tarjeta.
+     * @param mensajePago Mensaje devuelto por la estrategia de pago.
+     * @param correo Correo del cliente (vacío si no se envía).
+     * @return unsigned long long Folio del ticket.
+     */
+    static unsigned long long emitirVenta(Inventario& inv, const std::string& codigo, int cantidad, Dinero total,
+        Dinero cobro, TipoPago tipo, MarcaTarjeta marca, const std::string& mensajePago, const std::string& correo) {
+
+        // Obtener información real del producto
+        std::string nombre;
+        Dinero precioUnitario;
+        {
+            POS_MEDIR_ETAPA(Etapa::VentaProducto);
+            nombre = inv.obtenerNombreProducto(codigo);
+            precioUnitario = inv.obtenerPrecioProducto(codigo);
+        }
+
+        // Detectar el método de pago por su etiqueta
+        std::string tipoPago = tipoPagoToString(tipo);
+
+        //  Generar ticket profesional con IVA y su factura
+        unsigned long long folio;
+        {
+            POS_MEDIR_ETAPA(Etapa::VentaTicket);
+            folio = GeneradorTickets::generarTicket(
+                nombre,
+                cantidad,
+                precioUnitario,
+                total,
+                tipoPago,
+                correo
+            );
+        }
+        {
+            POS_MEDIR_ETAPA(Etapa::VentaFactura);
+            facturarVenta(folio, codigo, nombre, cantidad, precioUnitario, total, tipo);
+        }
 
         //  Ejecutar estrategia de pago
-        std::cout << metodo->pagar(total) << "\n";
+        std::cout << mensajePago << "\n";
+
+        POS_MEDIR_ETAPA(Etapa::VentaLiquidacion);
+        RegistroLiquidaciones::instancia().registrar(tipo, marca, cobro, cobro - total);
+        return folio;
+    }
+
+    /**
+     * @brief Registra la venta en el diario de ventas y genera su factura XML.
+     *
+     * @param folio Folio del ticket (también es el folio de la factura).
+     * @param codigo Código del producto.
+     * @param nombre Nombre del producto.
+     * @param cantidad Cantidad vendida.
+     * @param precioUnitario Precio unitario.
+     * @param total Total de la venta (sin comisión).
+     * @param tipo Forma de pago.
+     */
+    static void facturarVenta(unsigned long long folio, const std::string& codigo, const std::string& nombre,
+        int cantidad, Dinero precioUnitario, Dinero total, TipoPago tipo) {
+
+        VentaFacturable venta = VentaFacturable::crear(folio, Reloj::ahora(), codigo, nombre, cantidad,
+            precioUnitario, total, tipo);
+        RegistroVentas::instancia().registrar(venta);
+        if (GeneradorFacturas::facturar(venta)) {
+            char ruta[64];
+            std::snprintf(ruta, sizeof(ruta), "%s/A%06llu.xml", GeneradorFacturas::kCarpeta, folio);
+            std::cout << "Factura generada: " << ruta << "\n";
+        }
+    }
 
-        std::cout << "[Simulando envio de correo] ticket enviado a: arimj000@hotmail.com\n";
+    /**
+     * @brief Flujo común de la venta, parametrizado por la forma de cobrar.
+     *
+     * @param inv Referencia al inventario del sistema.
+     * @param codigo Código del producto.
+     * @param cantidad Cantidad a vender.
+     * @param tipo Etiqueta del método de pago (para el ticket).
+     * @param marca Marca de la tarjeta (para la liquidación).
+     * @param correo Correo del cliente (vacío si no se envía).
+     * @param cargar Función que devuelve el monto final cobrado (con comisión).
+     * @param cobrar Función que ejecuta el pago y devuelve el mensaje.
+     * @return unsigned long long Folio del ticket, o 0 si la venta no se hizo.
+     */
+    template <typename Cargo, typename Cobro>
+    unsigned long long procesarVentaCon(Inventario& inv, const std::string& codigo, int cantidad, TipoPago tipo, MarcaTarjeta marca,
+        const std::string& correo, Cargo&& cargar, Cobro&& cobrar) {
+
+        POS_MEDIR_ETAPA(Etapa::Venta);
+        Dinero total;
+        {
+            POS_MEDIR_ETAPA(Etapa::VentaInventario);
+            total = inv.venderProducto(codigo, cantidad);
+        }
+
+        if (total <= Dinero()) {
+            std::cout << "No se puede procesar la venta.\n";
+            return 0;
+        }
+
+        Dinero cobro;
+        std::string mensajePago;
+        {
+            POS_MEDIR_ETAPA(Etapa::VentaPago);
+            cobro = cargar(total);
+            mensajePago = cobrar(total);
+        }
+        return emitirVenta(inv, codigo, cantidad, total, cobro, tipo, marca, mensajePago, correo);
     }
 };
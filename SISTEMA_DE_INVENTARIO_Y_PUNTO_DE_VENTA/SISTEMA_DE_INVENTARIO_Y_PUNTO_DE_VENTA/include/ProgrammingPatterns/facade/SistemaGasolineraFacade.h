@@ -1,23 +1,24 @@
 #pragma once
 #include "ProgrammingPatterns/gasolinera/Gasolinera.h"
 #include "ProgrammingPatterns/strategy/MetodoPago.h"
+#include "ProgrammingPatterns/strategy/PagoVariante.h"
 
 /**
  * @file SistemaGasolineraFacade.h
  * @brief Fachada para simplificar y centralizar las operaciones de la gasolinera.
  *
  * Este archivo declara la clase `SistemaGasolineraFacade`, la cual implementa
- * el patrn **Facade** para encapsular la lgica necesaria al procesar
+ * el patrón **Facade** para encapsular la lógica necesaria al procesar
  * una carga de combustible.
  *
- * El propsito es proporcionar una interfaz simple que coordine:
+ * El propósito es proporcionar una interfaz simple que coordine:
  *  - Registro de litros cargados
- *  - Validacin del tipo de combustible
- *  - Clculo del total a pagar
- *  - Ejecucin de la estrategia de pago (Strategy)
- *  - Generacin de ticket o recibo (si aplica)
+ *  - Validación del tipo de combustible
+ *  - Cálculo del total a pagar
+ *  - Ejecución de la estrategia de pago (Strategy)
+ *  - Generación de ticket o recibo (si aplica)
  *
- * Esto permite que el resto del sistema interacte con la gasolinera sin
+ * Esto permite que el resto del sistema interactúe con la gasolinera sin
  * preocuparse por los detalles internos.
  */
 
@@ -27,11 +28,11 @@
   *
   * Esta clase centraliza las operaciones necesarias para procesar una
   * venta de gasolina. Oculta la complejidad de los subsistemas como:
-  *  - La lgica interna de la gasolinera
-  *  - Validacin de litros y tipos de combustible
-  *  - Mtodos de pago implementados mediante Strategy
+  *  - La lógica interna de la gasolinera
+  *  - Validación de litros y tipos de combustible
+  *  - Métodos de pago implementados mediante Strategy
   *
-  * De esta manera, el cliente (main, men, UI) solo necesita llamar a un mtodo:
+  * De esta manera, el cliente (main, menú, UI) solo necesita llamar a un método:
   * `procesarCarga()`.
   */
 
@@ -42,12 +43,12 @@ public:
     /**
      * @brief Procesa una carga de gasolina usando la fachada.
      *
-     * Este mtodo se encarga de:
+     * Este método se encarga de:
      *  1. Registrar los litros que se desean cargar.
      *  2. Validar el tipo de combustible solicitado.
-     *  3. Calcular el monto total multiplicando litros  precio por litro.
-     *  4. Ejecutar la estrategia de pago seleccionada (efectivo, crdito, dbito).
-     *  5. Registrar la operacin dentro del sistema interno de la gasolinera.
+     *  3. Calcular el monto total multiplicando litros × precio por litro.
+     *  4. Ejecutar la estrategia de pago seleccionada (efectivo, crédito, débito).
+     *  5. Registrar la operación dentro del sistema interno de la gasolinera.
      *
      * @param gasolinera Referencia al sistema de gasolinera.
      * @param litros Cantidad de litros que el cliente desea cargar.
@@ -58,6 +59,40 @@ public:
     void procesarCarga(Gasolinera& gasolinera,
         double litros,
         const std::string& tipo,
-        double precioLitro,
+        Dinero precioLitro,
         MetodoPago* metodo);
+
+    /**
+     * @brief Procesa una carga con el precio vigente de la tabla de precios.
+     *
+     * Igual que la versión anterior, pero el precio por litro no lo captura el
+     * despachador: se toma de la tabla versionada de la gasolinera.
+     *
+     * @param gasolinera Referencia al sistema de gasolinera.
+     * @param litros Cantidad de litros que el cliente desea cargar.
+     * @param tipo Tipo de combustible.
+     * @param metodo Estrategia de pago seleccionada.
+     */
+    void procesarCarga(Gasolinera& gasolinera,
+        double litros,
+        const std::string& tipo,
+        MetodoPago* metodo);
+
+    /**
+     * @brief Procesa una carga con precio de tabla y autorización asíncrona.
+     *
+     * La bomba despacha sin esperar al banco; la carga se confirma o se revierte
+     * cuando el autorizador entrega el resultado.
+     *
+     * @param gasolinera Referencia al sistema de gasolinera.
+     * @param litros Cantidad de litros que el cliente desea cargar.
+     * @param tipo Tipo de combustible.
+     * @param pago Método de pago seleccionado.
+     * @param autorizador Cola de autorizaciones de la caja.
+     */
+    void procesarCargaAsincrona(Gasolinera& gasolinera,
+        double litros,
+        const std::string& tipo,
+        PagoVariante& pago,
+        AutorizadorPagos& autorizador);
 };
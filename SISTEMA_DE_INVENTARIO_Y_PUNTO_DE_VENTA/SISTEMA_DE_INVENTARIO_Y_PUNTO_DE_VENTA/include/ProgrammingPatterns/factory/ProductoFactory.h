@@ -4,10 +4,10 @@
  * @file ProductoFactory.h
  * @brief Declara la clase ProductoFactory, encargada de crear instancias de productos.
  *
- * Esta clase implementa el patrn de diseo **Factory Method**, permitiendo
- * centralizar la creacin de objetos `Producto` de forma controlada.
+ * Esta clase implementa el patrón de diseño **Factory Method**, permitiendo
+ * centralizar la creación de objetos `Producto` de forma controlada.
  *
- * Su propsito es abstraer la lgica de construccin y facilitar la extensin
+ * Su propósito es abstraer la lógica de construcción y facilitar la extensión
  * futura (por ejemplo, si se agregan diferentes tipos de productos especializados).
  *
  * @date 2025-11-07
@@ -20,9 +20,9 @@
   * @class ProductoFactory
   * @brief Clase responsable de crear objetos `Producto`.
   *
-  * La clase `ProductoFactory` proporciona un mtodo esttico que genera y retorna
-  * instancias nicas (`std::unique_ptr`) de la clase `Producto`, evitando la necesidad
-  * de crear productos directamente con `new` en el resto del cdigo.
+  * La clase `ProductoFactory` proporciona un método estático que genera y retorna
+  * instancias únicas (`std::unique_ptr`) de la clase `Producto`, evitando la necesidad
+  * de crear productos directamente con `new` en el resto del código.
   *
   * @see Producto
   */
@@ -33,17 +33,17 @@ public:
     /**
      * @brief Crea un nuevo objeto `Producto`.
      *
-     * Este mtodo encapsula la creacin de un producto, asignando dinmicamente
-     * memoria y devolviendo un `std::unique_ptr` para asegurar una correcta gestin
+     * Este método encapsula la creación de un producto, asignando dinámicamente
+     * memoria y devolviendo un `std::unique_ptr` para asegurar una correcta gestión
      * de recursos.
      *
-     * @param codigo Identificador nico del producto.
+     * @param codigo Identificador único del producto.
      * @param nombre Nombre descriptivo del producto.
      * @param precio Precio unitario del producto.
      * @param cantidad Cantidad inicial disponible en el inventario.
-     * @return std::unique_ptr<Producto> Puntero nico al producto recin creado.
+     * @return std::unique_ptr<Producto> Puntero único al producto recién creado.
      */
-	static std::unique_ptr<Producto> crearProducto(const std::string& codigo, const std::string& nombre, double precio, int cantidad);
+	static std::unique_ptr<Producto> crearProducto(const std::string& codigo, const std::string& nombre, Dinero precio, int cantidad);
 
 
 
@@ -0,0 +1,67 @@
+﻿#pragma once
+#include "ProgrammingPatterns/facturas/RegistroVentas.h"
+#include <string>
+
+/**
+ * @file GeneradorFacturas.h
+ * @brief Facturas electrónicas en XML (formato tipo CFDI 4.0) por venta y por lote.
+ *
+ * El XML se escribe en forma de flujo: cada atributo se agrega directo a un búfer
+ * de texto, sin construir un árbol DOM. En el modo por lote, las ventas del día se
+ * reparten entre los núcleos; cada hilo renderiza sus facturas y va vaciando su
+ * búfer a su propio archivo de lote en bloques de 1 MB.
+ *
+ * @date 2026-10-19
+ * @version 1.0
+ * @author Ari
+ */
+
+ /**
+  * @class GeneradorFacturas
+  * @brief Genera facturas de ventas individuales y lotes diarios.
+  */
+class
+GeneradorFacturas {
+public:
+
+    /// Carpeta donde se guardan las facturas.
+    static constexpr const char* kCarpeta = "Facturas";
+
+    /**
+     * @brief Agrega al texto la factura (nodo `cfdi:Comprobante`) de una venta.
+     *
+     * @param venta Venta a facturar.
+     * @param salida Texto al que se agrega la factura.
+     */
+    static void renderizar(const VentaFacturable& venta, std::string& salida);
+
+    /**
+     * @brief Genera el archivo `Facturas/A<folio>.xml` de una venta.
+     *
+     * Si el escritor de tickets está activo, la escritura se hace en su hilo.
+     *
+     * @param venta Venta a facturar.
+     * @return true si la factura quedó generada (o en cola).
+     */
+    static bool facturar(const VentaFacturable& venta);
+
+    /**
+     * @brief Genera en paralelo las facturas de todas las ventas de un día.
+     *
+     * Escribe `Facturas/Lote_AAAA-MM-DD_parteNN.xml`, una parte por hilo. Una parte
+     * que no se pudo escribir completa se informa y no cuenta (si quedó a medias, se borra).
+     *
+     * @param ventas Ventas a facturar.
+     * @param etiqueta Texto para el nombre de los archivos (por ejemplo, la fecha).
+     * @return size_t Facturas generadas (solo de las partes escritas completas).
+     */
+    static size_t facturarLote(const std::vector<VentaFacturable>& ventas, const std::string& etiqueta);
+
+    /**
+     * @brief Factura todas las ventas registradas en el día indicado.
+     *
+     * @param dia Cualquier instante del día.
+     * @return size_t Facturas generadas.
+     */
+    static size_t facturarDia(time_t dia);
+};
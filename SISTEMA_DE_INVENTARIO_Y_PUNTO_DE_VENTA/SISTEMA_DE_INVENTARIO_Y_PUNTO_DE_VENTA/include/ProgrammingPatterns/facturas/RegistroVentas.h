@@ -0,0 +1,153 @@
+﻿#pragma once
+#include "Prerequisites.h"
+#include "ProgrammingPatterns/modelos/Dinero.h"
+#include "ProgrammingPatterns/strategy/MetodoPago.h"
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <cstdio>
+#include <mutex>
+#include <string_view>
+#include <thread>
+
+/**
+ * @file RegistroVentas.h
+ * @brief Diario de ventas facturables, con registros de tamaño fijo.
+ *
+ * Cada venta con ticket deja un registro con todo lo que necesita su factura
+ * (folio, fecha, producto, cantidad, precio, total y forma de pago). Registrar
+ * una venta solo la agrega en memoria; un hilo escritor pasa las ventas nuevas
+ * al diario binario `Ventas.dat` en lotes, a lo más cada `kIntervaloEscritura`,
+ * así que el cobro no agrega escrituras y una caída pierde a lo más ese tramo.
+ *
+ * @date 2026-10-19
+ * @version 1.0
+ * @author Ari
+ */
+
+ /**
+  * @struct VentaFacturable
+  * @brief Datos de una venta para su factura (tamaño fijo, sin punteros).
+  */
+struct
+VentaFacturable {
+    std::uint64_t folio = 0;
+    std::int64_t fecha = 0;
+    std::int64_t precioUnitarioCentavos = 0;
+    std::int64_t totalCentavos = 0;
+    std::int32_t cantidad = 0;
+    std::uint8_t tipoPago = 0;
+    char codigo[27] = {};
+    char descripcion[96] = {};
+
+    /**
+     * @brief Arma el registro a partir de los datos de la venta.
+     *
+     * Código y descripción se recortan si no caben, sin partir un carácter UTF-8.
+     */
+    static VentaFacturable crear(std::uint64_t folio, time_t fecha, std::string_view codigo,
+        std::string_view descripcion, int cantidad, Dinero precioUnitario, Dinero total, TipoPago tipo);
+};
+
+/**
+ * @class RegistroVentas
+ * @brief Ventas facturables del sistema (en memoria y en el diario).
+ *
+ * Existe una instancia compartida (`instancia()`).
+ */
+class
+RegistroVentas {
+public:
+
+    /// Tiempo máximo que una venta espera en memoria antes de ir al diario.
+    static constexpr std::chrono::milliseconds kIntervaloEscritura{ 100 };
+
+private:
+
+    /// Ventas en memoria (incluye las leídas del diario).
+    std::vector<VentaFacturable> ventas;
+
+    /// Ventas que todavía no se escriben en el diario.
+    std::vector<VentaFacturable> pendientes;
+
+    /// Diario binario abierto para agregar.
+    std::FILE* diario = nullptr;
+
+    /// Protege ventas, pendientes y banderas.
+    mutable std::mutex mutexVentas;
+
+    /// Ordena las escrituras al diario (hilo escritor y `guardar()`).
+    std::mutex mutexDiario;
+
+    /// Avisa al escritor que debe terminar.
+    std::condition_variable avisoEscritor;
+
+    /// Hilo escritor del diario.
+    std::thread hilo;
+
+    /// Indica al escritor que escriba lo pendiente y termine.
+    bool detenerSolicitado = false;
+
+    /**
+     * @brief Ciclo del hilo escritor.
+     */
+    void escribir();
+
+    /**
+     * @brief Escribe en el diario las ventas pendientes con una sola escritura.
+     */
+    void escribirPendientes();
+
+public:
+
+    RegistroVentas() = default;
+    ~RegistroVentas();
+
+    RegistroVentas(const RegistroVentas&) = delete;
+    RegistroVentas& operator=(const RegistroVentas&) = delete;
+
+    /**
+     * @brief Instancia compartida del sistema.
+     * @return RegistroVentas& Diario de ventas.
+     */
+    static RegistroVentas& instancia();
+
+    /**
+     * @brief Carga el diario existente, lo abre para agregar y arranca el escritor.
+     *
+     * Si el último registro quedó a medias, se descarta y el archivo se recorta
+     * antes de agregar.
+     *
+     * @param archivo Ruta del diario binario.
+     */
+    void abrir(const std::string& archivo);
+
+    /**
+     * @brief Agrega una venta (solo memoria; el diario lo escribe el hilo escritor).
+     * @param venta Venta facturable.
+     */
+    void registrar(const VentaFacturable& venta);
+
+    /**
+     * @brief Escribe ya en el diario las ventas pendientes.
+     */
+    void guardar();
+
+    /**
+     * @brief Busca la venta de un folio.
+     *
+     * @param folio Folio del ticket.
+     * @param venta Salida: venta encontrada.
+     * @return true si existe.
+     */
+    bool buscar(std::uint64_t folio, VentaFacturable& venta) const;
+
+    /**
+     * @brief Copia las ventas de un intervalo de tiempo.
+     *
+     * @param desde Inicio (incluido).
+     * @param hasta Fin (excluido).
+     * @return std::vector<VentaFacturable> Ventas del intervalo.
+     */
+    std::vector<VentaFacturable> ventasEntre(time_t desde, time_t hasta) const;
+};
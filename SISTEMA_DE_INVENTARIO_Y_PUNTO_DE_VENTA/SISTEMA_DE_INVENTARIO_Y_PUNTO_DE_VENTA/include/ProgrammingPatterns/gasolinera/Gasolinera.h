@@ -2,20 +2,28 @@
 #include <string>
 #include <vector>
 #include <iostream>
+#include <map>
+#include <memory>
 #include "ProgrammingPatterns/strategy/MetodoPago.h"
+#include "ProgrammingPatterns/gasolinera/Tanque.h"
+#include "ProgrammingPatterns/gasolinera/TablaPreciosCombustible.h"
+#include "ProgrammingPatterns/pagos/AutorizadorPagos.h"
+#include "ProgrammingPatterns/reportes/ReporteConsola.h"
+#include "nlohmann/json_fwd.hpp"
 
 /**
  * @file Gasolinera.h
- * @brief Declaracin de la clase Gasolinera y sus operaciones principales.
+ * @brief Declaración de la clase Gasolinera y sus operaciones principales.
  *
  * Esta clase representa el sistema central de una gasolinera, permitiendo:
  *  - Registrar cargas de combustible.
- *  - Validar pagos usando el patrn Strategy.
+ *  - Validar pagos usando el patrón Strategy.
  *  - Almacenar un historial de todas las cargas realizadas.
+ *  - Controlar el inventario de combustible en tanques por tipo.
  *  - Guardar y cargar dicho historial desde un archivo JSON.
  *
- * La clase se integra con el patrn **Strategy** mediante objetos de tipo `MetodoPago`,
- * y con un **Facade** externo que facilita su uso desde otros mdulos.
+ * La clase se integra con el patrón **Strategy** mediante objetos de tipo `MetodoPago`,
+ * y con un **Facade** externo que facilita su uso desde otros módulos.
  */
 
  /**
@@ -27,25 +35,32 @@
   *  - Tipo de combustible (Ej: Magna, Premium, Diesel).
   *  - Precio por litro al momento de la carga.
   *  - Total pagado por el cliente.
+  *  - Versión de la tabla de precios usada (0 si el precio se capturó a mano).
   */
 
 struct 
 CargaGasolina {
     double litros;
     std::string tipo;
-    double precioLitro;
-    double totalPagado;
+    Dinero precioLitro;
+    Dinero totalPagado;
+    unsigned int versionPrecio = 0;
 };
 
+/**
+ * @brief Serializa una carga como en `HistorialGas.json`.
+ */
+void to_json(nlohmann::json& j, const CargaGasolina& c);
+
 /**
  * @class Gasolinera
  * @brief Clase principal para gestionar el registro de cargas de gasolina.
  *
  * Esta clase administra todo el flujo interno relacionado con cargar combustible:
- * clculo de total, validacin del pago, registro histrico y almacenamiento en JSON.
+ * cálculo de total, validación del pago, registro histórico y almacenamiento en JSON.
  *
- * La validacin del pago depende del mtodo recibido, el cual utiliza el patrn Strategy
- * para ejecutar comportamientos distintos segn el tipo de pago.
+ * La validación del pago depende del método recibido, el cual utiliza el patrón Strategy
+ * para ejecutar comportamientos distintos según el tipo de pago.
  */
 class 
 Gasolinera {
@@ -54,6 +69,65 @@ private:
     /// Historial completo de cargas realizadas.
     std::vector<CargaGasolina> historial;
 
+    /// Tanques subterráneos indexados por tipo de combustible.
+    std::map<std::string, std::unique_ptr<Tanque>> tanques;
+
+    /// Entregas de combustible (pipas) recibidas.
+    std::vector<EntregaCombustible> entregas;
+
+    /// Observadores que se registran en cada tanque nuevo.
+    std::vector<Observador*> observadoresTanques;
+
+    /// Precios por litro vigentes, versionados.
+    TablaPreciosCombustible tablaPrecios;
+
+    /**
+     * @brief Aparta los litros del tanque, calcula el monto y valida el pago.
+     *
+     * Es la primera mitad del registro; no muestra el cobro y la carga todavía
+     * no entra al historial.
+     *
+     * @param litros Litros cargados.
+     * @param tipo Tipo de combustible.
+     * @param precioLitro Precio por litro aplicado.
+     * @param metodo Estrategia de pago.
+     * @param pagoCliente Salida: monto cobrado al cliente.
+     * @return true si el pago es suficiente y el tanque tenía combustible.
+     */
+    bool prepararCarga(double litros, const std::string& tipo, Dinero precioLitro,
+        MetodoPago* metodo, Dinero& pagoCliente);
+
+    /**
+     * @brief Muestra el cobro de una carga ya aceptada.
+     *
+     * @param total Total sin comisión.
+     * @param mensajePago Mensaje del método de pago.
+     * @param pagoCliente Monto cobrado al cliente.
+     */
+    static void mostrarCobro(Dinero total, const std::string& mensajePago, Dinero pagoCliente);
+
+    /**
+     * @brief Consulta el precio vigente de un combustible en la tabla.
+     *
+     * @param tipo Tipo de combustible.
+     * @param precioLitro Salida: precio por litro.
+     * @param version Salida: versión de la tabla.
+     * @return true si existe precio vigente.
+     */
+    bool precioVigente(const std::string& tipo, Dinero& precioLitro, unsigned int& version) const;
+
+    /**
+     * @brief Flujo común de registro de una carga con un precio ya resuelto.
+     *
+     * @param litros Litros cargados.
+     * @param tipo Tipo de combustible.
+     * @param precioLitro Precio por litro aplicado.
+     * @param versionPrecio Versión de la tabla de precios (0 si fue manual).
+     * @param metodo Estrategia de pago.
+     */
+    void registrarCargaConPrecio(double litros, const std::string& tipo, Dinero precioLitro,
+        unsigned int versionPrecio, MetodoPago* metodo);
+
 public:
     Gasolinera() = default;
     ~Gasolinera() = default;
@@ -61,41 +135,102 @@ public:
     /**
      * @brief Valida si el monto pagado cubre el total calculado.
      *
-     * Total esperado = litros  precioLitro.
+     * Total esperado = litros × precioLitro.
      * Devuelve true si el monto pagado es mayor o igual al total.
      *
      * @param litros Cantidad de litros que se desean cargar.
      * @param precioLitro Costo del combustible por litro.
-     * @param montoPagado Monto que el cliente pag mediante un mtodo Strategy.
+     * @param montoPagado Monto que el cliente pagó mediante un método Strategy.
      * @return true si el pago es suficiente, false si no.
      */
-    bool validarPago(double litros, double precioLitro, double montoPagado) const;
+    bool validarPago(double litros, Dinero precioLitro, Dinero montoPagado) const;
 
     /**
-     * @brief Registra una carga usando un mtodo de pago Strategy.
+     * @brief Registra una carga usando un método de pago Strategy.
      *
-     * Este mtodo:
-     *  1. Calcula el total segn litros  precio.
+     * Este método:
+     *  1. Calcula el total según litros × precio.
      *  2. Ejecuta la estrategia de pago seleccionada.
      *  3. Valida si el pago fue suficiente.
-     *  4. Agrega la carga al historial si procede.
+     *  4. Descuenta los litros del tanque del tipo indicado.
+     *  5. Agrega la carga al historial si procede.
+     *
+     * Si hay tanques configurados, la carga se rechaza cuando no existe un
+     * tanque para `tipo` o cuando no tiene combustible suficiente.
      *
      * @param litros Cantidad de litros cargados.
      * @param tipo Tipo de combustible (Magna, Premium, Diesel, etc.).
      * @param precioLitro Precio actual por litro.
      * @param metodo Puntero a un objeto de tipo MetodoPago.
      */
-    void registrarCarga(double litros, const std::string& tipo, double precioLitro, MetodoPago* metodo);
+    void registrarCarga(double litros, const std::string& tipo, Dinero precioLitro, MetodoPago* metodo);
+
+    /**
+     * @brief Registra una carga tomando el precio de la tabla de precios vigente.
+     *
+     * El precio se lee sin candados, así que un cambio de precio en curso no
+     * detiene a las bombas. La carga guarda la versión de la tabla utilizada.
+     *
+     * @param litros Cantidad de litros cargados.
+     * @param tipo Tipo de combustible.
+     * @param metodo Puntero a un objeto de tipo MetodoPago.
+     */
+    void registrarCarga(double litros, const std::string& tipo, MetodoPago* metodo);
 
     /**
-    * @brief Muestra en consola todo el historial de cargas realizadas.
+     * @brief Registra una carga sin esperar la autorización de la tarjeta.
+     *
+     * Los litros se apartan del tanque de inmediato (la bomba puede despachar) y el
+     * cobro se envía al autorizador. Al atenderse el resultado, el cobro se muestra
+     * y la carga se agrega al historial si fue aprobada; si fue rechazada, los
+     * litros regresan al tanque.
+     *
+     * @param litros Cantidad de litros cargados.
+     * @param tipo Tipo de combustible.
+     * @param metodo Estrategia de pago (solo se usa durante la llamada).
+     * @param marca Marca de la tarjeta.
+     * @param autorizador Cola de autorizaciones de la caja.
+     */
+    void registrarCargaAsincrona(double litros, const std::string& tipo, MetodoPago* metodo,
+        MarcaTarjeta marca, AutorizadorPagos& autorizador);
+
+    /**
+     * @brief Acceso a la tabla de precios para programar cambios.
+     * @return TablaPreciosCombustible& Tabla de precios de la gasolinera.
+     */
+    TablaPreciosCombustible& getTablaPrecios() { return tablaPrecios; }
+
+    /**
+     * @brief Acceso de solo lectura a la tabla de precios.
+     */
+    const TablaPreciosCombustible& getTablaPrecios() const { return tablaPrecios; }
+
+    /**
+     * @brief Compara cada carga contra la versión de precios que registró.
+     *
+     * Muestra litros y monto por versión e indica las cargas cuyo precio no
+     * coincide con el de la versión (por ejemplo, precios capturados a mano).
+     */
+    void auditarPrecios() const;
+
+    /**
+    * @brief Muestra el historial de cargas en una tabla.
+    *
+    * @param filtro Tipo de combustible a buscar y página (por omisión, todo).
+    * @param salida Flujo donde se escribe.
+    * @return ResultadoReporte Coincidencias y páginas.
     */
-    void mostrarHistorial() const;
+    ResultadoReporte mostrarHistorial(const FiltroReporte& filtro = FiltroReporte(), std::ostream& salida = std::cout) const;
+
+    /**
+     * @brief Cargas registradas, en orden.
+     */
+    const std::vector<CargaGasolina>& getHistorial() const { return historial; }
 
     /**
      * @brief Guarda el historial completo en un archivo JSON.
      *
-     * @param archivo Ruta y nombre del archivo donde se guardar el historial.
+     * @param archivo Ruta y nombre del archivo donde se guardará el historial.
      */
     void guardarHistorialJson(const std::string& archivo) const;
 
@@ -107,4 +242,67 @@ public:
    * @param archivo Ruta del archivo JSON.
    */
     void cargarHistorialJson(const std::string& archivo);
+
+    /**
+     * @brief Da de alta el tanque de un tipo de combustible.
+     *
+     * Los tanques deben configurarse antes de empezar a despachar, ya que el
+     * mapa de tanques no se protege para modificaciones concurrentes.
+     *
+     * @param tipo Tipo de combustible.
+     * @param capacidadLitros Capacidad máxima del tanque.
+     * @param volumenLitros Volumen actual del tanque.
+     * @param umbralBajoLitros Nivel a partir del cual se alerta.
+     */
+    void agregarTanque(const std::string& tipo, double capacidadLitros, double volumenLitros, double umbralBajoLitros);
+
+    /**
+     * @brief Obtiene el tanque de un tipo de combustible.
+     *
+     * @param tipo Tipo de combustible.
+     * @return Puntero al tanque o nullptr si no existe.
+     */
+    Tanque* obtenerTanque(const std::string& tipo) const;
+
+    /**
+     * @brief Indica si hay tanques configurados.
+     * @return true si existe al menos un tanque.
+     */
+    bool tieneTanques() const { return !tanques.empty(); }
+
+    /**
+     * @brief Registra un observador para las alertas de todos los tanques.
+     *
+     * Se aplica a los tanques existentes y a los que se agreguen después.
+     *
+     * @param obs Observador a registrar.
+     */
+    void agregarObservadorTanques(Observador* obs);
+
+    /**
+     * @brief Registra una entrega de combustible y rellena el tanque.
+     *
+     * @param entrega Datos de la entrega (tipo, litros, proveedor y fecha).
+     * @return true si existe el tanque y se aceptó la entrega.
+     */
+    bool registrarEntrega(const EntregaCombustible& entrega);
+
+    /**
+     * @brief Muestra en consola el nivel de cada tanque.
+     */
+    void mostrarTanques() const;
+
+    /**
+     * @brief Guarda tanques y entregas en un archivo JSON.
+     *
+     * @param archivo Ruta del archivo JSON.
+     */
+    void guardarTanquesJson(const std::string& archivo) const;
+
+    /**
+     * @brief Carga tanques y entregas desde un archivo JSON.
+     *
+     * @param archivo Ruta del archivo JSON.
+     */
+    void cargarTanquesJson(const std::string& archivo);
 };
@@ -0,0 +1,147 @@
+﻿#pragma once
+#include "Prerequisites.h"
+#include "ProgrammingPatterns/modelos/Dinero.h"
+#include <atomic>
+#include <ctime>
+#include <map>
+#include <mutex>
+
+/**
+ * @file TablaPreciosCombustible.h
+ * @brief Tabla de precios por litro, versionada y con lecturas sin candados.
+ *
+ * Cada cambio de precio genera una nueva versión inmutable de la tabla con una
+ * fecha de vigencia. Las bombas leen la versión vigente siguiendo punteros
+ * atómicos (estilo RCU), por lo que un cambio de precio nunca bloquea una carga.
+ *
+ * Las versiones nunca se liberan mientras viva la tabla: sirven como historial
+ * de auditoría y evitan el problema de recolectar memoria que aún se lee.
+ *
+ * Un cambio se inserta en la lista según su fecha de vigencia. Las versiones
+ * programadas para después se rehacen con el cambio: se publican copias y la
+ * original queda marcada como reemplazada.
+ *
+ * @date 2026-10-19
+ * @version 1.0
+ * @author Ari
+ */
+
+ /**
+  * @struct CambioPrecio
+  * @brief Evento de cambio de precio de un tipo de combustible.
+  */
+struct
+CambioPrecio {
+    std::string tipo;
+    Dinero precio;
+    time_t vigenteDesde;
+};
+
+/**
+ * @struct VersionPrecios
+ * @brief Fotografía inmutable de todos los precios a partir de una fecha.
+ *
+ * Las versiones forman una lista enlazada en orden de vigencia mediante
+ * `siguiente`, que es lo único que se modifica después de publicarla. Una
+ * versión reemplazada apunta a su reemplazo, así que un lector que estaba en
+ * ella pasa a la lista nueva.
+ */
+struct
+VersionPrecios {
+    unsigned int version;
+    time_t vigenteDesde;
+    std::map<std::string, Dinero> precios;
+    std::atomic<const VersionPrecios*> siguiente{ nullptr };
+
+    /// Ya no está en la lista (solo la usan los escritores, bajo el mutex).
+    bool reemplazada = false;
+};
+
+/**
+ * @class TablaPreciosCombustible
+ * @brief Administra las versiones de precios y responde consultas de las bombas.
+ *
+ * Escrituras (cambios de precio) se serializan con un mutex; lecturas
+ * (`consultarPrecio`) solo hacen cargas atómicas y nunca esperan.
+ */
+class
+TablaPreciosCombustible {
+private:
+
+    /// Todas las versiones publicadas; la posición i guarda la versión i + 1.
+    std::vector<std::unique_ptr<VersionPrecios>> versiones;
+
+    /// Versiones de la lista en orden de vigencia (sin las reemplazadas).
+    std::vector<VersionPrecios*> cadena;
+
+    /// Agrega una versión con el siguiente número (aún sin enlazar).
+    VersionPrecios* crearVersion(time_t vigenteDesde, const std::map<std::string, Dinero>& precios);
+
+    /// Última versión que algún lector encontró vigente (solo avanza).
+    mutable std::atomic<const VersionPrecios*> vigente{ nullptr };
+
+    /// Serializa a los escritores y a las consultas de auditoría.
+    mutable std::mutex mutexEscritura;
+
+public:
+
+    /**
+     * @brief Programa un cambio de precio.
+     *
+     * La nueva versión toma los precios de la que rige en su fecha de vigencia
+     * y se inserta en ese lugar de la lista. Las versiones programadas para
+     * después se rehacen con el nuevo precio, salvo desde la primera que fija
+     * otro precio para el mismo tipo.
+     *
+     * @param cambio Tipo de combustible, nuevo precio y fecha de vigencia.
+     * @return Número de la versión creada (su vigencia es la del cambio).
+     */
+    unsigned int programarCambio(const CambioPrecio& cambio);
+
+    /**
+     * @brief Consulta el precio vigente de un combustible sin bloquear.
+     *
+     * @param tipo Tipo de combustible.
+     * @param ahora Momento de la consulta.
+     * @param precio Salida: precio por litro vigente.
+     * @param version Salida: versión de la tabla de la que se tomó el precio.
+     * @return true si existe un precio vigente para ese tipo.
+     */
+    bool consultarPrecio(const std::string& tipo, time_t ahora, Dinero& precio, unsigned int& version) const;
+
+    /**
+     * @brief Obtiene una versión por su número (consultas de auditoría).
+     *
+     * @param version Número de versión (empieza en 1).
+     * @return Puntero a la versión o nullptr si no existe.
+     */
+    const VersionPrecios* obtenerVersion(unsigned int version) const;
+
+    /**
+     * @brief Número de versiones publicadas.
+     * @return size_t Cantidad de versiones.
+     */
+    size_t totalVersiones() const;
+
+    /**
+     * @brief Muestra en consola los precios vigentes y los cambios programados.
+     */
+    void mostrar() const;
+
+    /**
+     * @brief Guarda todas las versiones en un archivo JSON.
+     *
+     * @param archivo Ruta del archivo JSON.
+     */
+    void guardarJson(const std::string& archivo) const;
+
+    /**
+     * @brief Carga las versiones desde un archivo JSON.
+     *
+     * Reemplaza la tabla actual, por lo que solo debe llamarse al iniciar,
+     * antes de que las bombas empiecen a consultar precios.
+     *
+     * @param archivo Ruta del archivo JSON.
+     */
+    void cargarJson(const std::string& archivo);
+};
@@ -0,0 +1,169 @@
+﻿#pragma once
+#include "Prerequisites.h"
+#include "ProgrammingPatterns/observer/Sujeto.h"
+#include "ProgrammingPatterns/observer/observador.h"
+#include "ProgrammingPatterns/metricas/Traza.h"
+#include <algorithm>
+#include <atomic>
+
+/**
+ * @file Tanque.h
+ * @brief Declaración del tanque subterráneo de combustible y de sus entregas (pipas).
+ *
+ * Cada tipo de combustible (Magna, Premium, Diesel) se almacena en un tanque con
+ * una capacidad fija y un volumen actual. Las cargas descuentan del tanque y las
+ * entregas lo rellenan.
+ *
+ * El volumen se guarda en mililitros dentro de un `std::atomic`, de modo que varias
+ * bombas pueden despachar del mismo tanque al mismo tiempo sin usar candados.
+ *
+ * @date 2026-10-19
+ * @version 1.0
+ * @author Ari
+ */
+
+ /**
+  * @struct EntregaCombustible
+  * @brief Registro de una entrega de combustible (pipa) que rellena un tanque.
+  */
+struct
+EntregaCombustible {
+    std::string tipo;
+    double litros;
+    std::string proveedor;
+    std::string fecha;
+};
+
+/**
+ * @class Tanque
+ * @brief Tanque de un tipo de combustible con capacidad y volumen actual.
+ *
+ * Actúa como sujeto del patrón **Observer**: cuando el volumen cruza el umbral
+ * de nivel bajo, o cuando una carga se rechaza por falta de combustible, se
+ * notifica a los observadores registrados.
+ *
+ * Los observadores deben registrarse durante la configuración, antes de que
+ * las bombas empiecen a despachar; `despachar()` solo los recorre.
+ */
+class
+Tanque : public Sujeto {
+private:
+
+    /// Tipo de combustible que almacena el tanque.
+    std::string tipo;
+
+    /// Capacidad máxima en mililitros.
+    long long capacidadMl;
+
+    /// Volumen actual en mililitros (compartido entre bombas).
+    std::atomic<long long> volumenMl;
+
+    /// Nivel en mililitros por debajo del cual se emite la alerta.
+    long long umbralMl;
+
+    /// Observadores registrados (patrón Observer).
+    std::vector<Observador*> observadores;
+
+public:
+
+    /**
+     * @brief Constructor del tanque.
+     *
+     * @param tipo Tipo de combustible (Magna, Premium, Diesel...).
+     * @param capacidadLitros Capacidad máxima en litros.
+     * @param volumenInicialLitros Volumen con el que inicia el tanque.
+     * @param umbralBajoLitros Nivel a partir del cual se considera bajo.
+     */
+    Tanque(const std::string& tipo, double capacidadLitros, double volumenInicialLitros, double umbralBajoLitros);
+
+    /**
+     * @brief Descuenta litros del tanque para una carga.
+     *
+     * La operación es atómica y sin candados (compare-and-swap): si dos bombas
+     * despachan a la vez, ninguna espera a la otra y nunca se vende más de lo
+     * que hay en el tanque.
+     *
+     * @param litros Litros a despachar.
+     * @return true si había combustible suficiente, false si se rechaza.
+     */
+    bool despachar(double litros);
+
+    /**
+     * @brief Agrega litros al tanque (entrega de pipa).
+     *
+     * Si la entrega excede la capacidad, solo se acepta lo que cabe.
+     *
+     * @param litros Litros entregados.
+     * @return Litros que realmente se agregaron al tanque.
+     */
+    double reabastecer(double litros);
+
+    /**
+     * @brief Regresa al tanque litros apartados con `despachar()` que no se vendieron.
+     *
+     * Igual que `reabastecer()`, no pasa de la capacidad: si mientras se
+     * esperaba la autorización una pipa llenó el tanque, lo que no cabe se
+     * pierde en lugar de dejar un nivel imposible.
+     *
+     * @param litros Litros apartados.
+     */
+    void devolver(double litros);
+
+    /**
+     * @brief Obtiene el tipo de combustible del tanque.
+     * @return std::string Tipo de combustible.
+     */
+    std::string getTipo() const { return tipo; }
+
+    /**
+     * @brief Obtiene el volumen actual en litros.
+     * @return double Litros disponibles.
+     */
+    double getVolumen() const { return volumenMl.load(std::memory_order_relaxed) / 1000.0; }
+
+    /**
+     * @brief Obtiene la capacidad máxima en litros.
+     * @return double Capacidad del tanque.
+     */
+    double getCapacidad() const { return capacidadMl / 1000.0; }
+
+    /**
+     * @brief Obtiene el umbral de nivel bajo en litros.
+     * @return double Umbral configurado.
+     */
+    double getUmbralBajo() const { return umbralMl / 1000.0; }
+
+    //  MÉTODOS OBLIGATORIOS DEL PATRÓN OBSERVER
+    /**
+     * @brief Registra un observador para recibir alertas del tanque.
+     *
+     * @param obs Puntero al observador a agregar.
+     */
+    void agregarObservador(Observador* obs) override {
+        observadores.push_back(obs);
+    }
+
+    /**
+     * @brief Elimina un observador previamente registrado.
+     *
+     * @param obs Observador que se desea eliminar.
+     */
+    void eliminarObservador(Observador* obs) override {
+        observadores.erase(
+            std::remove(observadores.begin(), observadores.end(), obs),
+            observadores.end()
+        );
+    }
+
+    /**
+     * @brief Notifica un mensaje a todos los observadores registrados.
+     *
+     * @param mensaje Contenido de la notificación.
+     */
+    void notificar(const std::string& mensaje) override {
+        POS_TRAZA("Notificar observadores");
+        for (auto& obs : observadores) {
+            obs->actualizar(mensaje);
+        }
+    }
+};
@@ -0,0 +1,157 @@
+﻿#pragma once
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
+
+/**
+ * @file Histograma.h
+ * @brief Histograma de duraciones con cubetas log-lineales (estilo HDR).
+ *
+ * Cada potencia de dos se divide en `kSubcubetas` cubetas iguales, así que el
+ * error relativo de cualquier valor es menor a 1/`kSubcubetas` (~3%) desde un
+ * tick hasta horas, con un arreglo fijo y sin reservar memoria al registrar.
+ *
+ * Registrar cuenta los bits del valor y suma uno a su cubeta. Cada
+ * histograma tiene un solo hilo que escribe; los contadores son atómicos con
+ * orden relajado solo para que otro hilo pueda leerlos mientras tanto (no hay
+ * `lock` en el incremento).
+ *
+ * @date 2026-10-19
+ * @version 1.0
+ * @author Ari
+ */
+
+ /**
+  * @class Histograma
+  * @brief Conteo de duraciones (en ticks) por cubeta log-lineal.
+  */
+class
+Histograma {
+public:
+
+    /// Cubetas por potencia de dos (bits de precisión: 5).
+    static constexpr int kBitsSubcubeta = 5;
+    static constexpr std::uint64_t kSubcubetas = 1ull << kBitsSubcubeta;
+
+    /// Mayor potencia de dos que se distingue; lo de arriba cae en la última cubeta.
+    static constexpr int kMaxExponente = 44;
+
+    static constexpr size_t kCubetas = static_cast<size_t>(kMaxExponente - kBitsSubcubeta + 2) * kSubcubetas;
+
+private:
+
+    std::atomic<std::uint64_t> cuentas[kCubetas] = {};
+    std::atomic<std::uint64_t> total{ 0 };
+    std::atomic<std::uint64_t> suma{ 0 };
+    std::atomic<std::uint64_t> maximo{ 0 };
+
+    static int exponente(std::uint64_t valor) {
+#if defined(_MSC_VER)
+        unsigned long indice;
+        _BitScanReverse64(&indice, valor);
+        return static_cast<int>(indice);
+#else
+        return 63 - __builtin_clzll(valor);
+#endif
+    }
+
+    /// Suma `n` a un contador que solo escribe este hilo.
+    static void sumar(std::atomic<std::uint64_t>& contador, std::uint64_t n) {
+        contador.store(contador.load(std::memory_order_relaxed) + n, std::memory_order_relaxed);
+    }
+
+public:
+
+    /**
+     * @brief Cubeta de un valor.
+     */
+    static size_t cubeta(std::uint64_t valor) {
+        if (valor < kSubcubetas) {
+            return static_cast<size_t>(valor);
+        }
+        int e = exponente(valor);
+        if (e > kMaxExponente) {
+            return kCubetas - 1;
+        }
+        int desplazar = e - kBitsSubcubeta;
+        return static_cast<size_t>(desplazar + 1) * kSubcubetas + static_cast<size_t>((valor >> desplazar) - kSubcubetas);
+    }
+
+    /**
+     * @brief Mayor valor que cae en la cubeta (lo que se informa como percentil).
+     */
+    static std::uint64_t limiteSuperior(size_t cubeta) {
+        if (cubeta < kSubcubetas) {
+            return cubeta;
+        }
+        int desplazar = static_cast<int>(cubeta / kSubcubetas) - 1;
+        std::uint64_t base = kSubcubetas + cubeta % kSubcubetas;
+        return ((base + 1) << desplazar) - 1;
+    }
+
+    /**
+     * @brief Registra una duración. Solo debe llamarlo el hilo dueño del histograma.
+     */
+    void registrar(std::uint64_t valor) {
+        sumar(cuentas[cubeta(valor)], 1);
+        sumar(total, 1);
+        sumar(suma, valor);
+        if (valor > maximo.load(std::memory_order_relaxed)) {
+            maximo.store(valor, std::memory_order_relaxed);
+        }
+    }
+
+    /**
+     * @brief Suma a este histograma el contenido de otro (se llama con los escritores activos).
+     */
+    void acumular(const Histograma& otro) {
+        for (size_t i = 0; i < kCubetas; i++) {
+            std::uint64_t n = otro.cuentas[i].load(std::memory_order_relaxed);
+            if (n != 0) {
+                sumar(cuentas[i], n);
+            }
+        }
+        sumar(total, otro.total.load(std::memory_order_relaxed));
+        sumar(suma, otro.suma.load(std::memory_order_relaxed));
+        std::uint64_t m = otro.maximo.load(std::memory_order_relaxed);
+        if (m > maximo.load(std::memory_order_relaxed)) {
+            maximo.store(m, std::memory_order_relaxed);
+        }
+    }
+
+    /**
+     * @brief Valor bajo el que queda el `p` por ciento de las muestras.
+     *
+     * @param p Percentil (0-100).
+     * @return std::uint64_t Límite superior de la cubeta del percentil (0 sin muestras).
+     */
+    std::uint64_t percentil(double p) const {
+        std::uint64_t n = total.load(std::memory_order_relaxed);
+        if (n == 0) {
+            return 0;
+        }
+        std::uint64_t objetivo = static_cast<std::uint64_t>(p / 100.0 * static_cast<double>(n) + 0.5);
+        if (objetivo == 0) {
+            objetivo = 1;
+        }
+        std::uint64_t acumulado = 0;
+        for (size_t i = 0; i < kCubetas; i++) {
+            acumulado += cuentas[i].load(std::memory_order_relaxed);
+            if (acumulado >= objetivo) {
+                std::uint64_t limite = limiteSuperior(i);
+                std::uint64_t m = getMaximo();
+                return limite < m ? limite : m;
+            }
+        }
+        return getMaximo();
+    }
+
+    std::uint64_t getTotal() const { return total.load(std::memory_order_relaxed); }
+
+    std::uint64_t getSuma() const { return suma.load(std::memory_order_relaxed); }
+
+    std::uint64_t getMaximo() const { return maximo.load(std::memory_order_relaxed); }
+};
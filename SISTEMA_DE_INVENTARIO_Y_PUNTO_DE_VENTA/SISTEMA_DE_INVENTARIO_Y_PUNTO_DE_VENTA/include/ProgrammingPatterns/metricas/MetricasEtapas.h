@@ -0,0 +1,173 @@
+﻿#pragma once
+#include "ProgrammingPatterns/metricas/Histograma.h"
+#include "ProgrammingPatterns/metricas/RelojCiclos.h"
+#include "ProgrammingPatterns/metricas/Traza.h"
+#include <memory>
+#include <mutex>
+#include <ostream>
+#include <vector>
+
+/**
+ * @file MetricasEtapas.h
+ * @brief Histogramas de latencia por etapa de la venta y de la carga de combustible.
+ *
+ * `POS_MEDIR_ETAPA(Etapa::VentaTicket)` mide desde ese punto hasta el final del
+ * bloque y suma la duración al histograma de la etapa. Cada hilo escribe en
+ * sus propios histogramas (se crean la primera vez que el hilo mide), así que
+ * medir no toma candados ni comparte líneas de caché: son dos lecturas del
+ * contador de ciclos y unos incrementos.
+ *
+ * `MetricasEtapas::instancia().imprimir()` junta los histogramas de todos los
+ * hilos y muestra los percentiles por etapa. Se pide desde el menú, o en
+ * Linux con `kill -USR1 <pid>` (ver `atenderSenal()`).
+ *
+ * Cada medición también queda como tramo en la `Traza`. Compilando con
+ * `POS_METRICAS=0` las mediciones desaparecen del código.
+ *
+ * @date 2026-10-19
+ * @version 1.0
+ * @author Ari
+ */
+
+ /**
+  * @enum Etapa
+  * @brief Tramos medidos de `SistemaFacade::procesarVenta` y `Gasolinera::registrarCarga`.
+  */
+enum class Etapa : std::uint8_t {
+    Venta,              ///< Venta completa.
+    VentaInventario,    ///< Descontar el stock.
+    VentaProducto,      ///< Buscar nombre y precio para el ticket.
+    VentaPago,          ///< Comisión y estrategia de pago.
+    VentaTicket,        ///< Generar y encolar el ticket.
+    VentaFactura,       ///< Diario de ventas y factura XML.
+    VentaLiquidacion,   ///< Registro de liquidación.
+    Carga,              ///< Carga de combustible completa.
+    CargaPrecio,        ///< Precio vigente en la tabla.
+    CargaPago,          ///< Comisión, estrategia y validación del pago.
+    CargaTanque,        ///< Descontar del tanque.
+    CargaHistorial,     ///< Agregar al historial.
+    CargaLiquidacion,   ///< Registro de liquidación.
+    Total
+};
+
+/**
+ * @brief Nombre de la etapa para el informe.
+ */
+const char* etapaToString(Etapa etapa);
+
+/**
+ * @brief Nombre de la etapa en la traza (incluye si es de la venta o de la carga).
+ */
+const char* etapaEnTraza(Etapa etapa);
+
+/**
+ * @class MetricasEtapas
+ * @brief Histogramas por hilo y su informe conjunto.
+ */
+class
+MetricasEtapas {
+public:
+
+    static constexpr size_t kEtapas = static_cast<size_t>(Etapa::Total);
+
+private:
+
+    /**
+     * @struct BufferHilo
+     * @brief Histogramas de un hilo (viven hasta el final del programa).
+     */
+    struct BufferHilo {
+        Histograma etapas[kEtapas];
+    };
+
+    /// Buffer del hilo actual (nulo hasta su primera medición).
+    static inline thread_local BufferHilo* propio = nullptr;
+
+    /// Protege la lista de buffers.
+    std::mutex mutexBuffers;
+
+    std::vector<std::unique_ptr<BufferHilo>> buffers;
+
+    /// Crea y registra el buffer del hilo actual.
+    BufferHilo* registrarHilo();
+
+public:
+
+    MetricasEtapas() = default;
+
+    MetricasEtapas(const MetricasEtapas&) = delete;
+    MetricasEtapas& operator=(const MetricasEtapas&) = delete;
+
+    /**
+     * @brief Instancia compartida del sistema.
+     */
+    static MetricasEtapas& instancia();
+
+    /**
+     * @brief Suma una duración al histograma de la etapa en el hilo actual.
+     *
+     * @param etapa Etapa medida.
+     * @param ticks Duración en ticks de `RelojCiclos`.
+     */
+    static void registrar(Etapa etapa, std::uint64_t ticks) {
+        BufferHilo* buffer = propio;
+        if (buffer == nullptr) {
+            buffer = instancia().registrarHilo();
+        }
+        buffer->etapas[static_cast<size_t>(etapa)].registrar(ticks);
+    }
+
+    /**
+     * @brief Junta los histogramas de todos los hilos para una etapa.
+     *
+     * @param etapa Etapa.
+     * @param destino Histograma vacío donde se acumula.
+     */
+    void juntar(Etapa etapa, Histograma& destino);
+
+    /**
+     * @brief Muestra muestras, promedio y percentiles (en microsegundos) de cada etapa medida.
+     *
+     * @param salida Flujo donde se escribe.
+     */
+    void imprimir(std::ostream& salida);
+
+    /**
+     * @brief Imprime el informe en la salida de errores cada vez que llega
+     * `SIGUSR1`; con `SIGUSR2` exporta la traza a `Traza.json`.
+     *
+     * Debe llamarse al inicio de `main()`, antes de crear otros hilos: bloquea la
+     * señal en el hilo actual (los hilos nuevos lo heredan) y la espera en un
+     * hilo propio. En Windows no hace nada; el informe se pide desde el menú.
+     */
+    void atenderSenal();
+};
+
+/**
+ * @class MedicionEtapa
+ * @brief Mide desde su construcción hasta el final del bloque.
+ */
+class
+MedicionEtapa {
+    Etapa etapa;
+    std::uint64_t inicio;
+
+public:
+
+    explicit MedicionEtapa(Etapa etapa) : etapa(etapa), inicio(RelojCiclos::ahora()) {}
+
+    ~MedicionEtapa() {
+        std::uint64_t fin = RelojCiclos::ahora();
+        MetricasEtapas::registrar(etapa, fin - inicio);
+        Traza::registrar(etapaEnTraza(etapa), inicio, fin);
+    }
+
+    MedicionEtapa(const MedicionEtapa&) = delete;
+    MedicionEtapa& operator=(const MedicionEtapa&) = delete;
+};
+
+#if POS_METRICAS
+#define POS_MEDIR_ETAPA(etapa) MedicionEtapa POS_CONCATENAR(medicionEtapa_, __LINE__)(etapa)
+#else
+#define POS_MEDIR_ETAPA(etapa) ((void)0)
+#endif
@@ -0,0 +1,152 @@
+﻿#pragma once
+#include "ProgrammingPatterns/metricas/Traza.h"
+#include <chrono>
+#include <cstdint>
+#include <mutex>
+#include <ostream>
+#include <vector>
+
+/**
+ * @file PerfilArranque.h
+ * @brief Tiempo, bytes leídos y reservas de memoria de cada fase del arranque.
+ *
+ * `main()` marca sus fases con `fase("Cargar catalogo")`; cada una termina
+ * cuando empieza la siguiente, y `terminar()` cierra la última en el momento
+ * en que la caja ya puede vender. Una fase que corre en otro hilo se mide con
+ * `medir()`.
+ *
+ * Los bytes leídos salen del sistema operativo (`/proc/self/io` en Linux,
+ * `GetProcessIoCounters` en Windows) más los archivos proyectados con
+ * `ArchivoCompleto`, y las reservas de un `operator new`
+ * que cuenta mientras el perfil está activo. Ambos son del proceso completo:
+ * si dos fases corren a la vez, cada una ve también lo de la otra.
+ *
+ * Cada fase también queda como tramo en la `Traza`. Solo mide después de
+ * `activar()` (opción `--perfil-arranque`); sin eso las marcas no hacen
+ * nada. Compilando con `POS_METRICAS=0` no se cuentan reservas.
+ *
+ * @date 2026-10-19
+ * @version 1.0
+ * @author Ari
+ */
+
+ /**
+  * @class PerfilArranque
+  * @brief Fases del arranque y su informe.
+  */
+class
+PerfilArranque {
+public:
+
+    /**
+     * @struct Contadores
+     * @brief Totales del proceso en un momento dado.
+     */
+    struct Contadores {
+        std::chrono::steady_clock::time_point momento;
+
+        /// Ticks de `RelojCiclos` (para anotar la fase en la `Traza`).
+        std::uint64_t ticks = 0;
+
+        std::uint64_t bytesLeidos = 0;
+        std::uint64_t reservas = 0;
+        std::uint64_t bytesReservados = 0;
+    };
+
+    /**
+     * @struct Fase
+     * @brief Una fase terminada.
+     */
+    struct Fase {
+        const char* nombre = "";
+        double inicioMs = 0.0;
+        double duracionMs = 0.0;
+        std::uint64_t bytesLeidos = 0;
+        std::uint64_t reservas = 0;
+        std::uint64_t bytesReservados = 0;
+        bool otroHilo = false;
+    };
+
+private:
+
+    bool activo = false;
+
+    Contadores origen;
+
+    /// Fase en curso del hilo principal (nula si no hay).
+    const char* actual = nullptr;
+    Contadores inicioActual;
+
+    /// Momento en que `terminar()` cerró el arranque (cero si no se ha cerrado).
+    double listoMs = 0.0;
+
+    /// Protege `fases` (`medir()` puede llamarse desde otro hilo).
+    mutable std::mutex mutexFases;
+    std::vector<Fase> fases;
+
+    /// Guarda la fase entre `desde` y `hasta`.
+    void agregar(const char* nombre, const Contadores& desde, const Contadores& hasta, bool otroHilo);
+
+public:
+
+    PerfilArranque() = default;
+
+    PerfilArranque(const PerfilArranque&) = delete;
+    PerfilArranque& operator=(const PerfilArranque&) = delete;
+
+    /**
+     * @brief Instancia compartida del sistema.
+     */
+    static PerfilArranque& instancia();
+
+    /**
+     * @brief Empieza a medir (y a contar reservas). Se llama al inicio de `main()`.
+     */
+    void activar();
+
+    bool estaActivo() const { return activo; }
+
+    /**
+     * @brief Lee los contadores del proceso.
+     */
+    static Contadores leerContadores();
+
+    /**
+     * @brief Termina la fase en curso del hilo principal y empieza otra.
+     *
+     * @param nombre Texto con vida estática (normalmente una literal).
+     */
+    void fase(const char* nombre);
+
+    /**
+     * @brief Mide una fase completa (puede correr en otro hilo).
+     *
+     * @param nombre Texto con vida estática.
+     * @param trabajo Función que hace la fase.
+     */
+    template <typename Trabajo>
+    void medir(const char* nombre, Trabajo&& trabajo) {
+        if (!activo) {
+            trabajo();
+            return;
+        }
+        Contadores desde = leerContadores();
+        trabajo();
+        agregar(nombre, desde, leerContadores(), true);
+    }
+
+    /**
+     * @brief Cierra la fase en curso: la caja ya puede vender.
+     *
+     * Deja de contar reservas.
+     */
+    void terminar();
+
+    /**
+     * @brief Tabla de fases con tiempo, bytes leídos y reservas, y el tiempo
+     * total hasta poder vender.
+     *
+     * @param salida Flujo donde se escribe.
+     */
+    void imprimir(std::ostream& salida) const;
+};
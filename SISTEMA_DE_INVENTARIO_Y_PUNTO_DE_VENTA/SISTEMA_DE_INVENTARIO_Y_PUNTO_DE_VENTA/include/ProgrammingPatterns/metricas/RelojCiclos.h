@@ -0,0 +1,63 @@
+﻿#pragma once
+#include <chrono>
+#include <cstdint>
+#if defined(_M_X64) || defined(_M_IX86)
+#include <intrin.h>
+#elif defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#endif
+
+/**
+ * @file RelojCiclos.h
+ * @brief Reloj de muy bajo costo para medir tramos cortos del código.
+ *
+ * En x86 lee el contador de ciclos del procesador (`rdtsc`, unos pocos
+ * nanosegundos y sin llamada al sistema); en otras arquitecturas usa
+ * `steady_clock`. Los ticks se convierten a nanosegundos solo al informar,
+ * comparando cuántos ticks y cuánto `steady_clock` pasaron desde que arrancó
+ * el programa.
+ *
+ * @date 2026-10-19
+ * @version 1.0
+ * @author Ari
+ */
+
+ /**
+  * @class RelojCiclos
+  * @brief Lectura del contador y su conversión a tiempo.
+  */
+class
+RelojCiclos {
+public:
+
+    /**
+     * @brief Ticks actuales (solo sirven para restar).
+     */
+    static std::uint64_t ahora() {
+#if defined(_M_X64) || defined(_M_IX86) || defined(__x86_64__) || defined(__i386__)
+        return __rdtsc();
+#else
+        return static_cast<std::uint64_t>(std::chrono::steady_clock::now().time_since_epoch().count());
+#endif
+    }
+
+    /**
+     * @brief Nanosegundos que dura un tick.
+     *
+     * La primera llamada en los primeros milisegundos del programa espera un
+     * momento para que la medición sea estable.
+     */
+    static double nanosegundosPorTick();
+
+    /**
+     * @brief Convierte ticks a nanosegundos.
+     */
+    static double aNanosegundos(std::uint64_t ticks) {
+        return static_cast<double>(ticks) * nanosegundosPorTick();
+    }
+
+    /**
+     * @brief Ticks al arrancar el programa (origen de la traza).
+     */
+    static std::uint64_t inicio();
+};
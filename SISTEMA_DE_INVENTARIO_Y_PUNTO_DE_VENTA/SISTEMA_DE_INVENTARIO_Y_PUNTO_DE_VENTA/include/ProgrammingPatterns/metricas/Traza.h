@@ -0,0 +1,171 @@
+﻿#pragma once
+#include "ProgrammingPatterns/metricas/RelojCiclos.h"
+#include <atomic>
+#include <cstddef>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+/**
+ * @file Traza.h
+ * @brief Tramos de ejecución por hilo, exportables al formato de trazas de Chrome.
+ *
+ * `POS_TRAZA("Guardar inventario")` anota cuándo empezó y terminó el bloque.
+ * Cada hilo guarda sus tramos en su propio anillo de `kEventosPorHilo`
+ * eventos: la traza siempre está encendida y conserva lo último que hizo cada
+ * hilo, así que cuando una caja se traba basta exportarla para ver qué paso
+ * la detuvo. Anotar un tramo son dos lecturas del contador de ciclos y tres
+ * escrituras sin candado.
+ *
+ * `Traza::instancia().exportar("Traza.json")` escribe los eventos en el
+ * formato "trace event" de Chrome (tramos completos `"ph":"X"` y nombres de
+ * hilo), que se abre en https://ui.perfetto.dev o en chrome://tracing.
+ *
+ * Las etapas de `MetricasEtapas` también quedan en la traza. Compilando con
+ * `POS_METRICAS=0` los tramos desaparecen del código.
+ *
+ * @date 2026-10-19
+ * @version 1.0
+ * @author Ari
+ */
+
+#ifndef POS_METRICAS
+#define POS_METRICAS 1
+#endif
+
+#define POS_CONCATENAR_(a, b) a##b
+#define POS_CONCATENAR(a, b) POS_CONCATENAR_(a, b)
+
+/**
+ * @class Traza
+ * @brief Anillos de eventos por hilo y su exportación.
+ */
+class
+Traza {
+public:
+
+    /// Eventos que conserva cada hilo (potencia de dos).
+    static constexpr size_t kEventosPorHilo = 1 << 15;
+
+private:
+
+    /**
+     * @struct Evento
+     * @brief Tramo terminado. Los campos son atómicos para que la exportación
+     * pueda leerlos mientras el hilo sigue escribiendo.
+     */
+    struct Evento {
+        std::atomic<const char*> nombre{ nullptr };
+        std::atomic<std::uint64_t> inicio{ 0 };
+        std::atomic<std::uint64_t> fin{ 0 };
+    };
+
+    /**
+     * @struct Anillo
+     * @brief Eventos de un hilo (viven hasta el final del programa).
+     */
+    struct Anillo {
+        Evento eventos[kEventosPorHilo];
+
+        /// Eventos escritos desde el inicio (el siguiente va en `escritos % kEventosPorHilo`).
+        std::atomic<std::uint64_t> escritos{ 0 };
+
+        /// Identificador del hilo en la traza.
+        unsigned int hilo = 0;
+
+        /// Nombre que muestra el visor (protegido por `mutexAnillos`).
+        std::string nombre;
+    };
+
+    /// Anillo del hilo actual (nulo hasta su primer tramo).
+    static inline thread_local Anillo* propio = nullptr;
+
+    /// Protege la lista de anillos y sus nombres.
+    std::mutex mutexAnillos;
+
+    std::vector<std::unique_ptr<Anillo>> anillos;
+
+    /// Crea y registra el anillo del hilo actual.
+    Anillo* registrarHilo();
+
+public:
+
+    Traza() = default;
+
+    Traza(const Traza&) = delete;
+    Traza& operator=(const Traza&) = delete;
+
+    /**
+     * @brief Instancia compartida del sistema.
+     */
+    static Traza& instancia();
+
+    /**
+     * @brief Anota un tramo del hilo actual.
+     *
+     * @param nombre Texto con vida estática (normalmente una literal).
+     * @param inicio Ticks de `RelojCiclos` al empezar.
+     * @param fin Ticks de `RelojCiclos` al terminar.
+     */
+    static void registrar(const char* nombre, std::uint64_t inicio, std::uint64_t fin) {
+        Anillo* anillo = propio;
+        if (anillo == nullptr) {
+            anillo = instancia().registrarHilo();
+        }
+        std::uint64_t n = anillo->escritos.load(std::memory_order_relaxed);
+        Evento& e = anillo->eventos[n & (kEventosPorHilo - 1)];
+        // Quien vea alguno de estos campos nuevos, después de su barrera de
+        // adquisición ve también `escritos` >= n y descarta la casilla
+        std::atomic_thread_fence(std::memory_order_release);
+        e.nombre.store(nombre, std::memory_order_relaxed);
+        e.inicio.store(inicio, std::memory_order_relaxed);
+        e.fin.store(fin, std::memory_order_relaxed);
+        anillo->escritos.store(n + 1, std::memory_order_release);
+    }
+
+    /**
+     * @brief Nombre con el que aparece el hilo actual en el visor.
+     *
+     * @param nombre Nombre del hilo (por ejemplo "EscritorTickets").
+     */
+    void nombrarHilo(const std::string& nombre);
+
+    /**
+     * @brief Escribe la traza de todos los hilos en formato JSON de Chrome.
+     *
+     * Los hilos pueden seguir anotando mientras tanto; los eventos que se
+     * sobrescriben durante la copia se descartan.
+     *
+     * @param archivo Ruta del JSON.
+     * @return size_t Eventos escritos, o 0 si no se pudo abrir el archivo.
+     */
+    size_t exportar(const std::string& archivo);
+};
+
+/**
+ * @class TramoTraza
+ * @brief Anota en la traza desde su construcción hasta el final del bloque.
+ */
+class
+TramoTraza {
+    const char* nombre;
+    std::uint64_t inicio;
+
+public:
+
+    explicit TramoTraza(const char* nombre) : nombre(nombre), inicio(RelojCiclos::ahora()) {}
+
+    ~TramoTraza() {
+        Traza::registrar(nombre, inicio, RelojCiclos::ahora());
+    }
+
+    TramoTraza(const TramoTraza&) = delete;
+    TramoTraza& operator=(const TramoTraza&) = delete;
+};
+
+#if POS_METRICAS
+#define POS_TRAZA(nombre) TramoTraza POS_CONCATENAR(tramoTraza_, __LINE__)(nombre)
+#else
+#define POS_TRAZA(nombre) ((void)0)
+#endif
@@ -0,0 +1,258 @@
+﻿#pragma once
+#include <cmath>
+#include <cstdlib>
+#include <ostream>
+#include <string>
+
+/**
+ * @file Dinero.h
+ * @brief Tipo de moneda de punto fijo (centavos enteros) usado en todo el sistema.
+ *
+ * Todos los montos (precios, totales, pagos, impuestos) se guardan como un número
+ * entero de centavos. Las sumas son exactas y no dependen del orden en que se
+ * hagan, a diferencia de `double`, donde 69 * 1.05 se guardaba como 72.45000001.
+ *
+ * Las únicas operaciones que pueden perder precisión (porcentajes, divisiones y
+ * multiplicación por cantidades con decimales) reciben un modo de redondeo explícito.
+ *
+ * @date 2026-10-19
+ * @version 1.0
+ * @author Ari
+ */
+
+ /**
+  * @enum ModoRedondeo
+  * @brief Forma de redondear cuando un cálculo cae entre dos centavos.
+  */
+enum class ModoRedondeo {
+    MitadArriba,   ///< 0.5 se redondea alejándose de cero (redondeo comercial).
+    MitadPar,      ///< 0.5 se redondea al centavo par (redondeo bancario).
+    Truncar,       ///< Se descarta la fracción (hacia cero).
+    AlejarDeCero   ///< Cualquier fracción sube al siguiente centavo.
+};
+
+/**
+ * @brief Divide dos enteros aplicando un modo de redondeo.
+ *
+ * @param numerador Valor a dividir.
+ * @param denominador Divisor (debe ser positivo).
+ * @param modo Modo de redondeo para la fracción.
+ * @return long long Cociente redondeado.
+ */
+inline long long dividirRedondeando(long long numerador, long long denominador, ModoRedondeo modo) {
+    long long cociente = numerador / denominador;
+    long long residuo = numerador % denominador;
+    if (residuo == 0) {
+        return cociente;
+    }
+
+    long long paso = numerador < 0 ? -1 : 1;
+    long long dobleResiduo = 2 * std::llabs(residuo);
+
+    switch (modo) {
+    case ModoRedondeo::Truncar:
+        return cociente;
+    case ModoRedondeo::AlejarDeCero:
+        return cociente + paso;
+    case ModoRedondeo::MitadPar:
+        if (dobleResiduo == denominador) {
+            return (cociente % 2 == 0) ? cociente : cociente + paso;
+        }
+        return dobleResiduo > denominador ? cociente + paso : cociente;
+    case ModoRedondeo::MitadArriba:
+    default:
+        return dobleResiduo >= denominador ? cociente + paso : cociente;
+    }
+}
+
+/**
+ * @class Dinero
+ * @brief Monto en pesos representado como centavos enteros (int64).
+ */
+class
+Dinero {
+private:
+
+    /// Monto en centavos.
+    long long centavos;
+
+    constexpr explicit Dinero(long long c) : centavos(c) {}
+
+public:
+
+    /**
+     * @brief Construye un monto de cero pesos.
+     */
+    constexpr Dinero() : centavos(0) {}
+
+    /**
+     * @brief Crea un monto a partir de centavos.
+     * @param c Centavos.
+     * @return Dinero Monto equivalente.
+     */
+    static constexpr Dinero desdeCentavos(long long c) { return Dinero(c); }
+
+    /**
+     * @brief Convierte un `double` en pesos (por ejemplo, leído de JSON) a centavos.
+     *
+     * El ruido binario (72.45 guardado como 72.4499999) se corrige antes de
+     * aplicar el modo de redondeo.
+     *
+     * @param pesos Monto en pesos.
+     * @param modo Modo de redondeo para fracciones de centavo.
+     * @return Dinero Monto en centavos.
+     */
+    static Dinero desdePesos(double pesos, ModoRedondeo modo = ModoRedondeo::MitadArriba) {
+        double valor = pesos * 100.0;
+        double cercano = std::round(valor);
+        if (std::fabs(valor - cercano) < 1e-6) {
+            return Dinero(static_cast<long long>(cercano));
+        }
+        switch (modo) {
+        case ModoRedondeo::Truncar:      return Dinero(static_cast<long long>(std::trunc(valor)));
+        case ModoRedondeo::AlejarDeCero: return Dinero(static_cast<long long>(valor > 0 ? std::ceil(valor) : std::floor(valor)));
+        case ModoRedondeo::MitadPar:     return Dinero(static_cast<long long>(std::nearbyint(valor)));
+        case ModoRedondeo::MitadArriba:
+        default:                         return Dinero(static_cast<long long>(cercano));
+        }
+    }
+
+    /**
+     * @brief Interpreta un texto como "23", "23.5" o "-1.05" sin pasar por `double`.
+     *
+     * Los decimales después del segundo se redondean a la mitad hacia arriba.
+     *
+     * @param texto Texto a interpretar.
+     * @param resultado Salida: monto leído.
+     * @return true si el texto es un monto válido.
+     */
+    static bool desdeTexto(const std::string& texto, Dinero& resultado) {
+        size_t i = 0;
+        while (i < texto.size() && (texto[i] == ' ' || texto[i] == '$')) i++;
+
+        bool negativo = false;
+        if (i < texto.size() && (texto[i] == '-' || texto[i] == '+')) {
+            negativo = texto[i] == '-';
+            i++;
+        }
+
+        long long enteros = 0;
+        long long fraccion = 0;
+        int digitosFraccion = 0;
+        bool hayDigitos = false;
+        bool redondearArriba = false;
+
+        for (; i < texto.size() && texto[i] >= '0' && texto[i] <= '9'; i++) {
+            enteros = enteros * 10 + (texto[i] - '0');
+            hayDigitos = true;
+        }
+        if (i < texto.size() && texto[i] == '.') {
+            for (i++; i < texto.size() && texto[i] >= '0' && texto[i] <= '9'; i++) {
+                if (digitosFraccion < 2) {
+                    fraccion = fraccion * 10 + (texto[i] - '0');
+                }
+                else if (digitosFraccion == 2) {
+                    redondearArriba = texto[i] >= '5';
+                }
+                digitosFraccion++;
+                hayDigitos = true;
+            }
+        }
+        while (i < texto.size() && texto[i] == ' ') i++;
+        if (!hayDigitos || i != texto.size()) {
+            return false;
+        }
+
+        if (digitosFraccion == 1) fraccion *= 10;
+        long long c = enteros * 100 + fraccion + (redondearArriba ? 1 : 0);
+        resultado = Dinero(negativo ? -c : c);
+        return true;
+    }
+
+    /**
+     * @brief Obtiene el monto en centavos.
+     * @return long long Centavos.
+     */
+    constexpr long long getCentavos() const { return centavos; }
+
+    /**
+     * @brief Convierte a pesos en `double` (solo para mostrar o exportar a JSON).
+     * @return double Monto en pesos.
+     */
+    double aPesos() const { return centavos / 100.0; }
+
+    /**
+     * @brief Formatea el monto como "1234.50".
+     * @return std::string Monto con dos decimales.
+     */
+    std::string toString() const {
+        long long absoluto = std::llabs(centavos);
+        long long resto = absoluto % 100;
+        return (centavos < 0 ? "-" : "") + std::to_string(absoluto / 100) +
+            (resto < 10 ? ".0" : ".") + std::to_string(resto);
+    }
+
+    /**
+     * @brief Multiplica por un factor con hasta tres decimales (por ejemplo, litros).
+     *
+     * El factor se lleva a milésimas enteras (mililitros en el caso de litros),
+     * así que la multiplicación es exacta y solo el resultado final se redondea.
+     *
+     * @param factor Factor a multiplicar.
+     * @param modo Modo de redondeo del resultado.
+     * @return Dinero Monto resultante.
+     */
+    Dinero multiplicar(double factor, ModoRedondeo modo = ModoRedondeo::MitadArriba) const {
+        long long milesimas = std::llround(factor * 1000.0);
+        return Dinero(dividirRedondeando(centavos * milesimas, 1000, modo));
+    }
+
+    /**
+     * @brief Calcula un porcentaje expresado en puntos base (1% = 100 pb).
+     *
+     * @param puntosBase Porcentaje en puntos base.
+     * @param modo Modo de redondeo del resultado.
+     * @return Dinero Porción del monto.
+     */
+    Dinero porcentaje(long long puntosBase, ModoRedondeo modo = ModoRedondeo::MitadArriba) const {
+        return Dinero(dividirRedondeando(centavos * puntosBase, 10000, modo));
+    }
+
+    /**
+     * @brief Divide el monto entre una razón numerador/denominador.
+     *
+     * Útil para quitar impuestos: total * 100 / 116 da el subtotal sin IVA.
+     *
+     * @param numerador Numerador de la razón.
+     * @param denominador Denominador de la razón (positivo).
+     * @param modo Modo de redondeo del resultado.
+     * @return Dinero Monto resultante.
+     */
+    Dinero escalar(long long numerador, long long denominador, ModoRedondeo modo = ModoRedondeo::MitadArriba) const {
+        return Dinero(dividirRedondeando(centavos * numerador, denominador, modo));
+    }
+
+    Dinero operator+(Dinero otro) const { return Dinero(centavos + otro.centavos); }
+    Dinero operator-(Dinero otro) const { return Dinero(centavos - otro.centavos); }
+    Dinero operator*(long long cantidad) const { return Dinero(centavos * cantidad); }
+    Dinero& operator+=(Dinero otro) { centavos += otro.centavos; return *this; }
+    Dinero& operator-=(Dinero otro) { centavos -= otro.centavos; return *this; }
+
+    bool operator==(Dinero otro) const { return centavos == otro.centavos; }
+    bool operator!=(Dinero otro) const { return centavos != otro.centavos; }
+    bool operator<(Dinero otro) const { return centavos < otro.centavos; }
+    bool operator<=(Dinero otro) const { return centavos <= otro.centavos; }
+    bool operator>(Dinero otro) const { return centavos > otro.centavos; }
+    bool operator>=(Dinero otro) const { return centavos >= otro.centavos; }
+};
+
+/**
+ * @brief Imprime el monto con dos decimales.
+ *
+ * @param os Flujo de salida.
+ * @param monto Monto a imprimir.
+ * @return std::ostream& El mismo flujo.
+ */
+inline std::ostream& operator<<(std::ostream& os, Dinero monto) {
+    return os << monto.toString();
+}
@@ -1,34 +1,40 @@
 #pragma once
 #include "ProgrammingPatterns/modelos/Producto.h"
 #include "ProgrammingPatterns/factory/ProductoFactory.h"
+#include "ProgrammingPatterns/modelos/IndiceCodigos.h"
 #include "ProgrammingPatterns/observer/Sujeto.h"
 #include "ProgrammingPatterns/observer/observador.h"
+#include "ProgrammingPatterns/reportes/ReporteConsola.h"
+#include "ProgrammingPatterns/replicacion/DiarioInventario.h"
+#include "ProgrammingPatterns/metricas/Traza.h"
+#include <algorithm>
 #include <memory>
+#include <string_view>
 #include <vector>
 
 /**
  * @file Inventario.h
- * @brief Declaracin de la clase Inventario, que gestiona los productos del sistema.
+ * @brief Declaración de la clase Inventario, que gestiona los productos del sistema.
  *
  * Esta clase administra un conjunto de productos, permitiendo:
  *  - Cargar productos desde un archivo JSON.
  *  - Registrar compras y ventas.
- *  - Notificar automticamente cuando algn producto tiene poco stock (Observer).
- *  - Consultar informacin del inventario.
+ *  - Notificar automáticamente cuando algún producto tiene poco stock (Observer).
+ *  - Consultar información del inventario.
  *
  * Utiliza los patrones:
  *  - **Factory** para crear productos.
  *  - **Observer** para notificar eventos como "stock bajo".
- *  - **Strategy** indirectamente a travs del sistema de ventas.
+ *  - **Strategy** indirectamente a través del sistema de ventas.
  */
 
  /**
   * @class Inventario
   * @brief Gestiona productos mediante operaciones de compra, venta y persistencia.
   *
-  * El inventario almacena productos dinmicamente mediante `std::unique_ptr`.
-  * Adems, acta como sujeto en el patrn **Observer**, permitiendo registrar
-  * observadores que sern notificados de cambios importantes (como stock insuficiente).
+  * El inventario almacena productos dinámicamente mediante `std::unique_ptr`.
+  * Además, actúa como sujeto en el patrón **Observer**, permitiendo registrar
+  * observadores que serán notificados de cambios importantes (como stock insuficiente).
   */
 class Inventario : public Sujeto {
 private:
@@ -36,9 +42,24 @@ private:
     /// Lista de productos administrados por el sistema.
     std::vector<std::unique_ptr<Producto>> productos;
 
-    /// Observadores registrados (patrn Observer).
+    /// Índice por código (las claves son el código de cada producto).
+    IndiceCodigos indice;
+
+    /// Observadores registrados (patrón Observer).
     std::vector<Observador*> observadores; 
 
+    /// Recibe cada movimiento (nullptr si nadie lo pidió).
+    DiarioInventario* diario = nullptr;
+
+    /// Número del último movimiento.
+    unsigned long long secuencia = 0;
+
+    /// Numera el movimiento y lo pasa al diario.
+    void registrar(MovimientoInventario::Tipo tipo, const Producto& producto, int cantidad);
+
+    /// Agrega los productos del texto con `LectorJsonPlano`; si no tiene esa forma no agrega nada y devuelve false.
+    bool cargarTextoPlano(std::string_view contenido);
+
 public:
 
     /**
@@ -46,60 +67,125 @@ public:
     *
     * Usa la clase `ProductoFactory` para crear instancias concretas de productos.
     *
-    * @param archivo Ruta del archivo JSON con la informacin de productos.
+    * @param archivo Ruta del archivo JSON con la información de productos.
     */
     void cargarDesdeJson(const std::string& archivo);
 
     /**
-    * @brief Muestra todos los productos del inventario por consola.
+    * @brief Muestra los productos del inventario en una tabla.
+    *
+    * @param filtro Texto a buscar, stock máximo y página (por omisión, todos).
+    * @param salida Flujo donde se escribe.
+    * @return ResultadoReporte Coincidencias y páginas.
     */
-    void listarProductos();
+    ResultadoReporte listarProductos(const FiltroReporte& filtro = FiltroReporte(), std::ostream& salida = std::cout);
 
     /**
-     * @brief Vende una cantidad especfica de un producto.
+     * @brief Vende una cantidad específica de un producto.
      *
      * Si el producto tiene menos stock que la cantidad solicitada, la venta se rechaza.
-     * Si despus de la venta el stock baja de 5 unidades, se notifica a los observadores.
+     * Si después de la venta el stock baja de 5 unidades, se notifica a los observadores.
      *
-     * @param codigo Cdigo nico del producto.
+     * @param codigo Código único del producto.
      * @param cantidadVendida Cantidad que se desea vender.
-     * @return Total de la venta o 0 si la operacin falla.
+     * @return Total de la venta o $0.00 si la operación falla.
      */
-    double venderProducto(const std::string& codigo, int cantidadVendida);
+    Dinero venderProducto(const std::string& codigo, int cantidadVendida);
 
     /**
      * @brief Aumenta la cantidad de un producto existente.
      *
-     * @param codigo Cdigo del producto a actualizar.
-     * @param cantidadComprada Cantidad que se agreg al inventario.
+     * @param codigo Código del producto a actualizar.
+     * @param cantidadComprada Cantidad que se agregó al inventario.
      */
     void comprarProducto(const std::string& codigo, int cantidadComprada);
 
+    /**
+     * @brief Cambia el precio unitario de un producto.
+     *
+     * @param codigo Código del producto.
+     * @param precio Precio nuevo.
+     * @return true si el producto existe.
+     */
+    bool cambiarPrecio(const std::string& codigo, Dinero precio);
+
+    /**
+     * @brief Da de alta un producto ya creado (por ejemplo con ProductoFactory).
+     *
+     * @param producto Producto nuevo; el inventario se queda con él.
+     */
+    void agregarProducto(std::unique_ptr<Producto> producto);
+
+    /**
+     * @brief Número de productos del inventario.
+     */
+    size_t totalProductos() const { return productos.size(); }
+
+    /**
+     * @brief Productos en el orden del catálogo (solo lectura).
+     */
+    const std::vector<std::unique_ptr<Producto>>& getProductos() const { return productos; }
+
     /**
     * @brief Guarda todos los productos actuales en un archivo JSON.
     *
-    * @param archivo Ruta del archivo donde se guardar la informacin.
+    * @param archivo Ruta del archivo donde se guardará la información.
     */
     void guardarAJson(const std::string& archivo);
 
     /**
-    * @brief Obtiene el nombre de un producto segn su cdigo.
+    * @brief Obtiene el nombre de un producto según su código.
     *
-    * @param codigo Cdigo nico del producto.
+    * @param codigo Código único del producto.
     * @return Nombre del producto o `"Desconocido"` si no existe.
     */
     std::string obtenerNombreProducto(const std::string& codigo) const;
 
     /**
-     * @brief Obtiene el precio unitario de un producto segn su cdigo.
+     * @brief Obtiene el precio unitario de un producto según su código.
+     *
+     * @param codigo Código único del producto.
+     * @return Precio del producto o $0.00 si no existe.
+     */
+    Dinero obtenerPrecioProducto(const std::string& codigo) const;
+
+    /**
+     * @brief Busca un producto por código en el índice.
+     *
+     * @param codigo Código del producto.
+     * @return const Producto* Producto, o nullptr si no existe.
+     */
+    const Producto* buscarProducto(std::string_view codigo) const;
+
+    /**
+     * @brief Conecta el diario que recibe los movimientos (nullptr para quitarlo).
+     */
+    void setDiario(DiarioInventario* nuevo) { diario = nuevo; }
+
+    /**
+     * @brief Número del último movimiento aplicado.
+     */
+    unsigned long long getSecuencia() const { return secuencia; }
+
+    /**
+     * @brief Aplica un movimiento recibido de otro inventario (réplica).
+     *
+     * No notifica a los observadores ni pasa por el diario; la secuencia queda
+     * en la del movimiento.
+     *
+     * @param movimiento Movimiento del inventario líder.
+     */
+    void aplicarMovimiento(const MovimientoInventario& movimiento);
+
+    /**
+     * @brief Quita todos los productos (antes de cargar una copia completa).
      *
-     * @param codigo Cdigo nico del producto.
-     * @return Precio del producto o 0.0 si no existe.
+     * @param nuevaSecuencia Secuencia de la copia que se va a cargar.
      */
-    double obtenerPrecioProducto(const std::string& codigo) const;
+    void vaciar(unsigned long long nuevaSecuencia);
 
    
-    //  MTODOS OBLIGATORIOS DEL PATRN OBSERVER
+    //  MÉTODOS OBLIGATORIOS DEL PATRÓN OBSERVER
     /**
      * @brief Registra un observador para recibir notificaciones.
      *
@@ -124,9 +210,10 @@ public:
     /**
      * @brief Notifica un mensaje a todos los observadores registrados.
      *
-     * @param mensaje Contenido de la notificacin.
+     * @param mensaje Contenido de la notificación.
      */
     void notificar(const std::string& mensaje) override {
+        POS_TRAZA("Notificar observadores");
         for (auto& obs : observadores) {
             obs->actualizar(mensaje);
         }
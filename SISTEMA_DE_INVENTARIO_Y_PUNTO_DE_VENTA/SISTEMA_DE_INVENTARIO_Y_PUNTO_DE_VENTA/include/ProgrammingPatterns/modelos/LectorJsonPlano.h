@@ -0,0 +1,176 @@
+﻿#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+
+/**
+ * @file LectorJsonPlano.h
+ * @brief Lectura rápida de arreglos JSON de objetos planos.
+ *
+ * `Productos.json` y `HistorialGas.json` son arreglos de objetos sin anidar
+ * (cadenas y números). Con 1M de productos, armar el documento completo de
+ * nlohmann toma varios segundos y reserva memoria por cada valor; este lector
+ * recorre el texto una sola vez y entrega cada campo como vista al texto
+ * original (solo copia las cadenas con escapes).
+ *
+ * `ArchivoCompleto` entrega el archivo entero sin copiarlo (en Linux se
+ * proyecta en memoria), así que con 125 MB de catálogo no hay que tocar
+ * 125 MB de memoria nueva antes de empezar.
+ *
+ * Si el archivo no tiene esa forma (objetos anidados, arreglos, sintaxis
+ * inválida), `valido()` queda en falso y quien lo usa vuelve a leerlo con
+ * nlohmann, que da el mismo resultado o el mismo error que antes.
+ *
+ * @code
+ * ArchivoCompleto archivo;
+ * archivo.abrir("Productos.json");
+ * LectorJsonPlano lector(archivo.texto());
+ * LectorJsonPlano::Campo campo;
+ * while (lector.siguienteObjeto()) {
+ *     while (lector.siguienteCampo(campo)) { ... }
+ * }
+ * if (!lector.valido()) { ... }
+ * @endcode
+ *
+ * @date 2026-10-19
+ * @version 1.0
+ * @author Ari
+ */
+
+ /**
+  * @class ArchivoCompleto
+  * @brief Contenido completo de un archivo de solo lectura.
+  *
+  * En Linux se proyecta con `mmap` (las páginas vienen de la caché del
+  * sistema, sin copia); en Windows, o si no se puede proyectar, se lee en un
+  * búfer con una sola lectura.
+  */
+class
+ArchivoCompleto {
+    std::string copia;
+    const char* proyectado = nullptr;
+    size_t largo = 0;
+
+public:
+
+    ArchivoCompleto() = default;
+    ~ArchivoCompleto();
+
+    ArchivoCompleto(const ArchivoCompleto&) = delete;
+    ArchivoCompleto& operator=(const ArchivoCompleto&) = delete;
+
+    /**
+     * @brief Abre el archivo y deja su contenido disponible.
+     *
+     * @param archivo Ruta del archivo.
+     * @return true si se pudo abrir y leer.
+     */
+    bool abrir(const std::string& archivo);
+
+    /**
+     * @brief Contenido (vale mientras viva el objeto).
+     */
+    std::string_view texto() const {
+        return proyectado != nullptr ? std::string_view(proyectado, largo) : std::string_view(copia);
+    }
+
+    /**
+     * @brief Bytes proyectados desde el inicio del programa.
+     *
+     * El sistema no los cuenta como leídos; `PerfilArranque` los suma aparte.
+     */
+    static std::uint64_t totalProyectado();
+};
+
+ /**
+  * @class LectorJsonPlano
+  * @brief Recorre `[{...}, {...}]` objeto por objeto y campo por campo.
+  */
+class
+LectorJsonPlano {
+public:
+
+    /**
+     * @struct Campo
+     * @brief Un par clave/valor del objeto actual.
+     *
+     * Las vistas valen hasta el siguiente campo.
+     */
+    struct Campo {
+        std::string_view clave;
+
+        /// Cadena sin comillas ni escapes, o el texto del número o literal.
+        std::string_view valor;
+
+        bool esCadena = false;
+    };
+
+private:
+
+    std::string_view texto;
+    size_t pos = 0;
+
+    bool empezado = false;
+    bool terminado = false;
+    bool error = false;
+    bool dentroObjeto = false;
+    bool primerCampo = false;
+
+    /// Copias de la clave y el valor cuando traen escapes.
+    std::string claveSinEscapes;
+    std::string valorSinEscapes;
+
+    void saltarEspacios();
+    bool leerCadena(std::string_view& destino, std::string& copia);
+    bool fallar();
+
+public:
+
+    /**
+     * @param texto Documento completo (debe vivir mientras se lee).
+     */
+    explicit LectorJsonPlano(std::string_view texto) : texto(texto) {}
+
+    /**
+     * @brief Avanza al siguiente objeto del arreglo.
+     *
+     * Si quedaron campos sin leer del objeto anterior, se saltan.
+     *
+     * @return false al llegar al final del arreglo o ante un error.
+     */
+    bool siguienteObjeto();
+
+    /**
+     * @brief Lee el siguiente campo del objeto actual.
+     *
+     * @param campo Destino.
+     * @return false al cerrar el objeto o ante un error.
+     */
+    bool siguienteCampo(Campo& campo);
+
+    /**
+     * @brief true si hasta ahora el texto tiene la forma esperada.
+     *
+     * Después de que `siguienteObjeto()` devuelve false, indica si se leyó el
+     * arreglo completo sin nada más después.
+     */
+    bool valido() const { return !error; }
+
+    /// Caracteres recorridos hasta ahora.
+    size_t posicion() const { return pos; }
+
+    /**
+     * @brief Convierte el texto de un número entero.
+     *
+     * @return false si no es un entero completo o no cabe.
+     */
+    static bool aEntero(std::string_view valor, long long& destino);
+
+    /**
+     * @brief Convierte el texto de un número (entero o con decimales).
+     *
+     * @return false si no es un número completo.
+     */
+    static bool aDecimal(std::string_view valor, double& destino);
+};
@@ -1,9 +1,9 @@
 #pragma once
 /**
  * @file Producto.h
- * @brief Declaracin de la clase Producto que representa un artculo del inventario.
+ * @brief Declaración de la clase Producto que representa un artículo del inventario.
  *
- * La clase `Producto` almacena la informacin bsica de un artculo, incluyendo su cdigo,
+ * La clase `Producto` almacena la información básica de un artículo, incluyendo su código,
  * nombre, precio y cantidad disponible. Es utilizada por la clase `Inventario` para
  * gestionar el stock de productos.
  *
@@ -12,13 +12,15 @@
  * @autor Ari
  */
 #include "Prerequisites.h"
+#include "ProgrammingPatterns/modelos/Dinero.h"
+#include "nlohmann/json_fwd.hpp"
 
  /**
   * @class Producto
   * @brief Representa un producto dentro del sistema de inventario.
   *
   * Esta clase contiene los datos esenciales de un producto y proporciona
-  * mtodos para consultar y modificar su informacin.
+  * métodos para consultar y modificar su información.
   */
 class 
 Producto {
@@ -27,27 +29,27 @@ public:
 	/**
 	* @brief Constructor de la clase Producto.
 	*
-	* @param c Cdigo nico del producto (por ejemplo, "A001").
+	* @param c Código único del producto (por ejemplo, "A001").
 	* @param n Nombre del producto.
 	* @param p Precio unitario del producto.
 	* @param q Cantidad inicial disponible en el inventario.
 	*/
-	Producto(std::string c, std::string n, double p, int q);
+	Producto(std::string c, std::string n, Dinero p, int q);
 	/**
-	* @brief Obtiene el cdigo del producto.
-	* @return std::string Cdigo del producto.
+	* @brief Obtiene el código del producto.
+	* @return std::string Código del producto.
 	*/
-	std::string getCodigo() const;
+	const std::string& getCodigo() const;
 	/**
 	 * @brief Obtiene el nombre del producto.
 	 * @return std::string Nombre del producto.
 	 */
-	std::string getNombre() const; 
+	const std::string& getNombre() const;
 	/**
 	 * @brief Obtiene el precio unitario del producto.
-	 * @return double Precio actual.
+	 * @return Dinero Precio actual.
 	 */
-	double 
+	Dinero 
 	getPrecio() const;
 	/**
 	* @brief Obtiene la cantidad disponible del producto.
@@ -66,11 +68,11 @@ public:
 	* @param nuevoPrecio Nuevo precio unitario.
 	*/
 	void 
-	setPrecio(double nuevoPrecio);
+	setPrecio(Dinero nuevoPrecio);
 
 private:
 	/**
-	 * @brief Cdigo nico que identifica al producto.
+	 * @brief Código único que identifica al producto.
 	 */
 	std::string codigo;
 	/**
@@ -80,9 +82,16 @@ private:
 	/**
 	* @brief Precio unitario del producto.
 	*/
-	double precio;
+	Dinero precio;
 	/**
 	* @brief Cantidad disponible en el inventario.
 	*/
 	int cantidad;
-};
\ No newline at end of file
+};
+
+/**
+ * @brief Serializa un producto como en `Productos.json` (id, nombre, precio, cantidad).
+ *
+ * Lo usan el guardado del inventario y la API HTTP; `json j = producto;` lo llama.
+ */
+void to_json(nlohmann::json& j, const Producto& p);
\ No newline at end of file
@@ -0,0 +1,186 @@
+﻿#pragma once
+#include <cstddef>
+#include <new>
+#include <utility>
+
+/**
+ * @file VectorPequeno.h
+ * @brief Vector con almacenamiento interno para los primeros N elementos.
+ *
+ * Mientras el número de elementos no pase de N, no se pide memoria dinámica: los
+ * elementos viven dentro del propio objeto. Al rebasar N, se mudan a un arreglo
+ * en el heap que crece al doble, igual que `std::vector`.
+ *
+ * Se usa para listas que casi siempre son cortas, como los pagos de una venta.
+ *
+ * @date 2026-10-19
+ * @version 1.0
+ * @author Ari
+ */
+
+ /**
+  * @class VectorPequeno
+  * @brief Contenedor secuencial con N elementos en línea.
+  *
+  * @tparam T Tipo de elemento.
+  * @tparam N Elementos que caben sin memoria dinámica.
+  */
+template <typename T, size_t N>
+class
+VectorPequeno {
+private:
+
+    /// Almacenamiento en línea para los primeros N elementos.
+    alignas(T) unsigned char enLinea[N * sizeof(T)];
+
+    /// Inicio de los elementos (apunta a `enLinea` o al heap).
+    T* datos;
+
+    /// Número de elementos.
+    size_t tam = 0;
+
+    /// Capacidad actual.
+    size_t capacidad = N;
+
+    /**
+     * @brief Indica si los elementos están en el almacenamiento en línea.
+     * @return true si no se usa el heap.
+     */
+    bool esEnLinea() const { return datos == reinterpret_cast<const T*>(enLinea); }
+
+    /**
+     * @brief Muda los elementos a un arreglo más grande en el heap.
+     *
+     * @param nueva Nueva capacidad.
+     */
+    void crecer(size_t nueva) {
+        T* nuevos = static_cast<T*>(::operator new(nueva * sizeof(T)));
+        for (size_t i = 0; i < tam; i++) {
+            new (nuevos + i) T(std::move(datos[i]));
+            datos[i].~T();
+        }
+        if (!esEnLinea()) {
+            ::operator delete(datos);
+        }
+        datos = nuevos;
+        capacidad = nueva;
+    }
+
+    /**
+     * @brief Toma los elementos de otro vector, dejándolo vacío.
+     *
+     * @param otro Vector de origen.
+     */
+    void tomarDe(VectorPequeno& otro) {
+        if (otro.esEnLinea()) {
+            for (size_t i = 0; i < otro.tam; i++) {
+                new (datos + i) T(std::move(otro.datos[i]));
+            }
+            tam = otro.tam;
+            otro.clear();
+        }
+        else {
+            datos = otro.datos;
+            tam = otro.tam;
+            capacidad = otro.capacidad;
+            otro.datos = reinterpret_cast<T*>(otro.enLinea);
+            otro.tam = 0;
+            otro.capacidad = N;
+        }
+    }
+
+    /**
+     * @brief Destruye los elementos y libera el heap.
+     */
+    void liberar() {
+        clear();
+        if (!esEnLinea()) {
+            ::operator delete(datos);
+            datos = reinterpret_cast<T*>(enLinea);
+            capacidad = N;
+        }
+    }
+
+public:
+
+    VectorPequeno() : datos(reinterpret_cast<T*>(enLinea)) {}
+
+    VectorPequeno(const VectorPequeno& otro) : datos(reinterpret_cast<T*>(enLinea)) {
+        for (const T& v : otro) {
+            push_back(v);
+        }
+    }
+
+    VectorPequeno(VectorPequeno&& otro) noexcept : datos(reinterpret_cast<T*>(enLinea)) {
+        tomarDe(otro);
+    }
+
+    VectorPequeno& operator=(const VectorPequeno& otro) {
+        if (this != &otro) {
+            clear();
+            for (const T& v : otro) {
+                push_back(v);
+            }
+        }
+        return *this;
+    }
+
+    VectorPequeno& operator=(VectorPequeno&& otro) noexcept {
+        if (this != &otro) {
+            liberar();
+            tomarDe(otro);
+        }
+        return *this;
+    }
+
+    ~VectorPequeno() { liberar(); }
+
+    /**
+     * @brief Construye un elemento al final.
+     *
+     * @param args Argumentos del constructor de T.
+     * @return T& Elemento agregado.
+     */
+    template <typename... Args>
+    T& emplace_back(Args&&... args) {
+        if (tam == capacidad) {
+            crecer(capacidad * 2);
+        }
+        T* nuevo = new (datos + tam) T(std::forward<Args>(args)...);
+        tam++;
+        return *nuevo;
+    }
+
+    void push_back(const T& valor) { emplace_back(valor); }
+    void push_back(T&& valor) { emplace_back(std::move(valor)); }
+
+    /**
+     * @brief Destruye todos los elementos (conserva la capacidad).
+     */
+    void clear() {
+        for (size_t i = 0; i < tam; i++) {
+            datos[i].~T();
+        }
+        tam = 0;
+    }
+
+    size_t size() const { return tam; }
+    bool empty() const { return tam == 0; }
+
+    /**
+     * @brief Indica si los elementos ya se mudaron al heap.
+     * @return true si se rebasó la capacidad en línea.
+     */
+    bool usaHeap() const { return !esEnLinea(); }
+
+    T& operator[](size_t i) { return datos[i]; }
+    const T& operator[](size_t i) const { return datos[i]; }
+
+    T& back() { return datos[tam - 1]; }
+    const T& back() const { return datos[tam - 1]; }
+
+    T* begin() { return datos; }
+    T* end() { return datos + tam; }
+    const T* begin() const { return datos; }
+    const T* end() const { return datos + tam; }
+};
@@ -33,6 +33,6 @@ public:
     * ejecuta automáticamente cuando el sujeto invoca `notificar()`.
     */
     void actualizar(const std::string& mensaje) override {
-        std::cout << "⚠ ALERTA: " << mensaje << std::endl;
+        std::cout << "⚠ ALERTA: " << mensaje << "\n";
     }
 };
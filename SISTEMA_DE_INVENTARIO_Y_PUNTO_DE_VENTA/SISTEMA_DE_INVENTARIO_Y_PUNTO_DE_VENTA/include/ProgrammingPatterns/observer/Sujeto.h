@@ -6,11 +6,11 @@
 
 /**
  * @file Sujeto.h
- * @brief Interfaz del Sujeto para el patrn Observer.
+ * @brief Interfaz del Sujeto para el patrón Observer.
  *
  * Esta clase define la interfaz que deben implementar todos los objetos
  * capaces de notificar a observadores cuando ocurre un evento relevante.
- * Forma parte del patrn de diseo **Observer**, donde un "Sujeto" mantiene
+ * Forma parte del patrón de diseño **Observer**, donde un "Sujeto" mantiene
  * una lista de observadores y los notifica de cambios.
  */
 
@@ -20,8 +20,8 @@
   *
   * Las clases que hereden de esta interfaz deben proporcionar mecanismos
   * para registrar, eliminar y notificar observadores. Esto permite
-  * establecer un sistema de suscripcin donde los observadores reaccionan
-  * automticamente a cambios del sujeto.
+  * establecer un sistema de suscripción donde los observadores reaccionan
+  * automáticamente a cambios del sujeto.
   */
 class 
 Sujeto {
@@ -33,7 +33,7 @@ public:
    * @param obs Puntero al observador que desea recibir notificaciones.
    *
    * Agrega el observador a la lista interna del sujeto. Cada vez que ocurra
-   * un evento, el observador ser notificado mediante su mtodo `actualizar()`.
+   * un evento, el observador será notificado mediante su método `actualizar()`.
    */
     virtual void agregarObservador(Observador* obs) = 0;
 
@@ -52,7 +52,7 @@ public:
     *
     * @param mensaje Texto descriptivo del evento ocurrido.
     *
-    * Recorre la lista de observadores y llama su mtodo `actualizar()` con el
+    * Recorre la lista de observadores y llama su método `actualizar()` con el
     * mensaje correspondiente, permitiendo que reaccionen al cambio.
     */
     virtual void notificar(const std::string& mensaje) = 0;
@@ -4,10 +4,10 @@
 
 /**
  * @file Observador.h
- * @brief Interfaz base del patrn Observer.
+ * @brief Interfaz base del patrón Observer.
  *
  * Esta clase define la interfaz que deben implementar todos los observadores
- * dentro del patrn de diseo **Observer**. Un observador se suscribe a un
+ * dentro del patrón de diseño **Observer**. Un observador se suscribe a un
  * sujeto para recibir notificaciones cuando ocurre un evento relevante.
  */
 
@@ -15,8 +15,8 @@
   * @class Observador
   * @brief Interfaz abstracta para objetos que reciben notificaciones.
   *
-  * Las clases que hereden de esta interfaz deben implementar el mtodo
-  * `actualizar()`, el cual ser llamado por el sujeto cuando necesite comunicar
+  * Las clases que hereden de esta interfaz deben implementar el método
+  * `actualizar()`, el cual será llamado por el sujeto cuando necesite comunicar
   * un cambio o un evento. El mensaje es definido por el sujeto.
   */
 class 
@@ -24,12 +24,12 @@ Observador {
 public:
 
     /**
-     * @brief Mtodo que recibe un mensaje enviado por el sujeto.
+     * @brief Método que recibe un mensaje enviado por el sujeto.
      *
      * @param mensaje Texto informativo sobre el evento ocurrido.
      *
-     * Este mtodo debe ser implementado por todos los observadores concretos.
-     * El sujeto lo invoca automticamente cuando desea notificar cambios.
+     * Este método debe ser implementado por todos los observadores concretos.
+     * El sujeto lo invoca automáticamente cuando desea notificar cambios.
      */
     virtual void actualizar(const std::string& mensaje) = 0;
 };
@@ -0,0 +1,144 @@
+﻿#pragma once
+#include "ProgrammingPatterns/pagos/PasarelaPagos.h"
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <future>
+#include <thread>
+
+/**
+ * @file AutorizadorPagos.h
+ * @brief Capa asíncrona de autorización de pagos con tarjeta.
+ *
+ * La caja envía la solicitud y sigue atendiendo al siguiente cliente; varios hilos
+ * trabajadores hablan con la pasarela en paralelo, así que las autorizaciones se
+ * encadenan en lugar de esperar una por una.
+ *
+ * Los resultados se entregan como `std::future`. Cuando se registra una función de
+ * finalización, esta se ejecuta en el hilo de la caja dentro de `atenderCompletadas()`,
+ * de modo que puede tocar el inventario o el historial sin candados adicionales.
+ *
+ * @date 2026-10-19
+ * @version 1.0
+ * @author Ari
+ */
+
+ /**
+  * @class AutorizadorPagos
+  * @brief Cola de autorizaciones atendida por un grupo de hilos.
+  *
+  * Los pagos en efectivo no pasan por la pasarela: se aprueban de inmediato.
+  */
+class
+AutorizadorPagos {
+public:
+
+    /// Función que recibe el resultado de una autorización.
+    using Finalizacion = std::function<void(const ResultadoAutorizacion&)>;
+
+private:
+
+    /**
+     * @struct Trabajo
+     * @brief Solicitud en espera de un hilo trabajador.
+     */
+    struct Trabajo {
+        SolicitudAutorizacion solicitud;
+        std::promise<ResultadoAutorizacion> promesa;
+    };
+
+    /**
+     * @struct Pendiente
+     * @brief Autorización enviada cuya finalización aún no se ejecuta.
+     */
+    struct Pendiente {
+        std::future<ResultadoAutorizacion> futuro;
+        Finalizacion alCompletar;
+    };
+
+    /// Pasarela usada por los trabajadores.
+    PasarelaPagos& pasarela;
+
+    /// Hilos trabajadores.
+    std::vector<std::thread> hilos;
+
+    /// Solicitudes en espera de un trabajador.
+    std::deque<Trabajo> cola;
+
+    /// Protege la cola y la bandera de detención.
+    std::mutex mutexCola;
+
+    /// Despierta a los trabajadores cuando hay solicitudes.
+    std::condition_variable hayTrabajo;
+
+    /// Indica a los trabajadores que deben terminar.
+    bool detener = false;
+
+    /// Autorizaciones con finalización pendiente (solo las usa el hilo de la caja).
+    std::vector<Pendiente> pendientes;
+
+    /// Siguiente identificador de solicitud.
+    std::atomic<unsigned long long> siguienteId{ 1 };
+
+    /**
+     * @brief Ciclo de cada hilo trabajador.
+     */
+    void trabajar();
+
+public:
+
+    /**
+     * @brief Arranca los hilos trabajadores.
+     *
+     * @param pasarela Pasarela a la que se envían las autorizaciones.
+     * @param numeroHilos Autorizaciones que pueden estar en curso a la vez.
+     */
+    AutorizadorPagos(PasarelaPagos& pasarela, int numeroHilos);
+
+    /**
+     * @brief Espera a que terminen las autorizaciones en curso y detiene los hilos.
+     */
+    ~AutorizadorPagos();
+
+    AutorizadorPagos(const AutorizadorPagos&) = delete;
+    AutorizadorPagos& operator=(const AutorizadorPagos&) = delete;
+
+    /**
+     * @brief Envía una solicitud y devuelve el futuro con su resultado.
+     *
+     * @param solicitud Datos del cobro (el id se asigna aquí).
+     * @return std::future<ResultadoAutorizacion> Resultado cuando esté listo.
+     */
+    std::future<ResultadoAutorizacion> solicitar(SolicitudAutorizacion solicitud);
+
+    /**
+     * @brief Envía una solicitud y registra qué hacer cuando se resuelva.
+     *
+     * `alCompletar` se ejecuta en el hilo que llame a `atenderCompletadas()`.
+     *
+     * @param solicitud Datos del cobro.
+     * @param alCompletar Función a ejecutar con el resultado.
+     */
+    void solicitar(SolicitudAutorizacion solicitud, Finalizacion alCompletar);
+
+    /**
+     * @brief Ejecuta las finalizaciones de las autorizaciones ya resueltas.
+     *
+     * No bloquea: las que siguen en curso se quedan para la siguiente llamada.
+     *
+     * @return size_t Número de autorizaciones finalizadas.
+     */
+    size_t atenderCompletadas();
+
+    /**
+     * @brief Espera todas las autorizaciones pendientes y ejecuta sus finalizaciones.
+     */
+    void esperarTodas();
+
+    /**
+     * @brief Número de autorizaciones con finalización pendiente.
+     * @return size_t Pendientes.
+     */
+    size_t totalPendientes() const { return pendientes.size(); }
+};
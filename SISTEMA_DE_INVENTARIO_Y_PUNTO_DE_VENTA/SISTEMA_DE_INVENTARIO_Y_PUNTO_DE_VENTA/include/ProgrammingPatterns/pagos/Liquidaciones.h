@@ -0,0 +1,181 @@
+﻿#pragma once
+#include "Prerequisites.h"
+#include "ProgrammingPatterns/modelos/Dinero.h"
+#include "ProgrammingPatterns/pagos/MotorComisiones.h"
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <fstream>
+#include <mutex>
+#include <thread>
+
+/**
+ * @file Liquidaciones.h
+ * @brief Registro de liquidación por cobro y cierre del día por método de pago.
+ *
+ * Cada venta y cada carga de combustible deja un registro compacto de tamaño fijo
+ * (método, bruto, comisión, neto y hora) en un diario binario de solo agregado.
+ * La caja solo lo agrega en memoria; un hilo escritor pasa los registros nuevos al
+ * diario en lotes, a lo más cada `kIntervaloEscritura`. Al cierre, `cerrarDia()` reparte los registros del día entre varios hilos, cada
+ * uno acumula totales y arma sus renglones en memoria, y al final se escribe un
+ * archivo de liquidación por método de pago con una sola escritura.
+ *
+ * @date 2026-10-19
+ * @version 1.0
+ * @author Ari
+ */
+
+ /**
+  * @struct RegistroLiquidacion
+  * @brief Registro de liquidación de un cobro, en centavos.
+  *
+  * Bruto es lo que se cobró al cliente, comisión lo que retiene el procesador y
+  * neto lo que recibe el negocio (bruto - comisión).
+  *
+  * Se escribe tal cual en el diario, así que no tiene huecos de alineación: el
+  * relleno es explícito y siempre vale cero.
+  */
+struct
+RegistroLiquidacion {
+    std::int64_t fecha = 0;
+    std::int64_t brutoCentavos = 0;
+    std::int64_t comisionCentavos = 0;
+    std::int64_t netoCentavos = 0;
+    std::uint8_t tipo = 0;
+    std::uint8_t marca = 0;
+    std::uint8_t relleno[6] = {};
+};
+
+static_assert(sizeof(RegistroLiquidacion) == 40, "RegistroLiquidacion no debe tener huecos de alineacion");
+
+/**
+ * @struct TotalesLiquidacion
+ * @brief Totales acumulados de un método de pago.
+ */
+struct
+TotalesLiquidacion {
+    long long operaciones = 0;
+    long long brutoCentavos = 0;
+    long long comisionCentavos = 0;
+    long long netoCentavos = 0;
+};
+
+/**
+ * @class RegistroLiquidaciones
+ * @brief Diario de liquidaciones del sistema y generador del cierre del día.
+ *
+ * Existe una instancia compartida (`instancia()`) que usan la fachada de ventas y
+ * la gasolinera. `registrar()` puede llamarse desde varios hilos.
+ */
+class
+RegistroLiquidaciones {
+public:
+
+    /// Tiempo máximo que un registro espera en memoria antes de ir al diario.
+    static constexpr std::chrono::milliseconds kIntervaloEscritura{ 100 };
+
+private:
+
+    /// Registros en memoria (incluye los leídos del diario).
+    std::vector<RegistroLiquidacion> registros;
+
+    /// true mientras los registros estén en orden de fecha (el cierre busca el día por bisección).
+    bool ordenados = true;
+
+    /// Registros que el hilo escritor todavía no pasa al diario.
+    std::vector<RegistroLiquidacion> pendientes;
+
+    /// Diario binario abierto para agregar (solo lo usa el hilo escritor).
+    std::ofstream diario;
+
+    /// Protege registros, pendientes y banderas.
+    mutable std::mutex mutexRegistros;
+
+    /// Avisa al escritor que debe terminar.
+    std::condition_variable avisoEscritor;
+
+    /// Hilo escritor del diario.
+    std::thread hilo;
+
+    /// Indica al escritor que escriba lo pendiente y termine.
+    bool detenerSolicitado = false;
+
+    /**
+     * @brief Ciclo del hilo escritor.
+     */
+    void escribir();
+
+public:
+
+    RegistroLiquidaciones() = default;
+
+    /**
+     * @brief Escribe lo pendiente y detiene el hilo.
+     */
+    ~RegistroLiquidaciones();
+
+    RegistroLiquidaciones(const RegistroLiquidaciones&) = delete;
+    RegistroLiquidaciones& operator=(const RegistroLiquidaciones&) = delete;
+
+    /**
+     * @brief Instancia compartida del sistema.
+     * @return RegistroLiquidaciones& Diario de liquidaciones.
+     */
+    static RegistroLiquidaciones& instancia();
+
+    /**
+     * @brief Lee los registros del diario, lo deja abierto para agregar y arranca el escritor.
+     *
+     * Si el último registro quedó a medias (el programa se cerró mientras se
+     * escribía), se descarta y el archivo se recorta antes de agregar.
+     *
+     * @param archivo Ruta del diario binario.
+     */
+    void abrir(const std::string& archivo);
+
+    /**
+     * @brief Escribe los registros pendientes en el diario y detiene el escritor.
+     *
+     * Los registros posteriores solo quedan en memoria.
+     */
+    void detener();
+
+    /**
+     * @brief Agrega el registro de un cobro.
+     *
+     * @param tipo Método de pago.
+     * @param marca Marca de tarjeta.
+     * @param bruto Monto cobrado al cliente.
+     * @param comision Comisión del cobro.
+     */
+    void registrar(TipoPago tipo, MarcaTarjeta marca, Dinero bruto, Dinero comision);
+
+    /**
+     * @brief Agrega un registro ya armado (hora incluida).
+     *
+     * Solo copia memoria; el diario lo escribe el hilo escritor.
+     *
+     * @param registro Registro de liquidación.
+     */
+    void registrar(const RegistroLiquidacion& registro);
+
+    /**
+     * @brief Número de registros acumulados.
+     * @return size_t Registros.
+     */
+    size_t totalRegistros() const;
+
+    /**
+     * @brief Genera los archivos de liquidación de un día.
+     *
+     * Crea `Liquidacion_AAAA-MM-DD_<Metodo>.csv` por cada método con operaciones
+     * y muestra el resumen en consola.
+     *
+     * @param dia Cualquier instante del día a liquidar.
+     * @param directorio Carpeta destino (vacío = carpeta actual).
+     * @param totales Salida opcional: totales por método (índice = TipoPago).
+     * @return size_t Registros liquidados.
+     */
+    size_t cerrarDia(time_t dia, const std::string& directorio = "",
+        TotalesLiquidacion* totales = nullptr) const;
+};
@@ -0,0 +1,160 @@
+﻿#pragma once
+#include "Prerequisites.h"
+#include "ProgrammingPatterns/modelos/Dinero.h"
+#include "ProgrammingPatterns/strategy/MetodoPago.h"
+
+/**
+ * @file MotorComisiones.h
+ * @brief Motor de comisiones y recargos por método de pago, basado en una tabla.
+ *
+ * Las reglas (porcentaje, cuota fija, mínimo y tope) se leen de un archivo JSON y se
+ * compilan en una tabla plana indexada por tipo de pago y marca de tarjeta. Cambiar
+ * una comisión es cambiar datos, no código.
+ *
+ * Cada consulta es un índice en la tabla y aritmética entera, sin buscar reglas
+ * de respaldo ni llamadas virtuales. La comisión queda guardada en el registro de
+ * liquidación de cada cobro, así que el cierre del día no la vuelve a calcular.
+ *
+ * @date 2026-10-19
+ * @version 1.0
+ * @author Ari
+ */
+
+ /**
+  * @enum MarcaTarjeta
+  * @brief Marca de la tarjeta; `Generica` aplica cuando no hay regla específica.
+  */
+enum class MarcaTarjeta {
+    Generica,
+    Visa,
+    Mastercard,
+    Amex
+};
+
+/**
+ * @brief Convierte una marca de tarjeta a texto.
+ *
+ * @param marca Marca de tarjeta.
+ * @return const char* Nombre de la marca.
+ */
+inline const char* marcaTarjetaToString(MarcaTarjeta marca) {
+    switch (marca) {
+    case MarcaTarjeta::Visa: return "Visa";
+    case MarcaTarjeta::Mastercard: return "Mastercard";
+    case MarcaTarjeta::Amex: return "Amex";
+    default: return "Generica";
+    }
+}
+
+/**
+ * @struct ReglaComision
+ * @brief Regla compilada: comisión = porcentaje + cuota fija, acotada por mínimo y tope.
+ *
+ * Todos los valores son enteros (puntos base y centavos) para que el cálculo sea exacto.
+ * Un tope de 0 significa "sin tope".
+ */
+struct
+ReglaComision {
+    long long puntosBase = 0;
+    long long cuotaFijaCentavos = 0;
+    long long minimoCentavos = 0;
+    long long topeCentavos = 0;
+};
+
+/**
+ * @class MotorComisiones
+ * @brief Tabla de comisiones por tipo de pago y marca.
+ *
+ * Existe una instancia compartida por todo el sistema (`instancia()`), que usan las
+ * estrategias de pago. Sin configuración, reproduce la regla histórica: 5% en crédito
+ * y sin comisión en efectivo y débito.
+ *
+ * La configuración debe cargarse al iniciar, antes de procesar pagos; las consultas
+ * solo leen la tabla.
+ */
+class
+MotorComisiones {
+public:
+
+    /// Número de tipos de pago con regla (Efectivo, Debito, Credito, Otro).
+    static constexpr int kTipos = 4;
+
+    /// Número de marcas de tarjeta.
+    static constexpr int kMarcas = 4;
+
+private:
+
+    /// Tabla plana [tipo * kMarcas + marca] con las reglas ya resueltas.
+    ReglaComision tabla[kTipos * kMarcas];
+
+    /**
+     * @brief Calcula la comisión de un monto con una regla.
+     *
+     * @param regla Regla compilada.
+     * @param centavos Monto base en centavos.
+     * @return long long Comisión en centavos.
+     */
+    static long long aplicarRegla(const ReglaComision& regla, long long centavos) {
+        long long c = (centavos * regla.puntosBase + 5000) / 10000 + regla.cuotaFijaCentavos;
+        c = c < regla.minimoCentavos ? regla.minimoCentavos : c;
+        long long tope = regla.topeCentavos > 0 ? regla.topeCentavos : c;
+        return c > tope ? tope : c;
+    }
+
+public:
+
+    /**
+     * @brief Construye el motor con las reglas por defecto.
+     */
+    MotorComisiones();
+
+    /**
+     * @brief Instancia compartida que usan las estrategias de pago.
+     * @return MotorComisiones& Motor del sistema.
+     */
+    static MotorComisiones& instancia();
+
+    /**
+     * @brief Restablece la regla histórica (5% crédito, 0% en lo demás).
+     */
+    void reglasPorDefecto();
+
+    /**
+     * @brief Carga reglas desde JSON y las compila en la tabla.
+     *
+     * Formato: `{"reglas": [{"tipo": "Credito", "marca": "Visa", "porcentaje": 3.5,
+     * "cuotaFija": 2.0, "minimo": 5.0, "tope": 0}]}`. Una regla sin marca (o con
+     * "Generica") aplica a todas las marcas de ese tipo que no tengan regla propia.
+     *
+     * @param archivo Ruta del archivo JSON.
+     */
+    void cargarJson(const std::string& archivo);
+
+    /**
+     * @brief Obtiene la regla compilada para un tipo y marca.
+     *
+     * @param tipo Tipo de pago.
+     * @param marca Marca de tarjeta.
+     * @return const ReglaComision& Regla aplicable.
+     */
+    const ReglaComision& regla(TipoPago tipo, MarcaTarjeta marca) const {
+        return tabla[static_cast<int>(tipo) * kMarcas + static_cast<int>(marca)];
+    }
+
+    /**
+     * @brief Calcula la comisión de un pago.
+     *
+     * @param tipo Tipo de pago.
+     * @param marca Marca de tarjeta.
+     * @param monto Monto base.
+     * @return Dinero Comisión a cobrar.
+     */
+    Dinero comision(TipoPago tipo, MarcaTarjeta marca, Dinero monto) const {
+        return Dinero::desdeCentavos(aplicarRegla(regla(tipo, marca), monto.getCentavos()));
+    }
+
+    /**
+     * @brief Muestra la tabla de comisiones en consola.
+     */
+    void mostrar() const;
+};
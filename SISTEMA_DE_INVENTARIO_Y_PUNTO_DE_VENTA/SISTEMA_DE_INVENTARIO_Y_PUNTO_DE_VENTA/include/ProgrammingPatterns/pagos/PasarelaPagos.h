@@ -0,0 +1,140 @@
+﻿#pragma once
+#include "Prerequisites.h"
+#include "ProgrammingPatterns/modelos/Dinero.h"
+#include "ProgrammingPatterns/pagos/MotorComisiones.h"
+#include <algorithm>
+#include <chrono>
+#include <mutex>
+#include <random>
+#include <thread>
+
+/**
+ * @file PasarelaPagos.h
+ * @brief Interfaz de la pasarela de autorización de tarjetas y su simulación local.
+ *
+ * Una autorización real tarda cientos de milisegundos. La interfaz `PasarelaPagos`
+ * se llama desde los hilos del `AutorizadorPagos`, nunca desde la caja, así que una
+ * implementación puede bloquear mientras espera la respuesta.
+ *
+ * @date 2026-10-19
+ * @version 1.0
+ * @author Ari
+ */
+
+ /**
+  * @struct SolicitudAutorizacion
+  * @brief Datos que se envían a la pasarela para autorizar un cobro.
+  */
+struct
+SolicitudAutorizacion {
+    unsigned long long id = 0;
+    TipoPago tipo = TipoPago::Otro;
+    MarcaTarjeta marca = MarcaTarjeta::Generica;
+    Dinero monto;
+};
+
+/**
+ * @struct ResultadoAutorizacion
+ * @brief Respuesta de la pasarela.
+ */
+struct
+ResultadoAutorizacion {
+    unsigned long long id = 0;
+    bool aprobada = false;
+    std::string codigo;
+    std::string motivo;
+};
+
+/**
+ * @class PasarelaPagos
+ * @brief Interfaz de una pasarela de pagos (banco o procesador de tarjetas).
+ */
+class
+PasarelaPagos {
+public:
+    virtual ~PasarelaPagos() = default;
+
+    /**
+     * @brief Autoriza un cobro. Puede bloquear mientras llega la respuesta.
+     *
+     * Se invoca desde varios hilos a la vez, por lo que debe ser segura para
+     * llamadas concurrentes.
+     *
+     * @param solicitud Datos del cobro.
+     * @return ResultadoAutorizacion Aprobación o rechazo.
+     */
+    virtual ResultadoAutorizacion autorizar(const SolicitudAutorizacion& solicitud) = 0;
+};
+
+/**
+ * @class PasarelaSimulada
+ * @brief Pasarela local que simula la latencia y los rechazos de un banco.
+ *
+ * Cada autorización espera `latenciaMs` ± `variacionMs` y se rechaza con
+ * probabilidad `tasaRechazo`. Sirve para probar la caja sin servicios externos.
+ */
+class
+PasarelaSimulada : public PasarelaPagos {
+private:
+
+    /// Latencia media en milisegundos.
+    int latenciaMs;
+
+    /// Variación máxima de la latencia en milisegundos.
+    int variacionMs;
+
+    /// Probabilidad de rechazo (0.0 a 1.0).
+    double tasaRechazo;
+
+    /// Generador aleatorio compartido por los hilos.
+    std::mt19937 generador;
+
+    /// Protege al generador aleatorio.
+    std::mutex mutexGenerador;
+
+public:
+
+    /**
+     * @brief Constructor de la pasarela simulada.
+     *
+     * @param latenciaMs Latencia media de cada autorización.
+     * @param variacionMs Variación aleatoria de la latencia.
+     * @param tasaRechazo Probabilidad de rechazo.
+     */
+    PasarelaSimulada(int latenciaMs, int variacionMs, double tasaRechazo)
+        : latenciaMs(latenciaMs), variacionMs(variacionMs), tasaRechazo(tasaRechazo),
+          generador(std::random_device{}()) {}
+
+    /**
+     * @brief Simula la autorización: espera la latencia y decide el resultado.
+     *
+     * @param solicitud Datos del cobro.
+     * @return ResultadoAutorizacion Aprobación con código, o rechazo con motivo.
+     */
+    ResultadoAutorizacion autorizar(const SolicitudAutorizacion& solicitud) override {
+        int espera;
+        bool rechazar;
+        unsigned int codigo;
+        {
+            std::lock_guard<std::mutex> lock(mutexGenerador);
+            std::uniform_int_distribution<int> variacion(-variacionMs, variacionMs);
+            std::uniform_real_distribution<double> azar(0.0, 1.0);
+            espera = std::max(0, latenciaMs + variacion(generador));
+            rechazar = azar(generador) < tasaRechazo;
+            codigo = std::uniform_int_distribution<unsigned int>(100000, 999999)(generador);
+        }
+
+        std::this_thread::sleep_for(std::chrono::milliseconds(espera));
+
+        ResultadoAutorizacion resultado;
+        resultado.id = solicitud.id;
+        resultado.aprobada = !rechazar;
+        if (rechazar) {
+            resultado.motivo = "Fondos insuficientes";
+        }
+        else {
+            resultado.codigo = std::to_string(codigo);
+        }
+        return resultado;
+    }
+};
@@ -0,0 +1,72 @@
+﻿#pragma once
+#include <cstdint>
+#include <string>
+
+/**
+ * @file DiarioInventario.h
+ * @brief Movimientos del inventario y la interfaz que los recibe.
+ *
+ * Cada operación que cambia el inventario (venta, reposición, cambio de precio,
+ * alta de producto) recibe un número de secuencia consecutivo. Un diario
+ * conectado con `Inventario::setDiario` recibe los movimientos en ese orden;
+ * así el servidor líder los envía a sus réplicas (ver `LiderReplicacion`).
+ *
+ * Cada movimiento lleva el estado resultante del producto (stock, precio), no
+ * solo la diferencia, para que aplicarlo dos veces no cambie nada.
+ *
+ * @date 2026-10-19
+ * @version 1.0
+ * @author Ari
+ */
+
+ /**
+  * @struct MovimientoInventario
+  * @brief Un cambio del inventario.
+  */
+struct
+MovimientoInventario {
+
+    /// Qué operación lo produjo.
+    enum class Tipo : std::uint8_t {
+        Alta = 1,
+        Venta = 2,
+        Compra = 3,
+        Precio = 4
+    };
+
+    Tipo tipo = Tipo::Alta;
+
+    /// Número de secuencia en el inventario que lo produjo.
+    std::uint64_t secuencia = 0;
+
+    std::string codigo;
+
+    /// Nombre del producto (solo en las altas).
+    std::string nombre;
+
+    /// Unidades vendidas o compradas (0 en altas y cambios de precio).
+    std::int32_t cantidad = 0;
+
+    /// Existencia después del movimiento.
+    std::int32_t stock = 0;
+
+    /// Precio unitario después del movimiento, en centavos.
+    std::int64_t centavos = 0;
+};
+
+/**
+ * @class DiarioInventario
+ * @brief Recibe los movimientos del inventario en orden.
+ */
+class
+DiarioInventario {
+public:
+    virtual ~DiarioInventario() = default;
+
+    /**
+     * @brief Se llama después de aplicar cada movimiento, en el hilo que lo aplicó.
+     *
+     * @param movimiento Movimiento ya aplicado.
+     */
+    virtual void registrar(const MovimientoInventario& movimiento) = 0;
+};
@@ -0,0 +1,171 @@
+﻿#pragma once
+#include "ProgrammingPatterns/replicacion/DiarioInventario.h"
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+class Inventario;
+
+/**
+ * @file LiderReplicacion.h
+ * @brief Lado líder de la replicación del inventario.
+ *
+ * El líder guarda en memoria los últimos movimientos del inventario ya
+ * codificados y los copia al búfer de salida de cada réplica conectada; el
+ * `ServidorPOS` los envía al final de cada vuelta de su ciclo de eventos, así
+ * una ráfaga de ventas sale en un solo envío.
+ *
+ * Cuando una réplica se conecta dice qué época y secuencia tiene. Si los
+ * movimientos que le faltan siguen en el diario recibe solo esos (la cola);
+ * si no, recibe una foto completa del inventario y después los movimientos
+ * nuevos.
+ *
+ * La foto no se codifica de una vez: con 1M de productos pasaría del tope de
+ * salida de la réplica. Un cursor sobre los productos se rellena a medida
+ * que el socket se vacía (`continuarFoto`), y cada producto sale con su
+ * estado en ese momento. Al terminar se envía la cola del diario desde la
+ * secuencia en que empezó la foto; como cada movimiento trae el estado
+ * resultante, aplicarla encima deja la réplica igual que el líder. Si esa
+ * cola ya se recortó del diario, la foto vuelve a empezar.
+ *
+ * Todo se llama desde el hilo del ciclo de eventos, igual que el inventario.
+ *
+ * @date 2026-10-19
+ * @version 1.0
+ * @author Ari
+ */
+
+ /**
+  * @class LiderReplicacion
+  * @brief Diario del inventario que se envía a las réplicas.
+  */
+class
+LiderReplicacion : public DiarioInventario {
+public:
+
+    /// Movimientos que se guardan para que una réplica se ponga al día sin foto.
+    static constexpr size_t kMaxDiario = 1 << 18;
+
+    /**
+     * @struct Estadisticas
+     * @brief Contadores del líder.
+     */
+    struct Estadisticas {
+        unsigned long long movimientos = 0;
+        unsigned long long fotos = 0;
+        unsigned long long colas = 0;
+    };
+
+private:
+
+    Inventario& inventario;
+    std::uint64_t epoca;
+
+    /// Movimientos codificados y dónde empieza cada uno.
+    std::string diario;
+    std::vector<size_t> inicios;
+
+    /// Secuencia del primer movimiento guardado en `diario`.
+    std::uint64_t primeraSecuencia = 0;
+
+    /**
+     * @struct FotoEnCurso
+     * @brief Foto que todavía se está enviando a una réplica.
+     */
+    struct FotoEnCurso {
+        std::string* salida = nullptr;
+
+        /// Secuencia del inventario cuando empezó la foto.
+        std::uint64_t secuencia = 0;
+
+        /// Siguiente producto por enviar y cuántos anunció `InicioFoto`.
+        size_t siguiente = 0;
+        size_t total = 0;
+
+        std::int64_t marcaUs = 0;
+    };
+
+    /// Búferes de salida de las réplicas que ya reciben los movimientos nuevos.
+    std::vector<std::string*> seguidores;
+
+    /// Réplicas que aún reciben su foto (no están en `seguidores`).
+    std::vector<FotoEnCurso> fotos;
+
+    Estadisticas estadisticas;
+
+    /// Descarta la mitad más vieja del diario.
+    void recortarDiario();
+
+    /// Escribe `InicioFoto` y pone el cursor en el primer producto.
+    void empezarFoto(FotoEnCurso& foto);
+
+    FotoEnCurso* buscarFoto(const std::string& salida);
+
+public:
+
+    /**
+     * @brief Se conecta como diario del inventario.
+     *
+     * @param inventario Inventario que se replica.
+     */
+    explicit LiderReplicacion(Inventario& inventario);
+
+    /// Se desconecta del inventario.
+    ~LiderReplicacion() override;
+
+    LiderReplicacion(const LiderReplicacion&) = delete;
+    LiderReplicacion& operator=(const LiderReplicacion&) = delete;
+
+    void registrar(const MovimientoInventario& movimiento) override;
+
+    /**
+     * @brief Atiende el saludo de una réplica y le escribe la cola o el inicio de la foto.
+     *
+     * Con la cola, a partir de aquí `salida` recibe cada movimiento nuevo
+     * hasta que se llame a `quitarSeguidor`. Con la foto, los recibe después
+     * de que `continuarFoto` la termine.
+     *
+     * @param datos Bytes recibidos de la réplica.
+     * @param n Número de bytes.
+     * @param salida Búfer de salida de la conexión.
+     * @return size_t Bytes consumidos; 0 si el saludo aún no está completo o
+     * `ProtocoloReplicacion::kMensajeInvalido`.
+     */
+    size_t atenderSeguidor(const char* datos, size_t n, std::string& salida);
+
+    /**
+     * @brief Agrega a la foto en curso de la réplica hasta unos `bytes` más.
+     *
+     * Con el último producto escribe el fin de la foto y la cola del diario, y
+     * la réplica pasa a recibir los movimientos nuevos.
+     *
+     * @param salida Búfer de salida de la conexión.
+     * @param bytes Bytes que se pueden agregar (se pasa a lo más por un producto).
+     */
+    void continuarFoto(std::string& salida, size_t bytes);
+
+    /**
+     * @brief true si la réplica de ese búfer aún recibe su foto.
+     */
+    bool enviandoFoto(const std::string& salida) const;
+
+    /**
+     * @brief Deja de copiar movimientos a una réplica que se desconectó.
+     */
+    void quitarSeguidor(std::string& salida);
+
+    /**
+     * @brief Escribe un latido (secuencia actual y hora) a todas las réplicas.
+     */
+    void latido();
+
+    std::uint64_t getEpoca() const { return epoca; }
+
+    size_t totalSeguidores() const { return seguidores.size(); }
+
+    /// Movimientos guardados en el diario.
+    size_t totalDiario() const { return inicios.size(); }
+
+    const Estadisticas& getEstadisticas() const { return estadisticas; }
+};
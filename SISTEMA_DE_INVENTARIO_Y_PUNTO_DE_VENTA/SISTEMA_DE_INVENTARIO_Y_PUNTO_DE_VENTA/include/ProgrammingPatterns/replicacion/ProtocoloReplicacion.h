@@ -0,0 +1,89 @@
+﻿#pragma once
+#include "ProgrammingPatterns/replicacion/DiarioInventario.h"
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+/**
+ * @file ProtocoloReplicacion.h
+ * @brief Mensajes entre el servidor líder y sus réplicas.
+ *
+ * Mismo formato que `Protocolo.h`: un largo u32 al inicio y enteros en
+ * little-endian. Después del largo va un byte con el `TipoMensaje`.
+ *
+ * | Mensaje     | Sentido          | Campos                                                     |
+ * |-------------|------------------|------------------------------------------------------------|
+ * | Hola        | réplica → líder  | época u64, secuencia u64 (lo que ya tiene la réplica)      |
+ * | InicioFoto  | líder → réplica  | época u64, secuencia u64, productos u64                    |
+ * | Movimiento  | líder → réplica  | tipo u8, secuencia u64, marca i64, cantidad i32, stock i32, centavos i64, largos u16+u16, código, nombre |
+ * | FinFoto     | líder → réplica  | secuencia u64                                              |
+ * | Latido      | líder → réplica  | secuencia u64, marca i64                                   |
+ *
+ * La época identifica una ejecución del líder: las secuencias de otra
+ * ejecución no sirven para ponerse al día y la réplica recibe una foto
+ * completa. La marca son microsegundos del reloj del sistema cuando el líder
+ * registró el movimiento; con ella la réplica mide su retraso.
+ *
+ * @date 2026-10-19
+ * @version 1.0
+ * @author Ari
+ */
+
+ /**
+  * @struct MensajeReplicacion
+  * @brief Un mensaje ya leído (solo los campos de su tipo tienen sentido).
+  */
+struct
+MensajeReplicacion {
+
+    enum class Tipo : std::uint8_t {
+        Hola = 1,
+        InicioFoto = 2,
+        Movimiento = 3,
+        FinFoto = 4,
+        Latido = 5
+    };
+
+    Tipo tipo = Tipo::Hola;
+    std::uint64_t epoca = 0;
+    std::uint64_t secuencia = 0;
+    std::uint64_t productos = 0;
+    std::int64_t marcaUs = 0;
+    MovimientoInventario movimiento;
+};
+
+/**
+ * @class ProtocoloReplicacion
+ * @brief Escritura y lectura de los mensajes de replicación.
+ */
+class
+ProtocoloReplicacion {
+public:
+
+    /// Resultado de `leer` cuando el mensaje no es válido (la conexión debe cerrarse).
+    static constexpr size_t kMensajeInvalido = static_cast<size_t>(-1);
+
+    /// Microsegundos del reloj del sistema (para las marcas).
+    static std::int64_t ahoraUs();
+
+    static void escribirHola(std::uint64_t epoca, std::uint64_t secuencia, std::string& destino);
+
+    static void escribirInicioFoto(std::uint64_t epoca, std::uint64_t secuencia, std::uint64_t productos, std::string& destino);
+
+    static void escribirMovimiento(const MovimientoInventario& movimiento, std::int64_t marcaUs, std::string& destino);
+
+    static void escribirFinFoto(std::uint64_t secuencia, std::string& destino);
+
+    static void escribirLatido(std::uint64_t secuencia, std::int64_t marcaUs, std::string& destino);
+
+    /**
+     * @brief Lee un mensaje del inicio de `datos`.
+     *
+     * @param datos Bytes recibidos.
+     * @param n Número de bytes.
+     * @param mensaje Salida.
+     * @return size_t Bytes consumidos; 0 si el mensaje aún no está completo o
+     * `kMensajeInvalido` si no es válido.
+     */
+    static size_t leer(const char* datos, size_t n, MensajeReplicacion& mensaje);
+};
@@ -0,0 +1,124 @@
+﻿#pragma once
+#include "ProgrammingPatterns/replicacion/DiarioInventario.h"
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+class Inventario;
+
+/**
+ * @file SeguidorReplicacion.h
+ * @brief Lado réplica de la replicación del inventario.
+ *
+ * La réplica aplica los movimientos del líder en orden sobre su propio
+ * `Inventario`, que solo se consulta (el `ServidorPOS` rechaza las operaciones
+ * de escritura mientras sigue a un líder).
+ *
+ * Una foto completa se junta aparte y se aplica de una vez al llegar su fin:
+ * mientras llega, las consultas siguen viendo el inventario anterior.
+ *
+ * El retraso de cada movimiento es la hora de aplicación menos la marca que le
+ * puso el líder (los dos procesos corren en la misma máquina).
+ *
+ * @date 2026-10-19
+ * @version 1.0
+ * @author Ari
+ */
+
+ /**
+  * @class SeguidorReplicacion
+  * @brief Aplica el flujo del líder y mide el retraso.
+  */
+class
+SeguidorReplicacion {
+public:
+
+    /// Retrasos recientes que se guardan para los percentiles.
+    static constexpr size_t kMuestras = 1 << 16;
+
+    /**
+     * @struct Estadisticas
+     * @brief Contadores de la réplica.
+     */
+    struct Estadisticas {
+        unsigned long long movimientos = 0;
+        unsigned long long fotos = 0;
+        unsigned long long conexiones = 0;
+
+        /// Última secuencia que anunció el líder.
+        std::uint64_t secuenciaLider = 0;
+
+        std::int64_t retrasoUltimoUs = 0;
+        std::int64_t retrasoMaximoUs = 0;
+        std::int64_t retrasoTotalUs = 0;
+    };
+
+private:
+
+    Inventario& inventario;
+
+    /// Época del líder de la que vienen los datos (0 = ninguna).
+    std::uint64_t epoca = 0;
+
+    /// Foto en curso: se aplica completa al recibir `FinFoto`.
+    bool recibiendoFoto = false;
+    std::uint64_t epocaFoto = 0;
+    std::vector<MovimientoInventario> foto;
+
+    /// Retrasos recientes (anillo).
+    std::vector<std::int64_t> muestras;
+    size_t siguienteMuestra = 0;
+
+    Estadisticas estadisticas;
+
+    void medir(std::int64_t marcaUs);
+
+public:
+
+    /**
+     * @param inventario Inventario que recibe los movimientos.
+     */
+    explicit SeguidorReplicacion(Inventario& inventario);
+
+    /**
+     * @brief Escribe el saludo con lo que ya tiene la réplica (al conectarse).
+     *
+     * @param salida Búfer de salida hacia el líder.
+     */
+    void saludar(std::string& salida);
+
+    /**
+     * @brief Aplica los mensajes completos de `datos`.
+     *
+     * @param datos Bytes recibidos del líder.
+     * @param n Número de bytes.
+     * @return size_t Bytes consumidos o `ProtocoloReplicacion::kMensajeInvalido`.
+     */
+    size_t procesar(const char* datos, size_t n);
+
+    /**
+     * @brief Movimientos que le faltan por aplicar según el último latido.
+     */
+    std::uint64_t atraso() const;
+
+    /**
+     * @brief Percentil del retraso de los movimientos recientes.
+     *
+     * @param p Percentil entre 0 y 100.
+     * @return std::int64_t Microsegundos (0 sin muestras).
+     */
+    std::int64_t percentilRetrasoUs(double p) const;
+
+    /**
+     * @brief Retraso promedio desde el arranque, en microsegundos.
+     */
+    std::int64_t retrasoPromedioUs() const;
+
+    /**
+     * @brief Suma una conexión con el líder (para las estadísticas).
+     */
+    void conectado() { estadisticas.conexiones++; }
+
+    const Estadisticas& getEstadisticas() const { return estadisticas; }
+};
@@ -0,0 +1,137 @@
+﻿#pragma once
+#include "ProgrammingPatterns/modelos/Dinero.h"
+#include <memory>
+#include <ostream>
+#include <string>
+#include <string_view>
+#include <vector>
+
+class Producto;
+struct CargaGasolina;
+
+/**
+ * @file ReporteConsola.h
+ * @brief Listados grandes (catálogo, historial de cargas) en tablas con búfer.
+ *
+ * Las filas se formatean en un búfer de 256 KB que se escribe al flujo de una
+ * sola vez cuando se llena, en lugar de un `<<` por campo. Los anchos de las
+ * columnas se calculan una vez por página, y se puede filtrar y paginar.
+ *
+ * @date 2026-10-19
+ * @version 1.0
+ * @author Ari
+ */
+
+ /**
+  * @struct FiltroReporte
+  * @brief Qué filas mostrar y qué página.
+  */
+struct
+FiltroReporte {
+    /// Subcadena a buscar (código o nombre del producto; tipo de combustible). Vacía = todas.
+    std::string texto;
+
+    /// Solo productos con stock menor o igual (-1 = sin límite).
+    int stockMaximo = -1;
+
+    /// Página a mostrar, desde 1.
+    size_t pagina = 1;
+
+    /// Filas por página (0 = todas en una página).
+    size_t filasPorPagina = 0;
+
+    /// Indica si el producto pasa el filtro de texto y stock.
+    bool admite(const Producto& producto) const;
+
+    /// Indica si la carga pasa el filtro de tipo de combustible.
+    bool admite(const CargaGasolina& carga) const;
+
+    /// Indica si la coincidencia número `indice` (desde 0) cae en la página pedida.
+    bool enPagina(size_t indice) const;
+
+    /// Páginas que ocupan `coincidencias` filas.
+    size_t contarPaginas(size_t coincidencias) const;
+};
+
+/**
+ * @struct ResultadoReporte
+ * @brief Conteos de un listado, para ofrecer la siguiente página.
+ */
+struct
+ResultadoReporte {
+    size_t coincidencias = 0;
+    size_t mostradas = 0;
+    size_t paginas = 0;
+};
+
+/**
+ * @class ReporteConsola
+ * @brief Arma tablas de texto en un búfer grande y las escribe en pocos bloques.
+ */
+class
+ReporteConsola {
+public:
+
+    /// Tamaño del búfer de salida.
+    static constexpr size_t kCapacidad = 256 * 1024;
+
+    /// Ancho máximo de la columna de nombre (los nombres más largos se recortan).
+    static constexpr size_t kAnchoNombre = 48;
+
+private:
+
+    std::ostream& salida;
+    std::unique_ptr<char[]> buffer;
+    size_t usado = 0;
+
+    void agregar(std::string_view texto);
+
+    void agregarEspacios(size_t n);
+
+    void agregarColumna(std::string_view texto, size_t ancho, bool derecha);
+
+    void agregarPie(const ResultadoReporte& resultado, const FiltroReporte& filtro, const char* elementos);
+
+    /// Escribe el búfer si no cabe una fila más.
+    void asegurarEspacio(size_t bytes);
+
+public:
+
+    /**
+     * @brief Constructor del reporte.
+     *
+     * @param salida Flujo donde se escribe (por ejemplo `std::cout`).
+     */
+    explicit ReporteConsola(std::ostream& salida);
+
+    /// Escribe lo que quede en el búfer.
+    ~ReporteConsola();
+
+    /**
+     * @brief Tabla de productos: código, nombre, precio y stock.
+     *
+     * @param productos Productos del inventario.
+     * @param filtro Filtro y página.
+     * @return ResultadoReporte Coincidencias y páginas.
+     */
+    ResultadoReporte productos(const std::vector<std::unique_ptr<Producto>>& productos, const FiltroReporte& filtro);
+
+    /**
+     * @brief Tabla del historial de cargas: litros, tipo, precio, total y versión.
+     *
+     * @param historial Cargas registradas.
+     * @param filtro Filtro (por tipo de combustible) y página.
+     * @return ResultadoReporte Coincidencias y páginas.
+     */
+    ResultadoReporte historial(const std::vector<CargaGasolina>& historial, const FiltroReporte& filtro);
+
+    /**
+     * @brief Escribe el búfer al flujo.
+     */
+    void vaciar();
+
+    /**
+     * @brief Ancho en pantalla de un texto UTF-8 (caracteres, no bytes).
+     */
+    static size_t anchoVisible(std::string_view texto);
+};
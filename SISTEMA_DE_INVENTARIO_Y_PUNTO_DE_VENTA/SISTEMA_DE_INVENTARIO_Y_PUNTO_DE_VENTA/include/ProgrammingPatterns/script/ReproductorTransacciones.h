@@ -0,0 +1,152 @@
+﻿#pragma once
+#include "ProgrammingPatterns/facade/SistemaFacade.h"
+#include "ProgrammingPatterns/facade/SistemaGasolineraFacade.h"
+#include "ProgrammingPatterns/gasolinera/Gasolinera.h"
+#include <istream>
+#include <string_view>
+
+/**
+ * @file ReproductorTransacciones.h
+ * @brief Modo no interactivo: ejecuta un guion de transacciones a toda velocidad.
+ *
+ * Sirve para reproducir el día de una tienda (pruebas de capacidad o para
+ * reproducir un incidente). Cada línea es una transacción:
+ *
+ * | Línea                                 | Acción                                  |
+ * |---------------------------------------|-----------------------------------------|
+ * | `V <codigo> <cantidad> <pago> [correo]` | Venta con ticket y factura (Opción 5) |
+ * | `S <codigo> <cantidad>`               | Venta simple (Opción 2)                 |
+ * | `R <codigo> <cantidad>`               | Reposición de stock (Opción 3)          |
+ * | `C <tipo> <litros> <pago>`            | Carga de gasolina con precio de tabla   |
+ * | `G`                                   | Guardar inventario, historial y tanques |
+ * | `L [texto]`                           | Listado de productos (Opción 1)         |
+ * | `H [tipo]`                            | Historial de cargas (Opción 7)          |
+ *
+ * `<pago>` es `E` (efectivo), `D` (débito) o `C` (crédito), opcionalmente
+ * seguido de la marca: `V` Visa, `M` Mastercard, `A` Amex (por ejemplo `DV`).
+ * Las líneas vacías y las que empiezan con `#` se ignoran.
+ *
+ * Los listados van a la salida de reportes (ver `setSalidaReportes`), así se
+ * ven aunque los mensajes normales estén desactivados.
+ *
+ * Los cobros con tarjeta se aplican sin pasar por la pasarela simulada, para
+ * medir el sistema y no la latencia del banco.
+ *
+ * @date 2026-10-19
+ * @version 1.0
+ * @author Ari
+ */
+
+ /**
+  * @class ReproductorTransacciones
+  * @brief Interpreta un guion de transacciones y lo ejecuta con las fachadas.
+  */
+class
+ReproductorTransacciones {
+public:
+
+    /// Tipos de transacción del guion.
+    enum Operacion {
+        VentaTicket,
+        VentaSimple,
+        Reposicion,
+        Carga,
+        Guardado,
+        Listado,
+        kOperaciones
+    };
+
+    /**
+     * @struct Resumen
+     * @brief Conteos y tiempo de una reproducción.
+     */
+    struct Resumen {
+        size_t lineas = 0;
+
+        /// Transacciones que se completaron, por tipo.
+        size_t operaciones[kOperaciones] = {};
+
+        /// Ventas y cargas que el sistema rechazó (código desconocido, sin stock,
+        /// pago o tanque insuficiente). Toman el camino corto, así que no cuentan
+        /// en el rendimiento.
+        size_t rechazadas[kOperaciones] = {};
+
+        size_t errores = 0;
+        double segundos = 0.0;
+
+        /// Transacciones completadas.
+        size_t total() const;
+
+        /// Transacciones rechazadas.
+        size_t totalRechazadas() const;
+    };
+
+private:
+
+    Inventario& inventario;
+    Gasolinera& gasolinera;
+    SistemaFacade& facade;
+    SistemaGasolineraFacade& gasFacade;
+
+    /// Conteos de la reproducción en curso.
+    Resumen resumen;
+
+    /// Correo de la línea actual (se reutiliza para no reservar memoria por línea).
+    std::string correo;
+
+    /// Código de la línea actual.
+    std::string codigo;
+
+    /// Filtro de los listados (se reutiliza entre líneas).
+    FiltroReporte filtro;
+
+    /// Flujo de los listados `L` y `H`.
+    std::ostream* reportes = &std::cout;
+
+public:
+
+    /**
+     * @brief Constructor del reproductor.
+     *
+     * @param inventario Inventario del sistema.
+     * @param gasolinera Gasolinera del sistema.
+     * @param facade Fachada de ventas.
+     * @param gasFacade Fachada de la gasolinera.
+     */
+    ReproductorTransacciones(Inventario& inventario, Gasolinera& gasolinera, SistemaFacade& facade,
+        SistemaGasolineraFacade& gasFacade)
+        : inventario(inventario), gasolinera(gasolinera), facade(facade), gasFacade(gasFacade) {}
+
+    /**
+     * @brief Cambia el flujo donde se escriben los listados.
+     *
+     * @param salida Flujo de los listados (por ejemplo, la consola original).
+     */
+    void setSalidaReportes(std::ostream* salida) { reportes = salida; }
+
+    /**
+     * @brief Ejecuta todas las líneas de un guion.
+     *
+     * Los errores de formato se informan por `std::cerr` (los primeros) y se cuentan.
+     *
+     * @param entrada Guion (archivo o entrada estándar).
+     * @return Resumen Conteos y tiempo de ejecución.
+     */
+    Resumen reproducir(std::istream& entrada);
+
+    /**
+     * @brief Ejecuta una línea del guion.
+     *
+     * @param linea Texto de la línea.
+     * @return true si la línea es válida (o es comentario).
+     */
+    bool ejecutar(std::string_view linea);
+
+    /**
+     * @brief Muestra el resumen y el rendimiento (transacciones completadas por segundo).
+     *
+     * @param resumen Resultado de `reproducir`.
+     * @param salida Flujo donde se escribe.
+     */
+    static void imprimirResumen(const Resumen& resumen, std::ostream& salida);
+};
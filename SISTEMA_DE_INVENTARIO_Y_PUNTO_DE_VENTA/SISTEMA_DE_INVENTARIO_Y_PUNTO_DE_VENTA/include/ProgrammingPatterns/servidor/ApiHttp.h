@@ -0,0 +1,157 @@
+﻿#pragma once
+#include "ProgrammingPatterns/servidor/Http.h"
+#include <chrono>
+#include <string>
+#include <unordered_map>
+
+class ServidorPOS;
+class Inventario;
+class Gasolinera;
+
+/**
+ * @file ApiHttp.h
+ * @brief API HTTP/JSON para la oficina y los verificadores de precios.
+ *
+ * Rutas:
+ *
+ * | Método | Ruta                              | Respuesta                                    |
+ * |--------|-----------------------------------|----------------------------------------------|
+ * | GET    | /productos/{codigo}               | Producto (id, nombre, precio, cantidad)       |
+ * | GET    | /productos?texto=&stockMaximo=&pagina=&porPagina= | Página de productos          |
+ * | GET    | /gasolinera/historial?tipo=&pagina=&porPagina=    | Página del historial de cargas |
+ * | GET    | /gasolinera/precios               | Precio vigente por combustible               |
+ * | GET    | /reportes/resumen                 | Totales de inventario y de cargas por tipo   |
+ * | GET    | /replicacion                      | Rol, secuencia y retraso de la réplica       |
+ * | POST   | /ventas                           | `{"codigo","cantidad","pago","marca"}` → folio |
+ * | POST   | /reposiciones                     | `{"codigo","cantidad"}` → stock              |
+ * | POST   | /gasolinera/cargas                | `{"tipo","litros","pago","marca"}` → total   |
+ *
+ * Las operaciones de escritura pasan por `ServidorPOS::atender`, igual que las
+ * de las cajas. Las respuestas de lectura se guardan en una caché: se vuelven a
+ * calcular solo si cambió el inventario o la gasolinera y ya pasó la vigencia
+ * (1 s por omisión), así cien verificadores consultando precios no le quitan
+ * tiempo a las cajas.
+ *
+ * @date 2026-10-19
+ * @version 1.0
+ * @author Ari
+ */
+
+ /**
+  * @class ApiHttp
+  * @brief Rutas de la API y caché de respuestas de lectura.
+  */
+class
+ApiHttp {
+public:
+
+    /// Entradas máximas de la caché (al llenarse se vacía completa).
+    static constexpr size_t kMaxEntradasCache = 4096;
+
+    /// Filas por página cuando la consulta no dice `porPagina`, y el máximo permitido.
+    static constexpr size_t kFilasPorPagina = 100;
+    static constexpr size_t kMaxFilasPorPagina = 1000;
+
+    /**
+     * @struct Estadisticas
+     * @brief Contadores de la API.
+     */
+    struct Estadisticas {
+        unsigned long long solicitudes = 0;
+        unsigned long long aciertosCache = 0;
+        unsigned long long fallosCache = 0;
+    };
+
+private:
+
+    /// De qué datos depende una respuesta (0 = no se guarda en caché).
+    enum Dependencia : unsigned {
+        kNinguna = 0,
+        kInventario = 1,
+        kGasolinera = 2
+    };
+
+    /**
+     * @struct Respuesta
+     * @brief Resultado de una ruta antes de escribirse.
+     */
+    struct Respuesta {
+        int estado = 200;
+        std::string cuerpo;
+        unsigned dependencias = kNinguna;
+    };
+
+    /**
+     * @struct EntradaCache
+     * @brief Respuesta guardada y el estado de los datos cuando se calculó.
+     */
+    struct EntradaCache {
+        int estado = 200;
+        std::string cuerpo;
+        unsigned dependencias = kNinguna;
+        unsigned long long generacionInventario = 0;
+        unsigned long long generacionGasolinera = 0;
+        std::chrono::steady_clock::time_point calculada;
+    };
+
+    ServidorPOS& servidor;
+    const Inventario& inventario;
+    const Gasolinera& gasolinera;
+
+    std::unordered_map<std::string, EntradaCache> cache;
+    std::chrono::milliseconds vigencia{ 1000 };
+    Estadisticas estadisticas;
+
+    Respuesta resolver(const SolicitudHttp& s);
+
+    Respuesta producto(const std::string& codigo) const;
+
+    Respuesta productos(const std::string& consulta) const;
+
+    Respuesta historial(const std::string& consulta) const;
+
+    Respuesta precios() const;
+
+    Respuesta resumen() const;
+
+    Respuesta replicacion() const;
+
+    Respuesta venta(const std::string& cuerpo);
+
+    Respuesta reposicion(const std::string& cuerpo);
+
+    Respuesta carga(const std::string& cuerpo);
+
+    /// Indica si la entrada refleja los datos actuales o sigue dentro de la vigencia.
+    bool vigente(const EntradaCache& entrada, std::chrono::steady_clock::time_point ahora) const;
+
+public:
+
+    /**
+     * @brief Constructor de la API.
+     *
+     * @param servidor Servidor que atiende las operaciones de escritura.
+     * @param inventario Inventario que se consulta.
+     * @param gasolinera Gasolinera que se consulta.
+     */
+    ApiHttp(ServidorPOS& servidor, const Inventario& inventario, const Gasolinera& gasolinera);
+
+    /**
+     * @brief Atiende una solicitud y agrega la respuesta al búfer de la conexión.
+     *
+     * @param solicitud Solicitud HTTP.
+     * @param salida Búfer de salida de la conexión.
+     */
+    void atender(const SolicitudHttp& solicitud, std::string& salida);
+
+    /**
+     * @brief Cambia cuánto puede servirse una respuesta de la caché después de
+     * que cambiaron los datos (0 = nunca: siempre datos al día).
+     */
+    void setVigenciaCache(std::chrono::milliseconds ms) { vigencia = ms; }
+
+    /**
+     * @brief Contadores acumulados.
+     */
+    const Estadisticas& getEstadisticas() const { return estadisticas; }
+};
@@ -0,0 +1,98 @@
+﻿#pragma once
+#include "ProgrammingPatterns/servidor/Protocolo.h"
+#include <string>
+
+/**
+ * @file ClientePOS.h
+ * @brief Conexión de una caja con el servidor del punto de venta.
+ *
+ * Cliente bloqueante: `solicitar` envía una solicitud y espera su respuesta.
+ * Para enviar varias sin esperar (pipelining) se usan `encolar`, `enviar` y
+ * luego un `recibir` por cada solicitud.
+ *
+ * En Windows no está disponible y `conectar` devuelve false.
+ *
+ * @date 2026-10-19
+ * @version 1.0
+ * @author Ari
+ */
+
+ /**
+  * @class ClientePOS
+  * @brief Socket de una caja hacia `ServidorPOS`.
+  */
+class
+ClientePOS {
+private:
+
+    int fd = -1;
+
+    /// Espera máxima de conexión, envío y recepción (0 = sin límite).
+    int esperaMs = 0;
+
+    std::string pendiente;
+    std::string recibido;
+    size_t leido = 0;
+
+public:
+
+    ClientePOS() = default;
+
+    /// Cierra la conexión.
+    ~ClientePOS();
+
+    ClientePOS(const ClientePOS&) = delete;
+    ClientePOS& operator=(const ClientePOS&) = delete;
+
+    /**
+     * @brief Se conecta al servidor.
+     *
+     * @param direccion `unix:/ruta`, `tcp:puerto` o `tcp:host:puerto`.
+     * @return true si la conexión quedó abierta.
+     */
+    bool conectar(const std::string& direccion);
+
+    /**
+     * @brief Limita cuánto se espera al conectar, enviar o recibir.
+     *
+     * Aplica a las conexiones que se abran después. Si se agota, la operación
+     * falla como si se hubiera cerrado la conexión.
+     *
+     * @param ms Milisegundos (0 = sin límite).
+     */
+    void setEspera(int ms) { esperaMs = ms; }
+
+    /**
+     * @brief Cierra la conexión (se puede volver a conectar).
+     */
+    void cerrar();
+
+    /**
+     * @brief Agrega una solicitud a las pendientes de enviar.
+     */
+    void encolar(const SolicitudPOS& solicitud) { Protocolo::escribir(solicitud, pendiente); }
+
+    /**
+     * @brief Envía todas las solicitudes encoladas.
+     *
+     * @return true si se enviaron completas.
+     */
+    bool enviar();
+
+    /**
+     * @brief Espera la siguiente respuesta.
+     *
+     * @param respuesta Salida.
+     * @return true si llegó una respuesta válida; false si se cerró la conexión.
+     */
+    bool recibir(RespuestaPOS& respuesta);
+
+    /**
+     * @brief Envía una solicitud y espera su respuesta.
+     *
+     * @param solicitud Solicitud a enviar.
+     * @param respuesta Salida.
+     * @return true si hubo respuesta.
+     */
+    bool solicitar(const SolicitudPOS& solicitud, RespuestaPOS& respuesta);
+};
@@ -0,0 +1,99 @@
+﻿#pragma once
+#include <cstddef>
+#include <string>
+#include <string_view>
+
+/**
+ * @file Http.h
+ * @brief Lectura de solicitudes y escritura de respuestas HTTP/1.1.
+ *
+ * Lo mínimo que necesita la API de la oficina y los verificadores de precios:
+ * cuerpo con `Content-Length` (sin `chunked`), conexiones persistentes
+ * (`keep-alive` por omisión en HTTP/1.1) y varias solicitudes seguidas en la
+ * misma conexión (pipelining), que se contestan en orden.
+ *
+ * @date 2026-10-19
+ * @version 1.0
+ * @author Ari
+ */
+
+ /**
+  * @struct SolicitudHttp
+  * @brief Solicitud ya separada en sus partes.
+  */
+struct
+SolicitudHttp {
+    std::string metodo;
+
+    /// Ruta sin la consulta (por ejemplo `/productos/A001`).
+    std::string ruta;
+
+    /// Lo que sigue al `?`, sin decodificar.
+    std::string consulta;
+
+    std::string cuerpo;
+
+    /// false si la caja pidió `Connection: close` (o es HTTP/1.0 sin keep-alive).
+    bool mantener = true;
+};
+
+/**
+ * @class Http
+ * @brief Funciones del protocolo, con el mismo contrato de lectura que `Protocolo`.
+ */
+class
+Http {
+public:
+
+    /// Tamaño máximo de la línea de solicitud más los encabezados.
+    static constexpr size_t kMaxEncabezados = 16 * 1024;
+
+    /// Tamaño máximo del cuerpo.
+    static constexpr size_t kMaxCuerpo = 64 * 1024;
+
+    /// Resultado de `leer` cuando la solicitud no es válida (se contesta 400 y se cierra).
+    static constexpr size_t kSolicitudInvalida = static_cast<size_t>(-1);
+
+    /**
+     * @brief Lee una solicitud del inicio de `datos`.
+     *
+     * @param datos Bytes recibidos.
+     * @param n Número de bytes.
+     * @param solicitud Salida.
+     * @return size_t Bytes consumidos; 0 si la solicitud aún no está completa o
+     * `kSolicitudInvalida` si no es válida.
+     */
+    static size_t leer(const char* datos, size_t n, SolicitudHttp& solicitud);
+
+    /**
+     * @brief Agrega una respuesta JSON al final de `destino`.
+     *
+     * @param estado Código de estado (200, 404...).
+     * @param cuerpo Cuerpo JSON.
+     * @param mantener false para anunciar `Connection: close`.
+     * @param destino Búfer de salida de la conexión.
+     * @param encabezados Encabezados extra, cada uno terminado en "\r\n".
+     */
+    static void escribir(int estado, std::string_view cuerpo, bool mantener, std::string& destino,
+        std::string_view encabezados = {});
+
+    /**
+     * @brief Valor de un parámetro de la consulta (`a=1&b=x%20y`), decodificado.
+     *
+     * @param consulta Consulta de la solicitud.
+     * @param nombre Nombre del parámetro.
+     * @param valor Salida.
+     * @return true si el parámetro está presente.
+     */
+    static bool parametro(std::string_view consulta, std::string_view nombre, std::string& valor);
+
+    /**
+     * @brief Decodifica `%XX` y `+` de un componente de URL.
+     */
+    static std::string decodificar(std::string_view texto);
+
+    /**
+     * @brief Frase de un código de estado ("OK", "Not Found"...).
+     */
+    static const char* frase(int estado);
+};
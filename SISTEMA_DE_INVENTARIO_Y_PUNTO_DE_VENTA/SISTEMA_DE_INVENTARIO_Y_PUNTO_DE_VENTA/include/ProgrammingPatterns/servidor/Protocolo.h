@@ -0,0 +1,181 @@
+﻿#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+/**
+ * @file Protocolo.h
+ * @brief Protocolo binario entre las cajas y el servidor del punto de venta.
+ *
+ * Cada mensaje es una trama con un largo al inicio; todos los enteros van en
+ * little-endian. Una conexión puede enviar varias solicitudes sin esperar las
+ * respuestas, que llegan en el mismo orden con el mismo `id`.
+ *
+ * Solicitud (14 bytes + texto):
+ *
+ * | Campo      | Tipo   | Uso                                                  |
+ * |------------|--------|------------------------------------------------------|
+ * | largo      | u32    | Bytes que siguen a este campo                        |
+ * | tipo       | u8     | `TipoSolicitud`                                      |
+ * | pago       | u8     | 1-Efectivo 2-Debito 3-Credito                        |
+ * | marca      | u8     | `MarcaTarjeta`                                       |
+ * | reservado  | u8     | 0                                                    |
+ * | id         | u32    | Lo elige la caja; se devuelve en la respuesta        |
+ * | cantidad   | i32    | Unidades (venta, reposición), mililitros (carga), centavos (precio) o posición (catálogo) |
+ * | largoTexto | u16    | Bytes del texto                                      |
+ * | texto      | bytes  | Código del producto, tipo de combustible o nombre de la caja |
+ *
+ * Respuesta (30 bytes + texto):
+ *
+ * | Campo      | Tipo   | Uso                                                  |
+ * |------------|--------|------------------------------------------------------|
+ * | largo      | u32    | Bytes que siguen a este campo                        |
+ * | tipo       | u8     | Tipo de la solicitud                                 |
+ * | estado     | u8     | `EstadoRespuesta`                                    |
+ * | reservado  | u16    | 0                                                    |
+ * | id         | u32    | Id de la solicitud                                   |
+ * | centavos   | i64    | Total cobrado (venta, carga) o precio (consulta)     |
+ * | stock      | i32    | Existencia después de la operación                   |
+ * | folio      | u64    | Folio del ticket (venta) o total de productos (catálogo) |
+ * | largoTexto | u16    | Bytes del texto                                      |
+ * | texto      | bytes  | Nombre del producto (consulta) o `código\tnombre` (catálogo) |
+ *
+ * Una caja que se identifica (`Identificar` con su nombre, hasta 31 bytes)
+ * usa el `id` de sus ventas como número de venta, en orden creciente. Si
+ * reenvía una venta porque no le llegó la respuesta, el servidor contesta la
+ * respuesta original sin volver a vender. Si ya no la tiene, contesta
+ * `Repetida` con la existencia actual.
+ * `Catalogo` devuelve el producto de una posición del catálogo, para que la
+ * caja copie el catálogo completo enviando varias sin esperar.
+ *
+ * @date 2026-10-19
+ * @version 1.0
+ * @author Ari
+ */
+
+ /// Operaciones que atiende el servidor.
+enum class TipoSolicitud : std::uint8_t {
+    Ping = 0,
+    Venta = 1,
+    Reposicion = 2,
+    Carga = 3,
+    Consulta = 4,
+    Precio = 5,
+    Identificar = 6,
+    Catalogo = 7
+};
+
+/// Resultado de una solicitud.
+enum class EstadoRespuesta : std::uint8_t {
+    Ok = 0,
+    NoEncontrado = 1,
+    SinStock = 2,
+    Invalida = 3,
+    Rechazada = 4,
+
+    /// La venta ya se había atendido y su respuesta no se conserva; no se volvió a vender.
+    Repetida = 5
+};
+
+/**
+ * @struct SolicitudPOS
+ * @brief Solicitud de una caja.
+ */
+struct
+SolicitudPOS {
+    TipoSolicitud tipo = TipoSolicitud::Ping;
+    std::uint8_t pago = 1;
+    std::uint8_t marca = 0;
+    std::uint32_t id = 0;
+    std::int32_t cantidad = 0;
+    std::string texto;
+};
+
+/**
+ * @struct RespuestaPOS
+ * @brief Respuesta del servidor.
+ */
+struct
+RespuestaPOS {
+    TipoSolicitud tipo = TipoSolicitud::Ping;
+    EstadoRespuesta estado = EstadoRespuesta::Ok;
+    std::uint32_t id = 0;
+    std::int64_t centavos = 0;
+    std::int32_t stock = 0;
+    std::uint64_t folio = 0;
+    std::string texto;
+};
+
+/**
+ * @struct DireccionPOS
+ * @brief Dirección del servidor: `unix:/ruta/al/socket`, `tcp:puerto` o `tcp:host:puerto`.
+ *
+ * Con `tcp:puerto` se escucha solo en la interfaz local (127.0.0.1).
+ */
+struct
+DireccionPOS {
+    bool local = true;
+    std::string ruta;
+    std::string host = "127.0.0.1";
+    unsigned short puerto = 0;
+
+    /**
+     * @brief Interpreta el texto de una dirección.
+     *
+     * @param texto Dirección en uno de los formatos aceptados.
+     * @param direccion Salida.
+     * @return true si el formato es válido.
+     */
+    static bool leer(const std::string& texto, DireccionPOS& direccion);
+};
+
+/**
+ * @class Protocolo
+ * @brief Codificación y lectura de las tramas.
+ */
+class
+Protocolo {
+public:
+
+    /// Tamaño máximo del texto de una trama.
+    static constexpr size_t kMaxTexto = 1024;
+
+    /// Resultado de `leer` cuando la trama no es válida (la conexión debe cerrarse).
+    static constexpr size_t kTramaInvalida = static_cast<size_t>(-1);
+
+    /**
+     * @brief Agrega la trama de una solicitud al final de `destino`.
+     */
+    static void escribir(const SolicitudPOS& solicitud, std::string& destino);
+
+    /**
+     * @brief Agrega la trama de una respuesta al final de `destino`.
+     */
+    static void escribir(const RespuestaPOS& respuesta, std::string& destino);
+
+    /**
+     * @brief Lee una solicitud del inicio de `datos`.
+     *
+     * @param datos Bytes recibidos.
+     * @param n Número de bytes.
+     * @param solicitud Salida.
+     * @return size_t Bytes consumidos; 0 si la trama aún no está completa o
+     * `kTramaInvalida` si no es válida.
+     */
+    static size_t leer(const char* datos, size_t n, SolicitudPOS& solicitud);
+
+    /**
+     * @brief Lee una respuesta del inicio de `datos` (mismo contrato que la solicitud).
+     */
+    static size_t leer(const char* datos, size_t n, RespuestaPOS& respuesta);
+
+    /**
+     * @brief Agrega los `bytes` bytes menos significativos de `valor` en little-endian.
+     */
+    static void agregarEntero(std::string& destino, std::uint64_t valor, int bytes);
+
+    /**
+     * @brief Lee un entero little-endian de `bytes` bytes y avanza `p`.
+     */
+    static std::uint64_t tomarEntero(const char*& p, int bytes);
+};
@@ -0,0 +1,367 @@
+﻿#pragma once
+#include "ProgrammingPatterns/servidor/Protocolo.h"
+#include "ProgrammingPatterns/servidor/ApiHttp.h"
+#include "ProgrammingPatterns/replicacion/LiderReplicacion.h"
+#include "ProgrammingPatterns/replicacion/SeguidorReplicacion.h"
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <deque>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+class Inventario;
+class Gasolinera;
+class SistemaFacade;
+class SistemaGasolineraFacade;
+
+/**
+ * @file ServidorPOS.h
+ * @brief Servidor de la tienda y la gasolinera para varias cajas.
+ *
+ * Un solo proceso carga el `Inventario` y la `Gasolinera` y atiende a las
+ * cajas por un socket Unix o TCP local con el protocolo de `Protocolo.h`, en
+ * lugar de que cada caja tenga su propia copia de `Productos.json`.
+ *
+ * El ciclo de eventos usa `epoll` con sockets no bloqueantes en un solo hilo:
+ * las solicitudes se atienden en el orden en que llegan, por lo que el
+ * inventario y la gasolinera no necesitan candados. Lo lento (tickets, correos,
+ * diarios) ya se hace en sus propios hilos en segundo plano.
+ *
+ * Las ventas de una caja identificada se anotan con su respuesta en
+ * `VentasCajas.dat` (`abrirVentasCajas`). El archivo se vacía una vez por
+ * vuelta del ciclo, no por venta. Al reiniciar, el servidor recupera las
+ * respuestas recientes y el último número de venta de cada caja, así que un
+ * lote reenviado después del reinicio tampoco vende dos veces.
+ *
+ * Además del protocolo binario de las cajas, `escucharHttp` abre un socket
+ * para la API HTTP/JSON de la oficina (`ApiHttp`) en el mismo ciclo.
+ *
+ * Replicación del inventario: un servidor líder (`escucharReplicas`) envía
+ * cada movimiento a sus réplicas; un servidor réplica (`seguir`) se conecta al
+ * líder, aplica los movimientos en orden y solo atiende consultas (las ventas,
+ * reposiciones, cargas y cambios de precio se contestan como rechazadas). Si
+ * pierde la conexión la réplica reintenta cada segundo y se pone al día con la
+ * cola del diario o con una foto completa.
+ *
+ * En Windows el modo servidor no está disponible y `escuchar` devuelve false.
+ *
+ * @date 2026-10-19
+ * @version 1.0
+ * @author Ari
+ */
+
+ /**
+  * @class ServidorPOS
+  * @brief Ciclo de eventos que atiende las solicitudes de las cajas.
+  */
+class
+ServidorPOS {
+public:
+
+    /// Bytes de respuestas pendientes a partir de los cuales se deja de leer a la caja.
+    static constexpr size_t kMaxSalidaPendiente = 1 << 20;
+
+    /// Bytes pendientes de una réplica a partir de los cuales se desconecta (volverá a pedir la cola).
+    /// No aplica mientras recibe su foto, que se rellena de a `kBloqueFoto`.
+    static constexpr size_t kMaxSalidaReplica = 64 << 20;
+
+    /// Bytes de foto pendientes por réplica; se agrega más cuando el socket los vacía.
+    static constexpr size_t kBloqueFoto = 1 << 20;
+
+    /// Respuestas de venta que se recuerdan por caja identificada (para reenvíos).
+    static constexpr size_t kVentasRecordadas = 4096;
+
+    /// Bytes del nombre de una caja identificada (cabe en `VentasCajas.dat`).
+    static constexpr size_t kMaxNombreCaja = 31;
+
+    /// Cada cuánto el líder envía un latido a las réplicas.
+    static constexpr int kLatidoMs = 100;
+
+    /// Espera entre intentos de la réplica de conectarse al líder.
+    static constexpr int kReintentoMs = 1000;
+
+    /**
+     * @struct Estadisticas
+     * @brief Contadores del servidor.
+     */
+    struct Estadisticas {
+        unsigned long long conexiones = 0;
+        unsigned long long solicitudes = 0;
+        unsigned long long tramasInvalidas = 0;
+        unsigned long long ventasRepetidas = 0;
+    };
+
+private:
+
+    /// Qué se habla en una conexión.
+    enum class TipoConexion {
+        Caja,
+        Http,
+        Seguidor,
+        Lider
+    };
+
+    /**
+     * @struct Conexion
+     * @brief Caja conectada: bytes recibidos sin procesar y respuestas por enviar.
+     */
+    struct Conexion {
+        std::string entrada;
+        std::string salida;
+        size_t enviado = 0;
+        bool escribiendo = false;
+        bool leyendo = true;
+
+        /// Protocolo binario, HTTP, réplica conectada a este líder o el líder que sigue esta réplica.
+        TipoConexion tipo = TipoConexion::Caja;
+
+        /// La réplica ya saludó y recibe movimientos.
+        bool saludo = false;
+
+        /// Nombre con el que se identificó la caja (vacío si no lo hizo).
+        std::string caja;
+
+        /// Cerrar en cuanto se envíe lo pendiente (`Connection: close` o solicitud inválida).
+        bool cerrarAlEnviar = false;
+    };
+
+    /**
+     * @struct VentasCaja
+     * @brief Respuestas recientes de las ventas de una caja, por número de venta.
+     */
+    struct VentasCaja {
+        std::unordered_map<std::uint32_t, RespuestaPOS> respuestas;
+        std::deque<std::uint32_t> orden;
+
+        /// Número más alto ya atendido; la caja numera sus ventas en orden creciente.
+        std::uint32_t ultima = 0;
+    };
+
+    /**
+     * @struct VentaCajaAtendida
+     * @brief Registro de `VentasCajas.dat`: una venta de caja y su respuesta (tamaño fijo).
+     */
+    struct VentaCajaAtendida {
+        char caja[kMaxNombreCaja + 1] = {};
+        std::uint64_t folio = 0;
+        std::int64_t centavos = 0;
+        std::uint32_t numero = 0;
+        std::int32_t stock = 0;
+        std::uint8_t estado = 0;
+        std::uint8_t relleno[7] = {};
+    };
+    static_assert(sizeof(VentaCajaAtendida) == 64, "VentaCajaAtendida debe medir 64 bytes");
+
+    /**
+     * @struct Escucha
+     * @brief Socket que acepta conexiones y el protocolo que hablan.
+     */
+    struct Escucha {
+        int fd;
+        TipoConexion tipo;
+    };
+
+    Inventario& inventario;
+    Gasolinera& gasolinera;
+    SistemaFacade& facade;
+    SistemaGasolineraFacade& gasFacade;
+
+    /// Sockets que aceptan conexiones y la ruta de los sockets Unix (para borrarlos).
+    std::vector<Escucha> escuchas;
+    std::vector<std::string> rutasUnix;
+
+    std::unique_ptr<ApiHttp> api;
+
+    /// Replicación: a lo más uno de los dos existe.
+    std::unique_ptr<LiderReplicacion> lider;
+    std::unique_ptr<SeguidorReplicacion> seguidor;
+
+    /// Réplicas conectadas (líder).
+    std::vector<int> replicas;
+
+    /// Dirección y conexión con el líder (réplica); -1 si no está conectada.
+    std::string direccionLider;
+    int fdLider = -1;
+
+    /// Ya se avisó que el líder no contesta (no se repite en cada reintento).
+    bool falloConexionLider = false;
+
+    std::chrono::steady_clock::time_point ultimoLatido;
+    std::chrono::steady_clock::time_point ultimoIntento;
+
+    std::unordered_map<int, Conexion> conexiones;
+
+    /// Por nombre de caja; sobrevive a las reconexiones de la caja.
+    std::unordered_map<std::string, VentasCaja> ventasCajas;
+
+    /// `VentasCajas.dat` abierto para agregar, y si tiene registros sin vaciar.
+    std::FILE* diarioCajas = nullptr;
+    bool diarioCajasPendiente = false;
+    int epoll = -1;
+    std::atomic<bool> activo{ false };
+    Estadisticas estadisticas;
+
+    /// Cambian con cada operación que modifica el inventario o la gasolinera (para la caché HTTP).
+    unsigned long long generacionInventario = 0;
+    unsigned long long generacionGasolinera = 0;
+
+    /// Abre y pone a escuchar un socket; devuelve el descriptor o -1.
+    int abrirEscucha(const std::string& direccion);
+
+    void aceptar(const Escucha& escucha);
+
+    /**
+     * @brief Atiende las solicitudes completas de `datos` y escribe las respuestas.
+     *
+     * @return size_t Bytes consumidos, o `Protocolo::kTramaInvalida` si hay que cerrar ya.
+     */
+    size_t procesar(const char* datos, size_t n, Conexion& c);
+
+    /// Identificación de la caja y ventas repetidas; lo demás pasa a `atender`.
+    RespuestaPOS atenderCaja(const SolicitudPOS& solicitud, Conexion& c);
+
+    /// Guarda la respuesta entre las recientes de la caja (descarta la más vieja si no cabe).
+    static void recordarVenta(VentasCaja& ventas, const RespuestaPOS& respuesta);
+
+    /// Agrega la venta atendida a `VentasCajas.dat` (se vacía al final de la vuelta).
+    void anotarVentaCaja(const std::string& caja, const RespuestaPOS& respuesta);
+
+    /// Lee lo disponible, atiende las tramas completas y envía. Devuelve false si hay que cerrar.
+    bool leer(int fd, Conexion& c);
+
+    /// Envía lo pendiente. Devuelve false si hay que cerrar.
+    bool enviar(int fd, Conexion& c);
+
+    /// Ajusta los eventos de epoll según lo pendiente de la conexión.
+    void actualizarInteres(int fd, Conexion& c);
+
+    void cerrar(int fd);
+
+    /// Conecta con el líder y le envía el saludo. Devuelve false si no se pudo.
+    bool conectarLider();
+
+    /// Latidos, envío de movimientos a las réplicas y reconexión con el líder.
+    void atenderReplicacion();
+
+    void cerrarTodo();
+
+public:
+
+    /**
+     * @brief Constructor del servidor.
+     *
+     * @param inventario Inventario compartido por las cajas.
+     * @param gasolinera Gasolinera compartida por las cajas.
+     * @param facade Fachada de ventas.
+     * @param gasFacade Fachada de la gasolinera.
+     */
+    ServidorPOS(Inventario& inventario, Gasolinera& gasolinera, SistemaFacade& facade, SistemaGasolineraFacade& gasFacade);
+
+    /// Cierra las conexiones, los sockets de escucha y `VentasCajas.dat`.
+    ~ServidorPOS();
+
+    ServidorPOS(const ServidorPOS&) = delete;
+    ServidorPOS& operator=(const ServidorPOS&) = delete;
+
+    /**
+     * @brief Abre un socket de escucha (se puede llamar varias veces).
+     *
+     * @param direccion `unix:/ruta`, `tcp:puerto` o `tcp:host:puerto`.
+     * @return true si el socket quedó escuchando.
+     */
+    bool escuchar(const std::string& direccion);
+
+    /**
+     * @brief Abre un socket de escucha para la API HTTP/JSON.
+     *
+     * @param direccion Mismo formato que `escuchar` (normalmente `tcp:puerto`).
+     * @return true si el socket quedó escuchando.
+     */
+    bool escucharHttp(const std::string& direccion);
+
+    /**
+     * @brief Hace de este servidor el líder y abre un socket para las réplicas.
+     *
+     * @param direccion Mismo formato que `escuchar`.
+     * @return true si el socket quedó escuchando.
+     */
+    bool escucharReplicas(const std::string& direccion);
+
+    /**
+     * @brief Hace de este servidor una réplica de solo lectura del líder.
+     *
+     * La conexión se abre al ejecutar el ciclo y se reintenta si se pierde.
+     *
+     * @param direccion Dirección de réplicas del líder.
+     * @return true si la dirección es válida.
+     */
+    bool seguir(const std::string& direccion);
+
+    /**
+     * @brief Recupera las ventas atendidas de las cajas y abre el archivo para agregar.
+     *
+     * Solo se conservan las últimas `kVentasRecordadas` de cada caja: el
+     * archivo se reescribe con ellas (y sin un registro a medias) antes de
+     * agregar.
+     *
+     * @param archivo Ruta de `VentasCajas.dat`.
+     * @return true si el archivo quedó abierto.
+     */
+    bool abrirVentasCajas(const std::string& archivo);
+
+    /**
+     * @brief Atiende conexiones hasta que se llame a `detener()`.
+     *
+     * @return true si terminó por `detener()`, false si epoll falló.
+     */
+    bool ejecutar();
+
+    /**
+     * @brief Pide terminar el ciclo de eventos.
+     *
+     * Se puede llamar desde otro hilo o desde un manejador de señal; el ciclo
+     * lo nota en a lo más 200 ms.
+     */
+    void detener() { activo.store(false); }
+
+    /**
+     * @brief Atiende una solicitud (lo mismo que hace el ciclo con cada trama).
+     *
+     * @param solicitud Solicitud de la caja.
+     * @return RespuestaPOS Respuesta a enviar.
+     */
+    RespuestaPOS atender(const SolicitudPOS& solicitud);
+
+    /**
+     * @brief Contadores acumulados desde que arrancó el servidor.
+     */
+    const Estadisticas& getEstadisticas() const { return estadisticas; }
+
+    /**
+     * @brief API HTTP, o nullptr si no se llamó a `escucharHttp`.
+     */
+    ApiHttp* getApiHttp() { return api.get(); }
+
+    /**
+     * @brief Lado líder, o nullptr si no se llamó a `escucharReplicas`.
+     */
+    const LiderReplicacion* getLider() const { return lider.get(); }
+
+    /**
+     * @brief Lado réplica, o nullptr si no se llamó a `seguir`.
+     */
+    const SeguidorReplicacion* getSeguidor() const { return seguidor.get(); }
+
+    /**
+     * @brief Indica si la réplica está conectada con su líder.
+     */
+    bool conectadoAlLider() const { return fdLider >= 0; }
+
+    unsigned long long getGeneracionInventario() const { return generacionInventario; }
+
+    unsigned long long getGeneracionGasolinera() const { return generacionGasolinera; }
+};
@@ -1,15 +1,46 @@
 #pragma once
 #include <string>
+#include "ProgrammingPatterns/modelos/Dinero.h"
 
 /**
  * @file MetodoPago.h
- * @brief Interfaz base para el patrn Strategy que define mtodos de pago.
+ * @brief Interfaz base para el patrón Strategy que define métodos de pago.
  *
  * Esta clase establece la estructura que deben seguir todas las estrategias
- * de pago dentro del sistema. Cada mtodo de pago puede aplicar comisiones,
+ * de pago dentro del sistema. Cada método de pago puede aplicar comisiones,
  * descuentos u otras reglas internas, pero todos deben implementar las mismas
  * funciones para permitir su uso intercambiable.
  */
+
+ /**
+  * @enum TipoPago
+  * @brief Etiqueta explícita del método de pago.
+  *
+  * Permite identificar el método con un `switch` en lugar de `dynamic_cast`.
+  * Los tres primeros valores siguen el orden de `PagoVariante`.
+  */
+enum class TipoPago {
+    Efectivo,
+    Debito,
+    Credito,
+    Otro
+};
+
+/**
+ * @brief Convierte un `TipoPago` a su nombre para tickets y mensajes.
+ *
+ * @param tipo Tipo de pago.
+ * @return const char* Nombre del método (ej. "Efectivo").
+ */
+inline const char* tipoPagoToString(TipoPago tipo) {
+    switch (tipo) {
+    case TipoPago::Efectivo: return "Efectivo";
+    case TipoPago::Debito: return "Debito";
+    case TipoPago::Credito: return "Credito";
+    default: return "Otro";
+    }
+}
+
 class MetodoPago {
 public:
 
@@ -24,23 +55,32 @@ public:
     /**
      * @brief Procesa el pago y devuelve el monto final que debe pagar el cliente.
      *
-     * Esta funcin permite que cada mtodo de pago aplique comisiones,
-     * recargos, descuentos o cualquier clculo adicional necesario.
+     * Esta función permite que cada método de pago aplique comisiones,
+     * recargos, descuentos o cualquier cálculo adicional necesario.
      *
      * @param monto Monto base sin comisiones.
-     * @return double Monto final que se cobrar al cliente.
+     * @return Dinero Monto final que se cobrará al cliente.
      */
-    virtual double procesarPago(double monto) = 0;
+    virtual Dinero procesarPago(Dinero monto) = 0;
 
     /**
      * @brief Genera un mensaje informativo sobre el pago realizado.
      *
-     * Esta funcin es til para mostrar en la interfaz o en logs un mensaje
-     * descriptivo indicando cmo se proces el pago (por ejemplo, comisiones
-     * aplicadas o mtodo utilizado).
+     * Esta función es útil para mostrar en la interfaz o en logs un mensaje
+     * descriptivo indicando cómo se procesó el pago (por ejemplo, comisiones
+     * aplicadas o método utilizado).
      *
      * @param monto Monto final cobrado.
-     * @return std::string Mensaje con la informacin del proceso del pago.
+     * @return std::string Mensaje con la información del proceso del pago.
+     */
+    virtual std::string pagar(Dinero monto) = 0;
+
+    /**
+     * @brief Indica qué método de pago es.
+     *
+     * Las estrategias externas (extensiones) conservan el valor `Otro`.
+     *
+     * @return TipoPago Etiqueta del método.
      */
-    virtual std::string pagar(double monto) = 0;
+    virtual TipoPago tipo() const { return TipoPago::Otro; }
 };
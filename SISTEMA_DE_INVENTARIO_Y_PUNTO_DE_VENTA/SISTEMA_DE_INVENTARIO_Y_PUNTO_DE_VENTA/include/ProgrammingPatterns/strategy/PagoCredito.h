@@ -1,41 +1,60 @@
 #pragma once
 #include "ProgrammingPatterns/strategy/MetodoPago.h"
+#include "ProgrammingPatterns/pagos/MotorComisiones.h"
 #include <string>
 
 /**
  * @file PagoCredito.h
- * @brief Estrategia de pago con tarjeta de crdito.
+ * @brief Estrategia de pago con tarjeta de crédito.
  *
- * Esta implementacin del patrn Strategy aplica una comisin del 5% al
- * monto original. Se utiliza cuando el cliente selecciona pagar con
- * tarjeta de crdito.
+ * Esta implementación del patrón Strategy aplica la comisión de crédito
+ * configurada en el `MotorComisiones` para la marca de la tarjeta (5% por
+ * defecto). Se utiliza cuando el cliente selecciona pagar con tarjeta de crédito.
  */
-class PagoCredito : public MetodoPago {
+class PagoCredito final : public MetodoPago {
 public:
 
+    /// Etiqueta del método, disponible en tiempo de compilación.
+    static constexpr TipoPago kTipo = TipoPago::Credito;
+
+    /// Marca de la tarjeta, usada para elegir la regla de comisión.
+    MarcaTarjeta marca;
+
+    /**
+     * @brief Constructor del pago con crédito.
+     * @param marca Marca de la tarjeta (Generica si no se conoce).
+     */
+    explicit PagoCredito(MarcaTarjeta marca = MarcaTarjeta::Generica) : marca(marca) {}
+
     /**
-     * @brief Procesa el pago aplicando una comisin del 5%.
+     * @brief Procesa el pago aplicando la comisión de crédito de la marca.
      *
-     * Esta funcin toma el monto base y le incrementa un 5%, simulando
-     * la comisin tpica de pagos con tarjeta.
+     * La regla (porcentaje, cuota fija, mínimo y tope) sale de la tabla del
+     * motor de comisiones; sin configuración equivale a un 5% sobre el monto.
      *
      * @param monto Monto base a cobrar.
-     * @return double Monto final con comisin incluida.
+     * @return Dinero Monto final con comisión incluida.
      */
-    double procesarPago(double monto) override {
-        return monto * 1.05; // ejemplo: aade 5% de comisin
+    Dinero procesarPago(Dinero monto) override {
+        return monto + MotorComisiones::instancia().comision(kTipo, marca, monto);
     }
 
     /**
     * @brief Genera un mensaje informativo del pago realizado.
     *
     * Este mensaje puede mostrarse en la interfaz o utilizarse en logs
-    * del sistema para indicar cmo se proces el pago.
+    * del sistema para indicar cómo se procesó el pago.
     *
     * @param monto Monto final cobrado al cliente.
     * @return std::string Mensaje del proceso de pago.
     */
-    std::string pagar(double monto) override {
-        return "Pago con tarjeta de credito por $" + std::to_string(monto);
+    std::string pagar(Dinero monto) override {
+        return "Pago con tarjeta de credito por $" + monto.toString();
     }
+
+    /**
+     * @brief Indica que este método es tarjeta de crédito.
+     * @return TipoPago Etiqueta del método.
+     */
+    TipoPago tipo() const override { return kTipo; }
 };
@@ -1,39 +1,59 @@
 #pragma once
 #include "ProgrammingPatterns/strategy/MetodoPago.h"
+#include "ProgrammingPatterns/pagos/MotorComisiones.h"
 #include <string>
 
 /**
  * @file PagoDebito.h
- * @brief Estrategia de pago con tarjeta de dbito.
+ * @brief Estrategia de pago con tarjeta de débito.
  *
- * Esta implementacin del patrn Strategy procesa el pago sin aplicar
- * comisiones adicionales; el cliente paga exactamente el monto total.
+ * Esta implementación del patrón Strategy procesa el pago con la regla de
+ * débito del `MotorComisiones` según la marca de la tarjeta. Por defecto no
+ * hay comisión y el cliente paga exactamente el monto total.
  */
-class PagoDebito : public MetodoPago {
+class PagoDebito final : public MetodoPago {
 public:
 
+    /// Etiqueta del método, disponible en tiempo de compilación.
+    static constexpr TipoPago kTipo = TipoPago::Debito;
+
+    /// Marca de la tarjeta, usada para elegir la regla de comisión.
+    MarcaTarjeta marca;
+
+    /**
+     * @brief Constructor del pago con débito.
+     * @param marca Marca de la tarjeta (Generica si no se conoce).
+     */
+    explicit PagoDebito(MarcaTarjeta marca = MarcaTarjeta::Generica) : marca(marca) {}
+
     /**
-     * @brief Procesa el pago sin modificar el monto.
+     * @brief Procesa el pago aplicando la regla de débito para la marca.
      *
-     * A diferencia del pago con crdito, aqu no se agregan comisiones.
+     * Con la configuración por defecto no se agregan comisiones.
      *
      * @param monto Monto base a cobrar.
-     * @return double Monto final cobrado (igual al original).
+     * @return Dinero Monto final cobrado.
      */
-    double procesarPago(double monto) override {
-        return monto; // paga exactamente el total
+    Dinero procesarPago(Dinero monto) override {
+        return monto + MotorComisiones::instancia().comision(kTipo, marca, monto);
     }
 
     /**
     * @brief Genera un mensaje informativo del pago realizado.
     *
     * Este mensaje se usa para indicar que el pago fue procesado con
-    * tarjeta de dbito.
+    * tarjeta de débito.
     *
     * @param monto Monto cobrado.
     * @return std::string Mensaje del proceso de pago.
     */
-    std::string pagar(double monto) override {
-        return "Pago con tarjeta de debito por $" + std::to_string(monto);
+    std::string pagar(Dinero monto) override {
+        return "Pago con tarjeta de debito por $" + monto.toString();
     }
+
+    /**
+     * @brief Indica que este método es tarjeta de débito.
+     * @return TipoPago Etiqueta del método.
+     */
+    TipoPago tipo() const override { return kTipo; }
 };
@@ -1,42 +1,52 @@
 #pragma once
 #include "ProgrammingPatterns/strategy/MetodoPago.h"
+#include "ProgrammingPatterns/pagos/MotorComisiones.h"
 #include <string>
 
 /**
  * @file PagoEfectivo.h
  * @brief Estrategia de pago en efectivo.
  *
- * Implementacin del patrn Strategy para pagos en efectivo.
- * No aplica comisiones adicionales; el cliente paga exactamente el monto total.
+ * Implementación del patrón Strategy para pagos en efectivo.
+ * Por defecto no aplica comisiones; el recargo, si lo hay, se configura en `MotorComisiones`.
  *  * @date 2025-12-04
  * @version 1.0
  * @author Ari
  */
-class PagoEfectivo : public MetodoPago {
+class PagoEfectivo final : public MetodoPago {
 public:
 
+    /// Etiqueta del método, disponible en tiempo de compilación.
+    static constexpr TipoPago kTipo = TipoPago::Efectivo;
+
     /**
-     * @brief Procesa el pago sin modificar el monto.
+     * @brief Procesa el pago aplicando la regla de efectivo del motor de comisiones.
      *
-     * El pago en efectivo no incluye comisiones ni recargos.
+     * Con la configuración por defecto el pago en efectivo no incluye recargos.
      *
      * @param monto Monto base a cobrar.
-     * @return double Monto final cobrado (igual al original).
+     * @return Dinero Monto final cobrado.
      */
-    double procesarPago(double monto) override {
-        return monto; // paga exactamente el total
+    Dinero procesarPago(Dinero monto) override {
+        return monto + MotorComisiones::instancia().comision(kTipo, MarcaTarjeta::Generica, monto);
     }
 
 
     /**
     * @brief Genera un mensaje informativo del pago realizado.
     *
-    * Este mensaje indica que se efectu un pago en efectivo.
+    * Este mensaje indica que se efectuó un pago en efectivo.
     *
     * @param monto Monto cobrado.
     * @return std::string Mensaje del proceso de pago.
     */
-    std::string pagar(double monto) override {
-        return "Pago en efectivo por $" + std::to_string(monto);
+    std::string pagar(Dinero monto) override {
+        return "Pago en efectivo por $" + monto.toString();
     }
+
+    /**
+     * @brief Indica que este método es pago en efectivo.
+     * @return TipoPago Etiqueta del método.
+     */
+    TipoPago tipo() const override { return kTipo; }
 };
@@ -0,0 +1,127 @@
+﻿#pragma once
+#include "ProgrammingPatterns/strategy/PagoEfectivo.h"
+#include "ProgrammingPatterns/strategy/PagoDebito.h"
+#include "ProgrammingPatterns/strategy/PagoCredito.h"
+#include "ProgrammingPatterns/modelos/VectorPequeno.h"
+#include <variant>
+
+/**
+ * @file PagoVariante.h
+ * @brief Representación cerrada de los métodos de pago conocidos con `std::variant`.
+ *
+ * Los tres métodos de pago del sistema son un conjunto cerrado, así que se pueden
+ * guardar por valor en un `std::variant` en lugar de crearlos con `new` y llamarlos
+ * por la tabla virtual. Como las clases son `final`, `std::visit` llama directamente
+ * a cada implementación y el compilador puede expandirlas en línea.
+ *
+ * La interfaz `MetodoPago` se conserva como punto de extensión: `comoMetodoPago()`
+ * permite pasar una variante a cualquier función que reciba `MetodoPago*`.
+ *
+ * @date 2026-10-19
+ * @version 1.0
+ * @author Ari
+ */
+
+ /**
+  * @brief Método de pago conocido, almacenado por valor.
+  *
+  * El índice de la variante coincide con el valor de `TipoPago`.
+  */
+using PagoVariante = std::variant<PagoEfectivo, PagoDebito, PagoCredito>;
+
+/**
+ * @struct PagoParcial
+ * @brief Parte de una venta pagada con un método (pago dividido).
+ *
+ * Un monto de cero en el último pago significa "el resto del total".
+ */
+struct
+PagoParcial {
+    PagoVariante pago;
+    Dinero monto;
+};
+
+/**
+ * @brief Pagos de una venta, en orden.
+ *
+ * Uno o dos pagos (el caso común) caben sin memoria dinámica.
+ */
+using PagosVenta = VectorPequeno<PagoParcial, 2>;
+
+static_assert(std::is_same<std::variant_alternative_t<static_cast<size_t>(TipoPago::Efectivo), PagoVariante>, PagoEfectivo>::value &&
+    std::is_same<std::variant_alternative_t<static_cast<size_t>(TipoPago::Debito), PagoVariante>, PagoDebito>::value &&
+    std::is_same<std::variant_alternative_t<static_cast<size_t>(TipoPago::Credito), PagoVariante>, PagoCredito>::value,
+    "El orden de PagoVariante debe coincidir con TipoPago");
+
+/**
+ * @brief Crea la variante a partir de la opción del menú (1-Efectivo 2-Debito 3-Credito).
+ *
+ * Igual que el menú original, cualquier otra opción se toma como crédito.
+ *
+ * @param opcion Opción capturada por el usuario.
+ * @param marca Marca de la tarjeta (se ignora en efectivo).
+ * @return PagoVariante Método de pago seleccionado.
+ */
+inline PagoVariante crearPago(int opcion, MarcaTarjeta marca = MarcaTarjeta::Generica) {
+    switch (opcion) {
+    case 1: return PagoEfectivo();
+    case 2: return PagoDebito(marca);
+    default: return PagoCredito(marca);
+    }
+}
+
+/**
+ * @brief Obtiene la etiqueta del método sin llamadas virtuales.
+ *
+ * @param pago Método de pago.
+ * @return TipoPago Etiqueta del método.
+ */
+inline TipoPago tipoDe(const PagoVariante& pago) {
+    return static_cast<TipoPago>(pago.index());
+}
+
+/**
+ * @brief Obtiene la marca de la tarjeta (Generica en efectivo).
+ *
+ * @param pago Método de pago.
+ * @return MarcaTarjeta Marca de la tarjeta.
+ */
+inline MarcaTarjeta marcaDe(const PagoVariante& pago) {
+    switch (tipoDe(pago)) {
+    case TipoPago::Debito:  return std::get<PagoDebito>(pago).marca;
+    case TipoPago::Credito: return std::get<PagoCredito>(pago).marca;
+    default:                return MarcaTarjeta::Generica;
+    }
+}
+
+/**
+ * @brief Procesa el pago llamando directamente a la implementación concreta.
+ *
+ * @param pago Método de pago.
+ * @param monto Monto base.
+ * @return Dinero Monto final que se cobra al cliente.
+ */
+inline Dinero procesarPago(PagoVariante& pago, Dinero monto) {
+    return std::visit([monto](auto& metodo) { return metodo.procesarPago(monto); }, pago);
+}
+
+/**
+ * @brief Genera el mensaje informativo del pago.
+ *
+ * @param pago Método de pago.
+ * @param monto Monto cobrado.
+ * @return std::string Mensaje del proceso de pago.
+ */
+inline std::string pagar(PagoVariante& pago, Dinero monto) {
+    return std::visit([monto](auto& metodo) { return metodo.pagar(monto); }, pago);
+}
+
+/**
+ * @brief Expone la variante como `MetodoPago` para las APIs basadas en la interfaz.
+ *
+ * @param pago Método de pago.
+ * @return MetodoPago& Referencia al objeto contenido en la variante.
+ */
+inline MetodoPago& comoMetodoPago(PagoVariante& pago) {
+    return std::visit([](auto& metodo) -> MetodoPago& { return metodo; }, pago);
+}
@@ -0,0 +1,206 @@
+﻿#pragma once
+#include <atomic>
+#include <cstdint>
+#include <cstdio>
+#include <ctime>
+#include <map>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <vector>
+
+/**
+ * @file ArchivoTickets.h
+ * @brief Archivo histórico de tickets con folio único e índice para reimpresión.
+ *
+ * Cada ticket recibe un folio de una secuencia atómica (varias cajas pueden pedir
+ * folios a la vez) y su texto se agrega al segmento vigente (`segmento_NNNNNN.txt`).
+ * Un índice de tamaño fijo (`indice.dat`) guarda segmento, posición y longitud de
+ * cada folio, así que reimprimir es una consulta directa y una sola lectura. Un
+ * segundo índice por día (AAAAMMDD -> primer y último folio) permite exportar un
+ * rango de fechas sin recorrer los segmentos.
+ *
+ * @date 2026-10-19
+ * @version 1.0
+ * @author Ari
+ */
+
+ /**
+  * @struct EntradaIndiceTicket
+  * @brief Ubicación de un ticket dentro de los segmentos (32 bytes).
+  */
+struct
+EntradaIndiceTicket {
+    std::uint64_t folio = 0;
+    std::int64_t fecha = 0;
+    std::uint64_t posicion = 0;
+    std::uint32_t segmento = 0;
+    std::uint32_t longitud = 0;
+};
+
+/**
+ * @struct TicketPorArchivar
+ * @brief Ticket ya renderizado que se agrega al archivo.
+ */
+struct
+TicketPorArchivar {
+    unsigned long long folio = 0;
+    time_t fecha = 0;
+    std::string_view texto;
+};
+
+/**
+ * @class ArchivoTickets
+ * @brief Secuencia de folios, segmentos de tickets e índices de consulta.
+ *
+ * Existe una instancia compartida (`instancia()`). Sin `abrir()`, los folios se
+ * siguen asignando pero los tickets no se archivan.
+ */
+class
+ArchivoTickets {
+public:
+
+    /// Tamaño a partir del cual se abre un segmento nuevo.
+    static constexpr std::uint64_t kTamanoSegmento = 8u * 1024u * 1024u;
+
+private:
+
+    /// Siguiente folio a entregar.
+    std::atomic<unsigned long long> siguiente{ 1 };
+
+    /// Carpeta del archivo.
+    std::string directorio;
+
+    /// Índice por folio: la entrada del folio f está en la posición f - 1.
+    std::vector<EntradaIndiceTicket> indice;
+
+    /// Índice por día: AAAAMMDD -> (primer folio, último folio).
+    std::map<int, std::pair<std::uint64_t, std::uint64_t>> indicePorDia;
+
+    /// Segmento vigente.
+    std::FILE* segmento = nullptr;
+
+    /// Número del segmento vigente.
+    std::uint32_t numeroSegmento = 0;
+
+    /// Bytes escritos en el segmento vigente.
+    std::uint64_t tamanoSegmento = 0;
+
+    /// Archivo del índice por folio.
+    std::FILE* archivoIndice = nullptr;
+
+    /// Protege segmentos e índices.
+    mutable std::mutex mutexArchivo;
+
+    /**
+     * @brief Ruta del segmento con el número indicado.
+     * @param numero Número de segmento.
+     * @return std::string Ruta del archivo.
+     */
+    std::string rutaSegmento(std::uint32_t numero) const;
+
+    /**
+     * @brief Abre (o crea) el segmento para agregar.
+     * @param numero Número de segmento.
+     * @return true si se pudo abrir.
+     */
+    bool abrirSegmento(std::uint32_t numero);
+
+    /**
+     * @brief Registra una entrada en los índices en memoria.
+     * @param entrada Entrada a registrar.
+     */
+    void indexar(const EntradaIndiceTicket& entrada);
+
+    /**
+     * @brief Lee el texto de un ticket.
+     *
+     * @param entrada Ubicación del ticket.
+     * @param texto Salida: contenido.
+     * @return true si se leyó completo.
+     */
+    bool leer(const EntradaIndiceTicket& entrada, std::string& texto) const;
+
+public:
+
+    ArchivoTickets() = default;
+    ~ArchivoTickets();
+
+    ArchivoTickets(const ArchivoTickets&) = delete;
+    ArchivoTickets& operator=(const ArchivoTickets&) = delete;
+
+    /**
+     * @brief Instancia compartida del sistema.
+     * @return ArchivoTickets& Archivo de tickets.
+     */
+    static ArchivoTickets& instancia();
+
+    /**
+     * @brief Carga el índice existente y deja listo el segmento vigente.
+     *
+     * @param carpeta Carpeta del archivo (se crea si no existe).
+     * @return true si el archivo quedó abierto.
+     */
+    bool abrir(const std::string& carpeta);
+
+    /**
+     * @brief Reserva el siguiente folio (seguro entre hilos).
+     * @return unsigned long long Folio único.
+     */
+    unsigned long long reservarFolio() { return siguiente.fetch_add(1, std::memory_order_relaxed); }
+
+    /**
+     * @brief Agrega un ticket ya renderizado al archivo.
+     *
+     * @param folio Folio reservado con `reservarFolio()`.
+     * @param fecha Fecha del ticket.
+     * @param texto Texto del ticket.
+     * @return true si se archivó.
+     */
+    bool guardar(unsigned long long folio, time_t fecha, std::string_view texto);
+
+    /**
+     * @brief Agrega varios tickets con una escritura vectorizada por segmento.
+     *
+     * Los textos se escriben juntos (`writev` en POSIX) y las entradas del índice
+     * también; los datos quedan en el sistema operativo, no necesariamente en disco
+     * hasta llamar a `sincronizar()`.
+     *
+     * Si una escritura falla, el segmento y el índice se recortan a lo último
+     * completo y solo se cuentan (e indexan) los tickets cuya entrada quedó escrita.
+     *
+     * @param tickets Tickets a archivar.
+     * @param n Número de tickets.
+     * @return size_t Tickets archivados (los primeros del lote).
+     */
+    size_t guardarLote(const TicketPorArchivar* tickets, size_t n);
+
+    /**
+     * @brief Fuerza a disco el segmento vigente y el índice (`fsync`).
+     */
+    void sincronizar();
+
+    /**
+     * @brief Muestra en consola un ticket archivado.
+     *
+     * @param folio Folio del ticket.
+     * @return true si existe.
+     */
+    bool reimprimir(unsigned long long folio) const;
+
+    /**
+     * @brief Copia a un archivo todos los tickets de un rango de días.
+     *
+     * @param desde Primer día (AAAAMMDD).
+     * @param hasta Último día (AAAAMMDD), inclusive.
+     * @param destino Archivo de salida.
+     * @return size_t Tickets exportados.
+     */
+    size_t exportarRango(int desde, int hasta, const std::string& destino) const;
+
+    /**
+     * @brief Número de tickets archivados.
+     * @return size_t Tickets en el índice.
+     */
+    size_t totalTickets() const;
+};
@@ -0,0 +1,165 @@
+﻿#pragma once
+#include "ProgrammingPatterns/tickets/ArchivoTickets.h"
+#include "ProgrammingPatterns/tickets/RenderizadorTicket.h"
+#include <chrono>
+#include <condition_variable>
+#include <thread>
+
+/**
+ * @file EscritorTickets.h
+ * @brief Hilo escritor de tickets con cola acotada y escrituras por lote.
+ *
+ * La caja solo renderiza el ticket y copia el texto a una ranura libre de la cola;
+ * la escritura del ticket no ocurre en el cobro. Un hilo dedicado toma todas las ranuras listas,
+ * las agrega al `ArchivoTickets` con una escritura vectorizada, actualiza
+ * `ticket_compra.txt` con el último ticket del lote y hace `fsync` periódico.
+ *
+ * La misma cola acepta documentos sueltos (por ejemplo, la factura XML de una
+ * venta), que el hilo escribe en su propio archivo.
+ *
+ * La cola tiene un número fijo de ranuras reservadas al arrancar: si el disco se
+ * atrasa y se llena, la caja espera (contrapresión) en lugar de crecer sin límite.
+ *
+ * Hay casos en que la caja sí escribe en línea: mientras el escritor no está
+ * activo (antes de `iniciar()` o después de `detener()`) y con documentos que
+ * no caben en una ranura. El diario de liquidaciones tiene su propio hilo
+ * escritor (ver `RegistroLiquidaciones`).
+ *
+ * @date 2026-10-19
+ * @version 1.0
+ * @author Ari
+ */
+
+ /**
+  * @class EscritorTickets
+  * @brief Cola circular de tickets renderizados y su hilo escritor.
+  *
+  * Existe una instancia compartida (`instancia()`). Mientras no se llame a
+  * `iniciar()`, `encolar()` devuelve false y el ticket se escribe en línea.
+  */
+class
+EscritorTickets {
+public:
+
+    /// Ranuras de la cola (tickets en espera como máximo).
+    static constexpr size_t kRanuras = 256;
+
+    /// Intervalo entre `fsync` mientras haya escrituras.
+    static constexpr std::chrono::milliseconds kIntervaloSync{ 1000 };
+
+private:
+
+    /// Longitud máxima de la ruta de un documento suelto.
+    static constexpr size_t kMaxRuta = 128;
+
+    /**
+     * @struct Ranura
+     * @brief Ticket (o documento suelto) en espera de escritura, con su texto copiado.
+     *
+     * Si `ruta` no está vacía, el texto es un documento que va a su propio archivo.
+     */
+    struct Ranura {
+        unsigned long long folio = 0;
+        time_t fecha = 0;
+        size_t longitud = 0;
+        char ruta[kMaxRuta];
+        char texto[RenderizadorTicket::kCapacidad];
+    };
+
+    /// Ranuras reservadas una sola vez.
+    std::unique_ptr<Ranura[]> ranuras;
+
+    /// Posición absoluta de la siguiente ranura a llenar.
+    size_t cabeza = 0;
+
+    /// Posición absoluta de la siguiente ranura a escribir.
+    size_t cola = 0;
+
+    /// Protege cabeza, cola y banderas.
+    std::mutex mutexCola;
+
+    /// Avisa al escritor que hay tickets.
+    std::condition_variable hayTickets;
+
+    /// Avisa a las cajas que se liberaron ranuras.
+    std::condition_variable hayEspacio;
+
+    /// Hilo escritor.
+    std::thread hilo;
+
+    /// Indica que el escritor está activo.
+    bool activo = false;
+
+    /// Indica al escritor que vacíe la cola y termine.
+    bool detenerSolicitado = false;
+
+    /**
+     * @brief Ciclo del hilo escritor.
+     */
+    void escribir();
+
+    /**
+     * @brief Espera una ranura libre y copia el contenido.
+     *
+     * @param folio Folio del ticket (0 en documentos sueltos).
+     * @param fecha Fecha del ticket.
+     * @param ruta Archivo destino de un documento suelto (vacío para tickets).
+     * @param texto Contenido.
+     * @return true si quedó en la cola.
+     */
+    bool encolarRanura(unsigned long long folio, time_t fecha, std::string_view ruta, std::string_view texto);
+
+public:
+
+    EscritorTickets() = default;
+
+    /**
+     * @brief Vacía la cola y detiene el hilo.
+     */
+    ~EscritorTickets();
+
+    EscritorTickets(const EscritorTickets&) = delete;
+    EscritorTickets& operator=(const EscritorTickets&) = delete;
+
+    /**
+     * @brief Instancia compartida del sistema.
+     * @return EscritorTickets& Escritor de tickets.
+     */
+    static EscritorTickets& instancia();
+
+    /**
+     * @brief Reserva las ranuras y arranca el hilo escritor.
+     */
+    void iniciar();
+
+    /**
+     * @brief Escribe los tickets pendientes, sincroniza y detiene el hilo.
+     */
+    void detener();
+
+    /**
+     * @brief Copia un ticket a la cola (espera si está llena).
+     *
+     * @param folio Folio del ticket.
+     * @param fecha Fecha del ticket.
+     * @param texto Texto renderizado.
+     * @return true si quedó en la cola; false si el escritor no está activo.
+     */
+    bool encolar(unsigned long long folio, time_t fecha, std::string_view texto) {
+        return encolarRanura(folio, fecha, std::string_view(), texto);
+    }
+
+    /**
+     * @brief Copia un documento suelto a la cola; el hilo lo escribe en `ruta`.
+     *
+     * @param ruta Archivo destino (se sobrescribe).
+     * @param texto Contenido del documento (hasta `RenderizadorTicket::kCapacidad`).
+     * @return true si quedó en la cola; false si el escritor no está activo o no cabe.
+     */
+    bool encolarDocumento(std::string_view ruta, std::string_view texto) {
+        if (ruta.empty() || ruta.size() >= kMaxRuta || texto.size() > RenderizadorTicket::kCapacidad) {
+            return false;
+        }
+        return encolarRanura(0, 0, ruta, texto);
+    }
+};
@@ -1,17 +1,26 @@
 #pragma once
 #include <string>
-#include <fstream>
 #include <ctime>
 #include <iostream>
-#include <iomanip>
+#include "ProgrammingPatterns/modelos/Dinero.h"
+#include "ProgrammingPatterns/tickets/RenderizadorTicket.h"
+#include "ProgrammingPatterns/tickets/ArchivoTickets.h"
+#include "ProgrammingPatterns/tickets/EscritorTickets.h"
+#include "ProgrammingPatterns/correo/ColaCorreos.h"
 
 /**
  * @file GeneradorTickets.h
  * @brief Clase encargada de generar tickets de compra en archivo de texto.
  *
- * Esta clase funciona como un mdulo auxiliar que genera un recibo detallado
- * con informacin del producto, cantidad, precios, impuestos y mtodo de pago.
- * El ticket se guarda localmente como "ticket_compra.txt".
+ * Esta clase funciona como un módulo auxiliar que genera un recibo detallado
+ * con información del producto, cantidad, precios, impuestos y método de pago.
+ * El ticket se guarda localmente como "ticket_compra.txt" (último ticket) y se
+ * agrega al `ArchivoTickets` con un folio único para poder reimprimirlo.
+ *
+ * El formato lo hace `RenderizadorTicket` sobre un búfer fijo del hilo, sin
+ * flujos ni memoria dinámica. La escritura la hace el `EscritorTickets` en su
+ * propio hilo, así que la venta no espera al disco. Si el cliente dio su correo,
+ * el ticket se agrega a la `ColaCorreos`, que lo envía en segundo plano.
  *  * @date 2025-12-04
  * @version 1.0
  * @author Ari
@@ -29,62 +38,49 @@ public:
      * - Precio unitario
      * - Subtotal e IVA
      * - Total pagado
-     * - Mtodo de pago utilizado
-     * - Fecha y hora exacta de la transaccin
+     * - Método de pago utilizado
+     * - Fecha y hora exacta de la transacción
      *
      * @param producto Nombre del producto comprado.
      * @param cantidad Cantidad adquirida.
      * @param precioUnitario Precio por unidad del producto.
      * @param total Monto total pagado por el cliente.
-     * @param metodoPago Descripcin del mtodo de pago utilizado.
+     * @param metodoPago Descripción del método de pago utilizado.
+     * @param correo Dirección del cliente (vacía si no quiere el ticket por correo).
+     * @return unsigned long long Folio asignado al ticket.
      */
-    static void generarTicket(const std::string& producto, int cantidad, double precioUnitario, double total, const std::string& metodoPago) {
-
-        std::ofstream archivo("ticket_compra.txt");
-
-        if (!archivo.is_open()) {
-            std::cout << "No se pudo crear el ticket.\n";
-            return;
-        }
-
-        // Fecha y hora
-        time_t now = time(nullptr);
-        tm* t = localtime(&now);
-
-        // Clculo de IVA
-        double subtotal = total / 1.16;
-        double iva = subtotal * 0.16;
+    static unsigned long long generarTicket(const std::string& producto, int cantidad, Dinero precioUnitario, Dinero total, const std::string& metodoPago,
+        const std::string& correo = "") {
 
-        archivo << "*************** TIENDA DE LA ESQUINA ****************\n";
-        archivo << "               RECIBO DE COMPRA\n";
-        archivo << "-------------------------------------------\n\n";
+        DatosTicket datos;
+        datos.producto = producto;
+        datos.cantidad = cantidad;
+        datos.precioUnitario = precioUnitario;
+        datos.total = total;
+        datos.metodoPago = metodoPago;
+        datos.folio = ArchivoTickets::instancia().reservarFolio();
+        datos.fecha = Reloj::ahora();
 
-        archivo << "Ticket No: 001283\n";
-        archivo << "Fecha: "
-            << std::put_time(t, "%d/%m/%Y")
-            << "   Hora: "
-            << std::put_time(t, "%H:%M:%S") << "\n\n";
+        std::string_view texto = RenderizadorTicket::local().renderizar(datos);
 
-        archivo << "Descripcin                          Precio \n";
-        archivo << "-------------------------------------------\n";
-
-        archivo << producto
-            << std::setw(35 - producto.length())
-            << "$" << precioUnitario << "\n";
-
-        archivo << "Cantidad: " << cantidad << "\n";
-        archivo << "-------------------------------------------\n\n";
-
-        archivo << std::fixed << std::setprecision(2);
-        archivo << "Subtotal:                           $" << subtotal << "\n";
-        archivo << "IVA (16%):                          $" << iva << "\n";
-        archivo << "TOTAL:                              $" << total << "\n\n";
+        if (!correo.empty()) {
+            if (ColaCorreos::instancia().encolarTicket(correo, datos.folio, texto)) {
+                std::cout << "Ticket en cola de envio a: " << correo << "\n";
+            }
+            else {
+                std::cout << "No se pudo enviar el ticket por correo.\n";
+            }
+        }
 
-        archivo << "Mtodo de pago: " << metodoPago << "\n";
-        archivo << "-------------------------------------------\n";
-        archivo << "   Gracias por su compra. Vuelva pronto :)\n";
-        archivo << "*******************************************\n";
+        if (EscritorTickets::instancia().encolar(datos.folio, datos.fecha, texto)) {
+            return datos.folio;
+        }
 
-        archivo.close();
+        // Sin hilo escritor activo, se escribe en línea
+        ArchivoTickets::instancia().guardar(datos.folio, datos.fecha, texto);
+        if (!RenderizadorTicket::escribir("ticket_compra.txt", texto)) {
+            std::cout << "No se pudo crear el ticket.\n";
+        }
+        return datos.folio;
     }
 };
@@ -0,0 +1,116 @@
+﻿#pragma once
+#include "ProgrammingPatterns/modelos/Dinero.h"
+#include <ctime>
+#include <string>
+#include <string_view>
+
+/**
+ * @file RenderizadorTicket.h
+ * @brief Motor de formato de tickets sobre un búfer fijo, sin memoria dinámica.
+ *
+ * El texto fijo del ticket (encabezado, separadores, etiquetas) está precompilado
+ * como constantes; los campos variables se escriben con `std::to_chars` directo
+ * en un búfer reutilizable. El resultado se entrega como `std::string_view` y se
+ * escribe al archivo con una sola llamada, sin flujos ni manipuladores `iomanip`.
+ *
+ * El formato es el del ticket original con tres diferencias: el texto va en UTF-8
+ * (antes "Descripción" y "Método" salían en Latin-1), el precio unitario lleva
+ * siempre dos decimales ("$63.00", antes "$63") y el subtotal y el IVA se
+ * calculan en centavos exactos, así que pueden diferir en un centavo de los que
+ * daba el cálculo con `double`.
+ *
+ * @date 2026-10-19
+ * @version 1.0
+ * @author Ari
+ */
+
+ /**
+  * @struct DatosTicket
+  * @brief Campos variables de un ticket de compra.
+  *
+  * Las cadenas son vistas: deben seguir vivas mientras se renderiza.
+  */
+struct
+DatosTicket {
+    std::string_view producto;
+    int cantidad = 0;
+    Dinero precioUnitario;
+    Dinero total;
+    std::string_view metodoPago;
+    unsigned long long folio = 0;
+    time_t fecha = 0;
+};
+
+/**
+ * @class RenderizadorTicket
+ * @brief Da formato a tickets en un búfer interno de tamaño fijo.
+ *
+ * Cada hilo debe usar su propio renderizador (ver `local()`). Si un ticket no
+ * cabe en el búfer, se trunca en lugar de pedir memoria.
+ */
+class
+RenderizadorTicket {
+public:
+
+    /// Tamaño del búfer de un ticket.
+    static constexpr size_t kCapacidad = 4096;
+
+private:
+
+    /// Búfer reutilizable.
+    char buffer[kCapacidad];
+
+    /// Bytes ocupados del búfer.
+    size_t usado = 0;
+
+    /**
+     * @brief Copia texto al búfer.
+     * @param texto Texto a agregar.
+     */
+    void agregar(std::string_view texto);
+
+    /**
+     * @brief Escribe un entero con ceros a la izquierda hasta `ancho` dígitos.
+     *
+     * @param valor Entero no negativo.
+     * @param ancho Dígitos mínimos.
+     */
+    void agregarEntero(unsigned long long valor, int ancho = 0);
+
+    /**
+     * @brief Escribe un monto como "1234.50".
+     * @param monto Monto a escribir.
+     */
+    void agregarDinero(Dinero monto);
+
+    /**
+     * @brief Escribe `n` espacios.
+     * @param n Número de espacios.
+     */
+    void agregarEspacios(size_t n);
+
+public:
+
+    /**
+     * @brief Renderizador propio del hilo actual.
+     * @return RenderizadorTicket& Renderizador reutilizable del hilo.
+     */
+    static RenderizadorTicket& local();
+
+    /**
+     * @brief Da formato al ticket completo.
+     *
+     * @param datos Campos del ticket.
+     * @return std::string_view Texto del ticket (válido hasta el siguiente render).
+     */
+    std::string_view renderizar(const DatosTicket& datos);
+
+    /**
+     * @brief Escribe un texto en un archivo con una sola escritura.
+     *
+     * @param archivo Ruta del archivo (se sobrescribe).
+     * @param texto Contenido.
+     * @return true si se escribió completo.
+     */
+    static bool escribir(const char* archivo, std::string_view texto);
+};
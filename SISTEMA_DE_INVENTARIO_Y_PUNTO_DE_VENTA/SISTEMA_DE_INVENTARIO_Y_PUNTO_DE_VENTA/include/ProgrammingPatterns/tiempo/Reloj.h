@@ -0,0 +1,135 @@
+﻿#pragma once
+#include <cstdint>
+#include <ctime>
+
+/**
+ * @file Reloj.h
+ * @brief Reloj del sistema con la hora local en caché y textos ya formateados.
+ *
+ * `localtime` no es segura entre hilos y cada llamada consulta la zona horaria.
+ * `Reloj::local()` guarda por hilo la hora local del último segundo pedido junto
+ * con sus textos "DD/MM/AAAA", "HH:MM:SS" e ISO. Dentro de la misma hora los
+ * minutos y segundos se calculan con aritmética, así que `localtime_r` se llama a
+ * lo más una vez por hora y por hilo.
+ *
+ * También define la fecha compacta usada por `Fecha`: días desde 1970-01-01.
+ *
+ * @date 2026-10-19
+ * @version 1.0
+ * @author Ari
+ */
+
+ /**
+  * @brief Días desde 1970-01-01 de una fecha del calendario gregoriano.
+  *
+  * @param anio Año (por ejemplo 2026).
+  * @param mes Mes 1-12.
+  * @param dia Día 1-31.
+  * @return std::int32_t Días desde la época (negativo antes de 1970).
+  */
+constexpr std::int32_t diasDesdeCivil(int anio, int mes, int dia) {
+    int a = mes <= 2 ? anio - 1 : anio;
+    int era = (a >= 0 ? a : a - 399) / 400;
+    int anioEra = a - era * 400;
+    int diaAnio = (153 * (mes + (mes > 2 ? -3 : 9)) + 2) / 5 + dia - 1;
+    int diaEra = anioEra * 365 + anioEra / 4 - anioEra / 100 + diaAnio;
+    return era * 146097 + diaEra - 719468;
+}
+
+/**
+ * @brief Fecha del calendario gregoriano a partir de días desde 1970-01-01.
+ *
+ * @param dias Días desde la época.
+ * @param anio Salida: año.
+ * @param mes Salida: mes 1-12.
+ * @param dia Salida: día 1-31.
+ */
+constexpr void civilDesdeDias(std::int32_t dias, int& anio, int& mes, int& dia) {
+    int z = dias + 719468;
+    int era = (z >= 0 ? z : z - 146096) / 146097;
+    int diaEra = z - era * 146097;
+    int anioEra = (diaEra - diaEra / 1460 + diaEra / 36524 - diaEra / 146096) / 365;
+    int diaAnio = diaEra - (365 * anioEra + anioEra / 4 - anioEra / 100);
+    int mp = (5 * diaAnio + 2) / 153;
+    dia = diaAnio - (153 * mp + 2) / 5 + 1;
+    mes = mp < 10 ? mp + 3 : mp - 9;
+    anio = anioEra + era * 400 + (mes <= 2 ? 1 : 0);
+}
+
+/**
+ * @struct InstanteLocal
+ * @brief Hora local de un segundo, desglosada y formateada.
+ */
+struct
+InstanteLocal {
+    time_t instante = 0;
+
+    /// Días desde 1970-01-01 en el calendario local.
+    std::int32_t diasDesdeEpoca = 0;
+
+    int anio = 1970;
+    int mes = 1;
+    int dia = 1;
+    int hora = 0;
+    int minuto = 0;
+    int segundo = 0;
+
+    /// Día de la semana (0 = domingo).
+    int diaSemana = 4;
+
+    /// Diferencia de la hora local con UTC, en minutos.
+    int desfaseMinutos = 0;
+
+    /// Día en formato AAAAMMDD.
+    int aaaammdd = 19700101;
+
+    /// "DD/MM/AAAA"
+    char textoFecha[11] = {};
+
+    /// "HH:MM:SS"
+    char textoHora[9] = {};
+
+    /// "AAAA-MM-DDTHH:MM:SS"
+    char textoIso[20] = {};
+};
+
+/**
+ * @class Reloj
+ * @brief Hora actual y hora local en caché, segura entre hilos.
+ */
+class
+Reloj {
+public:
+
+    /**
+     * @brief Instante actual en segundos.
+     */
+    static time_t ahora() { return time(nullptr); }
+
+    /**
+     * @brief Hora local de un instante.
+     *
+     * La referencia es del hilo que llama y vale hasta su siguiente llamada a
+     * `local()`; si se necesita guardar, se copia.
+     *
+     * @param instante Segundo a convertir.
+     * @return const InstanteLocal& Hora local desglosada y formateada.
+     */
+    static const InstanteLocal& local(time_t instante);
+
+    /**
+     * @brief Hora local del instante actual.
+     */
+    static const InstanteLocal& local() { return local(ahora()); }
+
+    /**
+     * @brief Límites del día local que contiene un instante.
+     *
+     * Usa `mktime`, así que respeta los días de 23 o 25 horas por horario de verano.
+     *
+     * @param instante Instante dentro del día.
+     * @param desde Salida: inicio del día.
+     * @param hasta Salida: inicio del día siguiente.
+     */
+    static void limitesDelDia(time_t instante, time_t& desde, time_t& hasta);
+};
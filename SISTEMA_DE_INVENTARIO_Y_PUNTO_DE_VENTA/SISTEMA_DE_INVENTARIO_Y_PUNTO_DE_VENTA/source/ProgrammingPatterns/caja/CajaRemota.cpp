@@ -0,0 +1,366 @@
+﻿/**
+ * @file CajaRemota.cpp
+ * @brief Venta con catálogo local, cola en disco y sincronización por lotes.
+ *
+ * @date 2026-10-19
+ * @version 1.0
+ * @author Ari
+ */
+#include "ProgrammingPatterns/caja/CajaRemota.h"
+#include "nlohmann/json.hpp"
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+#include <ctime>
+#include <fstream>
+#include <unordered_map>
+
+using json = nlohmann::json;
+
+CajaRemota::CajaRemota(const std::string& nombre, const std::string& direccion)
+    : nombre(nombre), direccion(direccion) {}
+
+void CajaRemota::abrir(const std::string& archivoCatalogo, const std::string& archivoCola,
+    const std::string& archivoConflictos) {
+
+    this->archivoCola = archivoCola;
+    this->archivoConflictos = archivoConflictos;
+    catalogo.cargarDesdeJson(archivoCatalogo);
+
+    // Cola: número siguiente y después las ventas, una tras otra
+    if (std::FILE* f = std::fopen(archivoCola.c_str(), "rb")) {
+        std::uint32_t numero = 0;
+        if (std::fread(&numero, sizeof(numero), 1, f) == 1) {
+            siguienteNumero = std::max<std::uint32_t>(numero, 1);
+        }
+        VentaPendiente v;
+        while (std::fread(&v, sizeof(v), 1, f) == 1) {
+            cola.push_back(v);
+            siguienteNumero = std::max(siguienteNumero, v.numero + 1);
+        }
+        std::fclose(f);
+        std::cout << " Ventas pendientes de enviar: " << cola.size() << "\n";
+    }
+    guardarCola();
+
+    std::ifstream file(archivoConflictos);
+    if (file.is_open()) {
+        json data;
+        file >> data;
+        for (auto& item : data) {
+            ConflictoVenta c;
+            c.numero = item["numero"].get<std::uint32_t>();
+            c.codigo = item["codigo"].get<std::string>();
+            c.fecha = item["fecha"].get<std::int64_t>();
+            c.cantidad = item["cantidad"].get<int>();
+            c.disponibles = item["disponibles"].get<int>();
+            c.totalCaja = Dinero::desdePesos(item["totalCaja"].get<double>());
+            c.totalServidor = Dinero::desdePesos(item["totalServidor"].get<double>());
+            c.motivo = item["motivo"].get<std::string>();
+            conflictos.push_back(std::move(c));
+        }
+    }
+}
+
+bool CajaRemota::conectar() {
+    if (conectada) {
+        return true;
+    }
+    cliente.setEspera(kEsperaMs);
+    if (!cliente.conectar(direccion)) {
+        return false;
+    }
+    SolicitudPOS s;
+    s.tipo = TipoSolicitud::Identificar;
+    s.texto = nombre;
+    RespuestaPOS r;
+    if (!cliente.solicitar(s, r) || r.estado != EstadoRespuesta::Ok) {
+        std::cout << "El servidor no acepto la caja " << nombre << ".\n";
+        cliente.cerrar();
+        return false;
+    }
+    conectada = true;
+    return true;
+}
+
+void CajaRemota::desconectar() {
+    cliente.cerrar();
+    conectada = false;
+}
+
+void CajaRemota::guardarCola() const {
+    std::FILE* f = std::fopen(archivoCola.c_str(), "wb");
+    if (f == nullptr) {
+        std::cout << "No se pudo guardar " << archivoCola << ".\n";
+        return;
+    }
+    std::fwrite(&siguienteNumero, sizeof(siguienteNumero), 1, f);
+    if (!cola.empty()) {
+        std::fwrite(cola.data(), sizeof(VentaPendiente), cola.size(), f);
+    }
+    std::fclose(f);
+}
+
+void CajaRemota::guardarConflictos() const {
+    json data = json::array();
+    for (const auto& c : conflictos) {
+        data.push_back({
+            {"numero", c.numero},
+            {"codigo", c.codigo},
+            {"fecha", c.fecha},
+            {"cantidad", c.cantidad},
+            {"disponibles", c.disponibles},
+            {"totalCaja", c.totalCaja.aPesos()},
+            {"totalServidor", c.totalServidor.aPesos()},
+            {"motivo", c.motivo}
+        });
+    }
+    std::ofstream file(archivoConflictos);
+    file << data.dump(2);
+}
+
+Dinero CajaRemota::vender(const std::string& codigo, int cantidad, std::uint8_t pago, std::uint8_t marca) {
+    if (cantidad <= 0 || codigo.size() >= sizeof(VentaPendiente::codigo)) {
+        std::cout << "Venta invalida.\n";
+        return Dinero();
+    }
+    const Producto* p = catalogo.buscarProducto(codigo);
+    if (p == nullptr) {
+        std::cout << "Producto no encontrado en el catalogo de la caja.\n";
+        return Dinero();
+    }
+    if (p->getCantidad() < cantidad) {
+        std::cout << "No hay suficiente stock (quedan " << p->getCantidad() << ").\n";
+        return Dinero();
+    }
+    Dinero precio = p->getPrecio();
+    Dinero total = catalogo.venderProducto(codigo, cantidad);
+
+    VentaPendiente v;
+    v.numero = siguienteNumero++;
+    v.cantidad = cantidad;
+    v.fecha = static_cast<std::int64_t>(time(nullptr));
+    v.precioCentavos = precio.getCentavos();
+    v.pago = pago;
+    v.marca = marca;
+    std::memcpy(v.codigo, codigo.c_str(), codigo.size() + 1);
+    cola.push_back(v);
+
+    // A disco antes de seguir: la venta ya se cobró
+    if (std::FILE* f = std::fopen(archivoCola.c_str(), "ab")) {
+        std::fwrite(&v, sizeof(v), 1, f);
+        std::fclose(f);
+    }
+
+    if (cola.size() >= kVentasPorLote) {
+        sincronizar();
+    }
+    return total;
+}
+
+void CajaRemota::anotarConflicto(const VentaPendiente& v, const RespuestaPOS& r, const char* motivo) {
+    ConflictoVenta c;
+    c.numero = v.numero;
+    c.codigo = v.codigo;
+    c.fecha = v.fecha;
+    c.cantidad = v.cantidad;
+    c.disponibles = r.estado == EstadoRespuesta::SinStock ? r.stock : 0;
+    c.totalCaja = Dinero::desdeCentavos(v.precioCentavos) * v.cantidad;
+    c.totalServidor = Dinero::desdeCentavos(r.centavos);
+    c.motivo = motivo;
+    conflictos.push_back(std::move(c));
+}
+
+void CajaRemota::revisarRespuesta(const VentaPendiente& v, const RespuestaPOS& r, ResumenSincronizacion& resumen,
+    std::unordered_map<std::string, int>& stockServidor) {
+
+    switch (r.estado) {
+    case EstadoRespuesta::Ok:
+        resumen.confirmadas++;
+        stockServidor[v.codigo] = r.stock;
+        if (r.centavos != v.precioCentavos * v.cantidad) {
+            anotarConflicto(v, r, "El servidor cobro otro precio");
+            resumen.conflictos++;
+        }
+        break;
+
+    case EstadoRespuesta::Repetida:
+        // El servidor ya la había atendido (antes de reiniciarse, por ejemplo)
+        resumen.confirmadas++;
+        stockServidor[v.codigo] = r.stock;
+        break;
+
+    case EstadoRespuesta::SinStock: {
+        // Otra caja vendió antes: se vende lo que queda y se anota el faltante
+        anotarConflicto(v, r, "Sin stock suficiente en el servidor");
+        resumen.conflictos++;
+        stockServidor[v.codigo] = 0;
+        if (r.stock > 0) {
+            VentaPendiente parcial = v;
+            parcial.numero = siguienteNumero++;
+            parcial.cantidad = r.stock;
+            cola.push_back(parcial);
+        }
+        break;
+    }
+
+    case EstadoRespuesta::NoEncontrado:
+        anotarConflicto(v, r, "El producto ya no existe en el servidor");
+        resumen.conflictos++;
+        break;
+
+    case EstadoRespuesta::Rechazada:
+        anotarConflicto(v, r, "Pago rechazado o el servidor no acepta ventas");
+        resumen.conflictos++;
+        break;
+
+    default:
+        anotarConflicto(v, r, "Venta invalida");
+        resumen.conflictos++;
+        break;
+    }
+}
+
+void CajaRemota::actualizarStock(const std::string& codigo, int stock) {
+    const Producto* p = catalogo.buscarProducto(codigo);
+    if (p == nullptr) {
+        return;
+    }
+    MovimientoInventario m;
+    m.tipo = MovimientoInventario::Tipo::Compra;
+    m.secuencia = catalogo.getSecuencia();
+    m.codigo = codigo;
+    m.stock = stock;
+    m.centavos = p->getPrecio().getCentavos();
+    catalogo.aplicarMovimiento(m);
+}
+
+CajaRemota::ResumenSincronizacion CajaRemota::sincronizar() {
+    ResumenSincronizacion resumen;
+    ultimaSincronizacion = std::chrono::steady_clock::now();
+    if (cola.empty()) {
+        resumen.completa = true;
+        return resumen;
+    }
+    if (!conectar()) {
+        return resumen;
+    }
+
+    std::unordered_map<std::string, int> stockServidor;
+    size_t hechas = 0;
+    bool correcto = true;
+    while (correcto && hechas < cola.size()) {
+        // Un lote sin esperar cada respuesta; llegan en el mismo orden
+        size_t inicio = hechas;
+        size_t fin = std::min(inicio + kVentasPorLote, cola.size());
+        for (size_t i = inicio; i < fin; i++) {
+            SolicitudPOS s;
+            s.tipo = TipoSolicitud::Venta;
+            s.id = cola[i].numero;
+            s.cantidad = cola[i].cantidad;
+            s.pago = cola[i].pago;
+            s.marca = cola[i].marca;
+            s.texto = cola[i].codigo;
+            cliente.encolar(s);
+        }
+        correcto = cliente.enviar();
+        for (size_t i = inicio; correcto && i < fin; i++) {
+            RespuestaPOS r;
+            correcto = cliente.recibir(r) && r.id == cola[i].numero;
+            if (correcto) {
+                // Copia: la revisión puede agregar a la cola
+                VentaPendiente v = cola[i];
+                revisarRespuesta(v, r, resumen, stockServidor);
+                hechas = i + 1;
+            }
+        }
+    }
+    if (!correcto) {
+        // Las ventas sin respuesta se reenvían después; el servidor no las repite
+        std::cout << "Se perdio la conexion con el servidor; las ventas pendientes se enviaran despues.\n";
+        desconectar();
+    }
+    cola.erase(cola.begin(), cola.begin() + static_cast<std::ptrdiff_t>(hechas));
+
+    // Existencia conocida: la del servidor menos lo que sigue en la cola
+    for (auto& par : stockServidor) {
+        for (const auto& v : cola) {
+            if (par.first == v.codigo) {
+                par.second -= v.cantidad;
+            }
+        }
+        actualizarStock(par.first, std::max(par.second, 0));
+    }
+
+    guardarCola();
+    if (resumen.conflictos > 0) {
+        guardarConflictos();
+    }
+    resumen.completa = cola.empty();
+    return resumen;
+}
+
+void CajaRemota::sincronizarSiToca(std::chrono::seconds intervalo) {
+    if (!cola.empty() && std::chrono::steady_clock::now() - ultimaSincronizacion >= intervalo) {
+        sincronizar();
+    }
+}
+
+bool CajaRemota::actualizarCatalogo(const std::string& archivoCatalogo) {
+    if (!conectar()) {
+        return false;
+    }
+
+    // Se piden las posiciones por ventanas; la primera respuesta dice cuántas hay
+    std::vector<std::unique_ptr<Producto>> nuevos;
+    size_t total = 1;
+    bool correcto = true;
+    while (correcto && nuevos.size() < total) {
+        size_t inicio = nuevos.size();
+        size_t fin = nuevos.empty() ? 1 : std::min(total, inicio + kVentanaCatalogo);
+        for (size_t i = inicio; i < fin; i++) {
+            SolicitudPOS s;
+            s.tipo = TipoSolicitud::Catalogo;
+            s.id = static_cast<std::uint32_t>(i);
+            s.cantidad = static_cast<std::int32_t>(i);
+            cliente.encolar(s);
+        }
+        correcto = cliente.enviar();
+        for (size_t i = inicio; correcto && i < fin; i++) {
+            RespuestaPOS r;
+            correcto = cliente.recibir(r);
+            if (!correcto) {
+                break;
+            }
+            total = static_cast<size_t>(r.folio);
+            size_t tab = r.texto.find('\t');
+            if (r.estado != EstadoRespuesta::Ok || tab == std::string::npos) {
+                // Catálogo vacío en el servidor
+                correcto = total == 0;
+                break;
+            }
+            nuevos.push_back(ProductoFactory::crearProducto(r.texto.substr(0, tab), r.texto.substr(tab + 1),
+                Dinero::desdeCentavos(r.centavos), r.stock));
+        }
+        if (total == 0) {
+            break;
+        }
+    }
+    if (!correcto) {
+        std::cout << "No se pudo descargar el catalogo; se conserva la copia anterior.\n";
+        desconectar();
+        return false;
+    }
+
+    catalogo.vaciar(0);
+    for (auto& p : nuevos) {
+        catalogo.agregarProducto(std::move(p));
+    }
+    for (const auto& v : cola) {
+        if (const Producto* p = catalogo.buscarProducto(v.codigo)) {
+            actualizarStock(v.codigo, std::max(p->getCantidad() - v.cantidad, 0));
+        }
+    }
+    catalogo.guardarAJson(archivoCatalogo);
+    return true;
+}
@@ -0,0 +1,138 @@
+﻿/**
+ * @file GeneradorCarga.cpp
+ * @brief Escritura de catálogos e historiales sintéticos y flujo de transacciones.
+ *
+ * @date 2026-10-19
+ * @version 1.0
+ * @author Ari
+ */
+#include "ProgrammingPatterns/carga/GeneradorCarga.h"
+#include <algorithm>
+#include <cstdio>
+
+// Sílabas para nombres legibles; solo ASCII, así el JSON no necesita escapes
+static const char* const kSilabas[] = {
+    "ma", "re", "ti", "lo", "sa", "ne", "ca", "pi", "do", "ru", "be", "fo",
+    "la", "mi", "so", "te", "va", "ze", "cu", "no", "ga", "li", "po", "de" };
+static const size_t kTotalSilabas = sizeof(kSilabas) / sizeof(kSilabas[0]);
+
+/// Precio base por litro de cada combustible, en centavos.
+static const long long kPrecioCombustible[3] = { 2350, 2590, 2530 };
+
+/// Tamaño del búfer de escritura de los archivos generados.
+static const size_t kBufferArchivo = 1 << 20;
+
+std::string GeneradorCarga::codigoProducto(size_t indice) {
+    char codigo[16];
+    std::snprintf(codigo, sizeof(codigo), "75%011llu", static_cast<unsigned long long>(indice));
+    return codigo;
+}
+
+/**
+ * @brief Arma un nombre de producto del largo indicado con sílabas y espacios.
+ */
+static void generarNombre(std::mt19937_64& generador, size_t largo, std::string& nombre) {
+    nombre.clear();
+    size_t palabra = 0;
+    while (nombre.size() < largo) {
+        if (palabra >= 4 + generador() % 6 && nombre.size() + 1 < largo) {
+            nombre += ' ';
+            palabra = 0;
+            continue;
+        }
+        const char* silaba = kSilabas[generador() % kTotalSilabas];
+        nombre += silaba;
+        palabra += 2;
+    }
+    nombre.resize(largo);
+    nombre[0] = static_cast<char>(nombre[0] - 'a' + 'A');
+}
+
+bool GeneradorCarga::generarCatalogo(const ConfiguracionCatalogo& config, const std::string& archivo) {
+    std::FILE* f = std::fopen(archivo.c_str(), "wb");
+    if (f == nullptr) {
+        return false;
+    }
+    std::setvbuf(f, nullptr, _IOFBF, kBufferArchivo);
+
+    std::mt19937_64 generador(config.semilla);
+    std::normal_distribution<double> largo(config.largoMedio, config.largoDesviacion);
+    std::uniform_int_distribution<long long> precio(config.precioMinimoCentavos, config.precioMaximoCentavos);
+
+    std::string nombre;
+    std::fputs("[\n", f);
+    for (size_t i = 0; i < config.productos; i++) {
+        double l = std::round(largo(generador));
+        size_t largoNombre = static_cast<size_t>(std::clamp(l, static_cast<double>(config.largoMinimo),
+            static_cast<double>(config.largoMaximo)));
+        generarNombre(generador, largoNombre, nombre);
+        long long centavos = precio(generador);
+
+        std::fprintf(f, "  {\n    \"cantidad\": %d,\n    \"id\": \"75%011llu\",\n    \"nombre\": \"%s\",\n"
+            "    \"precio\": %lld.%02lld\n  }%s\n",
+            config.stockInicial, static_cast<unsigned long long>(i), nombre.c_str(),
+            centavos / 100, centavos % 100, i + 1 < config.productos ? "," : "");
+    }
+    std::fputs("]\n", f);
+    return std::fclose(f) == 0;
+}
+
+bool GeneradorCarga::generarHistorialGas(size_t registros, std::uint64_t semilla, const std::string& archivo) {
+    std::FILE* f = std::fopen(archivo.c_str(), "wb");
+    if (f == nullptr) {
+        return false;
+    }
+    std::setvbuf(f, nullptr, _IOFBF, kBufferArchivo);
+
+    std::mt19937_64 generador(semilla);
+    std::uniform_int_distribution<int> decilitros(50, 600);
+
+    std::fputs("[\n", f);
+    for (size_t i = 0; i < registros; i++) {
+        int tipo = static_cast<int>(generador() % 3);
+        int dl = decilitros(generador);
+        long long precio = kPrecioCombustible[tipo];
+        long long total = (precio * dl + 5) / 10;
+
+        std::fprintf(f, "  {\n    \"litros\": %d.%d,\n    \"precioLitro\": %lld.%02lld,\n    \"tipo\": \"%s\",\n"
+            "    \"totalPagado\": %lld.%02lld,\n    \"versionPrecio\": 0\n  }%s\n",
+            dl / 10, dl % 10, precio / 100, precio % 100, kCombustibles[tipo],
+            total / 100, total % 100, i + 1 < registros ? "," : "");
+    }
+    std::fputs("]\n", f);
+    return std::fclose(f) == 0;
+}
+
+std::vector<OperacionCarga> GeneradorCarga::generarOperaciones(size_t total, size_t productos, double exponenteZipf,
+    const MezclaOperaciones& mezcla, std::uint64_t semilla) {
+    std::vector<OperacionCarga> operaciones(total);
+    if (productos == 0) {
+        return operaciones;
+    }
+
+    std::mt19937_64 generador(semilla);
+    DistribucionZipf popularidad(productos, exponenteZipf);
+    std::discrete_distribution<int> tipo({ mezcla.ventas, mezcla.reposiciones, mezcla.cargas });
+    std::uniform_int_distribution<int> pago(1, 3);
+    std::uniform_int_distribution<int> decilitros(50, 600);
+
+    for (auto& op : operaciones) {
+        op.tipo = static_cast<OperacionCarga::Tipo>(tipo(generador));
+        op.pago = static_cast<std::uint8_t>(pago(generador));
+        switch (op.tipo) {
+        case OperacionCarga::Venta:
+            op.producto = static_cast<std::uint32_t>(popularidad(generador));
+            op.cantidad = 1 + static_cast<std::int32_t>(generador() % 3);
+            break;
+        case OperacionCarga::Reposicion:
+            op.producto = static_cast<std::uint32_t>(popularidad(generador));
+            op.cantidad = 10 + static_cast<std::int32_t>(generador() % 41);
+            break;
+        case OperacionCarga::Carga:
+            op.combustible = static_cast<std::uint8_t>(generador() % 3);
+            op.litros = decilitros(generador) / 10.0;
+            break;
+        }
+    }
+    return operaciones;
+}
@@ -0,0 +1,224 @@
+﻿/**
+ * @file ColaCorreos.cpp
+ * @brief Hilo de envío de correos: persistencia en disco, entrega y reintentos.
+ *
+ * @date 2026-10-19
+ * @version 1.0
+ * @author Ari
+ */
+#include "ProgrammingPatterns/correo/ColaCorreos.h"
+#include "ProgrammingPatterns/metricas/Traza.h"
+#include "ProgrammingPatterns/tiempo/Reloj.h"
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+#include <sstream>
+
+/**
+ * @brief Escribe un archivo completo.
+ *
+ * @param ruta Archivo destino.
+ * @param texto Contenido.
+ * @return true si se escribió completo.
+ */
+static bool escribirArchivo(const std::string& ruta, const std::string& texto) {
+    std::FILE* f = std::fopen(ruta.c_str(), "wb");
+    if (f == nullptr) {
+        return false;
+    }
+    bool completo = std::fwrite(texto.data(), 1, texto.size(), f) == texto.size();
+    return std::fclose(f) == 0 && completo;
+}
+
+/**
+ * @brief Instancia compartida de la cola.
+ * @return ColaCorreos& Cola del sistema.
+ */
+ColaCorreos& ColaCorreos::instancia() {
+    static ColaCorreos cola;
+    return cola;
+}
+
+ColaCorreos::~ColaCorreos() {
+    detener();
+}
+
+void ColaCorreos::iniciar(const std::string& carpeta, std::unique_ptr<DestinoCorreo> destino) {
+    std::lock_guard<std::mutex> lock(mutexCola);
+    if (activo) {
+        return;
+    }
+    this->carpeta = carpeta;
+    this->destino = std::move(destino);
+
+    std::error_code error;
+    std::filesystem::create_directories(carpeta + "/cola", error);
+    std::filesystem::create_directories(carpeta + "/fallidos", error);
+
+    // Los nombres empiezan en el reloj actual para no chocar con los de otra ejecución
+    secuencia = static_cast<unsigned long long>(
+        std::chrono::duration_cast<std::chrono::microseconds>(
+            std::chrono::system_clock::now().time_since_epoch()).count());
+
+    recuperar();
+
+    activo = true;
+    detenerSolicitado = false;
+    hilo = std::thread(&ColaCorreos::enviar, this);
+}
+
+void ColaCorreos::recuperar() {
+    std::error_code error;
+    auto ahora = std::chrono::steady_clock::now();
+    for (const auto& entrada : std::filesystem::directory_iterator(carpeta + "/cola", error)) {
+        if (!entrada.is_regular_file()) {
+            continue;
+        }
+        std::ifstream archivo(entrada.path(), std::ios::binary);
+        std::ostringstream contenido;
+        contenido << archivo.rdbuf();
+
+        Correo correo;
+        correo.nombre = entrada.path().filename().string();
+        correo.mensaje = contenido.str();
+        correo.proximoIntento = ahora;
+        size_t inicio = correo.mensaje.find("To: ");
+        if (inicio != std::string::npos) {
+            inicio += 4;
+            correo.destinatario = correo.mensaje.substr(inicio, correo.mensaje.find('\n', inicio) - inicio);
+        }
+        pendientes.push_back(std::move(correo));
+    }
+
+    if (!pendientes.empty()) {
+        enEspera += pendientes.size();
+        std::cout << " " << pendientes.size() << " correo(s) pendiente(s) recuperado(s) de " << carpeta << "/cola\n";
+    }
+}
+
+void ColaCorreos::detener() {
+    {
+        std::lock_guard<std::mutex> lock(mutexCola);
+        if (!activo) {
+            return;
+        }
+        activo = false;
+        detenerSolicitado = true;
+    }
+    hayCorreos.notify_all();
+    hilo.join();
+}
+
+bool ColaCorreos::encolarTicket(const std::string& destinatario, unsigned long long folio, std::string_view ticket) {
+    Correo correo;
+    correo.destinatario = destinatario;
+    correo.nombre = std::to_string(secuencia++) + "_F" + std::to_string(folio) + ".eml";
+
+    // Fecha en formato de correo (RFC 5322), con nombres en inglés como pide el estándar
+    static const char* const kDias[] = { "Sun", "Mon", "Tue", "Wed", "Thu", "Fri", "Sat" };
+    static const char* const kMeses[] = { "Jan", "Feb", "Mar", "Apr", "May", "Jun",
+        "Jul", "Aug", "Sep", "Oct", "Nov", "Dec" };
+    const InstanteLocal& local = Reloj::local();
+    int desfase = local.desfaseMinutos < 0 ? -local.desfaseMinutos : local.desfaseMinutos;
+    char fecha[64];
+    std::snprintf(fecha, sizeof(fecha), "%s, %02d %s %04d %s %c%02d%02d", kDias[local.diaSemana], local.dia,
+        kMeses[local.mes - 1], local.anio, local.textoHora, local.desfaseMinutos < 0 ? '-' : '+',
+        desfase / 60, desfase % 60);
+    char asunto[64];
+    std::snprintf(asunto, sizeof(asunto), "Ticket de compra folio %06llu", folio);
+
+    correo.mensaje.reserve(ticket.size() + 256);
+    correo.mensaje += "From: Tienda <tickets@tienda.local>\n";
+    correo.mensaje += "To: " + destinatario + "\n";
+    correo.mensaje += std::string("Subject: ") + asunto + "\n";
+    correo.mensaje += std::string("Date: ") + fecha + "\n";
+    correo.mensaje += "Message-ID: <" + correo.nombre + "@tienda.local>\n";
+    correo.mensaje += "Content-Type: text/plain; charset=UTF-8\n\n";
+    correo.mensaje += ticket;
+
+    {
+        std::lock_guard<std::mutex> lock(mutexCola);
+        if (!activo) {
+            return false;
+        }
+        nuevos.push_back(std::move(correo));
+        enEspera++;
+    }
+    hayCorreos.notify_one();
+    return true;
+}
+
+bool ColaCorreos::intentar(Correo& correo) {
+    std::string enCola = carpeta + "/cola/" + correo.nombre;
+    if (destino->entregar(correo)) {
+        std::remove(enCola.c_str());
+        entregados++;
+        return true;
+    }
+
+    correo.intentos++;
+    if (correo.intentos >= kMaxIntentos) {
+        std::error_code error;
+        std::filesystem::rename(enCola, carpeta + "/fallidos/" + correo.nombre, error);
+        return true;
+    }
+
+    auto espera = kEsperaBase * (1 << (correo.intentos - 1));
+    correo.proximoIntento = std::chrono::steady_clock::now() + std::min<std::chrono::seconds>(espera, kEsperaMaxima);
+    return false;
+}
+
+/**
+ * @brief Toma los mensajes nuevos, los guarda y entrega los que ya tocan.
+ *
+ * La cola se revisa cuando llega un mensaje o cuando vence el reintento más
+ * próximo; mientras no hay nada que hacer, el hilo duerme.
+ */
+void ColaCorreos::enviar() {
+    Traza::instancia().nombrarHilo("ColaCorreos");
+    while (true) {
+        std::deque<Correo> lote;
+        bool salir;
+        {
+            auto despertar = std::chrono::steady_clock::time_point::max();
+            for (const auto& c : pendientes) {
+                despertar = std::min(despertar, c.proximoIntento);
+            }
+
+            std::unique_lock<std::mutex> lock(mutexCola);
+            auto hayTrabajo = [this] { return detenerSolicitado || !nuevos.empty(); };
+            if (despertar == std::chrono::steady_clock::time_point::max()) {
+                hayCorreos.wait(lock, hayTrabajo);
+            }
+            else {
+                hayCorreos.wait_until(lock, despertar, hayTrabajo);
+            }
+            lote.swap(nuevos);
+            salir = detenerSolicitado;
+        }
+
+        // Primero a disco: desde aquí el mensaje sobrevive a un reinicio
+        auto ahora = std::chrono::steady_clock::now();
+        for (auto& c : lote) {
+            if (!escribirArchivo(carpeta + "/cola/" + c.nombre, c.mensaje)) {
+                std::cout << "No se pudo guardar el correo " << c.nombre << " en la cola.\n";
+            }
+            c.proximoIntento = ahora;
+            pendientes.push_back(std::move(c));
+        }
+
+        for (auto it = pendientes.begin(); it != pendientes.end();) {
+            if (it->proximoIntento <= ahora && intentar(*it)) {
+                it = pendientes.erase(it);
+                enEspera--;
+            }
+            else {
+                ++it;
+            }
+        }
+
+        if (salir) {
+            break;
+        }
+    }
+}
@@ -0,0 +1,43 @@
+﻿/**
+ * @file DestinoCorreo.cpp
+ * @brief Entrega local de correo en formato maildir.
+ *
+ * @date 2026-10-19
+ * @version 1.0
+ * @author Ari
+ */
+#include "ProgrammingPatterns/correo/DestinoCorreo.h"
+#include <cstdio>
+#include <filesystem>
+
+BuzonMaildir::BuzonMaildir(const std::string& carpeta, double tasaFallo)
+    : carpeta(carpeta), tasaFallo(tasaFallo), generador(std::random_device{}()) {
+    std::error_code error;
+    std::filesystem::create_directories(carpeta + "/tmp", error);
+    std::filesystem::create_directories(carpeta + "/new", error);
+}
+
+bool BuzonMaildir::entregar(const Correo& correo) {
+    if (tasaFallo > 0.0) {
+        std::lock_guard<std::mutex> lock(mutexGenerador);
+        if (std::uniform_real_distribution<double>(0.0, 1.0)(generador) < tasaFallo) {
+            return false;
+        }
+    }
+
+    std::string temporal = carpeta + "/tmp/" + correo.nombre;
+    std::FILE* f = std::fopen(temporal.c_str(), "wb");
+    if (f == nullptr) {
+        return false;
+    }
+    bool completo = std::fwrite(correo.mensaje.data(), 1, correo.mensaje.size(), f) == correo.mensaje.size();
+    completo = std::fclose(f) == 0 && completo;
+    if (!completo) {
+        std::remove(temporal.c_str());
+        return false;
+    }
+
+    std::error_code error;
+    std::filesystem::rename(temporal, carpeta + "/new/" + correo.nombre, error);
+    return !error;
+}
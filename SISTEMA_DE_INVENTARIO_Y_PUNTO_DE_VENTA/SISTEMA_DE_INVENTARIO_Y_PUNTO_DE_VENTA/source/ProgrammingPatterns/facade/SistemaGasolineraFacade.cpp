@@ -2,11 +2,11 @@
 
 /**
  * @file SistemaGasolineraFacade.cpp
- * @brief Implementacin del mtodo principal del Facade para la gasolinera.
+ * @brief Implementación del método principal del Facade para la gasolinera.
  *
- * Este archivo contiene la lgica que simplifica el proceso de registrar
- * una carga de gasolina. El cliente solo necesita llamar a este mtodo,
- * evitando manejar directamente la interaccin con la clase Gasolinera.
+ * Este archivo contiene la lógica que simplifica el proceso de registrar
+ * una carga de gasolina. El cliente solo necesita llamar a este método,
+ * evitando manejar directamente la interacción con la clase Gasolinera.
  *  * @date 2025-12-04
  * @version 1.0
  * @author Ari
@@ -15,9 +15,28 @@
 void SistemaGasolineraFacade::procesarCarga(Gasolinera& gasolinera,
     double litros,
     const std::string& tipo,
-    double precioLitro,
+    Dinero precioLitro,
     MetodoPago* metodo) {
 
-    // Delegamos toda la lgica interna a la clase Gasolinera.
+    // Delegamos toda la lógica interna a la clase Gasolinera.
     gasolinera.registrarCarga(litros, tipo, precioLitro, metodo);
 }
+
+void SistemaGasolineraFacade::procesarCarga(Gasolinera& gasolinera,
+    double litros,
+    const std::string& tipo,
+    MetodoPago* metodo) {
+
+    // El precio sale de la tabla de precios vigente.
+    gasolinera.registrarCarga(litros, tipo, metodo);
+}
+
+void SistemaGasolineraFacade::procesarCargaAsincrona(Gasolinera& gasolinera,
+    double litros,
+    const std::string& tipo,
+    PagoVariante& pago,
+    AutorizadorPagos& autorizador) {
+
+    // La autorización de la tarjeta se resuelve en segundo plano.
+    gasolinera.registrarCargaAsincrona(litros, tipo, &comoMetodoPago(pago), marcaDe(pago), autorizador);
+}
@@ -1,13 +1,13 @@
 /**
  * @file ProductoFactory.cpp
- * @brief Implementacin de la clase ProductoFactory.
+ * @brief Implementación de la clase ProductoFactory.
  *
- * Esta clase implementa el mtodo de fbrica responsable de crear objetos
- * `Producto` de manera dinmica, utilizando punteros inteligentes para una
- * gestin segura de memoria.
+ * Esta clase implementa el método de fábrica responsable de crear objetos
+ * `Producto` de manera dinámica, utilizando punteros inteligentes para una
+ * gestión segura de memoria.
  *
- * Forma parte del patrn de diseo **Factory Method**, utilizado para
- * centralizar y estandarizar la creacin de instancias de productos.
+ * Forma parte del patrón de diseño **Factory Method**, utilizado para
+ * centralizar y estandarizar la creación de instancias de productos.
  *
  * @date 2025-11-07
  * @version 1.0
@@ -18,16 +18,16 @@
  /**
   * @brief Crea una nueva instancia de la clase `Producto`.
   *
-  * Este mtodo construye un producto con los valores especificados y devuelve
-  * un puntero inteligente (`std::unique_ptr`) que garantiza la liberacin
-  * automtica de memoria cuando el objeto ya no es necesario.
+  * Este método construye un producto con los valores especificados y devuelve
+  * un puntero inteligente (`std::unique_ptr`) que garantiza la liberación
+  * automática de memoria cuando el objeto ya no es necesario.
   *
-  * @param codigo Identificador nico del producto.
+  * @param codigo Identificador único del producto.
   * @param nombre Nombre del producto.
   * @param precio Precio unitario del producto.
   * @param cantidad Cantidad inicial disponible en inventario.
-  * @return std::unique_ptr<Producto> Puntero nico al producto creado.
+  * @return std::unique_ptr<Producto> Puntero único al producto creado.
   */
-std::unique_ptr<Producto> ProductoFactory::crearProducto(const std::string& codigo, const std::string& nombre, double precio, int cantidad) {
+std::unique_ptr<Producto> ProductoFactory::crearProducto(const std::string& codigo, const std::string& nombre, Dinero precio, int cantidad) {
 	return std::make_unique<Producto>(codigo, nombre, precio, cantidad);
 }
\ No newline at end of file
@@ -0,0 +1,294 @@
+﻿/**
+ * @file GeneradorFacturas.cpp
+ * @brief Escritura en flujo del XML de facturas y generación por lote en paralelo.
+ *
+ * @date 2026-10-19
+ * @version 1.0
+ * @author Ari
+ */
+#include "ProgrammingPatterns/facturas/GeneradorFacturas.h"
+#include "ProgrammingPatterns/tickets/EscritorTickets.h"
+#include "ProgrammingPatterns/tiempo/Reloj.h"
+#include <algorithm>
+#include <charconv>
+#include <filesystem>
+#include <thread>
+
+// Datos fijos del emisor y del receptor genérico (público en general)
+static constexpr std::string_view kEmisor =
+    "  <cfdi:Emisor Rfc=\"TES000101AAA\" Nombre=\"TIENDA DE LA ESQUINA\" RegimenFiscal=\"601\"/>\n"
+    "  <cfdi:Receptor Rfc=\"XAXX010101000\" Nombre=\"PUBLICO EN GENERAL\" DomicilioFiscalReceptor=\"00000\""
+    " RegimenFiscalReceptor=\"616\" UsoCFDI=\"S01\"/>\n"
+    "  <cfdi:Conceptos>\n";
+static constexpr std::string_view kDeclaracion = "<?xml version=\"1.0\" encoding=\"UTF-8\"?>\n";
+
+/// Tamaño a partir del cual un hilo del lote vacía su búfer al archivo.
+static const size_t kBloqueLote = 1024 * 1024;
+
+/// Ventas por hilo a partir de las cuales conviene repartir el lote.
+static const size_t kVentasPorHilo = 2048;
+
+static void agregarEntero(std::string& s, long long valor, int ancho = 0) {
+    char digitos[24];
+    std::to_chars_result r = std::to_chars(digitos, digitos + sizeof(digitos), valor);
+    for (long long i = r.ptr - digitos; i < ancho; i++) {
+        s += '0';
+    }
+    s.append(digitos, r.ptr);
+}
+
+static void agregarDinero(std::string& s, long long centavos) {
+    if (centavos < 0) {
+        s += '-';
+        centavos = -centavos;
+    }
+    agregarEntero(s, centavos / 100);
+    s += '.';
+    agregarEntero(s, centavos % 100, 2);
+}
+
+/**
+ * @brief Agrega texto escapando los caracteres especiales de XML.
+ */
+static void agregarEscapado(std::string& s, std::string_view texto) {
+    for (char c : texto) {
+        switch (c) {
+        case '&': s += "&amp;"; break;
+        case '<': s += "&lt;"; break;
+        case '>': s += "&gt;"; break;
+        case '"': s += "&quot;"; break;
+        case '\'': s += "&apos;"; break;
+        default: s += c; break;
+        }
+    }
+}
+
+/**
+ * @brief Clave de forma de pago del SAT para el tipo de pago.
+ */
+static const char* formaPago(std::uint8_t tipo) {
+    switch (static_cast<TipoPago>(tipo)) {
+    case TipoPago::Efectivo: return "01";
+    case TipoPago::Credito: return "04";
+    case TipoPago::Debito: return "28";
+    default: return "99";
+    }
+}
+
+/**
+ * @brief Renderiza el comprobante de una venta: precios con IVA incluido,
+ * desglosados como subtotal + traslado de IVA 16%.
+ *
+ * @param venta Venta a facturar.
+ * @param s Texto al que se agrega el comprobante.
+ */
+void GeneradorFacturas::renderizar(const VentaFacturable& venta, std::string& s) {
+    Dinero total = Dinero::desdeCentavos(venta.totalCentavos);
+    long long subtotal = total.escalar(100, 116).getCentavos();
+    long long iva = venta.totalCentavos - subtotal;
+    long long valorUnitario = Dinero::desdeCentavos(venta.precioUnitarioCentavos).escalar(100, 116).getCentavos();
+
+    s += "<cfdi:Comprobante xmlns:cfdi=\"http://www.sat.gob.mx/cfd/4\" Version=\"4.0\" Serie=\"A\" Folio=\"";
+    agregarEntero(s, static_cast<long long>(venta.folio), 6);
+    s += "\" Fecha=\"";
+    s += Reloj::local(static_cast<time_t>(venta.fecha)).textoIso;
+    s += "\" FormaPago=\"";
+    s += formaPago(venta.tipoPago);
+    s += "\" SubTotal=\"";
+    agregarDinero(s, subtotal);
+    s += "\" Moneda=\"MXN\" Total=\"";
+    agregarDinero(s, venta.totalCentavos);
+    s += "\" TipoDeComprobante=\"I\" Exportacion=\"01\" MetodoPago=\"PUE\" LugarExpedicion=\"00000\">\n";
+
+    s += kEmisor;
+    s += "    <cfdi:Concepto ClaveProdServ=\"01010101\" NoIdentificacion=\"";
+    agregarEscapado(s, venta.codigo);
+    s += "\" Cantidad=\"";
+    agregarEntero(s, venta.cantidad);
+    s += "\" ClaveUnidad=\"H87\" Descripcion=\"";
+    agregarEscapado(s, venta.descripcion);
+    s += "\" ValorUnitario=\"";
+    agregarDinero(s, valorUnitario);
+    s += "\" Importe=\"";
+    agregarDinero(s, subtotal);
+    s += "\" ObjetoImp=\"02\">\n";
+    s += "      <cfdi:Impuestos><cfdi:Traslados><cfdi:Traslado Base=\"";
+    agregarDinero(s, subtotal);
+    s += "\" Impuesto=\"002\" TipoFactor=\"Tasa\" TasaOCuota=\"0.160000\" Importe=\"";
+    agregarDinero(s, iva);
+    s += "\"/></cfdi:Traslados></cfdi:Impuestos>\n";
+    s += "    </cfdi:Concepto>\n  </cfdi:Conceptos>\n";
+
+    s += "  <cfdi:Impuestos TotalImpuestosTrasladados=\"";
+    agregarDinero(s, iva);
+    s += "\"><cfdi:Traslados><cfdi:Traslado Base=\"";
+    agregarDinero(s, subtotal);
+    s += "\" Impuesto=\"002\" TipoFactor=\"Tasa\" TasaOCuota=\"0.160000\" Importe=\"";
+    agregarDinero(s, iva);
+    s += "\"/></cfdi:Traslados></cfdi:Impuestos>\n";
+    s += "</cfdi:Comprobante>\n";
+}
+
+/**
+ * @brief Renderiza la factura de una venta y la manda a escribir.
+ *
+ * El búfer es del hilo y conserva su capacidad entre ventas.
+ *
+ * @param venta Venta a facturar.
+ * @return true si la factura se escribió o quedó en cola.
+ */
+bool GeneradorFacturas::facturar(const VentaFacturable& venta) {
+    thread_local std::string texto;
+    texto.clear();
+    texto += kDeclaracion;
+    renderizar(venta, texto);
+
+    char ruta[64];
+    std::snprintf(ruta, sizeof(ruta), "%s/A%06llu.xml", kCarpeta, static_cast<unsigned long long>(venta.folio));
+
+    // La carpeta se crea una sola vez; el cobro no vuelve a tocar el disco
+    static const bool carpetaLista = [] {
+        std::error_code error;
+        std::filesystem::create_directories(kCarpeta, error);
+        return !error;
+    }();
+    (void)carpetaLista;
+
+    if (EscritorTickets::instancia().encolarDocumento(ruta, texto)) {
+        return true;
+    }
+
+    if (!RenderizadorTicket::escribir(ruta, texto)) {
+        std::cout << "No se pudo escribir la factura " << ruta << "\n";
+        return false;
+    }
+    return true;
+}
+
+/**
+ * @brief Renderiza un tramo del lote y lo escribe en su propio archivo.
+ *
+ * @param inicio Primera venta del tramo.
+ * @param fin Fin del tramo.
+ * @param ruta Archivo de la parte.
+ * @param etiqueta Texto del lote.
+ * @param parte Número de parte.
+ * @param generadas Salida: facturas escritas (cero si la parte falló).
+ * @return true si la parte se escribió completa.
+ */
+static bool facturarTramo(const VentaFacturable* inicio, const VentaFacturable* fin, const std::string& ruta,
+    const std::string& etiqueta, size_t parte, size_t& generadas) {
+    generadas = 0;
+    std::FILE* f = std::fopen(ruta.c_str(), "wb");
+    if (f == nullptr) {
+        return false;
+    }
+
+    std::string bloque;
+    bloque.reserve(kBloqueLote + 4096);
+    bloque += kDeclaracion;
+    bloque += "<LoteFacturas Etiqueta=\"";
+    agregarEscapado(bloque, etiqueta);
+    bloque += "\" Parte=\"";
+    agregarEntero(bloque, static_cast<long long>(parte));
+    bloque += "\">\n";
+
+    size_t renderizadas = 0;
+    bool correcta = true;
+    for (const VentaFacturable* v = inicio; v != fin && correcta; ++v) {
+        GeneradorFacturas::renderizar(*v, bloque);
+        renderizadas++;
+        if (bloque.size() >= kBloqueLote) {
+            correcta = std::fwrite(bloque.data(), 1, bloque.size(), f) == bloque.size();
+            bloque.clear();
+        }
+    }
+    if (correcta) {
+        bloque += "</LoteFacturas>\n";
+        correcta = std::fwrite(bloque.data(), 1, bloque.size(), f) == bloque.size();
+    }
+    if (std::fclose(f) != 0) {
+        correcta = false;
+    }
+    if (!correcta) {
+        // Una parte incompleta no es XML válido
+        std::error_code error;
+        std::filesystem::remove(ruta, error);
+        return false;
+    }
+    generadas = renderizadas;
+    return true;
+}
+
+/**
+ * @brief Reparte las ventas entre los núcleos y genera un archivo por parte.
+ *
+ * @param ventas Ventas a facturar.
+ * @param etiqueta Texto para los nombres de archivo.
+ * @return size_t Facturas generadas.
+ */
+size_t GeneradorFacturas::facturarLote(const std::vector<VentaFacturable>& ventas, const std::string& etiqueta) {
+    if (ventas.empty()) {
+        std::cout << "No hay ventas para facturar.\n";
+        return 0;
+    }
+
+    std::error_code error;
+    std::filesystem::create_directories(kCarpeta, error);
+
+    size_t n = ventas.size();
+    size_t maxHilos = std::max(1u, std::thread::hardware_concurrency());
+    size_t numHilos = std::min(maxHilos, n / kVentasPorHilo + 1);
+    size_t tramo = (n + numHilos - 1) / numHilos;
+
+    std::vector<size_t> generadas(numHilos, 0);
+    std::vector<char> correctas(numHilos, 0);
+    std::vector<std::string> rutas(numHilos);
+    std::vector<std::thread> hilos;
+    for (size_t h = 0; h < numHilos; h++) {
+        char nombre[32];
+        std::snprintf(nombre, sizeof(nombre), "_parte%02zu.xml", h + 1);
+        rutas[h] = std::string(kCarpeta) + "/Lote_" + etiqueta + nombre;
+        const VentaFacturable* inicio = ventas.data() + std::min(n, h * tramo);
+        const VentaFacturable* fin = ventas.data() + std::min(n, (h + 1) * tramo);
+        hilos.emplace_back([&rutas, &etiqueta, &generadas, &correctas, inicio, fin, h] {
+            correctas[h] = facturarTramo(inicio, fin, rutas[h], etiqueta, h + 1, generadas[h]);
+        });
+    }
+
+    // Los mensajes se dan al unir, para no mezclar la salida de los hilos
+    size_t total = 0;
+    size_t escritas = 0;
+    for (size_t h = 0; h < numHilos; h++) {
+        hilos[h].join();
+        if (!correctas[h]) {
+            std::cout << "No se pudo escribir la parte " << rutas[h] << "\n";
+            continue;
+        }
+        total += generadas[h];
+        escritas++;
+    }
+
+    std::cout << total << " factura(s) generadas en " << escritas << " archivo(s) " << kCarpeta << "/Lote_"
+        << etiqueta << "_parteNN.xml\n";
+    if (escritas != numHilos) {
+        std::cout << (numHilos - escritas) << " de " << numHilos << " parte(s) no se generaron.\n";
+    }
+    return total;
+}
+
+/**
+ * @brief Factura las ventas registradas en el día (hora local) indicado.
+ *
+ * @param dia Instante dentro del día.
+ * @return size_t Facturas generadas.
+ */
+size_t GeneradorFacturas::facturarDia(time_t dia) {
+    time_t desde;
+    time_t hasta;
+    Reloj::limitesDelDia(dia, desde, hasta);
+    std::string etiqueta(Reloj::local(dia).textoIso, 10);
+
+    RegistroVentas::instancia().guardar();
+    return facturarLote(RegistroVentas::instancia().ventasEntre(desde, hasta), etiqueta);
+}
@@ -0,0 +1,197 @@
+﻿/**
+ * @file RegistroVentas.cpp
+ * @brief Diario binario de ventas facturables.
+ *
+ * @date 2026-10-19
+ * @version 1.0
+ * @author Ari
+ */
+#include "ProgrammingPatterns/facturas/RegistroVentas.h"
+#include "ProgrammingPatterns/metricas/Traza.h"
+#include <cstring>
+#include <filesystem>
+
+/**
+ * @brief Copia texto a un campo de tamaño fijo, terminado en cero.
+ *
+ * Si no cabe, se corta antes del carácter UTF-8 que quedaría partido (la
+ * factura declara `encoding="UTF-8"` y una secuencia incompleta la invalida).
+ *
+ * @param destino Campo destino.
+ * @param tam Tamaño del campo.
+ * @param texto Texto a copiar.
+ */
+static void copiarCampo(char* destino, size_t tam, std::string_view texto) {
+    size_t n = texto.size() < tam - 1 ? texto.size() : tam - 1;
+    while (n > 0 && n < texto.size() && (static_cast<unsigned char>(texto[n]) & 0xC0) == 0x80) {
+        n--;
+    }
+    std::memcpy(destino, texto.data(), n);
+    destino[n] = '\0';
+}
+
+VentaFacturable VentaFacturable::crear(std::uint64_t folio, time_t fecha, std::string_view codigo,
+    std::string_view descripcion, int cantidad, Dinero precioUnitario, Dinero total, TipoPago tipo) {
+    VentaFacturable v;
+    v.folio = folio;
+    v.fecha = static_cast<std::int64_t>(fecha);
+    v.precioUnitarioCentavos = precioUnitario.getCentavos();
+    v.totalCentavos = total.getCentavos();
+    v.cantidad = cantidad;
+    v.tipoPago = static_cast<std::uint8_t>(tipo);
+    copiarCampo(v.codigo, sizeof(v.codigo), codigo);
+    copiarCampo(v.descripcion, sizeof(v.descripcion), descripcion);
+    return v;
+}
+
+RegistroVentas::~RegistroVentas() {
+    {
+        std::lock_guard<std::mutex> lock(mutexVentas);
+        detenerSolicitado = true;
+    }
+    avisoEscritor.notify_all();
+    if (hilo.joinable()) {
+        hilo.join();
+    }
+    escribirPendientes();
+    if (diario != nullptr) {
+        std::fclose(diario);
+    }
+}
+
+/**
+ * @brief Instancia compartida del diario de ventas.
+ * @return RegistroVentas& Diario del sistema.
+ */
+RegistroVentas& RegistroVentas::instancia() {
+    static RegistroVentas registro;
+    return registro;
+}
+
+/**
+ * @brief Lee las ventas guardadas, deja el diario abierto para agregar y arranca el escritor.
+ *
+ * @param archivo Ruta del diario.
+ */
+void RegistroVentas::abrir(const std::string& archivo) {
+    std::lock_guard<std::mutex> lock(mutexVentas);
+    if (diario != nullptr) {
+        return;
+    }
+
+    if (std::FILE* f = std::fopen(archivo.c_str(), "rb")) {
+        VentaFacturable v;
+        while (std::fread(&v, sizeof(v), 1, f) == 1) {
+            ventas.push_back(v);
+        }
+        std::fclose(f);
+        std::cout << " Ventas cargadas desde " << archivo << " (" << ventas.size() << " registros)\n";
+
+        // Un registro a medias desalinearía todos los que se agreguen después
+        std::error_code error;
+        std::uint64_t completos = static_cast<std::uint64_t>(ventas.size()) * sizeof(VentaFacturable);
+        if (std::filesystem::file_size(archivo, error) != completos && !error) {
+            std::filesystem::resize_file(archivo, completos, error);
+            if (error) {
+                std::cout << "No se pudo recortar el registro incompleto de " << archivo
+                    << ". Las ventas no se guardaran en disco.\n";
+                return;
+            }
+            std::cout << " Se descarto un registro incompleto al final de " << archivo << "\n";
+        }
+    }
+
+    diario = std::fopen(archivo.c_str(), "ab");
+    if (diario == nullptr) {
+        std::cout << "No se pudo abrir " << archivo << ". Las ventas no se guardaran en disco.\n";
+        return;
+    }
+    detenerSolicitado = false;
+    hilo = std::thread(&RegistroVentas::escribir, this);
+}
+
+/**
+ * @brief Agrega la venta en memoria y la deja pendiente para el diario.
+ *
+ * @param venta Venta facturable.
+ */
+void RegistroVentas::registrar(const VentaFacturable& venta) {
+    std::lock_guard<std::mutex> lock(mutexVentas);
+    ventas.push_back(venta);
+    if (diario != nullptr) {
+        pendientes.push_back(venta);
+    }
+}
+
+/**
+ * @brief Toma las ventas pendientes y las escribe con una sola escritura, sin tener `mutexVentas`.
+ *
+ * `mutexDiario` mantiene el orden si el hilo escritor y `guardar()` escriben a la vez.
+ */
+void RegistroVentas::escribirPendientes() {
+    std::lock_guard<std::mutex> lockDiario(mutexDiario);
+    std::vector<VentaFacturable> lote;
+    {
+        std::lock_guard<std::mutex> lock(mutexVentas);
+        lote.swap(pendientes);
+    }
+    if (lote.empty() || diario == nullptr) {
+        return;
+    }
+    POS_TRAZA("Escribir lote de ventas");
+    std::fwrite(lote.data(), sizeof(VentaFacturable), lote.size(), diario);
+    std::fflush(diario);
+}
+
+/**
+ * @brief Despierta cada `kIntervaloEscritura` (o al detenerse) y escribe lo pendiente.
+ */
+void RegistroVentas::escribir() {
+    Traza::instancia().nombrarHilo("EscritorVentas");
+    while (true) {
+        bool terminar;
+        {
+            std::unique_lock<std::mutex> lock(mutexVentas);
+            avisoEscritor.wait_for(lock, kIntervaloEscritura, [this] { return detenerSolicitado; });
+            terminar = detenerSolicitado;
+        }
+        escribirPendientes();
+        if (terminar) {
+            break;
+        }
+    }
+}
+
+void RegistroVentas::guardar() {
+    POS_TRAZA("Guardar diario de ventas");
+    escribirPendientes();
+}
+
+/**
+ * @brief Busca desde el final, donde están las ventas recientes.
+ *
+ * @param folio Folio del ticket.
+ * @param venta Salida: venta encontrada.
+ * @return true si existe.
+ */
+bool RegistroVentas::buscar(std::uint64_t folio, VentaFacturable& venta) const {
+    std::lock_guard<std::mutex> lock(mutexVentas);
+    for (auto it = ventas.rbegin(); it != ventas.rend(); ++it) {
+        if (it->folio == folio) {
+            venta = *it;
+            return true;
+        }
+    }
+    return false;
+}
+
+std::vector<VentaFacturable> RegistroVentas::ventasEntre(time_t desde, time_t hasta) const {
+    std::lock_guard<std::mutex> lock(mutexVentas);
+    std::vector<VentaFacturable> resultado;
+    for (const auto& v : ventas) {
+        if (v.fecha >= desde && v.fecha < hasta) {
+            resultado.push_back(v);
+        }
+    }
+    return resultado;
+}
@@ -11,11 +11,25 @@
  * @author Ari
  */
 #include "ProgrammingPatterns/gasolinera/Gasolinera.h"
+#include "ProgrammingPatterns/pagos/Liquidaciones.h"
+#include "ProgrammingPatterns/metricas/MetricasEtapas.h"
+#include "ProgrammingPatterns/modelos/LectorJsonPlano.h"
 #include "nlohmann/json.hpp"
+#include <climits>
 #include <fstream>
 
 using json = nlohmann::json;
 
+void to_json(json& j, const CargaGasolina& c) {
+    j = {
+        {"litros", c.litros},
+        {"tipo", c.tipo},
+        {"precioLitro", c.precioLitro.aPesos()},
+        {"totalPagado", c.totalPagado.aPesos()},
+        {"versionPrecio", c.versionPrecio}
+    };
+}
+
 /**
  * @brief Verifica si el cliente pagó suficiente para cubrir la carga.
  *
@@ -24,59 +38,227 @@ using json = nlohmann::json;
  * @param montoPagado Monto que el cliente efectivamente cubrió.
  * @return true si el pago cubre el total requerido, false de lo contrario.
  */
-bool Gasolinera::validarPago(double litros, double precioLitro, double montoPagado) const {
-    double total = litros * precioLitro;
+bool Gasolinera::validarPago(double litros, Dinero precioLitro, Dinero montoPagado) const {
+    Dinero total = precioLitro.multiplicar(litros);
     return montoPagado >= total;
 }
 
 /**
  * @brief Registra una carga de gasolina usando el método de pago Strategy.
  *
- * Valida el pago, procesa la comisión (si la hay) y guarda la operación en el historial.
+ * Valida el pago, procesa la comisión (si la hay), descuenta los litros del tanque
+ * y guarda la operación en el historial.
  *
  * @param litros Litros cargados.
  * @param tipo Tipo de combustible (Magna, Premium, Diesel, etc.).
  * @param precioLitro Precio de venta por litro.
  * @param metodo Estrategia de pago elegida (efectivo, crédito, débito).
  */
-void Gasolinera::registrarCarga(double litros, const std::string& tipo, double precioLitro, MetodoPago* metodo) {
+void Gasolinera::registrarCarga(double litros, const std::string& tipo, Dinero precioLitro, MetodoPago* metodo) {
+    POS_MEDIR_ETAPA(Etapa::Carga);
+    registrarCargaConPrecio(litros, tipo, precioLitro, 0, metodo);
+}
+
+/**
+ * @brief Registra una carga con el precio vigente de la tabla de precios.
+ *
+ * @param litros Litros cargados.
+ * @param tipo Tipo de combustible.
+ * @param metodo Estrategia de pago elegida.
+ */
+void Gasolinera::registrarCarga(double litros, const std::string& tipo, MetodoPago* metodo) {
+    POS_MEDIR_ETAPA(Etapa::Carga);
+    Dinero precioLitro;
+    unsigned int version = 0;
+    bool hayPrecio;
+    {
+        POS_MEDIR_ETAPA(Etapa::CargaPrecio);
+        hayPrecio = precioVigente(tipo, precioLitro, version);
+    }
+    if (!hayPrecio) {
+        return;
+    }
+    registrarCargaConPrecio(litros, tipo, precioLitro, version, metodo);
+}
+
+/**
+ * @brief Registra una carga apartando el combustible y autorizando el pago en segundo plano.
+ *
+ * @param litros Litros cargados.
+ * @param tipo Tipo de combustible.
+ * @param metodo Estrategia de pago elegida.
+ * @param marca Marca de la tarjeta.
+ * @param autorizador Cola de autorizaciones.
+ */
+void Gasolinera::registrarCargaAsincrona(double litros, const std::string& tipo, MetodoPago* metodo,
+    MarcaTarjeta marca, AutorizadorPagos& autorizador) {
+    Dinero precioLitro;
+    unsigned int version = 0;
+    if (!precioVigente(tipo, precioLitro, version)) {
+        return;
+    }
+
+    Dinero pagoCliente;
+    if (!prepararCarga(litros, tipo, precioLitro, metodo, pagoCliente)) {
+        return;
+    }
+    // El método solo vive durante la llamada: el mensaje se arma ahora y se muestra al aprobarse
+    Dinero total = precioLitro.multiplicar(litros);
+    std::string mensajePago = metodo->pagar(total);
+
+    SolicitudAutorizacion solicitud;
+    solicitud.tipo = metodo->tipo();
+    solicitud.marca = marca;
+    solicitud.monto = pagoCliente;
+    std::cout << "Autorizando pago de la carga...\n";
+
+    autorizador.solicitar(solicitud,
+        [this, litros, tipo, precioLitro, total, pagoCliente, version, solicitud, mensajePago](const ResultadoAutorizacion& r) {
+            if (!r.aprobada) {
+                // Los litros apartados regresan al tanque
+                Tanque* tanque = obtenerTanque(tipo);
+                if (tanque != nullptr) {
+                    tanque->devolver(litros);
+                }
+                std::cout << "Pago rechazado (" << r.motivo << "). Carga de " << litros << " L de " << tipo << " cancelada.\n";
+                return;
+            }
+            mostrarCobro(total, mensajePago, pagoCliente);
+            historial.push_back({ litros, tipo, precioLitro, pagoCliente, version });
+            RegistroLiquidaciones::instancia().registrar(solicitud.tipo, solicitud.marca, pagoCliente,
+                pagoCliente - precioLitro.multiplicar(litros));
+            std::cout << "Pago autorizado (" << r.codigo << "). Carga de " << litros << " L de " << tipo << " registrada.\n";
+        });
+}
+
+/**
+ * @brief Consulta el precio vigente en la tabla de precios y lo informa.
+ *
+ * @param tipo Tipo de combustible.
+ * @param precioLitro Salida: precio por litro.
+ * @param version Salida: versión de la tabla.
+ * @return true si hay precio vigente.
+ */
+bool Gasolinera::precioVigente(const std::string& tipo, Dinero& precioLitro, unsigned int& version) const {
+    if (!tablaPrecios.consultarPrecio(tipo, time(nullptr), precioLitro, version)) {
+        std::cout << "No hay precio vigente para el combustible " << tipo << ". No se puede registrar la carga.\n";
+        return false;
+    }
+    std::cout << "Precio vigente de " << tipo << ": $" << precioLitro << " por litro (v" << version << ")\n";
+    return true;
+}
+
+/**
+ * @brief Flujo común: aparta del tanque, cobra, valida y registra la carga.
+ *
+ * @param litros Litros cargados.
+ * @param tipo Tipo de combustible.
+ * @param precioLitro Precio por litro aplicado.
+ * @param versionPrecio Versión de la tabla de precios usada.
+ * @param metodo Estrategia de pago elegida.
+ */
+void Gasolinera::registrarCargaConPrecio(double litros, const std::string& tipo, Dinero precioLitro,
+    unsigned int versionPrecio, MetodoPago* metodo) {
+    Dinero pagoCliente;
+    if (!prepararCarga(litros, tipo, precioLitro, metodo, pagoCliente)) {
+        return;
+    }
+    Dinero total = precioLitro.multiplicar(litros);
+    mostrarCobro(total, metodo->pagar(total), pagoCliente);
+
+    {
+        POS_MEDIR_ETAPA(Etapa::CargaHistorial);
+        historial.push_back({ litros, tipo, precioLitro, pagoCliente, versionPrecio });
+    }
+    {
+        POS_MEDIR_ETAPA(Etapa::CargaLiquidacion);
+        RegistroLiquidaciones::instancia().registrar(metodo->tipo(), MarcaTarjeta::Generica, pagoCliente,
+            pagoCliente - precioLitro.multiplicar(litros));
+    }
+    std::cout << "Carga registrada correctamente.\n";
+}
+
+/**
+ * @brief Aparta los litros del tanque, calcula el monto con la estrategia y valida el pago.
+ *
+ * El combustible se aparta antes de cobrar: si el tanque no alcanza, el
+ * cliente no llega a pagar. Si el pago no se acepta, los litros regresan.
+ * El cobro lo muestra quien llama, cuando el pago queda aceptado.
+ *
+ * @param litros Litros cargados.
+ * @param tipo Tipo de combustible.
+ * @param precioLitro Precio por litro aplicado.
+ * @param metodo Estrategia de pago elegida.
+ * @param pagoCliente Salida: monto cobrado.
+ * @return true si la carga puede registrarse.
+ */
+bool Gasolinera::prepararCarga(double litros, const std::string& tipo, Dinero precioLitro,
+    MetodoPago* metodo, Dinero& pagoCliente) {
     if (metodo == nullptr) {
         std::cout << "ERROR: metodo de pago nulo.\n";
-        return;
+        return false;
     }
 
-    double total = litros * precioLitro;
-    std::cout << "Total a pagar: $" << total << "\n";
+    // Apartar del tanque (sin candados, varias bombas pueden despachar a la vez)
+    Tanque* tanque = nullptr;
+    {
+        POS_MEDIR_ETAPA(Etapa::CargaTanque);
+        if (!tanques.empty()) {
+            tanque = obtenerTanque(tipo);
+            if (tanque == nullptr) {
+                std::cout << "No existe tanque para el combustible " << tipo << ". No se puede registrar la carga.\n";
+                return false;
+            }
+            if (!tanque->despachar(litros)) {
+                std::cout << "Combustible insuficiente en el tanque " << tipo << ". No se puede registrar la carga.\n";
+                return false;
+            }
+        }
+    }
 
-    // Se procesa el pago usando el Strategy (puede incluir comisión)
-    double pagoCliente = metodo->procesarPago(total);
+    POS_MEDIR_ETAPA(Etapa::CargaPago);
+    Dinero total = precioLitro.multiplicar(litros);
 
-    
-    std::cout << metodo->pagar(total) << " -> Monto efectivo: $" << pagoCliente << "\n";
+    // Se procesa el pago usando el Strategy (puede incluir comisión)
+    pagoCliente = metodo->procesarPago(total);
 
     if (!validarPago(litros, precioLitro, pagoCliente)) {
         std::cout << "Pago insuficiente. No se puede registrar la carga.\n";
-        return;
+        if (tanque != nullptr) {
+            tanque->devolver(litros);
+        }
+        return false;
     }
+    return true;
+}
 
-    historial.push_back({ litros, tipo, precioLitro, pagoCliente });
-    std::cout << "Carga registrada correctamente.\n";
+/**
+ * @brief Muestra el total de la carga y el mensaje del método de pago.
+ *
+ * @param total Total sin comisión.
+ * @param mensajePago Mensaje de `MetodoPago::pagar`.
+ * @param pagoCliente Monto cobrado al cliente.
+ */
+void Gasolinera::mostrarCobro(Dinero total, const std::string& mensajePago, Dinero pagoCliente) {
+    std::cout << "Total a pagar: $" << total << "\n";
+    std::cout << mensajePago << " -> Monto efectivo: $" << pagoCliente << "\n";
 }
 
 /**
- * @brief Muestra por consola todas las cargas registradas.
+ * @brief Muestra las cargas registradas en una tabla con búfer (ver ReporteConsola).
+ *
+ * @param filtro Tipo de combustible a buscar y página.
+ * @param salida Flujo donde se escribe.
+ * @return ResultadoReporte Coincidencias y páginas.
  */
-void Gasolinera::mostrarHistorial() const {
-    std::cout << "\n HISTORIAL DE CARGAS:\n";
+ResultadoReporte Gasolinera::mostrarHistorial(const FiltroReporte& filtro, std::ostream& salida) const {
+    salida << "\n HISTORIAL DE CARGAS:\n";
     if (historial.empty()) {
-        std::cout << "(vacío)\n";
-        return;
-    }
-    for (const auto& c : historial) {
-        std::cout << c.litros << " L | " << c.tipo
-            << " | $" << c.precioLitro
-            << " | Pago: $" << c.totalPagado << "\n";
+        salida << "(vacío)\n";
+        return ResultadoReporte();
     }
+    ReporteConsola reporte(salida);
+    return reporte.historial(historial, filtro);
 }
 
 
@@ -86,15 +268,8 @@ void Gasolinera::mostrarHistorial() const {
  * @param archivo Ruta del archivo JSON donde se guardará.
  */
 void Gasolinera::guardarHistorialJson(const std::string& archivo) const {
-    json data = json::array();
-    for (const auto& c : historial) {
-        data.push_back({
-            {"litros", c.litros},
-            {"tipo", c.tipo},
-            {"precioLitro", c.precioLitro},
-            {"totalPagado", c.totalPagado}
-            });
-    }
+    POS_TRAZA("Guardar historial de gasolina");
+    json data = historial;
 
     std::ofstream file(archivo);
     if (!file.is_open()) {
@@ -105,21 +280,82 @@ void Gasolinera::guardarHistorialJson(const std::string& archivo) const {
     std::cout << " Historial guardado en " << archivo << "\n";
 }
 
+/**
+ * @brief Lee el historial con `LectorJsonPlano` (el formato que escribe `guardarHistorialJson`).
+ *
+ * Los campos que faltan toman los mismos valores por omisión que la lectura con nlohmann.
+ *
+ * @param contenido Texto completo del archivo.
+ * @param leidas Destino de las cargas.
+ * @return false si el archivo no tiene esa forma (se debe leer con nlohmann).
+ */
+static bool leerHistorialPlano(std::string_view contenido, std::vector<CargaGasolina>& leidas) {
+    LectorJsonPlano lector(contenido);
+    LectorJsonPlano::Campo campo;
+    while (lector.siguienteObjeto()) {
+        CargaGasolina c;
+        c.litros = 0.0;
+        c.tipo = "Desconocido";
+        double precioLitro = 0.0;
+        double totalPagado = 0.0;
+        bool correcto = true;
+        while (lector.siguienteCampo(campo)) {
+            if (campo.clave == "litros") {
+                correcto = correcto && !campo.esCadena && LectorJsonPlano::aDecimal(campo.valor, c.litros);
+            }
+            else if (campo.clave == "tipo") {
+                correcto = correcto && campo.esCadena;
+                c.tipo.assign(campo.valor);
+            }
+            else if (campo.clave == "precioLitro") {
+                correcto = correcto && !campo.esCadena && LectorJsonPlano::aDecimal(campo.valor, precioLitro);
+            }
+            else if (campo.clave == "totalPagado") {
+                correcto = correcto && !campo.esCadena && LectorJsonPlano::aDecimal(campo.valor, totalPagado);
+            }
+            else if (campo.clave == "versionPrecio") {
+                long long version = 0;
+                correcto = correcto && !campo.esCadena && LectorJsonPlano::aEntero(campo.valor, version) &&
+                    version >= 0 && version <= UINT_MAX;
+                c.versionPrecio = static_cast<unsigned int>(version);
+            }
+        }
+        if (!lector.valido() || !correcto) {
+            return false;
+        }
+        c.precioLitro = Dinero::desdePesos(precioLitro);
+        c.totalPagado = Dinero::desdePesos(totalPagado);
+        leidas.push_back(std::move(c));
+    }
+    return lector.valido();
+}
+
 /**
  * @brief Carga el historial de cargas desde un archivo JSON.
  *
+ * El archivo se lee de una vez y se recorre con `LectorJsonPlano`; solo si
+ * no tiene la forma habitual se arma el documento de nlohmann.
+ *
  * @param archivo Ruta del archivo JSON a leer.
  */
 void Gasolinera::cargarHistorialJson(const std::string& archivo) {
-    std::ifstream file(archivo);
-    if (!file.is_open()) {
+    POS_TRAZA("Cargar historial de gasolina");
+    ArchivoCompleto contenido;
+    if (!contenido.abrir(archivo)) {
         std::cout << " No se encontró " << archivo << ", se iniciará vacío.\n";
         return;
     }
 
+    std::vector<CargaGasolina> leidas;
+    if (leerHistorialPlano(contenido.texto(), leidas)) {
+        historial = std::move(leidas);
+        std::cout << " Historial cargado desde " << archivo << "\n";
+        return;
+    }
+
     json data;
     try {
-        file >> data;
+        data = json::parse(contenido.texto().begin(), contenido.texto().end());
     }
     catch (...) {
         std::cout << " Error leyendo JSON de " << archivo << ". Se iniciará vacío.\n";
@@ -131,10 +367,220 @@ void Gasolinera::cargarHistorialJson(const std::string& archivo) {
         CargaGasolina c;
         c.litros = item.value("litros", 0.0);
         c.tipo = item.value("tipo", std::string("Desconocido"));
-        c.precioLitro = item.value("precioLitro", 0.0);
-        c.totalPagado = item.value("totalPagado", 0.0);
+        c.precioLitro = Dinero::desdePesos(item.value("precioLitro", 0.0));
+        c.totalPagado = Dinero::desdePesos(item.value("totalPagado", 0.0));
+        c.versionPrecio = item.value("versionPrecio", 0u);
         historial.push_back(c);
     }
 
     std::cout << " Historial cargado desde " << archivo << "\n";
 }
+
+/**
+ * @brief Da de alta un tanque y le registra los observadores de tanques.
+ *
+ * Si ya existía un tanque del mismo tipo, se reemplaza.
+ *
+ * @param tipo Tipo de combustible.
+ * @param capacidadLitros Capacidad del tanque.
+ * @param volumenLitros Volumen actual.
+ * @param umbralBajoLitros Nivel de alerta.
+ */
+void Gasolinera::agregarTanque(const std::string& tipo, double capacidadLitros, double volumenLitros, double umbralBajoLitros) {
+    auto tanque = std::make_unique<Tanque>(tipo, capacidadLitros, volumenLitros, umbralBajoLitros);
+    for (auto* obs : observadoresTanques) {
+        tanque->agregarObservador(obs);
+    }
+    tanques[tipo] = std::move(tanque);
+}
+
+/**
+ * @brief Busca el tanque de un tipo de combustible.
+ *
+ * @param tipo Tipo de combustible.
+ * @return Puntero al tanque o nullptr si no existe.
+ */
+Tanque* Gasolinera::obtenerTanque(const std::string& tipo) const {
+    auto it = tanques.find(tipo);
+    return it != tanques.end() ? it->second.get() : nullptr;
+}
+
+/**
+ * @brief Registra un observador en todos los tanques.
+ *
+ * @param obs Observador a registrar.
+ */
+void Gasolinera::agregarObservadorTanques(Observador* obs) {
+    observadoresTanques.push_back(obs);
+    for (auto& par : tanques) {
+        par.second->agregarObservador(obs);
+    }
+}
+
+/**
+ * @brief Rellena el tanque correspondiente y guarda el registro de la entrega.
+ *
+ * @param entrega Datos de la entrega.
+ * @return true si la entrega se aplicó.
+ */
+bool Gasolinera::registrarEntrega(const EntregaCombustible& entrega) {
+    Tanque* tanque = obtenerTanque(entrega.tipo);
+    if (tanque == nullptr) {
+        std::cout << "No existe tanque para el combustible " << entrega.tipo << ".\n";
+        return false;
+    }
+    if (entrega.litros <= 0) {
+        std::cout << "Cantidad de litros invalida.\n";
+        return false;
+    }
+
+    double aceptados = tanque->reabastecer(entrega.litros);
+    EntregaCombustible registro = entrega;
+    registro.litros = aceptados;
+    entregas.push_back(registro);
+
+    std::cout << "Entrega registrada: " << aceptados << " L de " << entrega.tipo;
+    if (aceptados < entrega.litros) {
+        std::cout << " (tanque lleno, se rechazaron " << entrega.litros - aceptados << " L)";
+    }
+    std::cout << "\n";
+    return true;
+}
+
+/**
+ * @brief Muestra por consola el nivel de cada tanque.
+ */
+void Gasolinera::mostrarTanques() const {
+    std::cout << "\n NIVEL DE TANQUES:\n";
+    if (tanques.empty()) {
+        std::cout << "(sin tanques)\n";
+        return;
+    }
+    for (const auto& par : tanques) {
+        const Tanque& t = *par.second;
+        std::cout << t.getTipo() << " | " << t.getVolumen() << " / " << t.getCapacidad() << " L"
+            << (t.getVolumen() < t.getUmbralBajo() ? " | NIVEL BAJO" : "") << "\n";
+    }
+}
+
+/**
+ * @brief Guarda tanques y entregas en un archivo JSON.
+ *
+ * @param archivo Ruta del archivo JSON donde se guardará.
+ */
+void Gasolinera::guardarTanquesJson(const std::string& archivo) const {
+    POS_TRAZA("Guardar tanques");
+    json data;
+    data["tanques"] = json::array();
+    for (const auto& par : tanques) {
+        const Tanque& t = *par.second;
+        data["tanques"].push_back({
+            {"tipo", t.getTipo()},
+            {"capacidad", t.getCapacidad()},
+            {"volumen", t.getVolumen()},
+            {"umbralBajo", t.getUmbralBajo()}
+            });
+    }
+    data["entregas"] = json::array();
+    for (const auto& e : entregas) {
+        data["entregas"].push_back({
+            {"tipo", e.tipo},
+            {"litros", e.litros},
+            {"proveedor", e.proveedor},
+            {"fecha", e.fecha}
+            });
+    }
+
+    std::ofstream file(archivo);
+    if (!file.is_open()) {
+        std::cout << "ERROR: no se pudo abrir " << archivo << " para escribir.\n";
+        return;
+    }
+    file << data.dump(2);
+    std::cout << " Tanques guardados en " << archivo << "\n";
+}
+
+/**
+ * @brief Carga tanques y entregas desde un archivo JSON.
+ *
+ * @param archivo Ruta del archivo JSON a leer.
+ */
+void Gasolinera::cargarTanquesJson(const std::string& archivo) {
+    POS_TRAZA("Cargar tanques");
+    std::ifstream file(archivo);
+    if (!file.is_open()) {
+        std::cout << " No se encontró " << archivo << ", no hay tanques configurados.\n";
+        return;
+    }
+
+    json data;
+    try {
+        file >> data;
+    }
+    catch (...) {
+        std::cout << " Error leyendo JSON de " << archivo << ". No hay tanques configurados.\n";
+        return;
+    }
+
+    tanques.clear();
+    for (const auto& item : data.value("tanques", json::array())) {
+        agregarTanque(
+            item.value("tipo", std::string("Desconocido")),
+            item.value("capacidad", 0.0),
+            item.value("volumen", 0.0),
+            item.value("umbralBajo", 0.0)
+        );
+    }
+
+    entregas.clear();
+    for (const auto& item : data.value("entregas", json::array())) {
+        EntregaCombustible e;
+        e.tipo = item.value("tipo", std::string("Desconocido"));
+        e.litros = item.value("litros", 0.0);
+        e.proveedor = item.value("proveedor", std::string(""));
+        e.fecha = item.value("fecha", std::string(""));
+        entregas.push_back(e);
+    }
+
+    std::cout << " Tanques cargados desde " << archivo << "\n";
+}
+
+/**
+ * @brief Agrupa el historial por versión de precios y verifica cada carga.
+ *
+ * Como cada carga guarda el número de versión, la búsqueda del precio
+ * esperado es un acceso directo a la tabla y no una búsqueda por fecha.
+ */
+void Gasolinera::auditarPrecios() const {
+    struct Resumen {
+        size_t cargas = 0;
+        double litros = 0.0;
+        Dinero total;
+        size_t discrepancias = 0;
+    };
+    std::map<unsigned int, Resumen> porVersion;
+
+    for (const auto& c : historial) {
+        Resumen& r = porVersion[c.versionPrecio];
+        r.cargas++;
+        r.litros += c.litros;
+        r.total += c.totalPagado;
+
+        const VersionPrecios* v = tablaPrecios.obtenerVersion(c.versionPrecio);
+        if (v != nullptr) {
+            auto it = v->precios.find(c.tipo);
+            if (it == v->precios.end() || it->second != c.precioLitro) {
+                r.discrepancias++;
+            }
+        }
+    }
+
+    std::cout << "\n AUDITORIA DE PRECIOS:\n";
+    for (const auto& par : porVersion) {
+        std::cout << (par.first == 0 ? std::string("Manual") : "v" + std::to_string(par.first))
+            << " | Cargas: " << par.second.cargas
+            << " | Litros: " << par.second.litros
+            << " | Total: $" << par.second.total
+            << " | Discrepancias: " << par.second.discrepancias << "\n";
+    }
+}
@@ -0,0 +1,280 @@
+﻿/**
+ * @file TablaPreciosCombustible.cpp
+ * @brief Implementación de la tabla de precios versionada de la gasolinera.
+ *
+ * Los escritores insertan versiones en la lista según su vigencia y las
+ * publican con un store atómico; los lectores recorren la lista desde la
+ * última versión vigente conocida hasta encontrar la que aplica a la hora de
+ * la consulta.
+ *
+ * @date 2026-10-19
+ * @version 1.0
+ * @author Ari
+ */
+#include "ProgrammingPatterns/gasolinera/TablaPreciosCombustible.h"
+#include "ProgrammingPatterns/metricas/Traza.h"
+#include "nlohmann/json.hpp"
+#include <algorithm>
+#include <fstream>
+
+using json = nlohmann::json;
+
+VersionPrecios* TablaPreciosCombustible::crearVersion(time_t vigenteDesde, const std::map<std::string, Dinero>& precios) {
+    auto v = std::make_unique<VersionPrecios>();
+    v->version = static_cast<unsigned int>(versiones.size() + 1);
+    v->vigenteDesde = vigenteDesde;
+    v->precios = precios;
+    versiones.push_back(std::move(v));
+    return versiones.back().get();
+}
+
+/**
+ * @brief true si las dos versiones tienen el mismo precio (o ninguno) para el tipo.
+ */
+static bool mismoPrecio(const VersionPrecios* a, const VersionPrecios* b, const std::string& tipo) {
+    static const std::map<std::string, Dinero> kSinPrecios;
+    const auto& pa = a != nullptr ? a->precios : kSinPrecios;
+    const auto& pb = b != nullptr ? b->precios : kSinPrecios;
+    auto ia = pa.find(tipo);
+    auto ib = pb.find(tipo);
+    if (ia == pa.end() || ib == pb.end()) {
+        return ia == pa.end() && ib == pb.end();
+    }
+    return ia->second == ib->second;
+}
+
+/**
+ * @brief Crea la versión del cambio, rehace las posteriores y las publica.
+ *
+ * @param cambio Datos del cambio de precio.
+ * @return Número de la versión creada.
+ */
+unsigned int TablaPreciosCombustible::programarCambio(const CambioPrecio& cambio) {
+    static const std::map<std::string, Dinero> kSinPrecios;
+    std::lock_guard<std::mutex> lock(mutexEscritura);
+
+    // La versión que rige en la fecha del cambio (con empate, la última)
+    size_t posicion = static_cast<size_t>(std::upper_bound(cadena.begin(), cadena.end(), cambio.vigenteDesde,
+        [](time_t t, const VersionPrecios* v) { return t < v->vigenteDesde; }) - cadena.begin());
+    VersionPrecios* anterior = posicion > 0 ? cadena[posicion - 1] : nullptr;
+
+    VersionPrecios* nueva = crearVersion(cambio.vigenteDesde, anterior != nullptr ? anterior->precios : kSinPrecios);
+    nueva->precios[cambio.tipo] = cambio.precio;
+
+    // Las programadas para después llevan el cambio hasta que una fija otro precio para el tipo
+    std::vector<VersionPrecios*> nuevas{ nueva };
+    const VersionPrecios* previa = anterior;
+    bool fijado = false;
+    for (size_t i = posicion; i < cadena.size(); i++) {
+        fijado = fijado || !mismoPrecio(cadena[i], previa, cambio.tipo);
+        VersionPrecios* copia = crearVersion(cadena[i]->vigenteDesde, cadena[i]->precios);
+        if (!fijado) {
+            copia->precios[cambio.tipo] = cambio.precio;
+        }
+        nuevas.push_back(copia);
+        previa = cadena[i];
+    }
+    for (size_t i = 0; i + 1 < nuevas.size(); i++) {
+        nuevas[i]->siguiente.store(nuevas[i + 1], std::memory_order_relaxed);
+    }
+
+    // Publicación: a partir de aquí los lectores pueden alcanzar la versión
+    if (anterior != nullptr) {
+        anterior->siguiente.store(nueva, std::memory_order_release);
+    }
+    else {
+        vigente.store(nueva, std::memory_order_release);
+    }
+
+    // Quien siga en una versión reemplazada pasa a su copia (misma vigencia)
+    for (size_t i = posicion; i < cadena.size(); i++) {
+        cadena[i]->reemplazada = true;
+        cadena[i]->siguiente.store(nuevas[i - posicion + 1], std::memory_order_release);
+    }
+    cadena.resize(posicion);
+    cadena.insert(cadena.end(), nuevas.begin(), nuevas.end());
+    return nueva->version;
+}
+
+/**
+ * @brief Busca el precio vigente siguiendo la lista de versiones.
+ *
+ * Si encuentra una versión más nueva que la guardada en `vigente`, intenta
+ * adelantarla para que las siguientes consultas recorran menos nodos.
+ *
+ * @param tipo Tipo de combustible.
+ * @param ahora Momento de la consulta.
+ * @param precio Salida: precio por litro.
+ * @param version Salida: versión usada.
+ * @return true si hay precio para ese tipo.
+ */
+bool TablaPreciosCombustible::consultarPrecio(const std::string& tipo, time_t ahora, Dinero& precio, unsigned int& version) const {
+    const VersionPrecios* inicio = vigente.load(std::memory_order_acquire);
+    if (inicio == nullptr || inicio->vigenteDesde > ahora) {
+        return false;
+    }
+
+    const VersionPrecios* actual = inicio;
+    const VersionPrecios* siguiente = actual->siguiente.load(std::memory_order_acquire);
+    while (siguiente != nullptr && siguiente->vigenteDesde <= ahora) {
+        actual = siguiente;
+        siguiente = actual->siguiente.load(std::memory_order_acquire);
+    }
+
+    if (actual != inicio) {
+        vigente.compare_exchange_strong(inicio, actual, std::memory_order_release, std::memory_order_relaxed);
+    }
+
+    auto it = actual->precios.find(tipo);
+    if (it == actual->precios.end()) {
+        return false;
+    }
+    precio = it->second;
+    version = actual->version;
+    return true;
+}
+
+/**
+ * @brief Obtiene una versión por número.
+ *
+ * @param version Número de versión.
+ * @return Puntero a la versión o nullptr.
+ */
+const VersionPrecios* TablaPreciosCombustible::obtenerVersion(unsigned int version) const {
+    std::lock_guard<std::mutex> lock(mutexEscritura);
+    if (version == 0 || version > versiones.size()) {
+        return nullptr;
+    }
+    return versiones[version - 1].get();
+}
+
+/**
+ * @brief Cantidad de versiones publicadas.
+ * @return size_t Número de versiones.
+ */
+size_t TablaPreciosCombustible::totalVersiones() const {
+    std::lock_guard<std::mutex> lock(mutexEscritura);
+    return versiones.size();
+}
+
+/**
+ * @brief Muestra los precios vigentes y los cambios programados a futuro.
+ */
+void TablaPreciosCombustible::mostrar() const {
+    std::lock_guard<std::mutex> lock(mutexEscritura);
+    std::cout << "\n PRECIOS DE COMBUSTIBLE:\n";
+    if (versiones.empty()) {
+        std::cout << "(sin precios)\n";
+        return;
+    }
+
+    time_t ahora = time(nullptr);
+    const VersionPrecios* actual = nullptr;
+    for (const VersionPrecios* v : cadena) {
+        if (v->vigenteDesde <= ahora) {
+            actual = v;
+        }
+    }
+
+    if (actual != nullptr) {
+        std::cout << "Version vigente: " << actual->version << "\n";
+        for (const auto& par : actual->precios) {
+            std::cout << par.first << " | $" << par.second << " por litro\n";
+        }
+    }
+    for (const VersionPrecios* v : cadena) {
+        if (v->vigenteDesde > ahora) {
+            std::cout << "Programada v" << v->version << " en "
+                << (v->vigenteDesde - ahora) / 60 << " min\n";
+        }
+    }
+}
+
+/**
+ * @brief Guarda todas las versiones en JSON.
+ *
+ * @param archivo Ruta del archivo JSON.
+ */
+void TablaPreciosCombustible::guardarJson(const std::string& archivo) const {
+    POS_TRAZA("Guardar precios de combustible");
+    json data = json::array();
+    {
+        std::lock_guard<std::mutex> lock(mutexEscritura);
+        for (const auto& v : versiones) {
+            json precios = json::object();
+            for (const auto& par : v->precios) {
+                precios[par.first] = par.second.aPesos();
+            }
+            json item = {
+                {"version", v->version},
+                {"vigenteDesde", static_cast<long long>(v->vigenteDesde)},
+                {"precios", precios}
+            };
+            if (v->reemplazada) {
+                item["reemplazada"] = true;
+            }
+            data.push_back(std::move(item));
+        }
+    }
+
+    std::ofstream file(archivo);
+    if (!file.is_open()) {
+        std::cout << "ERROR: no se pudo abrir " << archivo << " para escribir.\n";
+        return;
+    }
+    file << data.dump(2);
+    std::cout << " Precios guardados en " << archivo << "\n";
+}
+
+/**
+ * @brief Carga las versiones desde JSON y vuelve a enlazar la lista.
+ *
+ * Las reemplazadas se conservan (los tickets guardan su número) pero no
+ * entran en la lista; las demás se enlazan por vigencia y, con empate, por
+ * número.
+ *
+ * @param archivo Ruta del archivo JSON.
+ */
+void TablaPreciosCombustible::cargarJson(const std::string& archivo) {
+    std::ifstream file(archivo);
+    if (!file.is_open()) {
+        std::cout << " No se encontró " << archivo << ", no hay precios configurados.\n";
+        return;
+    }
+
+    json data;
+    try {
+        file >> data;
+    }
+    catch (...) {
+        std::cout << " Error leyendo JSON de " << archivo << ". No hay precios configurados.\n";
+        return;
+    }
+
+    std::lock_guard<std::mutex> lock(mutexEscritura);
+    versiones.clear();
+    cadena.clear();
+    vigente.store(nullptr, std::memory_order_relaxed);
+
+    for (const auto& item : data) {
+        std::map<std::string, Dinero> precios;
+        for (const auto& par : item.value("precios", std::map<std::string, double>())) {
+            precios[par.first] = Dinero::desdePesos(par.second);
+        }
+        VersionPrecios* v = crearVersion(static_cast<time_t>(item.value("vigenteDesde", 0LL)), precios);
+        v->reemplazada = item.value("reemplazada", false);
+        if (!v->reemplazada) {
+            cadena.push_back(v);
+        }
+    }
+
+    std::stable_sort(cadena.begin(), cadena.end(),
+        [](const VersionPrecios* a, const VersionPrecios* b) { return a->vigenteDesde < b->vigenteDesde; });
+    for (size_t i = 0; i + 1 < cadena.size(); i++) {
+        cadena[i]->siguiente.store(cadena[i + 1], std::memory_order_relaxed);
+    }
+    if (!cadena.empty()) {
+        vigente.store(cadena.front(), std::memory_order_release);
+    }
+    std::cout << " Precios cargados desde " << archivo << "\n";
+}
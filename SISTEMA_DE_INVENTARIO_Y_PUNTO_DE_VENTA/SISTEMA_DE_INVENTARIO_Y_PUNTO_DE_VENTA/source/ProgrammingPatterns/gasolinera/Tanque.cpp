@@ -0,0 +1,103 @@
+﻿/**
+ * @file Tanque.cpp
+ * @brief Implementación del tanque de combustible con despacho atómico.
+ *
+ * El volumen se maneja en mililitros enteros para que el descuento y el
+ * reabastecimiento se hagan con compare-and-swap, sin candados ni errores
+ * de redondeo al acumular muchas cargas pequeñas.
+ *
+ * @date 2026-10-19
+ * @version 1.0
+ * @author Ari
+ */
+#include "ProgrammingPatterns/gasolinera/Tanque.h"
+#include <cmath>
+
+/**
+ * @brief Convierte litros a mililitros enteros.
+ *
+ * @param litros Cantidad en litros.
+ * @return long long Cantidad en mililitros (redondeada).
+ */
+static long long litrosAMl(double litros) {
+    return std::llround(litros * 1000.0);
+}
+
+Tanque::Tanque(const std::string& tipo, double capacidadLitros, double volumenInicialLitros, double umbralBajoLitros)
+    : tipo(tipo),
+      capacidadMl(litrosAMl(capacidadLitros)),
+      volumenMl(std::min(litrosAMl(volumenInicialLitros), litrosAMl(capacidadLitros))),
+      umbralMl(litrosAMl(umbralBajoLitros)) {}
+
+/**
+ * @brief Descuenta litros del tanque sin bloquear a otras bombas.
+ *
+ * Solo la bomba que cruza el umbral emite la alerta de nivel bajo, así que
+ * el aviso no se repite en cada carga posterior.
+ *
+ * @param litros Litros a despachar.
+ * @return true si la carga se pudo surtir.
+ */
+bool Tanque::despachar(double litros) {
+    long long ml = litrosAMl(litros);
+    if (ml <= 0) {
+        return false;
+    }
+
+    long long actual = volumenMl.load(std::memory_order_relaxed);
+    bool alcanza;
+    do {
+        alcanza = actual >= ml;
+    } while (alcanza && !volumenMl.compare_exchange_weak(actual, actual - ml,
+        std::memory_order_acq_rel, std::memory_order_relaxed));
+
+    // El aviso arma un texto y llama a los observadores: fuera del ciclo
+    if (!alcanza) {
+        notificar("Tanque " + tipo + " sin combustible suficiente para " + std::to_string(litros) + " L");
+        return false;
+    }
+
+    if (actual >= umbralMl && actual - ml < umbralMl) {
+        notificar("Nivel bajo en tanque " + tipo + ": " + std::to_string((actual - ml) / 1000.0) + " L");
+    }
+    return true;
+}
+
+/**
+ * @brief Rellena el tanque respetando su capacidad.
+ *
+ * @param litros Litros entregados por la pipa.
+ * @return Litros aceptados.
+ */
+double Tanque::reabastecer(double litros) {
+    long long ml = litrosAMl(litros);
+    if (ml <= 0) {
+        return 0.0;
+    }
+
+    long long actual = volumenMl.load(std::memory_order_relaxed);
+    long long nuevo;
+    do {
+        nuevo = std::min(actual + ml, capacidadMl);
+    } while (!volumenMl.compare_exchange_weak(actual, nuevo,
+        std::memory_order_acq_rel, std::memory_order_relaxed));
+
+    return (nuevo - actual) / 1000.0;
+}
+
+/**
+ * @brief Regresa litros apartados que no se vendieron (pago rechazado).
+ *
+ * @param litros Litros apartados con `despachar()`.
+ */
+void Tanque::devolver(double litros) {
+    long long ml = litrosAMl(litros);
+    if (ml <= 0) {
+        return;
+    }
+
+    long long actual = volumenMl.load(std::memory_order_relaxed);
+    while (!volumenMl.compare_exchange_weak(actual, std::min(actual + ml, capacidadMl),
+        std::memory_order_acq_rel, std::memory_order_relaxed)) {
+    }
+}
@@ -0,0 +1,141 @@
+﻿/**
+ * @file MetricasEtapas.cpp
+ * @brief Registro de los buffers por hilo, informe de percentiles y señal de volcado.
+ *
+ * @date 2026-10-19
+ * @version 1.0
+ * @author Ari
+ */
+#include "ProgrammingPatterns/metricas/MetricasEtapas.h"
+#include <cstdio>
+#include <iostream>
+#include <string>
+#include <thread>
+#ifndef _WIN32
+#include <csignal>
+#include <pthread.h>
+#endif
+
+const char* etapaToString(Etapa etapa) {
+    switch (etapa) {
+    case Etapa::Venta:            return "Venta";
+    case Etapa::VentaInventario:  return "Inventario";
+    case Etapa::VentaProducto:    return "Producto";
+    case Etapa::VentaPago:        return "Pago";
+    case Etapa::VentaTicket:      return "Ticket";
+    case Etapa::VentaFactura:     return "Factura";
+    case Etapa::VentaLiquidacion: return "Liquidacion";
+    case Etapa::Carga:            return "Carga";
+    case Etapa::CargaPrecio:      return "Precio";
+    case Etapa::CargaPago:        return "Pago";
+    case Etapa::CargaTanque:      return "Tanque";
+    case Etapa::CargaHistorial:   return "Historial";
+    case Etapa::CargaLiquidacion: return "Liquidacion";
+    default:                      return "?";
+    }
+}
+
+const char* etapaEnTraza(Etapa etapa) {
+    switch (etapa) {
+    case Etapa::Venta:            return "Venta";
+    case Etapa::VentaInventario:  return "Venta: inventario";
+    case Etapa::VentaProducto:    return "Venta: producto";
+    case Etapa::VentaPago:        return "Venta: pago";
+    case Etapa::VentaTicket:      return "Venta: ticket";
+    case Etapa::VentaFactura:     return "Venta: factura";
+    case Etapa::VentaLiquidacion: return "Venta: liquidacion";
+    case Etapa::Carga:            return "Carga";
+    case Etapa::CargaPrecio:      return "Carga: precio";
+    case Etapa::CargaPago:        return "Carga: pago";
+    case Etapa::CargaTanque:      return "Carga: tanque";
+    case Etapa::CargaHistorial:   return "Carga: historial";
+    case Etapa::CargaLiquidacion: return "Carga: liquidacion";
+    default:                      return "?";
+    }
+}
+
+MetricasEtapas& MetricasEtapas::instancia() {
+    static MetricasEtapas metricas;
+    return metricas;
+}
+
+MetricasEtapas::BufferHilo* MetricasEtapas::registrarHilo() {
+    std::lock_guard<std::mutex> lock(mutexBuffers);
+    buffers.push_back(std::make_unique<BufferHilo>());
+    propio = buffers.back().get();
+    return propio;
+}
+
+void MetricasEtapas::juntar(Etapa etapa, Histograma& destino) {
+    std::lock_guard<std::mutex> lock(mutexBuffers);
+    for (const auto& buffer : buffers) {
+        destino.acumular(buffer->etapas[static_cast<size_t>(etapa)]);
+    }
+}
+
+void MetricasEtapas::imprimir(std::ostream& salida) {
+#if !POS_METRICAS
+    salida << "Las mediciones por etapa estan desactivadas en esta compilacion (POS_METRICAS=0).\n";
+#else
+    double ns = RelojCiclos::nanosegundosPorTick();
+    auto us = [ns](std::uint64_t ticks) { return static_cast<double>(ticks) * ns / 1000.0; };
+
+    char linea[160];
+    std::snprintf(linea, sizeof(linea), "%-16s %10s %10s %10s %10s %10s %10s %10s\n", "Etapa (us)", "Muestras",
+        "Promedio", "p50", "p90", "p99", "p99.9", "Maximo");
+    salida << linea;
+
+    bool hayMuestras = false;
+    for (size_t i = 0; i < kEtapas; i++) {
+        Etapa etapa = static_cast<Etapa>(i);
+        auto h = std::make_unique<Histograma>();
+        juntar(etapa, *h);
+        if (h->getTotal() == 0) {
+            continue;
+        }
+        hayMuestras = true;
+
+        // Las etapas internas van sangradas bajo la venta o la carga
+        std::string nombre = etapa == Etapa::Venta || etapa == Etapa::Carga ? "" : "  ";
+        nombre += etapaToString(etapa);
+        std::snprintf(linea, sizeof(linea), "%-16s %10llu %10.2f %10.2f %10.2f %10.2f %10.2f %10.2f\n",
+            nombre.c_str(), static_cast<unsigned long long>(h->getTotal()),
+            us(h->getSuma()) / static_cast<double>(h->getTotal()), us(h->percentil(50)), us(h->percentil(90)),
+            us(h->percentil(99)), us(h->percentil(99.9)), us(h->getMaximo()));
+        salida << linea;
+    }
+    if (!hayMuestras) {
+        salida << "Sin ventas ni cargas medidas todavia.\n";
+    }
+    salida.flush();
+#endif
+}
+
+void MetricasEtapas::atenderSenal() {
+#ifndef _WIN32
+    static bool atendiendo = false;
+    if (atendiendo) {
+        return;
+    }
+    atendiendo = true;
+
+    sigset_t senales;
+    sigemptyset(&senales);
+    sigaddset(&senales, SIGUSR1);
+    sigaddset(&senales, SIGUSR2);
+    pthread_sigmask(SIG_BLOCK, &senales, nullptr);
+
+    std::thread([this, senales]() {
+        int senal = 0;
+        Traza::instancia().nombrarHilo("Senales");
+        while (sigwait(&senales, &senal) == 0) {
+            if (senal == SIGUSR1) {
+                imprimir(std::cerr);
+                continue;
+            }
+            size_t eventos = Traza::instancia().exportar("Traza.json");
+            std::cerr << "Traza: " << eventos << " evento(s) en Traza.json\n";
+        }
+    }).detach();
+#endif
+}
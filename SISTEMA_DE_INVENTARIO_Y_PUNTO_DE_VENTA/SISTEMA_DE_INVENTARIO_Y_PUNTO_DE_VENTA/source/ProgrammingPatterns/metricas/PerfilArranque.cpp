@@ -0,0 +1,207 @@
+﻿/**
+ * @file PerfilArranque.cpp
+ * @brief Contadores del proceso, `operator new` que cuenta reservas e informe del arranque.
+ *
+ * @date 2026-10-19
+ * @version 1.0
+ * @author Ari
+ */
+#include "ProgrammingPatterns/metricas/PerfilArranque.h"
+#include "ProgrammingPatterns/modelos/LectorJsonPlano.h"
+#include <algorithm>
+#include <atomic>
+#include <cstdio>
+#include <cstdlib>
+#include <new>
+#include <string>
+#ifdef _WIN32
+#define WIN32_LEAN_AND_MEAN
+#define NOMINMAX
+#include <windows.h>
+#endif
+
+#if POS_METRICAS
+
+// Reservas contadas mientras el perfil está activo. Reemplazar `operator new`
+// en esta unidad asegura que quede enlazado junto con el perfil.
+static std::atomic<bool> contandoReservas{ false };
+static std::atomic<std::uint64_t> totalReservas{ 0 };
+static std::atomic<std::uint64_t> totalBytesReservados{ 0 };
+
+/**
+ * @brief Reserva con `malloc`, contando si el perfil está activo.
+ */
+static void* reservar(std::size_t bytes) noexcept {
+    if (bytes == 0) {
+        bytes = 1;
+    }
+    if (contandoReservas.load(std::memory_order_relaxed)) {
+        totalReservas.fetch_add(1, std::memory_order_relaxed);
+        totalBytesReservados.fetch_add(bytes, std::memory_order_relaxed);
+    }
+    return std::malloc(bytes);
+}
+
+/**
+ * @brief Reserva como exige `operator new`: reintenta con el new_handler o lanza `bad_alloc`.
+ */
+static void* reservarOLanzar(std::size_t bytes) {
+    void* p = reservar(bytes);
+    while (p == nullptr) {
+        std::new_handler manejador = std::get_new_handler();
+        if (manejador == nullptr) {
+            throw std::bad_alloc();
+        }
+        manejador();
+        p = std::malloc(bytes == 0 ? 1 : bytes);
+    }
+    return p;
+}
+
+void* operator new(std::size_t bytes) { return reservarOLanzar(bytes); }
+void* operator new[](std::size_t bytes) { return reservarOLanzar(bytes); }
+void* operator new(std::size_t bytes, const std::nothrow_t&) noexcept { return reservar(bytes); }
+void* operator new[](std::size_t bytes, const std::nothrow_t&) noexcept { return reservar(bytes); }
+void operator delete(void* p) noexcept { std::free(p); }
+void operator delete[](void* p) noexcept { std::free(p); }
+void operator delete(void* p, std::size_t) noexcept { std::free(p); }
+void operator delete[](void* p, std::size_t) noexcept { std::free(p); }
+void operator delete(void* p, const std::nothrow_t&) noexcept { std::free(p); }
+void operator delete[](void* p, const std::nothrow_t&) noexcept { std::free(p); }
+
+#endif
+
+/**
+ * @brief Bytes que el proceso ha leído (archivos, tuberías y sockets), más
+ * los archivos proyectados en memoria, que el sistema no cuenta.
+ */
+static std::uint64_t bytesLeidosProceso() {
+#ifdef _WIN32
+    IO_COUNTERS io;
+    if (GetProcessIoCounters(GetCurrentProcess(), &io)) {
+        return static_cast<std::uint64_t>(io.ReadTransferCount);
+    }
+    return 0;
+#else
+    std::FILE* f = std::fopen("/proc/self/io", "r");
+    if (f == nullptr) {
+        return 0;
+    }
+    unsigned long long leidos = 0;
+    if (std::fscanf(f, "rchar: %llu", &leidos) != 1) {
+        leidos = 0;
+    }
+    std::fclose(f);
+    return leidos;
+#endif
+}
+
+PerfilArranque& PerfilArranque::instancia() {
+    static PerfilArranque perfil;
+    return perfil;
+}
+
+PerfilArranque::Contadores PerfilArranque::leerContadores() {
+    Contadores c;
+    c.momento = std::chrono::steady_clock::now();
+    c.ticks = RelojCiclos::ahora();
+    c.bytesLeidos = bytesLeidosProceso() + ArchivoCompleto::totalProyectado();
+#if POS_METRICAS
+    c.reservas = totalReservas.load(std::memory_order_relaxed);
+    c.bytesReservados = totalBytesReservados.load(std::memory_order_relaxed);
+#endif
+    return c;
+}
+
+void PerfilArranque::activar() {
+    if (activo) {
+        return;
+    }
+#if POS_METRICAS
+    contandoReservas.store(true, std::memory_order_relaxed);
+#endif
+    origen = leerContadores();
+    activo = true;
+}
+
+void PerfilArranque::agregar(const char* nombre, const Contadores& desde, const Contadores& hasta, bool otroHilo) {
+    using Ms = std::chrono::duration<double, std::milli>;
+    Fase f;
+    f.nombre = nombre;
+    f.inicioMs = Ms(desde.momento - origen.momento).count();
+    f.duracionMs = Ms(hasta.momento - desde.momento).count();
+    f.bytesLeidos = hasta.bytesLeidos - desde.bytesLeidos;
+    f.reservas = hasta.reservas - desde.reservas;
+    f.bytesReservados = hasta.bytesReservados - desde.bytesReservados;
+    f.otroHilo = otroHilo;
+#if POS_METRICAS
+    Traza::registrar(nombre, desde.ticks, hasta.ticks);
+#endif
+    std::lock_guard<std::mutex> lock(mutexFases);
+    fases.push_back(f);
+}
+
+void PerfilArranque::fase(const char* nombre) {
+    if (!activo) {
+        return;
+    }
+    Contadores ahora = leerContadores();
+    if (actual != nullptr) {
+        agregar(actual, inicioActual, ahora, false);
+    }
+    actual = nombre;
+    inicioActual = ahora;
+}
+
+void PerfilArranque::terminar() {
+    if (!activo || listoMs > 0.0) {
+        return;
+    }
+    Contadores ahora = leerContadores();
+    if (actual != nullptr) {
+        agregar(actual, inicioActual, ahora, false);
+        actual = nullptr;
+    }
+    listoMs = std::chrono::duration<double, std::milli>(ahora.momento - origen.momento).count();
+#if POS_METRICAS
+    contandoReservas.store(false, std::memory_order_relaxed);
+#endif
+}
+
+void PerfilArranque::imprimir(std::ostream& salida) const {
+    std::vector<Fase> copia;
+    {
+        std::lock_guard<std::mutex> lock(mutexFases);
+        copia = fases;
+    }
+    std::stable_sort(copia.begin(), copia.end(), [](const Fase& a, const Fase& b) { return a.inicioMs < b.inicioMs; });
+
+    char linea[200];
+    std::snprintf(linea, sizeof(linea), "%-36s %10s %12s %12s %12s %14s\n", "Fase del arranque", "Inicio ms",
+        "Duracion ms", "Leido KB", "Reservas", "Reservado KB");
+    salida << linea;
+
+    bool hayOtroHilo = false;
+    for (const Fase& f : copia) {
+        std::string nombre = f.nombre;
+        if (f.otroHilo) {
+            nombre += " *";
+            hayOtroHilo = true;
+        }
+        std::snprintf(linea, sizeof(linea), "%-36s %10.1f %12.1f %12llu %12llu %14llu\n", nombre.c_str(), f.inicioMs,
+            f.duracionMs, static_cast<unsigned long long>(f.bytesLeidos / 1024),
+            static_cast<unsigned long long>(f.reservas), static_cast<unsigned long long>(f.bytesReservados / 1024));
+        salida << linea;
+    }
+    if (hayOtroHilo) {
+        salida << "* en otro hilo: sus bytes y reservas incluyen lo que corria a la vez.\n";
+    }
+#if !POS_METRICAS
+    salida << "Las reservas no se cuentan en esta compilacion (POS_METRICAS=0).\n";
+#endif
+    if (listoMs > 0.0) {
+        std::snprintf(linea, sizeof(linea), "Listo para vender a los %.1f ms.\n", listoMs);
+        salida << linea;
+    }
+    salida.flush();
+}
@@ -0,0 +1,57 @@
+﻿/**
+ * @file RelojCiclos.cpp
+ * @brief Calibración del contador de ciclos contra `steady_clock`.
+ *
+ * @date 2026-10-19
+ * @version 1.0
+ * @author Ari
+ */
+#include "ProgrammingPatterns/metricas/RelojCiclos.h"
+#include <atomic>
+#include <thread>
+
+namespace {
+
+/// Mínimo de tiempo transcurrido para calibrar.
+constexpr std::chrono::milliseconds kCalibracion{ 20 };
+
+struct Origen {
+    std::uint64_t ticks = RelojCiclos::ahora();
+    std::chrono::steady_clock::time_point instante = std::chrono::steady_clock::now();
+};
+
+const Origen& origen() {
+    static const Origen o;
+    return o;
+}
+
+// Toma el origen al arrancar, no en la primera medición
+const Origen& origenAlArrancar = origen();
+
+}
+
+double RelojCiclos::nanosegundosPorTick() {
+    // Se recalcula hasta que pasa un segundo desde el arranque; después la razón ya no cambia
+    static std::atomic<double> razonFija{ 0.0 };
+    double fija = razonFija.load(std::memory_order_relaxed);
+    if (fija > 0.0) {
+        return fija;
+    }
+
+    const Origen& o = origen();
+    auto transcurrido = std::chrono::steady_clock::now() - o.instante;
+    if (transcurrido < kCalibracion) {
+        std::this_thread::sleep_for(kCalibracion - transcurrido);
+    }
+    std::uint64_t ticks = ahora() - o.ticks;
+    auto ns = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - o.instante).count();
+    double razon = ticks == 0 ? 1.0 : static_cast<double>(ns) / static_cast<double>(ticks);
+    if (ns >= 1000000000) {
+        razonFija.store(razon, std::memory_order_relaxed);
+    }
+    return razon;
+}
+
+std::uint64_t RelojCiclos::inicio() {
+    return origen().ticks;
+}
@@ -0,0 +1,110 @@
+﻿/**
+ * @file Traza.cpp
+ * @brief Registro de anillos por hilo y escritura del JSON de trazas de Chrome.
+ *
+ * @date 2026-10-19
+ * @version 1.0
+ * @author Ari
+ */
+#include "ProgrammingPatterns/metricas/Traza.h"
+#include <cstdio>
+#include <fstream>
+
+/**
+ * @brief Escribe un texto como cadena JSON.
+ */
+static void escribirCadena(std::ofstream& salida, const char* texto) {
+    salida << '"';
+    for (const char* p = texto; *p != '\0'; p++) {
+        if (*p == '"' || *p == '\\') {
+            salida << '\\';
+        }
+        if (static_cast<unsigned char>(*p) >= 0x20) {
+            salida << *p;
+        }
+    }
+    salida << '"';
+}
+
+Traza& Traza::instancia() {
+    static Traza traza;
+    return traza;
+}
+
+Traza::Anillo* Traza::registrarHilo() {
+    std::lock_guard<std::mutex> lock(mutexAnillos);
+    anillos.push_back(std::make_unique<Anillo>());
+    Anillo* anillo = anillos.back().get();
+    anillo->hilo = static_cast<unsigned int>(anillos.size());
+    anillo->nombre = "Hilo " + std::to_string(anillo->hilo);
+    propio = anillo;
+    return anillo;
+}
+
+void Traza::nombrarHilo(const std::string& nombre) {
+    Anillo* anillo = propio != nullptr ? propio : registrarHilo();
+    std::lock_guard<std::mutex> lock(mutexAnillos);
+    anillo->nombre = nombre;
+}
+
+size_t Traza::exportar(const std::string& archivo) {
+    std::ofstream salida(archivo, std::ios::binary | std::ios::trunc);
+    if (!salida) {
+        return 0;
+    }
+
+    struct Copia {
+        const char* nombre;
+        std::uint64_t inicio;
+        std::uint64_t fin;
+    };
+    std::vector<Copia> copia;
+    copia.reserve(kEventosPorHilo);
+
+    salida << "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[\n";
+    salida << "{\"ph\":\"M\",\"pid\":1,\"tid\":0,\"name\":\"process_name\",\"args\":{\"name\":\"Punto de venta\"}}";
+
+    size_t total = 0;
+    char numero[64];
+    double nsPorTick = RelojCiclos::nanosegundosPorTick();
+    std::uint64_t origen = RelojCiclos::inicio();
+    std::lock_guard<std::mutex> lock(mutexAnillos);
+    for (const auto& anillo : anillos) {
+        salida << ",\n{\"ph\":\"M\",\"pid\":1,\"tid\":" << anillo->hilo << ",\"name\":\"thread_name\",\"args\":{\"name\":";
+        escribirCadena(salida, anillo->nombre.c_str());
+        salida << "}}";
+
+        // Se copia lo que hay y se descarta lo que el hilo alcanzó a sobrescribir
+        std::uint64_t hasta = anillo->escritos.load(std::memory_order_acquire);
+        std::uint64_t desde = hasta > kEventosPorHilo ? hasta - kEventosPorHilo : 0;
+        copia.clear();
+        for (std::uint64_t i = desde; i < hasta; i++) {
+            const Evento& e = anillo->eventos[i & (kEventosPorHilo - 1)];
+            copia.push_back({ e.nombre.load(std::memory_order_relaxed), e.inicio.load(std::memory_order_relaxed),
+                e.fin.load(std::memory_order_relaxed) });
+        }
+        // Pareja de la barrera de `registrar`: si se copió un campo que el hilo
+        // ya estaba sobrescribiendo, `despues` lo refleja
+        std::atomic_thread_fence(std::memory_order_acquire);
+        std::uint64_t despues = anillo->escritos.load(std::memory_order_relaxed);
+        std::uint64_t validosDesde = despues + 1 > kEventosPorHilo ? despues + 1 - kEventosPorHilo : 0;
+        size_t primero = validosDesde > desde ? static_cast<size_t>(validosDesde - desde) : 0;
+
+        for (size_t i = primero; i < copia.size(); i++) {
+            const Copia& c = copia[i];
+            if (c.nombre == nullptr || c.fin < c.inicio) {
+                continue;
+            }
+            double ts = c.inicio > origen ? static_cast<double>(c.inicio - origen) * nsPorTick / 1000.0 : 0.0;
+            double dur = static_cast<double>(c.fin - c.inicio) * nsPorTick / 1000.0;
+            salida << ",\n{\"ph\":\"X\",\"pid\":1,\"tid\":" << anillo->hilo << ",\"name\":";
+            escribirCadena(salida, c.nombre);
+            std::snprintf(numero, sizeof(numero), ",\"ts\":%.3f,\"dur\":%.3f}", ts, dur);
+            salida << numero;
+            total++;
+        }
+    }
+    salida << "\n]}\n";
+    salida.flush();
+    return salida ? total : 0;
+}
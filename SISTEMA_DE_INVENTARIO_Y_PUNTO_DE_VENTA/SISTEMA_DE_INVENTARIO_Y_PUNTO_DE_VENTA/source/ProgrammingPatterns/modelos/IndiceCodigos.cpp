@@ -0,0 +1,107 @@
+﻿/**
+ * @file IndiceCodigos.cpp
+ * @brief Sondeo lineal, crecimiento y borrado con corrimiento hacia atrás.
+ *
+ * @date 2026-10-19
+ * @version 1.0
+ * @author Ari
+ */
+#include "ProgrammingPatterns/modelos/IndiceCodigos.h"
+#include <functional>
+
+size_t IndiceCodigos::calcularHash(std::string_view codigo) {
+    return std::hash<std::string_view>()(codigo);
+}
+
+size_t IndiceCodigos::ubicar(std::string_view codigo, size_t hash) const {
+    size_t mascara = casillas.size() - 1;
+    size_t i = hash & mascara;
+    while (casillas[i].producto != nullptr) {
+        if (casillas[i].hash == hash && casillas[i].producto->getCodigo() == codigo) {
+            return i;
+        }
+        i = (i + 1) & mascara;
+    }
+    return i;
+}
+
+void IndiceCodigos::redimensionar(size_t nuevasCasillas) {
+    std::vector<Casilla> anteriores(nuevasCasillas);
+    anteriores.swap(casillas);
+    size_t mascara = casillas.size() - 1;
+    for (const Casilla& c : anteriores) {
+        if (c.producto == nullptr) {
+            continue;
+        }
+        size_t i = c.hash & mascara;
+        while (casillas[i].producto != nullptr) {
+            i = (i + 1) & mascara;
+        }
+        casillas[i] = c;
+    }
+}
+
+void IndiceCodigos::reservar(size_t cantidad) {
+    size_t necesarias = 16;
+    while (necesarias * 3 < cantidad * 4) {
+        necesarias <<= 1;
+    }
+    if (necesarias > casillas.size()) {
+        redimensionar(necesarias);
+    }
+}
+
+bool IndiceCodigos::insertar(Producto* producto) {
+    if ((elementos + 1) * 4 > casillas.size() * 3) {
+        redimensionar(casillas.empty() ? 16 : casillas.size() * 2);
+    }
+    size_t hash = calcularHash(producto->getCodigo());
+    size_t i = ubicar(producto->getCodigo(), hash);
+    if (casillas[i].producto != nullptr) {
+        return false;
+    }
+    casillas[i].hash = hash;
+    casillas[i].producto = producto;
+    elementos++;
+    return true;
+}
+
+bool IndiceCodigos::quitar(const Producto* producto) {
+    if (casillas.empty()) {
+        return false;
+    }
+    size_t i = ubicar(producto->getCodigo(), calcularHash(producto->getCodigo()));
+    if (casillas[i].producto != producto) {
+        return false;
+    }
+
+    // Se recorren hacia atrás las casillas siguientes que quedarían inalcanzables
+    size_t mascara = casillas.size() - 1;
+    size_t hueco = i;
+    size_t j = (i + 1) & mascara;
+    while (casillas[j].producto != nullptr) {
+        size_t ideal = casillas[j].hash & mascara;
+        if (((j - ideal) & mascara) >= ((j - hueco) & mascara)) {
+            casillas[hueco] = casillas[j];
+            hueco = j;
+        }
+        j = (j + 1) & mascara;
+    }
+    casillas[hueco] = Casilla();
+    elementos--;
+    return true;
+}
+
+Producto* IndiceCodigos::buscar(std::string_view codigo) const {
+    if (casillas.empty()) {
+        return nullptr;
+    }
+    return casillas[ubicar(codigo, calcularHash(codigo))].producto;
+}
+
+void IndiceCodigos::limpiar() {
+    for (Casilla& c : casillas) {
+        c = Casilla();
+    }
+    elementos = 0;
+}
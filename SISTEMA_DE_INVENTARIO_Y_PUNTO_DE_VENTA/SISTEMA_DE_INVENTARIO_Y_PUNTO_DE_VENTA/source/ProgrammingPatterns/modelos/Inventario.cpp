@@ -14,49 +14,126 @@
  */
 #include "ProgrammingPatterns/modelos/Inventario.h"
 #include "ProgrammingPatterns/factory/ProductoFactory.h"
+#include "ProgrammingPatterns/modelos/LectorJsonPlano.h"
 #include "nlohmann/json.hpp"
+#include <climits>
 #include <fstream>
 
 using json = nlohmann::json;
 
+/**
+ * @brief Agrega los productos leídos con `LectorJsonPlano` (el formato que escribe `guardarAJson`).
+ *
+ * Cada producto entra al índice en cuanto se crea, mientras sigue en caché.
+ * Las altas se registran al final: si el texto no tiene la forma esperada se
+ * quitan los productos agregados y el diario no ve nada.
+ *
+ * @param contenido Texto completo del archivo.
+ * @return false si el archivo no tiene esa forma (se debe leer con nlohmann).
+ */
+bool Inventario::cargarTextoPlano(std::string_view contenido) {
+    constexpr size_t kMuestraEstimacion = 1000;
+    size_t antes = productos.size();
+    LectorJsonPlano lector(contenido);
+    LectorJsonPlano::Campo campo;
+    std::string codigo;
+    std::string nombre;
+    bool correcto = true;
+    while (correcto && lector.siguienteObjeto()) {
+        bool hayCodigo = false, hayNombre = false, hayPrecio = false, hayCantidad = false;
+        double precio = 0.0;
+        long long cantidad = 0;
+        while (lector.siguienteCampo(campo)) {
+            if (campo.clave == "id" && campo.esCadena) {
+                codigo.assign(campo.valor);
+                hayCodigo = true;
+            }
+            else if (campo.clave == "nombre" && campo.esCadena) {
+                nombre.assign(campo.valor);
+                hayNombre = true;
+            }
+            else if (campo.clave == "precio" && !campo.esCadena) {
+                hayPrecio = LectorJsonPlano::aDecimal(campo.valor, precio);
+            }
+            else if (campo.clave == "cantidad" && !campo.esCadena) {
+                hayCantidad = LectorJsonPlano::aEntero(campo.valor, cantidad) && cantidad >= INT_MIN && cantidad <= INT_MAX;
+            }
+        }
+        correcto = lector.valido() && hayCodigo && hayNombre && hayPrecio && hayCantidad;
+        if (!correcto) {
+            break;
+        }
+
+        // Con los primeros objetos se estima cuántos vienen (con holgura), para
+        // no rehacer el índice a media carga
+        if (productos.size() == antes + kMuestraEstimacion) {
+            size_t estimado = contenido.size() / (lector.posicion() / kMuestraEstimacion + 1) * 5 / 4;
+            productos.reserve(antes + estimado);
+            indice.reservar(indice.size() + estimado);
+        }
+        auto producto = ProductoFactory::crearProducto(codigo, nombre, Dinero::desdePesos(precio), static_cast<int>(cantidad));
+        indice.insertar(producto.get());
+        productos.push_back(std::move(producto));
+    }
+
+    if (!correcto || !lector.valido()) {
+        for (size_t i = productos.size(); i-- > antes;) {
+            indice.quitar(productos[i].get());
+        }
+        productos.resize(antes);
+        return false;
+    }
+    for (size_t i = antes; i < productos.size(); i++) {
+        registrar(MovimientoInventario::Tipo::Alta, *productos[i], 0);
+    }
+    return true;
+}
+
 /**
  * @brief Carga los productos desde un archivo JSON.
  *
  * Cada entrada del archivo se utiliza para crear productos
- * a través de la fábrica ProductoFactory.
+ * a través de la fábrica ProductoFactory. El archivo se lee de una vez y se
+ * recorre con `LectorJsonPlano`; solo si no tiene la forma habitual se arma
+ * el documento de nlohmann.
  *
  * @param archivo Nombre del archivo JSON a leer.
  */
 void Inventario::cargarDesdeJson(const std::string& archivo) {
-    std::ifstream file(archivo);
-    if (!file.is_open()) {
+    POS_TRAZA("Cargar inventario");
+    ArchivoCompleto contenido;
+    if (!contenido.abrir(archivo)) {
         std::cout << "No se pudo abrir " << archivo << "\n";
         return;
     }
 
-    json data;
-    file >> data;
+    if (cargarTextoPlano(contenido.texto())) {
+        return;
+    }
 
+    // Con otra forma (campos faltantes, valores anidados) se lee el documento completo
+    json data = json::parse(contenido.texto().begin(), contenido.texto().end());
     for (auto& item : data) {
         auto producto = ProductoFactory::crearProducto(
             item["id"].get<std::string>(),
             item["nombre"].get<std::string>(),
-            item["precio"].get<double>(),
+            Dinero::desdePesos(item["precio"].get<double>()),
             item["cantidad"].get<int>()
         );
-        productos.push_back(std::move(producto));
+        agregarProducto(std::move(producto));
     }
 }
 
 /**
- * @brief Muestra todos los productos en el inventario por consola.
+ * @brief Muestra los productos en una tabla con búfer (ver ReporteConsola).
+ *
+ * @param filtro Texto a buscar, stock máximo y página.
+ * @param salida Flujo donde se escribe.
+ * @return ResultadoReporte Coincidencias y páginas.
  */
-void Inventario::listarProductos() {
-    for (auto& p : productos) {
-        std::cout << p->getCodigo() << " - " << p->getNombre()
-            << " | $" << p->getPrecio()
-            << " | Stock: " << p->getCantidad() << "\n";
-    }
+ResultadoReporte Inventario::listarProductos(const FiltroReporte& filtro, std::ostream& salida) {
+    ReporteConsola reporte(salida);
+    return reporte.productos(productos, filtro);
 }
 
 /**
@@ -66,29 +143,30 @@ void Inventario::listarProductos() {
  *
  * @param codigo Código del producto a vender.
  * @param cantidadVendida Cantidad solicitada por el cliente.
- * @return Total de la venta. Devuelve 0 si falla la operación.
+ * @return Total de la venta. Devuelve $0.00 si falla la operación.
  */
-double Inventario::venderProducto(const std::string& codigo, int cantidadVendida) {
-    for (auto& p : productos) {
-        if (p->getCodigo() == codigo) {
-            if (p->getCantidad() < cantidadVendida) {
-                std::cout << "No hay suficiente stock.\n";
-                return 0;
-            }
+Dinero Inventario::venderProducto(const std::string& codigo, int cantidadVendida) {
+    Producto* p = indice.buscar(codigo);
+    if (p == nullptr) {
+        std::cout << "Producto no encontrado.\n";
+        return Dinero();
+    }
 
-            p->setCantidad(p->getCantidad() - cantidadVendida);
-            double total = p->getPrecio() * cantidadVendida;
+    if (p->getCantidad() < cantidadVendida) {
+        std::cout << "No hay suficiente stock.\n";
+        return Dinero();
+    }
 
-            // Notificación por stock bajo
-            if (p->getCantidad() < 5) {
-                notificar("Stock bajo de " + p->getNombre());
-            }
+    p->setCantidad(p->getCantidad() - cantidadVendida);
+    Dinero total = p->getPrecio() * cantidadVendida;
+    registrar(MovimientoInventario::Tipo::Venta, *p, cantidadVendida);
 
-            return total;
-        }
+    // Notificación por stock bajo
+    if (p->getCantidad() < 5) {
+        notificar("Stock bajo de " + p->getNombre());
     }
-    std::cout << "Producto no encontrado.\n";
-    return 0;
+
+    return total;
 }
 
 /**
@@ -98,12 +176,101 @@ double Inventario::venderProducto(const std::string& codigo, int cantidadVendida
  * @param cantidad Cantidad a agregar al inventario.
  */
 void Inventario::comprarProducto(const std::string& codigo, int cantidad) {
-    for (auto& p : productos) {
-        if (p->getCodigo() == codigo) {
-            p->setCantidad(p->getCantidad() + cantidad);
-            return;
+    Producto* p = indice.buscar(codigo);
+    if (p != nullptr) {
+        p->setCantidad(p->getCantidad() + cantidad);
+        registrar(MovimientoInventario::Tipo::Compra, *p, cantidad);
+    }
+}
+
+/**
+ * @brief Cambia el precio unitario de un producto.
+ *
+ * @param codigo Código del producto.
+ * @param precio Precio nuevo.
+ * @return true si el producto existe.
+ */
+bool Inventario::cambiarPrecio(const std::string& codigo, Dinero precio) {
+    Producto* p = indice.buscar(codigo);
+    if (p == nullptr) {
+        return false;
+    }
+    p->setPrecio(precio);
+    registrar(MovimientoInventario::Tipo::Precio, *p, 0);
+    return true;
+}
+
+/**
+ * @brief Agrega un producto al final del inventario.
+ *
+ * @param producto Producto a agregar.
+ */
+void Inventario::agregarProducto(std::unique_ptr<Producto> producto) {
+    // Si el código se repite, las búsquedas siguen encontrando el primero
+    indice.insertar(producto.get());
+    productos.push_back(std::move(producto));
+    registrar(MovimientoInventario::Tipo::Alta, *productos.back(), 0);
+}
+
+/**
+ * @brief Numera un movimiento y, si hay diario, se lo entrega.
+ *
+ * @param tipo Operación que lo produjo.
+ * @param producto Producto ya modificado.
+ * @param cantidad Unidades vendidas o compradas.
+ */
+void Inventario::registrar(MovimientoInventario::Tipo tipo, const Producto& producto, int cantidad) {
+    secuencia++;
+    if (diario == nullptr) {
+        return;
+    }
+    MovimientoInventario m;
+    m.tipo = tipo;
+    m.secuencia = secuencia;
+    m.codigo = producto.getCodigo();
+    if (tipo == MovimientoInventario::Tipo::Alta) {
+        m.nombre = producto.getNombre();
+    }
+    m.cantidad = cantidad;
+    m.stock = producto.getCantidad();
+    m.centavos = producto.getPrecio().getCentavos();
+    diario->registrar(m);
+}
+
+/**
+ * @brief Aplica un movimiento del inventario líder.
+ *
+ * Se copia el estado resultante (stock y precio), por lo que repetir un
+ * movimiento no lo aplica dos veces.
+ *
+ * @param m Movimiento recibido.
+ */
+void Inventario::aplicarMovimiento(const MovimientoInventario& m) {
+    Producto* p = indice.buscar(m.codigo);
+    if (p == nullptr) {
+        if (m.tipo == MovimientoInventario::Tipo::Alta) {
+            auto producto = ProductoFactory::crearProducto(m.codigo, m.nombre,
+                Dinero::desdeCentavos(m.centavos), m.stock);
+            indice.insertar(producto.get());
+            productos.push_back(std::move(producto));
         }
     }
+    else {
+        p->setCantidad(m.stock);
+        p->setPrecio(Dinero::desdeCentavos(m.centavos));
+    }
+    secuencia = m.secuencia;
+}
+
+/**
+ * @brief Quita todos los productos del inventario.
+ *
+ * @param nuevaSecuencia Secuencia de la copia que se va a cargar.
+ */
+void Inventario::vaciar(unsigned long long nuevaSecuencia) {
+    indice.limpiar();
+    productos.clear();
+    secuencia = nuevaSecuencia;
 }
 
 /**
@@ -112,15 +279,11 @@ void Inventario::comprarProducto(const std::string& codigo, int cantidad) {
  * @param archivo Ruta del archivo donde se guardará el inventario.
  */
 void Inventario::guardarAJson(const std::string& archivo) {
+    POS_TRAZA("Guardar inventario");
     json data = json::array();
 
     for (auto& p : productos) {
-        data.push_back({
-            {"id", p->getCodigo()},
-            {"nombre", p->getNombre()},
-            {"precio", p->getPrecio()},
-            {"cantidad", p->getCantidad()}
-            });
+        data.push_back(*p);
     }
 
     std::ofstream file(archivo);
@@ -135,21 +298,27 @@ void Inventario::guardarAJson(const std::string& archivo) {
  * @return Nombre del producto, o "Desconocido" si no existe.
  */
 std::string Inventario::obtenerNombreProducto(const std::string& codigo) const {
-    for (const auto& p : productos)
-        if (p->getCodigo() == codigo)
-            return p->getNombre();
-    return "Desconocido";
+    const Producto* p = buscarProducto(codigo);
+    return p != nullptr ? p->getNombre() : "Desconocido";
 }
 
 /**
  * @brief Obtiene el precio unitario del producto según su código.
  *
  * @param codigo Código del producto.
- * @return Precio del producto o 0.0 si no existe.
+ * @return Precio del producto o $0.00 si no existe.
+ */
+Dinero Inventario::obtenerPrecioProducto(const std::string& codigo) const {
+    const Producto* p = buscarProducto(codigo);
+    return p != nullptr ? p->getPrecio() : Dinero();
+}
+
+/**
+ * @brief Busca un producto por código en tiempo constante.
+ *
+ * @param codigo Código del producto.
+ * @return Producto encontrado o nullptr.
  */
-double Inventario::obtenerPrecioProducto(const std::string& codigo) const {
-    for (const auto& p : productos)
-        if (p->getCodigo() == codigo)
-            return p->getPrecio();
-    return 0.0;
+const Producto* Inventario::buscarProducto(std::string_view codigo) const {
+    return indice.buscar(codigo);
 }
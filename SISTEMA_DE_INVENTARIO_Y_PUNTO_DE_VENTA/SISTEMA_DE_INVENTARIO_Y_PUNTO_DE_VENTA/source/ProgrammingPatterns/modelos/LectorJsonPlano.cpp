@@ -0,0 +1,324 @@
+﻿/**
+ * @file LectorJsonPlano.cpp
+ * @brief Proyección del archivo, recorrido del texto, cadenas con escapes y
+ * conversión de números.
+ *
+ * @date 2026-10-19
+ * @version 1.0
+ * @author Ari
+ */
+#include "ProgrammingPatterns/modelos/LectorJsonPlano.h"
+#include <atomic>
+#include <charconv>
+#include <cstring>
+#include <fstream>
+#ifndef _WIN32
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+static std::atomic<std::uint64_t> bytesProyectados{ 0 };
+
+std::uint64_t ArchivoCompleto::totalProyectado() {
+    return bytesProyectados.load(std::memory_order_relaxed);
+}
+
+ArchivoCompleto::~ArchivoCompleto() {
+#ifndef _WIN32
+    if (proyectado != nullptr) {
+        munmap(const_cast<char*>(proyectado), largo);
+    }
+#endif
+}
+
+bool ArchivoCompleto::abrir(const std::string& archivo) {
+#ifndef _WIN32
+    int fd = open(archivo.c_str(), O_RDONLY);
+    if (fd < 0) {
+        return false;
+    }
+    struct stat info;
+    if (fstat(fd, &info) == 0 && info.st_size > 0) {
+        void* p = mmap(nullptr, static_cast<size_t>(info.st_size), PROT_READ, MAP_PRIVATE, fd, 0);
+        if (p != MAP_FAILED) {
+            // El texto se recorre una vez de principio a fin
+            madvise(p, static_cast<size_t>(info.st_size), MADV_SEQUENTIAL);
+            proyectado = static_cast<const char*>(p);
+            largo = static_cast<size_t>(info.st_size);
+            bytesProyectados.fetch_add(largo, std::memory_order_relaxed);
+            close(fd);
+            return true;
+        }
+    }
+    close(fd);
+#endif
+
+    // Sin proyección (Windows, archivo vacío o especial): una sola lectura
+    std::ifstream file(archivo, std::ios::binary);
+    if (!file.is_open()) {
+        return false;
+    }
+    file.seekg(0, std::ios::end);
+    std::streamoff tam = file.tellg();
+    if (tam < 0) {
+        return false;
+    }
+    file.seekg(0, std::ios::beg);
+    copia.resize(static_cast<size_t>(tam));
+    file.read(copia.data(), tam);
+    copia.resize(static_cast<size_t>(file.gcount()));
+    return true;
+}
+
+void LectorJsonPlano::saltarEspacios() {
+    while (pos < texto.size()) {
+        char c = texto[pos];
+        if (c != ' ' && c != '\n' && c != '\r' && c != '\t') {
+            return;
+        }
+        pos++;
+    }
+}
+
+bool LectorJsonPlano::fallar() {
+    error = true;
+    dentroObjeto = false;
+    return false;
+}
+
+/**
+ * @brief Agrega un punto de código Unicode en UTF-8.
+ */
+static void agregarUtf8(std::string& destino, unsigned int cp) {
+    if (cp < 0x80) {
+        destino += static_cast<char>(cp);
+    }
+    else if (cp < 0x800) {
+        destino += static_cast<char>(0xC0 | (cp >> 6));
+        destino += static_cast<char>(0x80 | (cp & 0x3F));
+    }
+    else if (cp < 0x10000) {
+        destino += static_cast<char>(0xE0 | (cp >> 12));
+        destino += static_cast<char>(0x80 | ((cp >> 6) & 0x3F));
+        destino += static_cast<char>(0x80 | (cp & 0x3F));
+    }
+    else {
+        destino += static_cast<char>(0xF0 | (cp >> 18));
+        destino += static_cast<char>(0x80 | ((cp >> 12) & 0x3F));
+        destino += static_cast<char>(0x80 | ((cp >> 6) & 0x3F));
+        destino += static_cast<char>(0x80 | (cp & 0x3F));
+    }
+}
+
+/**
+ * @brief Lee los cuatro dígitos hexadecimales de un `\\uXXXX`.
+ */
+static bool leerHex4(std::string_view texto, size_t pos, unsigned int& valor) {
+    if (pos + 4 > texto.size()) {
+        return false;
+    }
+    auto r = std::from_chars(texto.data() + pos, texto.data() + pos + 4, valor, 16);
+    return r.ec == std::errc() && r.ptr == texto.data() + pos + 4;
+}
+
+/**
+ * @brief Lee la cadena que empieza en `pos` (sobre la comilla).
+ *
+ * Sin escapes, la vista apunta al texto original; con escapes se arma en `copia`.
+ */
+bool LectorJsonPlano::leerCadena(std::string_view& destino, std::string& copia) {
+    if (pos >= texto.size() || texto[pos] != '"') {
+        return false;
+    }
+    size_t desde = pos + 1;
+    const char* inicio = texto.data() + desde;
+    size_t resto = texto.size() - desde;
+    const char* comilla = static_cast<const char*>(std::memchr(inicio, '"', resto));
+    if (comilla == nullptr) {
+        return false;
+    }
+    if (std::memchr(inicio, '\\', static_cast<size_t>(comilla - inicio)) == nullptr) {
+        destino = std::string_view(inicio, static_cast<size_t>(comilla - inicio));
+        pos = desde + destino.size() + 1;
+        return true;
+    }
+
+    copia.clear();
+    size_t i = desde;
+    while (i < texto.size()) {
+        char c = texto[i];
+        if (c == '"') {
+            destino = copia;
+            pos = i + 1;
+            return true;
+        }
+        if (c != '\\') {
+            copia += c;
+            i++;
+            continue;
+        }
+        if (i + 1 >= texto.size()) {
+            return false;
+        }
+        char e = texto[i + 1];
+        i += 2;
+        switch (e) {
+        case '"':  copia += '"'; break;
+        case '\\': copia += '\\'; break;
+        case '/':  copia += '/'; break;
+        case 'b':  copia += '\b'; break;
+        case 'f':  copia += '\f'; break;
+        case 'n':  copia += '\n'; break;
+        case 'r':  copia += '\r'; break;
+        case 't':  copia += '\t'; break;
+        case 'u': {
+            unsigned int cp = 0;
+            if (!leerHex4(texto, i, cp)) {
+                return false;
+            }
+            i += 4;
+            // Par sustituto (caracteres fuera del plano básico)
+            if (cp >= 0xD800 && cp <= 0xDBFF) {
+                unsigned int bajo = 0;
+                if (i + 1 >= texto.size() || texto[i] != '\\' || texto[i + 1] != 'u' || !leerHex4(texto, i + 2, bajo) ||
+                    bajo < 0xDC00 || bajo > 0xDFFF) {
+                    return false;
+                }
+                i += 6;
+                cp = 0x10000 + ((cp - 0xD800) << 10) + (bajo - 0xDC00);
+            }
+            else if (cp >= 0xDC00 && cp <= 0xDFFF) {
+                return false;
+            }
+            agregarUtf8(copia, cp);
+            break;
+        }
+        default:
+            return false;
+        }
+    }
+    return false;
+}
+
+bool LectorJsonPlano::siguienteObjeto() {
+    if (error || terminado) {
+        return false;
+    }
+
+    // Campos que el llamador no leyó del objeto anterior
+    Campo resto;
+    while (dentroObjeto && siguienteCampo(resto)) {
+    }
+    if (error) {
+        return false;
+    }
+
+    saltarEspacios();
+    if (!empezado) {
+        empezado = true;
+        if (pos >= texto.size() || texto[pos] != '[') {
+            return fallar();
+        }
+        pos++;
+        saltarEspacios();
+        if (pos < texto.size() && texto[pos] == ']') {
+            pos++;
+            terminado = true;
+        }
+    }
+    else if (pos < texto.size() && texto[pos] == ',') {
+        pos++;
+        saltarEspacios();
+    }
+    else if (pos < texto.size() && texto[pos] == ']') {
+        pos++;
+        terminado = true;
+    }
+    else {
+        return fallar();
+    }
+
+    if (terminado) {
+        saltarEspacios();
+        return pos == texto.size() ? false : fallar();
+    }
+    if (pos >= texto.size() || texto[pos] != '{') {
+        return fallar();
+    }
+    pos++;
+    dentroObjeto = true;
+    primerCampo = true;
+    return true;
+}
+
+bool LectorJsonPlano::siguienteCampo(Campo& campo) {
+    if (!dentroObjeto) {
+        return false;
+    }
+    saltarEspacios();
+    if (pos < texto.size() && texto[pos] == '}') {
+        pos++;
+        dentroObjeto = false;
+        return false;
+    }
+    if (!primerCampo) {
+        if (pos >= texto.size() || texto[pos] != ',') {
+            return fallar();
+        }
+        pos++;
+        saltarEspacios();
+    }
+    primerCampo = false;
+
+    if (!leerCadena(campo.clave, claveSinEscapes)) {
+        return fallar();
+    }
+    saltarEspacios();
+    if (pos >= texto.size() || texto[pos] != ':') {
+        return fallar();
+    }
+    pos++;
+    saltarEspacios();
+    if (pos >= texto.size()) {
+        return fallar();
+    }
+
+    if (texto[pos] == '"') {
+        campo.esCadena = true;
+        if (!leerCadena(campo.valor, valorSinEscapes)) {
+            return fallar();
+        }
+        return true;
+    }
+
+    // Número o literal: hasta el siguiente separador. Objetos y arreglos no se aceptan.
+    size_t desde = pos;
+    while (pos < texto.size()) {
+        char c = texto[pos];
+        if (c == ',' || c == '}' || c == ']' || c == ' ' || c == '\n' || c == '\r' || c == '\t') {
+            break;
+        }
+        if (c == '{' || c == '[' || c == '"') {
+            return fallar();
+        }
+        pos++;
+    }
+    if (pos == desde) {
+        return fallar();
+    }
+    campo.esCadena = false;
+    campo.valor = texto.substr(desde, pos - desde);
+    return true;
+}
+
+bool LectorJsonPlano::aEntero(std::string_view valor, long long& destino) {
+    auto r = std::from_chars(valor.data(), valor.data() + valor.size(), destino);
+    return r.ec == std::errc() && r.ptr == valor.data() + valor.size();
+}
+
+bool LectorJsonPlano::aDecimal(std::string_view valor, double& destino) {
+    auto r = std::from_chars(valor.data(), valor.data() + valor.size(), destino);
+    return r.ec == std::errc() && r.ptr == valor.data() + valor.size();
+}
@@ -1,9 +1,9 @@
 /**
  * @file Producto.cpp
- * @brief Implementacin de la clase Producto.
+ * @brief Implementación de la clase Producto.
  *
- * Esta clase representa un producto dentro del inventario. Contiene informacin
- * bsica como cdigo, nombre, precio y cantidad disponible, adems de mtodos
+ * Esta clase representa un producto dentro del inventario. Contiene información
+ * básica como código, nombre, precio y cantidad disponible, además de métodos
  * para consultar y modificar dichos atributos.
  *
  * @date 2025-11-07
@@ -11,35 +11,36 @@
  * @author Ari
  */
 #include "ProgrammingPatterns/modelos/Producto.h"
+#include "nlohmann/json.hpp"
 
  /**
   * @brief Constructor de la clase Producto.
   *
   * Inicializa un nuevo producto con los valores proporcionados.
   *
-  * @param c Cdigo nico del producto.
+  * @param c Código único del producto.
   * @param n Nombre del producto.
   * @param p Precio unitario del producto.
   * @param q Cantidad disponible en inventario.
   */
-Producto::Producto(std::string c, std::string n, double p, int q) : codigo(c), nombre(n), precio(p), cantidad(q) {}
+Producto::Producto(std::string c, std::string n, Dinero p, int q) : codigo(std::move(c)), nombre(std::move(n)), precio(p), cantidad(q) {}
 
 /**
- * @brief Obtiene el cdigo del producto.
- * @return Cdigo del producto como una cadena de texto.
+ * @brief Obtiene el código del producto.
+ * @return Código del producto como una cadena de texto.
  */
-std::string Producto::getCodigo() const { return codigo;}
+const std::string& Producto::getCodigo() const { return codigo;}
 
 /**
  * @brief Obtiene el nombre del producto.
  * @return Nombre del producto como una cadena de texto.
  */
-std::string Producto::getNombre() const { return nombre;}
+const std::string& Producto::getNombre() const { return nombre;}
 /**
  * @brief Obtiene el precio unitario del producto.
- * @return Precio como valor de tipo double.
+ * @return Precio en centavos exactos (Dinero).
  */
-double 
+Dinero 
 Producto::getPrecio() const { return precio;}
 /**
  * @brief Obtiene la cantidad disponible del producto.
@@ -59,4 +60,17 @@ Producto::setCantidad(int nuevaCantidad) { cantidad = nuevaCantidad;}
  * @param nuevoPrecio Nuevo valor del precio.
  */
 void 
-Producto::setPrecio(double nuevoPrecio) { precio = nuevoPrecio;}
\ No newline at end of file
+Producto::setPrecio(Dinero nuevoPrecio) { precio = nuevoPrecio;}
+/**
+ * @brief Serializa el producto con los campos de `Productos.json`.
+ * @param j JSON de salida.
+ * @param p Producto a serializar.
+ */
+void to_json(nlohmann::json& j, const Producto& p) {
+	j = {
+		{"id", p.getCodigo()},
+		{"nombre", p.getNombre()},
+		{"precio", p.getPrecio().aPesos()},
+		{"cantidad", p.getCantidad()}
+	};
+}
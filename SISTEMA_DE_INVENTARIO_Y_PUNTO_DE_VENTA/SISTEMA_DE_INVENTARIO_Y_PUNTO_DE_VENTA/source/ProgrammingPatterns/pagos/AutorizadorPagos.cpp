@@ -0,0 +1,130 @@
+﻿/**
+ * @file AutorizadorPagos.cpp
+ * @brief Implementación de la cola de autorizaciones y sus hilos trabajadores.
+ *
+ * @date 2026-10-19
+ * @version 1.0
+ * @author Ari
+ */
+#include "ProgrammingPatterns/pagos/AutorizadorPagos.h"
+#include "ProgrammingPatterns/metricas/Traza.h"
+
+AutorizadorPagos::AutorizadorPagos(PasarelaPagos& pasarela, int numeroHilos) : pasarela(pasarela) {
+    for (int i = 0; i < std::max(1, numeroHilos); i++) {
+        hilos.emplace_back(&AutorizadorPagos::trabajar, this);
+    }
+}
+
+AutorizadorPagos::~AutorizadorPagos() {
+    {
+        std::lock_guard<std::mutex> lock(mutexCola);
+        detener = true;
+    }
+    hayTrabajo.notify_all();
+    for (auto& h : hilos) {
+        h.join();
+    }
+}
+
+/**
+ * @brief Toma solicitudes de la cola y las envía a la pasarela.
+ *
+ * Al detenerse, el trabajador termina de vaciar la cola para que ningún
+ * futuro quede sin resultado.
+ */
+void AutorizadorPagos::trabajar() {
+    Traza::instancia().nombrarHilo("Autorizador");
+    while (true) {
+        Trabajo trabajo;
+        {
+            std::unique_lock<std::mutex> lock(mutexCola);
+            hayTrabajo.wait(lock, [this] { return detener || !cola.empty(); });
+            if (cola.empty()) {
+                return;
+            }
+            trabajo = std::move(cola.front());
+            cola.pop_front();
+        }
+
+        try {
+            POS_TRAZA("Autorizar pago");
+            trabajo.promesa.set_value(pasarela.autorizar(trabajo.solicitud));
+        }
+        catch (...) {
+            ResultadoAutorizacion fallo;
+            fallo.id = trabajo.solicitud.id;
+            fallo.motivo = "Error de comunicacion con la pasarela";
+            trabajo.promesa.set_value(fallo);
+        }
+    }
+}
+
+/**
+ * @brief Encola la solicitud (o la aprueba al instante si es efectivo).
+ *
+ * @param solicitud Datos del cobro.
+ * @return std::future<ResultadoAutorizacion> Resultado futuro.
+ */
+std::future<ResultadoAutorizacion> AutorizadorPagos::solicitar(SolicitudAutorizacion solicitud) {
+    solicitud.id = siguienteId.fetch_add(1, std::memory_order_relaxed);
+
+    Trabajo trabajo;
+    trabajo.solicitud = solicitud;
+    std::future<ResultadoAutorizacion> futuro = trabajo.promesa.get_future();
+
+    if (solicitud.tipo == TipoPago::Efectivo) {
+        ResultadoAutorizacion resultado;
+        resultado.id = solicitud.id;
+        resultado.aprobada = true;
+        resultado.codigo = "EFECTIVO";
+        trabajo.promesa.set_value(resultado);
+        return futuro;
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(mutexCola);
+        cola.push_back(std::move(trabajo));
+    }
+    hayTrabajo.notify_one();
+    return futuro;
+}
+
+/**
+ * @brief Encola la solicitud y guarda la finalización para el hilo de la caja.
+ *
+ * @param solicitud Datos del cobro.
+ * @param alCompletar Función que recibe el resultado.
+ */
+void AutorizadorPagos::solicitar(SolicitudAutorizacion solicitud, Finalizacion alCompletar) {
+    pendientes.push_back({ solicitar(solicitud), std::move(alCompletar) });
+}
+
+/**
+ * @brief Ejecuta, en orden de envío, las finalizaciones ya resueltas.
+ *
+ * @return size_t Cantidad de finalizaciones ejecutadas.
+ */
+size_t AutorizadorPagos::atenderCompletadas() {
+    size_t atendidas = 0;
+    for (size_t i = 0; i < pendientes.size();) {
+        if (pendientes[i].futuro.wait_for(std::chrono::seconds(0)) != std::future_status::ready) {
+            i++;
+            continue;
+        }
+        Pendiente p = std::move(pendientes[i]);
+        pendientes.erase(pendientes.begin() + static_cast<long>(i));
+        p.alCompletar(p.futuro.get());
+        atendidas++;
+    }
+    return atendidas;
+}
+
+/**
+ * @brief Espera cada autorización pendiente y ejecuta su finalización.
+ */
+void AutorizadorPagos::esperarTodas() {
+    while (!pendientes.empty()) {
+        pendientes.front().futuro.wait();
+        atenderCompletadas();
+    }
+}
@@ -0,0 +1,385 @@
+﻿/**
+ * @file Liquidaciones.cpp
+ * @brief Diario binario de liquidaciones y cierre del día con agregación en paralelo.
+ *
+ * @date 2026-10-19
+ * @version 1.0
+ * @author Ari
+ */
+#include "ProgrammingPatterns/pagos/Liquidaciones.h"
+#include "ProgrammingPatterns/metricas/Traza.h"
+#include "ProgrammingPatterns/tiempo/Reloj.h"
+#include <algorithm>
+#include <cstdio>
+#include <filesystem>
+#include <iterator>
+
+/// Registros por hilo a partir de los cuales conviene repartir el cierre.
+static const size_t kRegistrosPorHilo = 16384;
+
+/**
+ * @brief Escribe un monto en centavos como "123.45" en un búfer.
+ *
+ * @param buf Búfer destino.
+ * @param tam Tamaño del búfer.
+ * @param centavos Monto en centavos.
+ * @return int Caracteres escritos.
+ */
+static int formatearCentavos(char* buf, size_t tam, long long centavos) {
+    const char* signo = centavos < 0 ? "-" : "";
+    long long abs = centavos < 0 ? -centavos : centavos;
+    return std::snprintf(buf, tam, "%s%lld.%02lld", signo, abs / 100, abs % 100);
+}
+
+/**
+ * @brief Día local a liquidar.
+ *
+ * En el día del cambio de horario la hora local no es `fecha - desde`: a partir
+ * de `cambioHorario` se le suma `ajusteSegundos` (3600 al adelantar el reloj,
+ * -3600 al atrasarlo).
+ */
+struct DiaLiquidacion {
+    time_t desde = 0;
+    time_t hasta = 0;
+    time_t cambioHorario = 0;
+    long long ajusteSegundos = 0;
+};
+
+/**
+ * @brief Arma el día local que contiene un instante y ubica su cambio de horario, si lo hay.
+ *
+ * @param instante Instante dentro del día.
+ * @return DiaLiquidacion Límites del día y ajuste de la hora.
+ */
+static DiaLiquidacion diaLocal(time_t instante) {
+    DiaLiquidacion dia;
+    Reloj::limitesDelDia(instante, dia.desde, dia.hasta);
+    dia.cambioHorario = dia.hasta;
+
+    int desfaseInicio = Reloj::local(dia.desde).desfaseMinutos;
+    int desfaseFin = Reloj::local(dia.hasta - 1).desfaseMinutos;
+    if (desfaseInicio != desfaseFin) {
+        // Primer segundo con el desfase nuevo (el cambio ocurre una vez al día)
+        time_t bajo = dia.desde;
+        time_t alto = dia.hasta - 1;
+        while (bajo < alto) {
+            time_t medio = bajo + (alto - bajo) / 2;
+            if (Reloj::local(medio).desfaseMinutos == desfaseInicio) {
+                bajo = medio + 1;
+            }
+            else {
+                alto = medio;
+            }
+        }
+        dia.cambioHorario = bajo;
+        dia.ajusteSegundos = static_cast<long long>(desfaseFin - desfaseInicio) * 60;
+    }
+    return dia;
+}
+
+/**
+ * @brief Acumulado parcial de un hilo: totales y renglones por método.
+ */
+struct ParcialLiquidacion {
+    TotalesLiquidacion totales[MotorComisiones::kTipos];
+    std::string renglones[MotorComisiones::kTipos];
+};
+
+/**
+ * @brief Acumula un tramo de registros del día.
+ *
+ * La hora se obtiene restando el inicio del día (con el ajuste del cambio de
+ * horario), sin llamar a `localtime` (que no es segura entre hilos).
+ *
+ * @param inicio Primer registro del tramo.
+ * @param fin Fin del tramo.
+ * @param dia Día a liquidar.
+ * @param parcial Salida del hilo.
+ */
+static void acumularTramo(const RegistroLiquidacion* inicio, const RegistroLiquidacion* fin,
+    DiaLiquidacion dia, ParcialLiquidacion& parcial) {
+    char linea[128];
+    for (const RegistroLiquidacion* r = inicio; r != fin; ++r) {
+        if (r->fecha < dia.desde || r->fecha >= dia.hasta || r->tipo >= MotorComisiones::kTipos) {
+            continue;
+        }
+
+        TotalesLiquidacion& t = parcial.totales[r->tipo];
+        t.operaciones++;
+        t.brutoCentavos += r->brutoCentavos;
+        t.comisionCentavos += r->comisionCentavos;
+        t.netoCentavos += r->netoCentavos;
+
+        long long s = r->fecha - dia.desde + (r->fecha >= dia.cambioHorario ? dia.ajusteSegundos : 0);
+        int n = std::snprintf(linea, sizeof(linea), "%02lld:%02lld:%02lld,%s,", s / 3600, (s / 60) % 60, s % 60,
+            marcaTarjetaToString(static_cast<MarcaTarjeta>(r->marca)));
+        n += formatearCentavos(linea + n, sizeof(linea) - n, r->brutoCentavos);
+        linea[n++] = ',';
+        n += formatearCentavos(linea + n, sizeof(linea) - n, r->comisionCentavos);
+        linea[n++] = ',';
+        n += formatearCentavos(linea + n, sizeof(linea) - n, r->netoCentavos);
+        linea[n++] = '\n';
+        parcial.renglones[r->tipo].append(linea, n);
+    }
+}
+
+/**
+ * @brief Instancia compartida del diario.
+ * @return RegistroLiquidaciones& Diario del sistema.
+ */
+RegistroLiquidaciones& RegistroLiquidaciones::instancia() {
+    static RegistroLiquidaciones registro;
+    return registro;
+}
+
+RegistroLiquidaciones::~RegistroLiquidaciones() {
+    detener();
+}
+
+/**
+ * @brief Carga el diario existente, lo abre para agregar y arranca el escritor.
+ *
+ * @param archivo Ruta del diario binario.
+ */
+void RegistroLiquidaciones::abrir(const std::string& archivo) {
+    std::lock_guard<std::mutex> lock(mutexRegistros);
+    if (hilo.joinable()) {
+        return;
+    }
+
+    std::ifstream entrada(archivo, std::ios::binary);
+    if (entrada.is_open()) {
+        entrada.seekg(0, std::ios::end);
+        size_t bytes = static_cast<size_t>(entrada.tellg());
+        size_t n = bytes / sizeof(RegistroLiquidacion);
+        entrada.seekg(0, std::ios::beg);
+        registros.resize(n);
+        entrada.read(reinterpret_cast<char*>(registros.data()), n * sizeof(RegistroLiquidacion));
+        entrada.close();
+        for (size_t i = 1; i < n && ordenados; i++) {
+            ordenados = registros[i - 1].fecha <= registros[i].fecha;
+        }
+        std::cout << " Liquidaciones cargadas desde " << archivo << " (" << n << " registros)\n";
+
+        // Un registro a medias desalinearía todos los que se agreguen después
+        if (bytes != n * sizeof(RegistroLiquidacion)) {
+            std::error_code error;
+            std::filesystem::resize_file(archivo, n * sizeof(RegistroLiquidacion), error);
+            if (error) {
+                std::cout << "No se pudo recortar el registro incompleto de " << archivo
+                    << ". Las liquidaciones no se guardaran en disco.\n";
+                return;
+            }
+            std::cout << " Se descarto un registro incompleto al final de " << archivo << "\n";
+        }
+    }
+
+    diario.open(archivo, std::ios::binary | std::ios::app);
+    if (!diario.is_open()) {
+        std::cout << "No se pudo abrir " << archivo << ". Las liquidaciones no se guardaran en disco.\n";
+        return;
+    }
+    detenerSolicitado = false;
+    hilo = std::thread(&RegistroLiquidaciones::escribir, this);
+}
+
+/**
+ * @brief Pide al escritor que escriba lo pendiente y espera a que termine.
+ */
+void RegistroLiquidaciones::detener() {
+    {
+        std::lock_guard<std::mutex> lock(mutexRegistros);
+        if (!hilo.joinable()) {
+            return;
+        }
+        detenerSolicitado = true;
+    }
+    avisoEscritor.notify_all();
+    hilo.join();
+    diario.close();
+}
+
+/**
+ * @brief Pasa al diario los registros pendientes, en lotes.
+ *
+ * Despierta cada `kIntervaloEscritura` (o al detenerse) y escribe todo lo
+ * acumulado con una sola escritura, sin tener el candado.
+ */
+void RegistroLiquidaciones::escribir() {
+    Traza::instancia().nombrarHilo("EscritorLiquidaciones");
+    std::vector<RegistroLiquidacion> lote;
+    while (true) {
+        bool terminar;
+        {
+            std::unique_lock<std::mutex> lock(mutexRegistros);
+            avisoEscritor.wait_for(lock, kIntervaloEscritura, [this] { return detenerSolicitado; });
+            terminar = detenerSolicitado;
+            lote.swap(pendientes);
+        }
+
+        if (!lote.empty()) {
+            POS_TRAZA("Escribir lote de liquidaciones");
+            diario.write(reinterpret_cast<const char*>(lote.data()),
+                static_cast<std::streamsize>(lote.size() * sizeof(RegistroLiquidacion)));
+            diario.flush();
+            lote.clear();
+        }
+        if (terminar) {
+            break;
+        }
+    }
+}
+
+/**
+ * @brief Arma el registro con la hora actual y lo agrega.
+ *
+ * @param tipo Método de pago.
+ * @param marca Marca de tarjeta.
+ * @param bruto Monto cobrado.
+ * @param comision Comisión retenida.
+ */
+void RegistroLiquidaciones::registrar(TipoPago tipo, MarcaTarjeta marca, Dinero bruto, Dinero comision) {
+    RegistroLiquidacion r;
+    r.fecha = static_cast<std::int64_t>(Reloj::ahora());
+    r.brutoCentavos = bruto.getCentavos();
+    r.comisionCentavos = comision.getCentavos();
+    r.netoCentavos = (bruto - comision).getCentavos();
+    r.tipo = static_cast<std::uint8_t>(tipo);
+    r.marca = static_cast<std::uint8_t>(marca);
+    registrar(r);
+}
+
+/**
+ * @brief Agrega el registro en memoria y lo deja pendiente para el diario.
+ *
+ * @param registro Registro de liquidación.
+ */
+void RegistroLiquidaciones::registrar(const RegistroLiquidacion& registro) {
+    std::lock_guard<std::mutex> lock(mutexRegistros);
+    if (!registros.empty() && registro.fecha < registros.back().fecha) {
+        ordenados = false;
+    }
+    registros.push_back(registro);
+    if (hilo.joinable() && !detenerSolicitado) {
+        pendientes.push_back(registro);
+    }
+}
+
+size_t RegistroLiquidaciones::totalRegistros() const {
+    std::lock_guard<std::mutex> lock(mutexRegistros);
+    return registros.size();
+}
+
+/**
+ * @brief Liquida el día: agrega en paralelo y escribe un archivo por método.
+ *
+ * Si los registros están en orden de fecha (lo normal: se agregan al
+ * cobrar), solo se recorren los del día; si no, se revisan todos. Bajo el
+ * candado solo se copian los registros del día, para no detener los cobros
+ * mientras se agregan y se escriben los archivos.
+ *
+ * @param dia Instante dentro del día a liquidar.
+ * @param directorio Carpeta destino.
+ * @param totales Salida opcional de totales por método.
+ * @return size_t Registros liquidados.
+ */
+size_t RegistroLiquidaciones::cerrarDia(time_t dia, const std::string& directorio, TotalesLiquidacion* totales) const {
+    DiaLiquidacion limites = diaLocal(dia);
+    char fechaTexto[16];
+    std::snprintf(fechaTexto, sizeof(fechaTexto), "%.10s", Reloj::local(dia).textoIso);
+
+    std::vector<RegistroLiquidacion> delDia;
+    {
+        std::lock_guard<std::mutex> lock(mutexRegistros);
+        if (ordenados) {
+            auto antesDe = [](const RegistroLiquidacion& r, time_t t) { return r.fecha < t; };
+            auto desde = std::lower_bound(registros.begin(), registros.end(), limites.desde, antesDe);
+            auto hasta = std::lower_bound(desde, registros.end(), limites.hasta, antesDe);
+            delDia.assign(desde, hasta);
+        }
+        else {
+            std::copy_if(registros.begin(), registros.end(), std::back_inserter(delDia),
+                [&limites](const RegistroLiquidacion& r) { return r.fecha >= limites.desde && r.fecha < limites.hasta; });
+        }
+    }
+    const RegistroLiquidacion* primero = delDia.data();
+    const RegistroLiquidacion* ultimo = delDia.data() + delDia.size();
+
+    // Repartir los registros en tramos contiguos, uno por hilo
+    size_t n = static_cast<size_t>(ultimo - primero);
+    size_t maxHilos = std::max(1u, std::thread::hardware_concurrency());
+    size_t numHilos = std::min(maxHilos, n / kRegistrosPorHilo + 1);
+    std::vector<ParcialLiquidacion> parciales(numHilos);
+    std::vector<std::thread> hilos;
+    size_t tramo = (n + numHilos - 1) / numHilos;
+    for (size_t h = 0; h < numHilos; h++) {
+        const RegistroLiquidacion* inicio = primero + std::min(n, h * tramo);
+        const RegistroLiquidacion* fin = primero + std::min(n, (h + 1) * tramo);
+        if (h + 1 == numHilos) {
+            acumularTramo(inicio, fin, limites, parciales[h]);
+        }
+        else {
+            hilos.emplace_back(acumularTramo, inicio, fin, limites, std::ref(parciales[h]));
+        }
+    }
+    for (auto& h : hilos) {
+        h.join();
+    }
+
+    // Unir los parciales en orden y escribir cada archivo de una vez
+    std::cout << "\n LIQUIDACION DEL DIA " << fechaTexto << ":\n";
+    size_t liquidados = 0;
+    char linea[160];
+    for (int t = 0; t < MotorComisiones::kTipos; t++) {
+        TotalesLiquidacion suma;
+        size_t tamano = 0;
+        for (const auto& p : parciales) {
+            suma.operaciones += p.totales[t].operaciones;
+            suma.brutoCentavos += p.totales[t].brutoCentavos;
+            suma.comisionCentavos += p.totales[t].comisionCentavos;
+            suma.netoCentavos += p.totales[t].netoCentavos;
+            tamano += p.renglones[t].size();
+        }
+        if (totales != nullptr) {
+            totales[t] = suma;
+        }
+        if (suma.operaciones == 0) {
+            continue;
+        }
+        liquidados += static_cast<size_t>(suma.operaciones);
+
+        std::string contenido;
+        contenido.reserve(tamano + 128);
+        contenido += "hora,marca,bruto,comision,neto\n";
+        for (const auto& p : parciales) {
+            contenido += p.renglones[t];
+        }
+        int k = std::snprintf(linea, sizeof(linea), "TOTAL,%lld,", suma.operaciones);
+        k += formatearCentavos(linea + k, sizeof(linea) - k, suma.brutoCentavos);
+        linea[k++] = ',';
+        k += formatearCentavos(linea + k, sizeof(linea) - k, suma.comisionCentavos);
+        linea[k++] = ',';
+        k += formatearCentavos(linea + k, sizeof(linea) - k, suma.netoCentavos);
+        linea[k++] = '\n';
+        contenido.append(linea, k);
+
+        const char* metodo = tipoPagoToString(static_cast<TipoPago>(t));
+        std::string archivo = directorio + "Liquidacion_" + fechaTexto + "_" + metodo + ".csv";
+        std::ofstream salida(archivo, std::ios::binary);
+        if (!salida.is_open()) {
+            std::cout << "No se pudo escribir " << archivo << "\n";
+            continue;
+        }
+        salida.write(contenido.data(), static_cast<std::streamsize>(contenido.size()));
+
+        std::cout << metodo << " | Operaciones: " << suma.operaciones
+            << " | Bruto: $" << Dinero::desdeCentavos(suma.brutoCentavos)
+            << " | Comision: $" << Dinero::desdeCentavos(suma.comisionCentavos)
+            << " | Neto: $" << Dinero::desdeCentavos(suma.netoCentavos)
+            << " -> " << archivo << "\n";
+    }
+    if (liquidados == 0) {
+        std::cout << "(sin operaciones)\n";
+    }
+    return liquidados;
+}
@@ -0,0 +1,151 @@
+﻿/**
+ * @file MotorComisiones.cpp
+ * @brief Carga, compilación y evaluación de la tabla de comisiones.
+ *
+ * @date 2026-10-19
+ * @version 1.0
+ * @author Ari
+ */
+#include "ProgrammingPatterns/pagos/MotorComisiones.h"
+#include "nlohmann/json.hpp"
+#include <cmath>
+#include <fstream>
+
+using json = nlohmann::json;
+
+/**
+ * @brief Interpreta el nombre de un tipo de pago del archivo de configuración.
+ *
+ * @param texto Nombre ("Efectivo", "Debito", "Credito" u otro).
+ * @return TipoPago Tipo correspondiente.
+ */
+static TipoPago tipoDesdeTexto(const std::string& texto) {
+    if (texto == "Efectivo") return TipoPago::Efectivo;
+    if (texto == "Debito") return TipoPago::Debito;
+    if (texto == "Credito") return TipoPago::Credito;
+    return TipoPago::Otro;
+}
+
+/**
+ * @brief Interpreta el nombre de una marca de tarjeta.
+ *
+ * @param texto Nombre de la marca.
+ * @return MarcaTarjeta Marca correspondiente (Generica si no se reconoce).
+ */
+static MarcaTarjeta marcaDesdeTexto(const std::string& texto) {
+    if (texto == "Visa") return MarcaTarjeta::Visa;
+    if (texto == "Mastercard") return MarcaTarjeta::Mastercard;
+    if (texto == "Amex") return MarcaTarjeta::Amex;
+    return MarcaTarjeta::Generica;
+}
+
+MotorComisiones::MotorComisiones() {
+    reglasPorDefecto();
+}
+
+/**
+ * @brief Instancia compartida del motor.
+ * @return MotorComisiones& Motor del sistema.
+ */
+MotorComisiones& MotorComisiones::instancia() {
+    static MotorComisiones motor;
+    return motor;
+}
+
+/**
+ * @brief Regla histórica: 5% en crédito, sin comisión en lo demás.
+ */
+void MotorComisiones::reglasPorDefecto() {
+    for (auto& r : tabla) {
+        r = ReglaComision();
+    }
+    for (int m = 0; m < kMarcas; m++) {
+        tabla[static_cast<int>(TipoPago::Credito) * kMarcas + m].puntosBase = 500;
+    }
+}
+
+/**
+ * @brief Lee las reglas del archivo y las compila en la tabla plana.
+ *
+ * Primero se aplican las reglas genéricas de cada tipo a todas sus marcas y
+ * después se sobrescriben con las reglas específicas de marca, de modo que la
+ * consulta nunca necesita buscar una regla de respaldo.
+ *
+ * @param archivo Ruta del archivo JSON.
+ */
+void MotorComisiones::cargarJson(const std::string& archivo) {
+    std::ifstream file(archivo);
+    if (!file.is_open()) {
+        std::cout << " No se encontró " << archivo << ", se usan las comisiones por defecto.\n";
+        return;
+    }
+
+    json data;
+    try {
+        file >> data;
+    }
+    catch (...) {
+        std::cout << " Error leyendo JSON de " << archivo << ". Se usan las comisiones por defecto.\n";
+        return;
+    }
+
+    for (auto& r : tabla) {
+        r = ReglaComision();
+    }
+
+    const json reglas = data.value("reglas", json::array());
+    for (int pasada = 0; pasada < 2; pasada++) {
+        for (const auto& item : reglas) {
+            MarcaTarjeta marca = marcaDesdeTexto(item.value("marca", std::string("Generica")));
+            bool generica = marca == MarcaTarjeta::Generica;
+            if ((pasada == 0) != generica) {
+                continue;
+            }
+
+            ReglaComision r;
+            r.puntosBase = std::llround(item.value("porcentaje", 0.0) * 100.0);
+            r.cuotaFijaCentavos = Dinero::desdePesos(item.value("cuotaFija", 0.0)).getCentavos();
+            r.minimoCentavos = Dinero::desdePesos(item.value("minimo", 0.0)).getCentavos();
+            r.topeCentavos = Dinero::desdePesos(item.value("tope", 0.0)).getCentavos();
+
+            int t = static_cast<int>(tipoDesdeTexto(item.value("tipo", std::string("Otro"))));
+            if (generica) {
+                for (int m = 0; m < kMarcas; m++) {
+                    tabla[t * kMarcas + m] = r;
+                }
+            }
+            else {
+                tabla[t * kMarcas + static_cast<int>(marca)] = r;
+            }
+        }
+    }
+
+    std::cout << " Comisiones cargadas desde " << archivo << "\n";
+}
+
+/**
+ * @brief Muestra las reglas distintas de cero.
+ */
+void MotorComisiones::mostrar() const {
+    std::cout << "\n TABLA DE COMISIONES:\n";
+    bool alguna = false;
+    for (int t = 0; t < kTipos; t++) {
+        for (int m = 0; m < kMarcas; m++) {
+            const ReglaComision& r = tabla[t * kMarcas + m];
+            if (r.puntosBase == 0 && r.cuotaFijaCentavos == 0 && r.minimoCentavos == 0 && r.topeCentavos == 0) {
+                continue;
+            }
+            alguna = true;
+            std::cout << tipoPagoToString(static_cast<TipoPago>(t)) << " / "
+                << marcaTarjetaToString(static_cast<MarcaTarjeta>(m))
+                << " | " << r.puntosBase / 100.0 << "%"
+                << " + $" << Dinero::desdeCentavos(r.cuotaFijaCentavos)
+                << " | Min: $" << Dinero::desdeCentavos(r.minimoCentavos)
+                << " | Tope: " << (r.topeCentavos > 0 ? "$" + Dinero::desdeCentavos(r.topeCentavos).toString() : std::string("sin tope"))
+                << "\n";
+        }
+    }
+    if (!alguna) {
+        std::cout << "(sin comisiones)\n";
+    }
+}
@@ -0,0 +1,158 @@
+﻿/**
+ * @file LiderReplicacion.cpp
+ * @brief Diario de movimientos del líder, fotos y colas para las réplicas.
+ *
+ * @date 2026-10-19
+ * @version 1.0
+ * @author Ari
+ */
+#include "ProgrammingPatterns/replicacion/LiderReplicacion.h"
+#include "ProgrammingPatterns/replicacion/ProtocoloReplicacion.h"
+#include "ProgrammingPatterns/modelos/Inventario.h"
+#include <algorithm>
+#include <random>
+
+LiderReplicacion::LiderReplicacion(Inventario& inventario)
+    : inventario(inventario), primeraSecuencia(inventario.getSecuencia() + 1) {
+
+    // Distinta en cada ejecución; 0 queda para "sin datos"
+    std::random_device aleatorio;
+    epoca = (static_cast<std::uint64_t>(aleatorio()) << 32) ^ static_cast<std::uint64_t>(ProtocoloReplicacion::ahoraUs());
+    if (epoca == 0) {
+        epoca = 1;
+    }
+    inventario.setDiario(this);
+}
+
+LiderReplicacion::~LiderReplicacion() {
+    inventario.setDiario(nullptr);
+}
+
+void LiderReplicacion::registrar(const MovimientoInventario& m) {
+    if (inicios.size() >= kMaxDiario) {
+        recortarDiario();
+    }
+    size_t inicio = diario.size();
+    inicios.push_back(inicio);
+    ProtocoloReplicacion::escribirMovimiento(m, ProtocoloReplicacion::ahoraUs(), diario);
+    estadisticas.movimientos++;
+
+    for (std::string* salida : seguidores) {
+        salida->append(diario, inicio, std::string::npos);
+    }
+}
+
+void LiderReplicacion::recortarDiario() {
+    size_t quitar = inicios.size() / 2;
+    size_t bytes = inicios[quitar];
+    diario.erase(0, bytes);
+    inicios.erase(inicios.begin(), inicios.begin() + static_cast<std::ptrdiff_t>(quitar));
+    for (size_t& inicio : inicios) {
+        inicio -= bytes;
+    }
+    primeraSecuencia += quitar;
+}
+
+size_t LiderReplicacion::atenderSeguidor(const char* datos, size_t n, std::string& salida) {
+    MensajeReplicacion hola;
+    size_t usados = ProtocoloReplicacion::leer(datos, n, hola);
+    if (usados == 0 || usados == ProtocoloReplicacion::kMensajeInvalido) {
+        return usados;
+    }
+    if (hola.tipo != MensajeReplicacion::Tipo::Hola) {
+        return ProtocoloReplicacion::kMensajeInvalido;
+    }
+
+    std::uint64_t actual = inventario.getSecuencia();
+    bool alcanzaCola = hola.epoca == epoca && hola.secuencia + 1 >= primeraSecuencia && hola.secuencia <= actual;
+    if (alcanzaCola) {
+        // Solo lo que le falta, tal como está en el diario
+        if (hola.secuencia < actual) {
+            salida.append(diario, inicios[static_cast<size_t>(hola.secuencia + 1 - primeraSecuencia)], std::string::npos);
+        }
+        estadisticas.colas++;
+    }
+    else {
+        // Los productos salen por partes con continuarFoto
+        FotoEnCurso foto;
+        foto.salida = &salida;
+        empezarFoto(foto);
+        fotos.push_back(foto);
+        estadisticas.fotos++;
+        return usados;
+    }
+    seguidores.push_back(&salida);
+    return usados;
+}
+
+void LiderReplicacion::empezarFoto(FotoEnCurso& foto) {
+    foto.secuencia = inventario.getSecuencia();
+    foto.siguiente = 0;
+    foto.total = inventario.totalProductos();
+    foto.marcaUs = ProtocoloReplicacion::ahoraUs();
+    ProtocoloReplicacion::escribirInicioFoto(epoca, foto.secuencia, foto.total, *foto.salida);
+}
+
+LiderReplicacion::FotoEnCurso* LiderReplicacion::buscarFoto(const std::string& salida) {
+    for (FotoEnCurso& foto : fotos) {
+        if (foto.salida == &salida) {
+            return &foto;
+        }
+    }
+    return nullptr;
+}
+
+bool LiderReplicacion::enviandoFoto(const std::string& salida) const {
+    return std::any_of(fotos.begin(), fotos.end(), [&salida](const FotoEnCurso& f) { return f.salida == &salida; });
+}
+
+void LiderReplicacion::continuarFoto(std::string& salida, size_t bytes) {
+    FotoEnCurso* foto = buscarFoto(salida);
+    if (foto == nullptr) {
+        return;
+    }
+
+    // Sin la cola desde el inicio de la foto no se puede terminar: otra foto
+    std::uint64_t actual = inventario.getSecuencia();
+    if (foto->secuencia < actual && foto->secuencia + 1 < primeraSecuencia) {
+        empezarFoto(*foto);
+        actual = foto->secuencia;
+    }
+
+    const auto& productos = inventario.getProductos();
+    size_t total = std::min(foto->total, productos.size());
+    size_t limite = salida.size() + bytes;
+    MovimientoInventario alta;
+    alta.secuencia = foto->secuencia;
+    while (foto->siguiente < total && salida.size() < limite) {
+        const Producto& p = *productos[foto->siguiente++];
+        alta.codigo = p.getCodigo();
+        alta.nombre = p.getNombre();
+        alta.stock = p.getCantidad();
+        alta.centavos = p.getPrecio().getCentavos();
+        ProtocoloReplicacion::escribirMovimiento(alta, foto->marcaUs, salida);
+    }
+    if (foto->siguiente < total) {
+        return;
+    }
+
+    ProtocoloReplicacion::escribirFinFoto(foto->secuencia, salida);
+    if (foto->secuencia < actual) {
+        salida.append(diario, inicios[static_cast<size_t>(foto->secuencia + 1 - primeraSecuencia)], std::string::npos);
+    }
+    fotos.erase(fotos.begin() + (foto - fotos.data()));
+    seguidores.push_back(&salida);
+}
+
+void LiderReplicacion::quitarSeguidor(std::string& salida) {
+    seguidores.erase(std::remove(seguidores.begin(), seguidores.end(), &salida), seguidores.end());
+    fotos.erase(std::remove_if(fotos.begin(), fotos.end(), [&salida](const FotoEnCurso& f) { return f.salida == &salida; }),
+        fotos.end());
+}
+
+void LiderReplicacion::latido() {
+    std::int64_t marca = ProtocoloReplicacion::ahoraUs();
+    for (std::string* salida : seguidores) {
+        ProtocoloReplicacion::escribirLatido(inventario.getSecuencia(), marca, *salida);
+    }
+}
@@ -0,0 +1,156 @@
+﻿/**
+ * @file ProtocoloReplicacion.cpp
+ * @brief Escritura y lectura de los mensajes entre el líder y las réplicas.
+ *
+ * @date 2026-10-19
+ * @version 1.0
+ * @author Ari
+ */
+#include "ProgrammingPatterns/replicacion/ProtocoloReplicacion.h"
+#include "ProgrammingPatterns/servidor/Protocolo.h"
+#include <chrono>
+
+/// Bytes fijos de cada mensaje después del largo (incluye el byte de tipo).
+static constexpr size_t kFijoHola = 17;
+static constexpr size_t kFijoInicioFoto = 25;
+static constexpr size_t kFijoMovimiento = 38;
+static constexpr size_t kFijoFinFoto = 9;
+static constexpr size_t kFijoLatido = 17;
+
+/// Largo máximo de un mensaje (un movimiento con código y nombre al máximo).
+static constexpr size_t kMaxMensaje = kFijoMovimiento + 2 * Protocolo::kMaxTexto;
+
+static size_t recortar(const std::string& texto) {
+    return texto.size() < Protocolo::kMaxTexto ? texto.size() : Protocolo::kMaxTexto;
+}
+
+std::int64_t ProtocoloReplicacion::ahoraUs() {
+    return std::chrono::duration_cast<std::chrono::microseconds>(
+        std::chrono::system_clock::now().time_since_epoch()).count();
+}
+
+void ProtocoloReplicacion::escribirHola(std::uint64_t epoca, std::uint64_t secuencia, std::string& d) {
+    Protocolo::agregarEntero(d, kFijoHola, 4);
+    Protocolo::agregarEntero(d, static_cast<std::uint8_t>(MensajeReplicacion::Tipo::Hola), 1);
+    Protocolo::agregarEntero(d, epoca, 8);
+    Protocolo::agregarEntero(d, secuencia, 8);
+}
+
+void ProtocoloReplicacion::escribirInicioFoto(std::uint64_t epoca, std::uint64_t secuencia, std::uint64_t productos,
+    std::string& d) {
+
+    Protocolo::agregarEntero(d, kFijoInicioFoto, 4);
+    Protocolo::agregarEntero(d, static_cast<std::uint8_t>(MensajeReplicacion::Tipo::InicioFoto), 1);
+    Protocolo::agregarEntero(d, epoca, 8);
+    Protocolo::agregarEntero(d, secuencia, 8);
+    Protocolo::agregarEntero(d, productos, 8);
+}
+
+void ProtocoloReplicacion::escribirMovimiento(const MovimientoInventario& m, std::int64_t marcaUs, std::string& d) {
+    size_t codigo = recortar(m.codigo);
+    size_t nombre = recortar(m.nombre);
+    Protocolo::agregarEntero(d, kFijoMovimiento + codigo + nombre, 4);
+    Protocolo::agregarEntero(d, static_cast<std::uint8_t>(MensajeReplicacion::Tipo::Movimiento), 1);
+    Protocolo::agregarEntero(d, static_cast<std::uint8_t>(m.tipo), 1);
+    Protocolo::agregarEntero(d, m.secuencia, 8);
+    Protocolo::agregarEntero(d, static_cast<std::uint64_t>(marcaUs), 8);
+    Protocolo::agregarEntero(d, static_cast<std::uint32_t>(m.cantidad), 4);
+    Protocolo::agregarEntero(d, static_cast<std::uint32_t>(m.stock), 4);
+    Protocolo::agregarEntero(d, static_cast<std::uint64_t>(m.centavos), 8);
+    Protocolo::agregarEntero(d, codigo, 2);
+    Protocolo::agregarEntero(d, nombre, 2);
+    d.append(m.codigo, 0, codigo);
+    d.append(m.nombre, 0, nombre);
+}
+
+void ProtocoloReplicacion::escribirFinFoto(std::uint64_t secuencia, std::string& d) {
+    Protocolo::agregarEntero(d, kFijoFinFoto, 4);
+    Protocolo::agregarEntero(d, static_cast<std::uint8_t>(MensajeReplicacion::Tipo::FinFoto), 1);
+    Protocolo::agregarEntero(d, secuencia, 8);
+}
+
+void ProtocoloReplicacion::escribirLatido(std::uint64_t secuencia, std::int64_t marcaUs, std::string& d) {
+    Protocolo::agregarEntero(d, kFijoLatido, 4);
+    Protocolo::agregarEntero(d, static_cast<std::uint8_t>(MensajeReplicacion::Tipo::Latido), 1);
+    Protocolo::agregarEntero(d, secuencia, 8);
+    Protocolo::agregarEntero(d, static_cast<std::uint64_t>(marcaUs), 8);
+}
+
+size_t ProtocoloReplicacion::leer(const char* datos, size_t n, MensajeReplicacion& m) {
+    if (n < 4) {
+        return 0;
+    }
+    const char* p = datos;
+    size_t largo = static_cast<size_t>(Protocolo::tomarEntero(p, 4));
+    if (largo == 0 || largo > kMaxMensaje) {
+        return kMensajeInvalido;
+    }
+    if (n < 4 + largo) {
+        return 0;
+    }
+
+    m.tipo = static_cast<MensajeReplicacion::Tipo>(Protocolo::tomarEntero(p, 1));
+    switch (m.tipo) {
+    case MensajeReplicacion::Tipo::Hola:
+        if (largo != kFijoHola) {
+            return kMensajeInvalido;
+        }
+        m.epoca = Protocolo::tomarEntero(p, 8);
+        m.secuencia = Protocolo::tomarEntero(p, 8);
+        break;
+
+    case MensajeReplicacion::Tipo::InicioFoto:
+        if (largo != kFijoInicioFoto) {
+            return kMensajeInvalido;
+        }
+        m.epoca = Protocolo::tomarEntero(p, 8);
+        m.secuencia = Protocolo::tomarEntero(p, 8);
+        m.productos = Protocolo::tomarEntero(p, 8);
+        break;
+
+    case MensajeReplicacion::Tipo::Movimiento: {
+        if (largo < kFijoMovimiento) {
+            return kMensajeInvalido;
+        }
+        MovimientoInventario& mov = m.movimiento;
+        std::uint8_t tipo = static_cast<std::uint8_t>(Protocolo::tomarEntero(p, 1));
+        if (tipo < 1 || tipo > 4) {
+            return kMensajeInvalido;
+        }
+        mov.tipo = static_cast<MovimientoInventario::Tipo>(tipo);
+        mov.secuencia = Protocolo::tomarEntero(p, 8);
+        m.marcaUs = static_cast<std::int64_t>(Protocolo::tomarEntero(p, 8));
+        mov.cantidad = static_cast<std::int32_t>(static_cast<std::uint32_t>(Protocolo::tomarEntero(p, 4)));
+        mov.stock = static_cast<std::int32_t>(static_cast<std::uint32_t>(Protocolo::tomarEntero(p, 4)));
+        mov.centavos = static_cast<std::int64_t>(Protocolo::tomarEntero(p, 8));
+        size_t codigo = static_cast<size_t>(Protocolo::tomarEntero(p, 2));
+        size_t nombre = static_cast<size_t>(Protocolo::tomarEntero(p, 2));
+        if (kFijoMovimiento + codigo + nombre != largo) {
+            return kMensajeInvalido;
+        }
+        mov.codigo.assign(p, codigo);
+        mov.nombre.assign(p + codigo, nombre);
+        m.secuencia = mov.secuencia;
+        break;
+    }
+
+    case MensajeReplicacion::Tipo::FinFoto:
+        if (largo != kFijoFinFoto) {
+            return kMensajeInvalido;
+        }
+        m.secuencia = Protocolo::tomarEntero(p, 8);
+        break;
+
+    case MensajeReplicacion::Tipo::Latido:
+        if (largo != kFijoLatido) {
+            return kMensajeInvalido;
+        }
+        m.secuencia = Protocolo::tomarEntero(p, 8);
+        m.marcaUs = static_cast<std::int64_t>(Protocolo::tomarEntero(p, 8));
+        break;
+
+    default:
+        return kMensajeInvalido;
+    }
+    return 4 + largo;
+}
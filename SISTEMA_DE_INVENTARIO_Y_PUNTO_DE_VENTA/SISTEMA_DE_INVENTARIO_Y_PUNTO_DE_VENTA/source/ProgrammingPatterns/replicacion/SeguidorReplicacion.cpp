@@ -0,0 +1,123 @@
+﻿/**
+ * @file SeguidorReplicacion.cpp
+ * @brief Aplicación del flujo del líder y medición del retraso.
+ *
+ * @date 2026-10-19
+ * @version 1.0
+ * @author Ari
+ */
+#include "ProgrammingPatterns/replicacion/SeguidorReplicacion.h"
+#include "ProgrammingPatterns/replicacion/ProtocoloReplicacion.h"
+#include "ProgrammingPatterns/modelos/Inventario.h"
+#include <algorithm>
+
+SeguidorReplicacion::SeguidorReplicacion(Inventario& inventario)
+    : inventario(inventario) {}
+
+void SeguidorReplicacion::saludar(std::string& salida) {
+    // Una foto a medias no cuenta: se vuelve a pedir
+    recibiendoFoto = false;
+    foto.clear();
+    ProtocoloReplicacion::escribirHola(epoca, epoca != 0 ? inventario.getSecuencia() : 0, salida);
+}
+
+size_t SeguidorReplicacion::procesar(const char* datos, size_t n) {
+    size_t consumido = 0;
+    MensajeReplicacion m;
+    while (true) {
+        size_t usados = ProtocoloReplicacion::leer(datos + consumido, n - consumido, m);
+        if (usados == 0) {
+            break;
+        }
+        if (usados == ProtocoloReplicacion::kMensajeInvalido) {
+            return usados;
+        }
+        consumido += usados;
+
+        switch (m.tipo) {
+        case MensajeReplicacion::Tipo::InicioFoto:
+            recibiendoFoto = true;
+            epocaFoto = m.epoca;
+            foto.clear();
+            foto.reserve(static_cast<size_t>(m.productos));
+            break;
+
+        case MensajeReplicacion::Tipo::Movimiento:
+            if (recibiendoFoto) {
+                foto.push_back(std::move(m.movimiento));
+                break;
+            }
+            inventario.aplicarMovimiento(m.movimiento);
+            estadisticas.movimientos++;
+            if (m.movimiento.secuencia > estadisticas.secuenciaLider) {
+                estadisticas.secuenciaLider = m.movimiento.secuencia;
+            }
+            medir(m.marcaUs);
+            break;
+
+        case MensajeReplicacion::Tipo::FinFoto:
+            if (!recibiendoFoto) {
+                return ProtocoloReplicacion::kMensajeInvalido;
+            }
+            inventario.vaciar(m.secuencia);
+            for (const MovimientoInventario& alta : foto) {
+                inventario.aplicarMovimiento(alta);
+            }
+            foto.clear();
+            foto.shrink_to_fit();
+            recibiendoFoto = false;
+            epoca = epocaFoto;
+            estadisticas.fotos++;
+            estadisticas.secuenciaLider = m.secuencia;
+            break;
+
+        case MensajeReplicacion::Tipo::Latido:
+            // Sin ventas también se sabe si la réplica está al día
+            estadisticas.secuenciaLider = m.secuencia;
+            break;
+
+        default:
+            return ProtocoloReplicacion::kMensajeInvalido;
+        }
+    }
+    return consumido;
+}
+
+void SeguidorReplicacion::medir(std::int64_t marcaUs) {
+    std::int64_t retraso = ProtocoloReplicacion::ahoraUs() - marcaUs;
+    if (retraso < 0) {
+        retraso = 0;
+    }
+    estadisticas.retrasoUltimoUs = retraso;
+    estadisticas.retrasoTotalUs += retraso;
+    if (retraso > estadisticas.retrasoMaximoUs) {
+        estadisticas.retrasoMaximoUs = retraso;
+    }
+    if (muestras.size() < kMuestras) {
+        muestras.push_back(retraso);
+    }
+    else {
+        muestras[siguienteMuestra] = retraso;
+        siguienteMuestra = (siguienteMuestra + 1) % kMuestras;
+    }
+}
+
+std::uint64_t SeguidorReplicacion::atraso() const {
+    std::uint64_t propia = inventario.getSecuencia();
+    return estadisticas.secuenciaLider > propia ? estadisticas.secuenciaLider - propia : 0;
+}
+
+std::int64_t SeguidorReplicacion::percentilRetrasoUs(double p) const {
+    if (muestras.empty()) {
+        return 0;
+    }
+    std::vector<std::int64_t> ordenadas(muestras);
+    size_t k = static_cast<size_t>(p / 100.0 * static_cast<double>(ordenadas.size() - 1) + 0.5);
+    std::nth_element(ordenadas.begin(), ordenadas.begin() + static_cast<std::ptrdiff_t>(k), ordenadas.end());
+    return ordenadas[k];
+}
+
+std::int64_t SeguidorReplicacion::retrasoPromedioUs() const {
+    return estadisticas.movimientos == 0 ? 0
+        : estadisticas.retrasoTotalUs / static_cast<std::int64_t>(estadisticas.movimientos);
+}
@@ -0,0 +1,273 @@
+﻿/**
+ * @file ReporteConsola.cpp
+ * @brief Formato de las tablas de productos e historial en el búfer del reporte.
+ *
+ * @date 2026-10-19
+ * @version 1.0
+ * @author Ari
+ */
+#include "ProgrammingPatterns/reportes/ReporteConsola.h"
+#include "ProgrammingPatterns/modelos/Producto.h"
+#include "ProgrammingPatterns/gasolinera/Gasolinera.h"
+#include <algorithm>
+#include <charconv>
+#include <cstdio>
+#include <cstring>
+
+/// Bytes máximos de una fila (columnas más separadores y fin de línea).
+static constexpr size_t kFilaMaxima = 512;
+
+/**
+ * @brief Escribe un monto "1234.50" en `destino`.
+ *
+ * @return size_t Bytes escritos (a lo más 24).
+ */
+static size_t formatearDinero(Dinero monto, char* destino) {
+    long long centavos = monto.getCentavos();
+    char* p = destino;
+    if (centavos < 0) {
+        *p++ = '-';
+        centavos = -centavos;
+    }
+    p = std::to_chars(p, destino + 21, centavos / 100).ptr;
+    *p++ = '.';
+    *p++ = static_cast<char>('0' + centavos % 100 / 10);
+    *p++ = static_cast<char>('0' + centavos % 10);
+    return static_cast<size_t>(p - destino);
+}
+
+static size_t formatearEntero(long long valor, char* destino) {
+    return static_cast<size_t>(std::to_chars(destino, destino + 24, valor).ptr - destino);
+}
+
+/**
+ * @brief Recorta un texto UTF-8 a `ancho` caracteres sin partir un carácter.
+ */
+static std::string_view recortar(std::string_view texto, size_t ancho) {
+    size_t caracteres = 0;
+    for (size_t i = 0; i < texto.size(); i++) {
+        if ((static_cast<unsigned char>(texto[i]) & 0xC0) != 0x80) {
+            if (caracteres == ancho) {
+                return texto.substr(0, i);
+            }
+            caracteres++;
+        }
+    }
+    return texto;
+}
+
+bool FiltroReporte::admite(const Producto& p) const {
+    if (stockMaximo >= 0 && p.getCantidad() > stockMaximo) {
+        return false;
+    }
+    return texto.empty() || p.getNombre().find(texto) != std::string::npos ||
+        p.getCodigo().find(texto) != std::string::npos;
+}
+
+bool FiltroReporte::admite(const CargaGasolina& c) const {
+    return texto.empty() || c.tipo.find(texto) != std::string::npos;
+}
+
+bool FiltroReporte::enPagina(size_t indice) const {
+    if (filasPorPagina == 0) {
+        return true;
+    }
+    size_t inicio = (std::max<size_t>(pagina, 1) - 1) * filasPorPagina;
+    return indice >= inicio && indice < inicio + filasPorPagina;
+}
+
+size_t FiltroReporte::contarPaginas(size_t coincidencias) const {
+    if (coincidencias == 0) {
+        return 0;
+    }
+    return filasPorPagina == 0 ? 1 : (coincidencias + filasPorPagina - 1) / filasPorPagina;
+}
+
+ReporteConsola::ReporteConsola(std::ostream& salida)
+    : salida(salida), buffer(new char[kCapacidad]) {}
+
+ReporteConsola::~ReporteConsola() {
+    vaciar();
+}
+
+size_t ReporteConsola::anchoVisible(std::string_view texto) {
+    size_t ancho = 0;
+    for (char c : texto) {
+        if ((static_cast<unsigned char>(c) & 0xC0) != 0x80) {
+            ancho++;
+        }
+    }
+    return ancho;
+}
+
+void ReporteConsola::vaciar() {
+    if (usado > 0) {
+        salida.write(buffer.get(), static_cast<std::streamsize>(usado));
+        usado = 0;
+    }
+}
+
+void ReporteConsola::asegurarEspacio(size_t bytes) {
+    if (kCapacidad - usado < bytes) {
+        vaciar();
+    }
+}
+
+void ReporteConsola::agregar(std::string_view texto) {
+    if (texto.size() > kCapacidad - usado) {
+        vaciar();
+        if (texto.size() > kCapacidad) {
+            salida.write(texto.data(), static_cast<std::streamsize>(texto.size()));
+            return;
+        }
+    }
+    std::memcpy(buffer.get() + usado, texto.data(), texto.size());
+    usado += texto.size();
+}
+
+void ReporteConsola::agregarEspacios(size_t n) {
+    static constexpr std::string_view kEspacios = "                                                                ";
+    while (n > 0) {
+        size_t k = std::min(n, kEspacios.size());
+        agregar(kEspacios.substr(0, k));
+        n -= k;
+    }
+}
+
+void ReporteConsola::agregarColumna(std::string_view texto, size_t ancho, bool derecha) {
+    size_t visible = anchoVisible(texto);
+    size_t relleno = visible < ancho ? ancho - visible : 0;
+    if (derecha) {
+        agregarEspacios(relleno);
+        agregar(texto);
+    }
+    else {
+        agregar(texto);
+        agregarEspacios(relleno);
+    }
+}
+
+void ReporteConsola::agregarPie(const ResultadoReporte& resultado, const FiltroReporte& filtro, const char* elementos) {
+    char numero[24];
+    agregar("Mostrando ");
+    agregar(std::string_view(numero, formatearEntero(static_cast<long long>(resultado.mostradas), numero)));
+    agregar(" de ");
+    agregar(std::string_view(numero, formatearEntero(static_cast<long long>(resultado.coincidencias), numero)));
+    agregar(" ");
+    agregar(elementos);
+    if (resultado.paginas > 1) {
+        agregar(" (pagina ");
+        agregar(std::string_view(numero, formatearEntero(static_cast<long long>(filtro.pagina), numero)));
+        agregar(" de ");
+        agregar(std::string_view(numero, formatearEntero(static_cast<long long>(resultado.paginas), numero)));
+        agregar(")");
+    }
+    agregar("\n");
+}
+
+ResultadoReporte ReporteConsola::productos(const std::vector<std::unique_ptr<Producto>>& productos,
+    const FiltroReporte& filtro) {
+
+    // Primera pasada: filtro, página y anchos de columna
+    ResultadoReporte resultado;
+    std::vector<const Producto*> filas;
+    size_t anchoCodigo = 6, anchoNombre = 6, anchoPrecio = 6, anchoStock = 5;
+    char numero[24];
+
+    for (const auto& p : productos) {
+        if (!filtro.admite(*p)) {
+            continue;
+        }
+        if (filtro.enPagina(resultado.coincidencias++)) {
+            filas.push_back(p.get());
+            anchoCodigo = std::max(anchoCodigo, anchoVisible(p->getCodigo()));
+            anchoNombre = std::max(anchoNombre, anchoVisible(p->getNombre()));
+            anchoPrecio = std::max(anchoPrecio, formatearDinero(p->getPrecio(), numero) + 1);
+            anchoStock = std::max(anchoStock, formatearEntero(p->getCantidad(), numero));
+        }
+    }
+    anchoCodigo = std::min(anchoCodigo, kAnchoNombre);
+    anchoNombre = std::min(anchoNombre, kAnchoNombre);
+    resultado.mostradas = filas.size();
+    resultado.paginas = filtro.contarPaginas(resultado.coincidencias);
+
+    // Segunda pasada: las filas
+    agregarColumna("Codigo", anchoCodigo, false);
+    agregar("  ");
+    agregarColumna("Nombre", anchoNombre, false);
+    agregar("  ");
+    agregarColumna("Precio", anchoPrecio, true);
+    agregar("  ");
+    agregarColumna("Stock", anchoStock, true);
+    agregar("\n");
+
+    for (const Producto* p : filas) {
+        asegurarEspacio(kFilaMaxima);
+        agregarColumna(recortar(p->getCodigo(), anchoCodigo), anchoCodigo, false);
+        agregar("  ");
+        agregarColumna(recortar(p->getNombre(), anchoNombre), anchoNombre, false);
+        agregar("  ");
+        numero[0] = '$';
+        agregarColumna(std::string_view(numero, formatearDinero(p->getPrecio(), numero + 1) + 1), anchoPrecio, true);
+        agregar("  ");
+        agregarColumna(std::string_view(numero, formatearEntero(p->getCantidad(), numero)), anchoStock, true);
+        agregar("\n");
+    }
+    agregarPie(resultado, filtro, "productos");
+    return resultado;
+}
+
+ResultadoReporte ReporteConsola::historial(const std::vector<CargaGasolina>& historial, const FiltroReporte& filtro) {
+    ResultadoReporte resultado;
+    std::vector<const CargaGasolina*> filas;
+    size_t anchoLitros = 6, anchoTipo = 4, anchoPrecio = 6, anchoTotal = 5;
+    char numero[32];
+
+    for (const auto& c : historial) {
+        if (!filtro.admite(c)) {
+            continue;
+        }
+        if (filtro.enPagina(resultado.coincidencias++)) {
+            filas.push_back(&c);
+            anchoTipo = std::max(anchoTipo, anchoVisible(c.tipo));
+            anchoPrecio = std::max(anchoPrecio, formatearDinero(c.precioLitro, numero) + 1);
+            anchoTotal = std::max(anchoTotal, formatearDinero(c.totalPagado, numero) + 1);
+            anchoLitros = std::max(anchoLitros, static_cast<size_t>(std::snprintf(numero, sizeof(numero), "%.2f", c.litros)));
+        }
+    }
+    anchoTipo = std::min(anchoTipo, kAnchoNombre);
+    resultado.mostradas = filas.size();
+    resultado.paginas = filtro.contarPaginas(resultado.coincidencias);
+
+    agregarColumna("Litros", anchoLitros, true);
+    agregar("  ");
+    agregarColumna("Tipo", anchoTipo, false);
+    agregar("  ");
+    agregarColumna("$/L", anchoPrecio, true);
+    agregar("  ");
+    agregarColumna("Total", anchoTotal, true);
+    agregar("  Precio\n");
+
+    for (const CargaGasolina* c : filas) {
+        asegurarEspacio(kFilaMaxima);
+        int n = std::snprintf(numero, sizeof(numero), "%.2f", c->litros);
+        agregarColumna(std::string_view(numero, static_cast<size_t>(std::max(n, 0))), anchoLitros, true);
+        agregar("  ");
+        agregarColumna(recortar(c->tipo, anchoTipo), anchoTipo, false);
+        agregar("  ");
+        numero[0] = '$';
+        agregarColumna(std::string_view(numero, formatearDinero(c->precioLitro, numero + 1) + 1), anchoPrecio, true);
+        agregar("  ");
+        agregarColumna(std::string_view(numero, formatearDinero(c->totalPagado, numero + 1) + 1), anchoTotal, true);
+        if (c->versionPrecio != 0) {
+            agregar("  v");
+            agregar(std::string_view(numero, formatearEntero(c->versionPrecio, numero)));
+        }
+        else {
+            agregar("  manual");
+        }
+        agregar("\n");
+    }
+    agregarPie(resultado, filtro, "cargas");
+    return resultado;
+}
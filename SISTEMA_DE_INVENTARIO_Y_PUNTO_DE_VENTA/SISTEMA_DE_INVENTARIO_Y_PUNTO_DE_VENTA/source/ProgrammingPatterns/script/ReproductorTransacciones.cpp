@@ -0,0 +1,224 @@
+﻿/**
+ * @file ReproductorTransacciones.cpp
+ * @brief Lectura del guion de transacciones y su ejecución.
+ *
+ * @date 2026-10-19
+ * @version 1.0
+ * @author Ari
+ */
+#include "ProgrammingPatterns/script/ReproductorTransacciones.h"
+#include <charconv>
+#include <chrono>
+#include <cstdlib>
+#include <algorithm>
+#include <iomanip>
+
+/// Errores de formato que se muestran antes de solo contarlos.
+static const size_t kErroresVisibles = 10;
+
+/**
+ * @brief Separa la siguiente palabra de la línea.
+ *
+ * @param linea Resto de la línea; avanza después de la palabra.
+ * @return std::string_view Palabra (vacía si ya no hay).
+ */
+static std::string_view siguientePalabra(std::string_view& linea) {
+    size_t inicio = linea.find_first_not_of(" \t\r");
+    if (inicio == std::string_view::npos) {
+        linea = std::string_view();
+        return std::string_view();
+    }
+    size_t fin = linea.find_first_of(" \t\r", inicio);
+    std::string_view palabra = linea.substr(inicio, fin == std::string_view::npos ? std::string_view::npos : fin - inicio);
+    linea.remove_prefix(fin == std::string_view::npos ? linea.size() : fin);
+    return palabra;
+}
+
+static bool leerEntero(std::string_view texto, int& valor) {
+    std::from_chars_result r = std::from_chars(texto.data(), texto.data() + texto.size(), valor);
+    return r.ec == std::errc() && r.ptr == texto.data() + texto.size() && valor > 0;
+}
+
+static bool leerLitros(std::string_view texto, double& valor) {
+    char numero[32];
+    if (texto.empty() || texto.size() >= sizeof(numero)) {
+        return false;
+    }
+    texto.copy(numero, texto.size());
+    numero[texto.size()] = '\0';
+    char* fin = nullptr;
+    valor = std::strtod(numero, &fin);
+    return fin == numero + texto.size() && valor > 0.0;
+}
+
+/**
+ * @brief Convierte `E`, `D`, `C` (con marca opcional `V`, `M`, `A`) en un pago.
+ */
+static bool leerPago(std::string_view texto, PagoVariante& pago) {
+    if (texto.empty() || texto.size() > 2) {
+        return false;
+    }
+    MarcaTarjeta marca = MarcaTarjeta::Generica;
+    if (texto.size() == 2) {
+        switch (texto[1]) {
+        case 'V': marca = MarcaTarjeta::Visa; break;
+        case 'M': marca = MarcaTarjeta::Mastercard; break;
+        case 'A': marca = MarcaTarjeta::Amex; break;
+        default: return false;
+        }
+    }
+    switch (texto[0]) {
+    case 'E': pago = crearPago(1); return texto.size() == 1;
+    case 'D': pago = crearPago(2, marca); return true;
+    case 'C': pago = crearPago(3, marca); return true;
+    default: return false;
+    }
+}
+
+size_t ReproductorTransacciones::Resumen::total() const {
+    size_t suma = 0;
+    for (size_t n : operaciones) {
+        suma += n;
+    }
+    return suma;
+}
+
+size_t ReproductorTransacciones::Resumen::totalRechazadas() const {
+    size_t suma = 0;
+    for (size_t n : rechazadas) {
+        suma += n;
+    }
+    return suma;
+}
+
+ReproductorTransacciones::Resumen ReproductorTransacciones::reproducir(std::istream& entrada) {
+    resumen = Resumen();
+    std::string linea;
+    linea.reserve(256);
+
+    auto inicio = std::chrono::steady_clock::now();
+    while (std::getline(entrada, linea)) {
+        resumen.lineas++;
+        if (!ejecutar(linea)) {
+            if (++resumen.errores <= kErroresVisibles) {
+                std::cerr << "Linea " << resumen.lineas << " invalida: " << linea << "\n";
+            }
+        }
+    }
+    resumen.segundos = std::chrono::duration<double>(std::chrono::steady_clock::now() - inicio).count();
+    return resumen;
+}
+
+bool ReproductorTransacciones::ejecutar(std::string_view linea) {
+    std::string_view accion = siguientePalabra(linea);
+    if (accion.empty() || accion[0] == '#') {
+        return true;
+    }
+    if (accion.size() != 1) {
+        return false;
+    }
+
+    switch (accion[0]) {
+    case 'V': {
+        std::string_view cod = siguientePalabra(linea);
+        int cantidad;
+        PagoVariante pago;
+        if (cod.empty() || !leerEntero(siguientePalabra(linea), cantidad) || !leerPago(siguientePalabra(linea), pago)) {
+            return false;
+        }
+        codigo.assign(cod);
+        correo.assign(siguientePalabra(linea));
+        bool vendida = facade.procesarVenta(inventario, codigo, cantidad, pago, correo) != 0;
+        (vendida ? resumen.operaciones : resumen.rechazadas)[VentaTicket]++;
+        return true;
+    }
+    case 'S':
+    case 'R': {
+        std::string_view cod = siguientePalabra(linea);
+        int cantidad;
+        if (cod.empty() || !leerEntero(siguientePalabra(linea), cantidad)) {
+            return false;
+        }
+        codigo.assign(cod);
+        if (accion[0] == 'S') {
+            bool vendida = inventario.venderProducto(codigo, cantidad) != Dinero();
+            (vendida ? resumen.operaciones : resumen.rechazadas)[VentaSimple]++;
+        }
+        else {
+            inventario.comprarProducto(codigo, cantidad);
+            resumen.operaciones[Reposicion]++;
+        }
+        return true;
+    }
+    case 'C': {
+        std::string_view tipo = siguientePalabra(linea);
+        double litros;
+        PagoVariante pago;
+        if (tipo.empty() || !leerLitros(siguientePalabra(linea), litros) || !leerPago(siguientePalabra(linea), pago)) {
+            return false;
+        }
+        codigo.assign(tipo);
+        size_t cargas = gasolinera.getHistorial().size();
+        gasFacade.procesarCarga(gasolinera, litros, codigo, &comoMetodoPago(pago));
+        bool registrada = gasolinera.getHistorial().size() > cargas;
+        (registrada ? resumen.operaciones : resumen.rechazadas)[Carga]++;
+        return true;
+    }
+    case 'G':
+        inventario.guardarAJson("Productos.json");
+        gasolinera.guardarHistorialJson("HistorialGas.json");
+        gasolinera.guardarTanquesJson("Tanques.json");
+        resumen.operaciones[Guardado]++;
+        return true;
+    case 'L':
+    case 'H': {
+        // El resto de la línea (sin espacios al inicio) es el filtro
+        std::string_view texto = linea.substr(std::min(linea.size(), linea.find_first_not_of(" \t")));
+        while (!texto.empty() && (texto.back() == '\r' || texto.back() == ' ')) {
+            texto.remove_suffix(1);
+        }
+        filtro.texto.assign(texto);
+        if (accion[0] == 'L') {
+            inventario.listarProductos(filtro, *reportes);
+        }
+        else {
+            gasolinera.mostrarHistorial(filtro, *reportes);
+        }
+        resumen.operaciones[Listado]++;
+        return true;
+    }
+    default:
+        return false;
+    }
+}
+
+void ReproductorTransacciones::imprimirResumen(const Resumen& resumen, std::ostream& salida) {
+    static const char* const kNombres[kOperaciones] = {
+        "Ventas con ticket", "Ventas simples", "Reposiciones", "Cargas de gasolina", "Guardados", "Listados" };
+
+    salida << "\n===== REPRODUCCION DE TRANSACCIONES =====\n";
+    salida << "Lineas leidas: " << resumen.lineas << "\n";
+    for (int i = 0; i < kOperaciones; i++) {
+        salida << std::left << std::setw(22) << kNombres[i] << std::right << resumen.operaciones[i];
+        if (resumen.rechazadas[i] > 0) {
+            salida << " (+" << resumen.rechazadas[i] << " rechazadas)";
+        }
+        salida << "\n";
+    }
+    salida << "Lineas invalidas: " << resumen.errores << "\n";
+    if (resumen.totalRechazadas() > 0) {
+        salida << "Rechazadas: " << resumen.totalRechazadas() << " (no cuentan en el rendimiento)\n";
+    }
+
+    size_t total = resumen.total();
+    salida << std::fixed << std::setprecision(3);
+    salida << "Tiempo: " << resumen.segundos << " s\n";
+    if (resumen.segundos > 0.0) {
+        salida << std::setprecision(0) << "Rendimiento: " << total / resumen.segundos << " transacciones/s";
+        if (total > 0) {
+            salida << std::setprecision(2) << " (" << resumen.segundos * 1e6 / total << " us por transaccion)";
+        }
+        salida << "\n";
+    }
+    salida << std::defaultfloat << std::setprecision(6);
+}
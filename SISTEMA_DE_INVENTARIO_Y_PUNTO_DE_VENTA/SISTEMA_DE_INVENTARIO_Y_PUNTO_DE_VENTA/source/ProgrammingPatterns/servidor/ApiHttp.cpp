@@ -0,0 +1,390 @@
+﻿/**
+ * @file ApiHttp.cpp
+ * @brief Rutas de la API HTTP/JSON y su caché de respuestas.
+ *
+ * @date 2026-10-19
+ * @version 1.0
+ * @author Ari
+ */
+#include "ProgrammingPatterns/servidor/ApiHttp.h"
+#include "ProgrammingPatterns/servidor/ServidorPOS.h"
+#include "ProgrammingPatterns/modelos/Inventario.h"
+#include "ProgrammingPatterns/gasolinera/Gasolinera.h"
+#include "nlohmann/json.hpp"
+#include <cmath>
+#include <cstdlib>
+#include <map>
+
+using json = nlohmann::json;
+
+/**
+ * @brief Respuesta de error `{"error": mensaje}`.
+ */
+static std::string error(const char* mensaje) {
+    return json{ {"error", mensaje} }.dump();
+}
+
+/**
+ * @brief Lee filtro y página de la consulta (`texto`/`tipo`, `stockMaximo`, `pagina`, `porPagina`).
+ */
+static FiltroReporte leerFiltro(const std::string& consulta, const char* campoTexto) {
+    FiltroReporte filtro;
+    std::string valor;
+    Http::parametro(consulta, campoTexto, filtro.texto);
+    if (Http::parametro(consulta, "stockMaximo", valor)) {
+        filtro.stockMaximo = std::atoi(valor.c_str());
+    }
+    if (Http::parametro(consulta, "pagina", valor)) {
+        filtro.pagina = std::max(1L, std::atol(valor.c_str()));
+    }
+    filtro.filasPorPagina = ApiHttp::kFilasPorPagina;
+    if (Http::parametro(consulta, "porPagina", valor)) {
+        long filas = std::atol(valor.c_str());
+        filtro.filasPorPagina = static_cast<size_t>(std::min<long>(std::max(1L, filas),
+            static_cast<long>(ApiHttp::kMaxFilasPorPagina)));
+    }
+    return filtro;
+}
+
+/**
+ * @brief Entero de un campo del cuerpo, o `omision` si no viene.
+ *
+ * @return false si el campo viene pero no es un número.
+ */
+static bool leerEntero(const json& cuerpo, const char* campo, int omision, int& valor) {
+    auto it = cuerpo.find(campo);
+    if (it == cuerpo.end()) {
+        valor = omision;
+        return true;
+    }
+    if (!it->is_number_integer()) {
+        return false;
+    }
+    valor = it->get<int>();
+    return true;
+}
+
+ApiHttp::ApiHttp(ServidorPOS& servidor, const Inventario& inventario, const Gasolinera& gasolinera)
+    : servidor(servidor), inventario(inventario), gasolinera(gasolinera) {}
+
+bool ApiHttp::vigente(const EntradaCache& e, std::chrono::steady_clock::time_point ahora) const {
+    bool alDia = ((e.dependencias & kInventario) == 0 || e.generacionInventario == servidor.getGeneracionInventario()) &&
+        ((e.dependencias & kGasolinera) == 0 || e.generacionGasolinera == servidor.getGeneracionGasolinera());
+    return alDia || ahora - e.calculada < vigencia;
+}
+
+void ApiHttp::atender(const SolicitudHttp& s, std::string& salida) {
+    estadisticas.solicitudes++;
+
+    // Lecturas: primero la caché
+    std::string clave;
+    auto ahora = std::chrono::steady_clock::now();
+    if (s.metodo == "GET") {
+        clave.reserve(s.ruta.size() + 1 + s.consulta.size());
+        clave.append(s.ruta).append(1, '?').append(s.consulta);
+        auto it = cache.find(clave);
+        if (it != cache.end() && vigente(it->second, ahora)) {
+            estadisticas.aciertosCache++;
+            Http::escribir(it->second.estado, it->second.cuerpo, s.mantener, salida, "X-Cache: HIT\r\n");
+            return;
+        }
+    }
+
+    Respuesta r = resolver(s);
+    if (r.dependencias == kNinguna || clave.empty()) {
+        Http::escribir(r.estado, r.cuerpo, s.mantener, salida);
+        return;
+    }
+
+    estadisticas.fallosCache++;
+    Http::escribir(r.estado, r.cuerpo, s.mantener, salida, "X-Cache: MISS\r\n");
+    if (cache.size() >= kMaxEntradasCache) {
+        cache.clear();
+    }
+    EntradaCache& e = cache[clave];
+    e.estado = r.estado;
+    e.cuerpo = std::move(r.cuerpo);
+    e.dependencias = r.dependencias;
+    e.generacionInventario = servidor.getGeneracionInventario();
+    e.generacionGasolinera = servidor.getGeneracionGasolinera();
+    e.calculada = ahora;
+}
+
+ApiHttp::Respuesta ApiHttp::resolver(const SolicitudHttp& s) {
+    static const std::string kPrefijoProducto = "/productos/";
+    bool get = s.metodo == "GET";
+    bool post = s.metodo == "POST";
+
+    if (s.ruta.compare(0, kPrefijoProducto.size(), kPrefijoProducto) == 0 && s.ruta.size() > kPrefijoProducto.size()) {
+        if (get) return producto(Http::decodificar(std::string_view(s.ruta).substr(kPrefijoProducto.size())));
+    }
+    else if (s.ruta == "/productos") {
+        if (get) return productos(s.consulta);
+    }
+    else if (s.ruta == "/gasolinera/historial") {
+        if (get) return historial(s.consulta);
+    }
+    else if (s.ruta == "/gasolinera/precios") {
+        if (get) return precios();
+    }
+    else if (s.ruta == "/reportes/resumen") {
+        if (get) return resumen();
+    }
+    else if (s.ruta == "/replicacion") {
+        if (get) return replicacion();
+    }
+    else if (s.ruta == "/ventas") {
+        if (post) return venta(s.cuerpo);
+    }
+    else if (s.ruta == "/reposiciones") {
+        if (post) return reposicion(s.cuerpo);
+    }
+    else if (s.ruta == "/gasolinera/cargas") {
+        if (post) return carga(s.cuerpo);
+    }
+    else {
+        return { 404, error("Ruta desconocida") };
+    }
+    return { 405, error("Metodo no permitido") };
+}
+
+ApiHttp::Respuesta ApiHttp::producto(const std::string& codigo) const {
+    const Producto* p = inventario.buscarProducto(codigo);
+    if (p == nullptr) {
+        return { 404, error("Producto no encontrado"), kInventario };
+    }
+    json j = *p;
+    return { 200, j.dump(), kInventario };
+}
+
+ApiHttp::Respuesta ApiHttp::productos(const std::string& consulta) const {
+    FiltroReporte filtro = leerFiltro(consulta, "texto");
+    json lista = json::array();
+    size_t coincidencias = 0;
+    for (const auto& p : inventario.getProductos()) {
+        if (filtro.admite(*p) && filtro.enPagina(coincidencias++)) {
+            lista.push_back(*p);
+        }
+    }
+    json j = {
+        {"coincidencias", coincidencias},
+        {"pagina", filtro.pagina},
+        {"paginas", filtro.contarPaginas(coincidencias)},
+        {"productos", std::move(lista)}
+    };
+    return { 200, j.dump(), kInventario };
+}
+
+ApiHttp::Respuesta ApiHttp::historial(const std::string& consulta) const {
+    FiltroReporte filtro = leerFiltro(consulta, "tipo");
+    json lista = json::array();
+    size_t coincidencias = 0;
+    for (const auto& c : gasolinera.getHistorial()) {
+        if (filtro.admite(c) && filtro.enPagina(coincidencias++)) {
+            lista.push_back(c);
+        }
+    }
+    json j = {
+        {"coincidencias", coincidencias},
+        {"pagina", filtro.pagina},
+        {"paginas", filtro.contarPaginas(coincidencias)},
+        {"cargas", std::move(lista)}
+    };
+    return { 200, j.dump(), kGasolinera };
+}
+
+ApiHttp::Respuesta ApiHttp::precios() const {
+    // Los precios cambian con la hora programada, no con las operaciones: no se guardan
+    const TablaPreciosCombustible& tabla = gasolinera.getTablaPrecios();
+    const VersionPrecios* ultima = tabla.obtenerVersion(static_cast<unsigned int>(tabla.totalVersiones()));
+    json j = json::object();
+    time_t ahora = time(nullptr);
+    if (ultima != nullptr) {
+        for (const auto& par : ultima->precios) {
+            Dinero precio;
+            unsigned int version = 0;
+            if (tabla.consultarPrecio(par.first, ahora, precio, version)) {
+                j[par.first] = { {"precio", precio.aPesos()}, {"version", version} };
+            }
+        }
+    }
+    return { 200, j.dump() };
+}
+
+ApiHttp::Respuesta ApiHttp::replicacion() const {
+    // Cambia con cada movimiento y cada latido: no se guarda
+    json j = { {"secuencia", inventario.getSecuencia()} };
+    if (const LiderReplicacion* lider = servidor.getLider()) {
+        const LiderReplicacion::Estadisticas& e = lider->getEstadisticas();
+        j["rol"] = "lider";
+        j["epoca"] = lider->getEpoca();
+        j["replicas"] = lider->totalSeguidores();
+        j["diario"] = lider->totalDiario();
+        j["fotos"] = e.fotos;
+        j["colas"] = e.colas;
+    }
+    else if (const SeguidorReplicacion* seguidor = servidor.getSeguidor()) {
+        const SeguidorReplicacion::Estadisticas& e = seguidor->getEstadisticas();
+        j["rol"] = "replica";
+        j["conectada"] = servidor.conectadoAlLider();
+        j["secuenciaLider"] = e.secuenciaLider;
+        j["atraso"] = seguidor->atraso();
+        j["movimientos"] = e.movimientos;
+        j["fotos"] = e.fotos;
+        j["conexiones"] = e.conexiones;
+        j["retrasoUs"] = {
+            {"ultimo", e.retrasoUltimoUs},
+            {"promedio", seguidor->retrasoPromedioUs()},
+            {"p50", seguidor->percentilRetrasoUs(50)},
+            {"p99", seguidor->percentilRetrasoUs(99)},
+            {"maximo", e.retrasoMaximoUs}
+        };
+    }
+    else {
+        j["rol"] = "independiente";
+    }
+    return { 200, j.dump() };
+}
+
+ApiHttp::Respuesta ApiHttp::resumen() const {
+    long long unidades = 0;
+    size_t sinStock = 0, stockBajo = 0;
+    Dinero valor;
+    for (const auto& p : inventario.getProductos()) {
+        unidades += p->getCantidad();
+        valor += p->getPrecio() * p->getCantidad();
+        if (p->getCantidad() <= 0) {
+            sinStock++;
+        }
+        else if (p->getCantidad() < 5) {
+            stockBajo++;
+        }
+    }
+
+    struct Totales { size_t cargas = 0; double litros = 0; Dinero total; };
+    std::map<std::string, Totales> porTipo;
+    Totales todas;
+    for (const auto& c : gasolinera.getHistorial()) {
+        Totales& t = porTipo[c.tipo];
+        t.cargas++;
+        t.litros += c.litros;
+        t.total += c.totalPagado;
+        todas.cargas++;
+        todas.litros += c.litros;
+        todas.total += c.totalPagado;
+    }
+    // Los litros se suman en double: se redondean a centésimas para el reporte
+    auto redondear = [](double litros) { return std::round(litros * 100.0) / 100.0; };
+    json tipos = json::object();
+    for (const auto& par : porTipo) {
+        tipos[par.first] = { {"cargas", par.second.cargas}, {"litros", redondear(par.second.litros)},
+            {"total", par.second.total.aPesos()} };
+    }
+
+    json j = {
+        {"inventario", {
+            {"productos", inventario.totalProductos()},
+            {"unidades", unidades},
+            {"valor", valor.aPesos()},
+            {"sinStock", sinStock},
+            {"stockBajo", stockBajo}
+        }},
+        {"gasolinera", {
+            {"cargas", todas.cargas},
+            {"litros", redondear(todas.litros)},
+            {"total", todas.total.aPesos()},
+            {"porTipo", std::move(tipos)}
+        }}
+    };
+    return { 200, j.dump(), kInventario | kGasolinera };
+}
+
+/**
+ * @brief Convierte el resultado de `ServidorPOS::atender` en estado HTTP.
+ */
+static int estadoHttp(EstadoRespuesta estado) {
+    switch (estado) {
+    case EstadoRespuesta::Ok:           return 201;
+    case EstadoRespuesta::NoEncontrado: return 404;
+    case EstadoRespuesta::Invalida:     return 422;
+    default:                            return 409;
+    }
+}
+
+static const char* mensajeDe(EstadoRespuesta estado) {
+    switch (estado) {
+    case EstadoRespuesta::NoEncontrado: return "Producto no encontrado";
+    case EstadoRespuesta::SinStock:     return "Stock insuficiente";
+    case EstadoRespuesta::Invalida:     return "Datos invalidos";
+    default:                            return "Operacion rechazada";
+    }
+}
+
+ApiHttp::Respuesta ApiHttp::venta(const std::string& cuerpo) {
+    json datos = json::parse(cuerpo, nullptr, false);
+    SolicitudPOS s;
+    int cantidad = 0, pago = 1, marca = 0;
+    if (!datos.is_object() || !datos.contains("codigo") || !datos["codigo"].is_string() ||
+        !leerEntero(datos, "cantidad", 0, cantidad) || !leerEntero(datos, "pago", 1, pago) ||
+        !leerEntero(datos, "marca", 0, marca) || pago < 1 || pago > 3 || marca < 0 || marca > 3) {
+        return { 400, error("Se espera {\"codigo\", \"cantidad\", \"pago\" (1-3), \"marca\" (0-3)}") };
+    }
+    s.tipo = TipoSolicitud::Venta;
+    s.texto = datos["codigo"].get<std::string>();
+    s.cantidad = cantidad;
+    s.pago = static_cast<std::uint8_t>(pago);
+    s.marca = static_cast<std::uint8_t>(marca);
+
+    RespuestaPOS r = servidor.atender(s);
+    if (r.estado != EstadoRespuesta::Ok) {
+        return { estadoHttp(r.estado), error(mensajeDe(r.estado)) };
+    }
+    json j = { {"folio", r.folio}, {"total", Dinero::desdeCentavos(r.centavos).aPesos()}, {"stock", r.stock} };
+    return { 201, j.dump() };
+}
+
+ApiHttp::Respuesta ApiHttp::reposicion(const std::string& cuerpo) {
+    json datos = json::parse(cuerpo, nullptr, false);
+    SolicitudPOS s;
+    int cantidad = 0;
+    if (!datos.is_object() || !datos.contains("codigo") || !datos["codigo"].is_string() ||
+        !leerEntero(datos, "cantidad", 0, cantidad)) {
+        return { 400, error("Se espera {\"codigo\", \"cantidad\"}") };
+    }
+    s.tipo = TipoSolicitud::Reposicion;
+    s.texto = datos["codigo"].get<std::string>();
+    s.cantidad = cantidad;
+
+    RespuestaPOS r = servidor.atender(s);
+    if (r.estado != EstadoRespuesta::Ok) {
+        return { estadoHttp(r.estado), error(mensajeDe(r.estado)) };
+    }
+    return { 201, json{ {"stock", r.stock} }.dump() };
+}
+
+ApiHttp::Respuesta ApiHttp::carga(const std::string& cuerpo) {
+    json datos = json::parse(cuerpo, nullptr, false);
+    SolicitudPOS s;
+    int pago = 1, marca = 0;
+    if (!datos.is_object() || !datos.contains("tipo") || !datos["tipo"].is_string() ||
+        !datos.contains("litros") || !datos["litros"].is_number() ||
+        !leerEntero(datos, "pago", 1, pago) || !leerEntero(datos, "marca", 0, marca) ||
+        pago < 1 || pago > 3 || marca < 0 || marca > 3) {
+        return { 400, error("Se espera {\"tipo\", \"litros\", \"pago\" (1-3), \"marca\" (0-3)}") };
+    }
+    double litros = datos["litros"].get<double>();
+    if (!(litros > 0.0) || litros > 1e6) {
+        return { 422, error("Litros invalidos") };
+    }
+    s.tipo = TipoSolicitud::Carga;
+    s.texto = datos["tipo"].get<std::string>();
+    s.cantidad = static_cast<std::int32_t>(litros * 1000.0 + 0.5);
+    s.pago = static_cast<std::uint8_t>(pago);
+    s.marca = static_cast<std::uint8_t>(marca);
+
+    RespuestaPOS r = servidor.atender(s);
+    if (r.estado != EstadoRespuesta::Ok) {
+        return { estadoHttp(r.estado), error(mensajeDe(r.estado)) };
+    }
+    return { 201, json{ {"total", Dinero::desdeCentavos(r.centavos).aPesos()} }.dump() };
+}
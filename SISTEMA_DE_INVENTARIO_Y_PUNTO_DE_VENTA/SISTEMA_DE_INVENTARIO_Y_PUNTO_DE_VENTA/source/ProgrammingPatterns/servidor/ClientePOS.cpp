@@ -0,0 +1,168 @@
+﻿/**
+ * @file ClientePOS.cpp
+ * @brief Conexión bloqueante de una caja con el servidor.
+ *
+ * @date 2026-10-19
+ * @version 1.0
+ * @author Ari
+ */
+#include "ProgrammingPatterns/servidor/ClientePOS.h"
+#include <iostream>
+#ifndef _WIN32
+#include <arpa/inet.h>
+#include <cerrno>
+#include <cstring>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <sys/socket.h>
+#include <sys/time.h>
+#include <sys/un.h>
+#include <unistd.h>
+#endif
+
+ClientePOS::~ClientePOS() {
+    cerrar();
+}
+
+bool ClientePOS::solicitar(const SolicitudPOS& solicitud, RespuestaPOS& respuesta) {
+    encolar(solicitud);
+    return enviar() && recibir(respuesta);
+}
+
+#ifdef _WIN32
+
+bool ClientePOS::conectar(const std::string&) {
+    std::cout << "La conexion con el servidor solo esta disponible en Linux.\n";
+    return false;
+}
+
+void ClientePOS::cerrar() {}
+
+bool ClientePOS::enviar() {
+    return false;
+}
+
+bool ClientePOS::recibir(RespuestaPOS&) {
+    return false;
+}
+
+#else
+
+/**
+ * @brief Aplica la espera máxima a un socket (en Linux también limita `connect`).
+ */
+static void limitarEspera(int fd, int ms) {
+    if (fd < 0 || ms <= 0) {
+        return;
+    }
+    timeval espera{};
+    espera.tv_sec = ms / 1000;
+    espera.tv_usec = (ms % 1000) * 1000;
+    setsockopt(fd, SOL_SOCKET, SO_RCVTIMEO, &espera, sizeof(espera));
+    setsockopt(fd, SOL_SOCKET, SO_SNDTIMEO, &espera, sizeof(espera));
+}
+
+bool ClientePOS::conectar(const std::string& texto) {
+    cerrar();
+    DireccionPOS direccion;
+    if (!DireccionPOS::leer(texto, direccion)) {
+        std::cout << "Direccion invalida: " << texto << "\n";
+        return false;
+    }
+
+    int resultado = -1;
+    if (direccion.local) {
+        sockaddr_un dir{};
+        if (direccion.ruta.size() >= sizeof(dir.sun_path)) {
+            std::cout << "Ruta de socket demasiado larga: " << direccion.ruta << "\n";
+            return false;
+        }
+        dir.sun_family = AF_UNIX;
+        std::memcpy(dir.sun_path, direccion.ruta.c_str(), direccion.ruta.size() + 1);
+        fd = socket(AF_UNIX, SOCK_STREAM | SOCK_CLOEXEC, 0);
+        if (fd >= 0) {
+            limitarEspera(fd, esperaMs);
+            resultado = connect(fd, reinterpret_cast<sockaddr*>(&dir), sizeof(dir));
+        }
+    }
+    else {
+        sockaddr_in dir{};
+        dir.sin_family = AF_INET;
+        dir.sin_port = htons(direccion.puerto);
+        if (inet_pton(AF_INET, direccion.host.c_str(), &dir.sin_addr) != 1) {
+            std::cout << "Host invalido: " << direccion.host << "\n";
+            return false;
+        }
+        fd = socket(AF_INET, SOCK_STREAM | SOCK_CLOEXEC, 0);
+        if (fd >= 0) {
+            int uno = 1;
+            setsockopt(fd, IPPROTO_TCP, TCP_NODELAY, &uno, sizeof(uno));
+            limitarEspera(fd, esperaMs);
+            resultado = connect(fd, reinterpret_cast<sockaddr*>(&dir), sizeof(dir));
+        }
+    }
+
+    if (resultado != 0) {
+        std::cout << "No se pudo conectar a " << texto << ": " << std::strerror(errno) << "\n";
+        cerrar();
+        return false;
+    }
+    return true;
+}
+
+void ClientePOS::cerrar() {
+    if (fd >= 0) {
+        close(fd);
+        fd = -1;
+    }
+    pendiente.clear();
+    recibido.clear();
+    leido = 0;
+}
+
+bool ClientePOS::enviar() {
+    size_t enviado = 0;
+    while (fd >= 0 && enviado < pendiente.size()) {
+        ssize_t n = send(fd, pendiente.data() + enviado, pendiente.size() - enviado, MSG_NOSIGNAL);
+        if (n < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            return false;
+        }
+        enviado += static_cast<size_t>(n);
+    }
+    pendiente.clear();
+    return fd >= 0;
+}
+
+bool ClientePOS::recibir(RespuestaPOS& respuesta) {
+    char bloque[16 * 1024];
+    while (fd >= 0) {
+        size_t usados = Protocolo::leer(recibido.data() + leido, recibido.size() - leido, respuesta);
+        if (usados == Protocolo::kTramaInvalida) {
+            return false;
+        }
+        if (usados > 0) {
+            leido += usados;
+            if (leido == recibido.size()) {
+                recibido.clear();
+                leido = 0;
+            }
+            return true;
+        }
+        ssize_t n = recv(fd, bloque, sizeof(bloque), 0);
+        if (n < 0 && errno == EINTR) {
+            continue;
+        }
+        if (n <= 0) {
+            return false;
+        }
+        recibido.erase(0, leido);
+        leido = 0;
+        recibido.append(bloque, static_cast<size_t>(n));
+    }
+    return false;
+}
+
+#endif
@@ -0,0 +1,197 @@
+﻿/**
+ * @file Http.cpp
+ * @brief Lectura de solicitudes y escritura de respuestas HTTP/1.1.
+ *
+ * @date 2026-10-19
+ * @version 1.0
+ * @author Ari
+ */
+#include "ProgrammingPatterns/servidor/Http.h"
+#include <charconv>
+#include <cstring>
+
+/**
+ * @brief Compara sin distinguir mayúsculas (ASCII).
+ */
+static bool igualSinMayusculas(std::string_view a, std::string_view b) {
+    if (a.size() != b.size()) {
+        return false;
+    }
+    for (size_t i = 0; i < a.size(); i++) {
+        char x = a[i], y = b[i];
+        if (x >= 'A' && x <= 'Z') x = static_cast<char>(x - 'A' + 'a');
+        if (y >= 'A' && y <= 'Z') y = static_cast<char>(y - 'A' + 'a');
+        if (x != y) {
+            return false;
+        }
+    }
+    return true;
+}
+
+/**
+ * @brief Indica si una lista separada por comas (`Connection`) contiene un valor.
+ */
+static bool contieneToken(std::string_view lista, std::string_view token) {
+    while (!lista.empty()) {
+        size_t coma = lista.find(',');
+        std::string_view parte = lista.substr(0, coma);
+        while (!parte.empty() && parte.front() == ' ') parte.remove_prefix(1);
+        while (!parte.empty() && parte.back() == ' ') parte.remove_suffix(1);
+        if (igualSinMayusculas(parte, token)) {
+            return true;
+        }
+        if (coma == std::string_view::npos) {
+            break;
+        }
+        lista.remove_prefix(coma + 1);
+    }
+    return false;
+}
+
+size_t Http::leer(const char* datos, size_t n, SolicitudHttp& s) {
+    std::string_view texto(datos, n);
+    size_t finEncabezados = texto.find("\r\n\r\n");
+    if (finEncabezados == std::string_view::npos) {
+        return n > kMaxEncabezados ? kSolicitudInvalida : 0;
+    }
+    if (finEncabezados > kMaxEncabezados) {
+        return kSolicitudInvalida;
+    }
+
+    // Línea de solicitud: MÉTODO RUTA VERSIÓN
+    size_t finLinea = texto.find("\r\n");
+    std::string_view linea = texto.substr(0, finLinea);
+    size_t esp1 = linea.find(' ');
+    size_t esp2 = esp1 == std::string_view::npos ? esp1 : linea.find(' ', esp1 + 1);
+    if (esp2 == std::string_view::npos || esp1 == 0) {
+        return kSolicitudInvalida;
+    }
+    std::string_view version = linea.substr(esp2 + 1);
+    if (version != "HTTP/1.1" && version != "HTTP/1.0") {
+        return kSolicitudInvalida;
+    }
+    std::string_view destino = linea.substr(esp1 + 1, esp2 - esp1 - 1);
+    if (destino.empty() || destino[0] != '/') {
+        return kSolicitudInvalida;
+    }
+    s.metodo.assign(linea.data(), esp1);
+    size_t pregunta = destino.find('?');
+    s.ruta.assign(destino.substr(0, pregunta));
+    s.consulta.assign(pregunta == std::string_view::npos ? std::string_view() : destino.substr(pregunta + 1));
+    s.mantener = version == "HTTP/1.1";
+
+    // Encabezados
+    size_t largoCuerpo = 0;
+    size_t pos = finLinea + 2;
+    while (pos < finEncabezados) {
+        size_t fin = texto.find("\r\n", pos);
+        std::string_view encabezado = texto.substr(pos, fin - pos);
+        pos = fin + 2;
+        size_t dosPuntos = encabezado.find(':');
+        if (dosPuntos == std::string_view::npos) {
+            return kSolicitudInvalida;
+        }
+        std::string_view nombre = encabezado.substr(0, dosPuntos);
+        std::string_view valor = encabezado.substr(dosPuntos + 1);
+        while (!valor.empty() && (valor.front() == ' ' || valor.front() == '\t')) valor.remove_prefix(1);
+        while (!valor.empty() && (valor.back() == ' ' || valor.back() == '\t')) valor.remove_suffix(1);
+
+        if (igualSinMayusculas(nombre, "content-length")) {
+            auto r = std::from_chars(valor.data(), valor.data() + valor.size(), largoCuerpo);
+            if (r.ec != std::errc() || r.ptr != valor.data() + valor.size() || largoCuerpo > kMaxCuerpo) {
+                return kSolicitudInvalida;
+            }
+        }
+        else if (igualSinMayusculas(nombre, "transfer-encoding")) {
+            // Sin soporte para chunked: no se sabría dónde termina el cuerpo
+            return kSolicitudInvalida;
+        }
+        else if (igualSinMayusculas(nombre, "connection")) {
+            if (contieneToken(valor, "close")) {
+                s.mantener = false;
+            }
+            else if (contieneToken(valor, "keep-alive")) {
+                s.mantener = true;
+            }
+        }
+    }
+
+    size_t total = finEncabezados + 4 + largoCuerpo;
+    if (n < total) {
+        return 0;
+    }
+    s.cuerpo.assign(datos + finEncabezados + 4, largoCuerpo);
+    return total;
+}
+
+const char* Http::frase(int estado) {
+    switch (estado) {
+    case 200: return "OK";
+    case 201: return "Created";
+    case 400: return "Bad Request";
+    case 404: return "Not Found";
+    case 405: return "Method Not Allowed";
+    case 409: return "Conflict";
+    case 422: return "Unprocessable Entity";
+    default:  return "Internal Server Error";
+    }
+}
+
+void Http::escribir(int estado, std::string_view cuerpo, bool mantener, std::string& destino,
+    std::string_view encabezados) {
+
+    char numero[24];
+    destino.append("HTTP/1.1 ");
+    destino.append(numero, static_cast<size_t>(std::to_chars(numero, numero + sizeof(numero), estado).ptr - numero));
+    destino.push_back(' ');
+    destino.append(frase(estado));
+    destino.append("\r\nContent-Type: application/json; charset=utf-8\r\nContent-Length: ");
+    destino.append(numero, static_cast<size_t>(std::to_chars(numero, numero + sizeof(numero), cuerpo.size()).ptr - numero));
+    destino.append(mantener ? "\r\nConnection: keep-alive\r\n" : "\r\nConnection: close\r\n");
+    destino.append(encabezados);
+    destino.append("\r\n");
+    destino.append(cuerpo);
+}
+
+std::string Http::decodificar(std::string_view texto) {
+    std::string resultado;
+    resultado.reserve(texto.size());
+    for (size_t i = 0; i < texto.size(); i++) {
+        char c = texto[i];
+        if (c == '+') {
+            resultado.push_back(' ');
+        }
+        else if (c == '%' && i + 2 < texto.size()) {
+            unsigned valor = 0;
+            auto r = std::from_chars(texto.data() + i + 1, texto.data() + i + 3, valor, 16);
+            if (r.ec == std::errc() && r.ptr == texto.data() + i + 3) {
+                resultado.push_back(static_cast<char>(valor));
+                i += 2;
+            }
+            else {
+                resultado.push_back(c);
+            }
+        }
+        else {
+            resultado.push_back(c);
+        }
+    }
+    return resultado;
+}
+
+bool Http::parametro(std::string_view consulta, std::string_view nombre, std::string& valor) {
+    while (!consulta.empty()) {
+        size_t amp = consulta.find('&');
+        std::string_view par = consulta.substr(0, amp);
+        size_t igual = par.find('=');
+        if (par.substr(0, igual) == nombre) {
+            valor = igual == std::string_view::npos ? std::string() : decodificar(par.substr(igual + 1));
+            return true;
+        }
+        if (amp == std::string_view::npos) {
+            break;
+        }
+        consulta.remove_prefix(amp + 1);
+    }
+    return false;
+}
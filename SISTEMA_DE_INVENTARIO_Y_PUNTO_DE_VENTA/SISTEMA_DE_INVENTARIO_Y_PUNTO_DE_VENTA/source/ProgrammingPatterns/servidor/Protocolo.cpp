@@ -0,0 +1,139 @@
+﻿/**
+ * @file Protocolo.cpp
+ * @brief Escritura y lectura de tramas little-endian.
+ *
+ * @date 2026-10-19
+ * @version 1.0
+ * @author Ari
+ */
+#include "ProgrammingPatterns/servidor/Protocolo.h"
+#include <cstdlib>
+
+/// Bytes fijos después del largo: solicitud y respuesta.
+static constexpr size_t kFijoSolicitud = 14;
+static constexpr size_t kFijoRespuesta = 30;
+
+void Protocolo::agregarEntero(std::string& d, std::uint64_t valor, int bytes) {
+    for (int i = 0; i < bytes; i++) {
+        d.push_back(static_cast<char>((valor >> (8 * i)) & 0xFF));
+    }
+}
+
+std::uint64_t Protocolo::tomarEntero(const char*& p, int bytes) {
+    std::uint64_t valor = 0;
+    for (int i = 0; i < bytes; i++) {
+        valor |= static_cast<std::uint64_t>(static_cast<unsigned char>(p[i])) << (8 * i);
+    }
+    p += bytes;
+    return valor;
+}
+
+/**
+ * @brief Revisa el largo de la trama.
+ *
+ * @return size_t Largo total (con el campo de largo), 0 si falta o kTramaInvalida.
+ */
+static size_t largoTrama(const char* datos, size_t n, size_t fijo) {
+    if (n < 4) {
+        return 0;
+    }
+    const char* p = datos;
+    size_t largo = static_cast<size_t>(Protocolo::tomarEntero(p, 4));
+    if (largo < fijo || largo > fijo + Protocolo::kMaxTexto) {
+        return Protocolo::kTramaInvalida;
+    }
+    return n < 4 + largo ? 0 : 4 + largo;
+}
+
+bool DireccionPOS::leer(const std::string& texto, DireccionPOS& d) {
+    d = DireccionPOS();
+    if (texto.compare(0, 5, "unix:") == 0) {
+        d.ruta = texto.substr(5);
+        return !d.ruta.empty();
+    }
+    if (texto.compare(0, 4, "tcp:") != 0) {
+        return false;
+    }
+    d.local = false;
+    std::string resto = texto.substr(4);
+    size_t dosPuntos = resto.rfind(':');
+    if (dosPuntos != std::string::npos) {
+        d.host = resto.substr(0, dosPuntos);
+        resto = resto.substr(dosPuntos + 1);
+    }
+    char* fin = nullptr;
+    unsigned long puerto = std::strtoul(resto.c_str(), &fin, 10);
+    if (resto.empty() || *fin != '\0' || puerto == 0 || puerto > 65535 || d.host.empty()) {
+        return false;
+    }
+    d.puerto = static_cast<unsigned short>(puerto);
+    return true;
+}
+
+void Protocolo::escribir(const SolicitudPOS& s, std::string& d) {
+    size_t texto = s.texto.size() < kMaxTexto ? s.texto.size() : kMaxTexto;
+    agregarEntero(d, kFijoSolicitud + texto, 4);
+    agregarEntero(d, static_cast<std::uint8_t>(s.tipo), 1);
+    agregarEntero(d, s.pago, 1);
+    agregarEntero(d, s.marca, 1);
+    agregarEntero(d, 0, 1);
+    agregarEntero(d, s.id, 4);
+    agregarEntero(d, static_cast<std::uint32_t>(s.cantidad), 4);
+    agregarEntero(d, texto, 2);
+    d.append(s.texto, 0, texto);
+}
+
+void Protocolo::escribir(const RespuestaPOS& r, std::string& d) {
+    size_t texto = r.texto.size() < kMaxTexto ? r.texto.size() : kMaxTexto;
+    agregarEntero(d, kFijoRespuesta + texto, 4);
+    agregarEntero(d, static_cast<std::uint8_t>(r.tipo), 1);
+    agregarEntero(d, static_cast<std::uint8_t>(r.estado), 1);
+    agregarEntero(d, 0, 2);
+    agregarEntero(d, r.id, 4);
+    agregarEntero(d, static_cast<std::uint64_t>(r.centavos), 8);
+    agregarEntero(d, static_cast<std::uint32_t>(r.stock), 4);
+    agregarEntero(d, r.folio, 8);
+    agregarEntero(d, texto, 2);
+    d.append(r.texto, 0, texto);
+}
+
+size_t Protocolo::leer(const char* datos, size_t n, SolicitudPOS& s) {
+    size_t total = largoTrama(datos, n, kFijoSolicitud);
+    if (total == 0 || total == kTramaInvalida) {
+        return total;
+    }
+    const char* p = datos + 4;
+    s.tipo = static_cast<TipoSolicitud>(tomarEntero(p, 1));
+    s.pago = static_cast<std::uint8_t>(tomarEntero(p, 1));
+    s.marca = static_cast<std::uint8_t>(tomarEntero(p, 1));
+    tomarEntero(p, 1);
+    s.id = static_cast<std::uint32_t>(tomarEntero(p, 4));
+    s.cantidad = static_cast<std::int32_t>(static_cast<std::uint32_t>(tomarEntero(p, 4)));
+    size_t texto = static_cast<size_t>(tomarEntero(p, 2));
+    if (4 + kFijoSolicitud + texto != total) {
+        return kTramaInvalida;
+    }
+    s.texto.assign(p, texto);
+    return total;
+}
+
+size_t Protocolo::leer(const char* datos, size_t n, RespuestaPOS& r) {
+    size_t total = largoTrama(datos, n, kFijoRespuesta);
+    if (total == 0 || total == kTramaInvalida) {
+        return total;
+    }
+    const char* p = datos + 4;
+    r.tipo = static_cast<TipoSolicitud>(tomarEntero(p, 1));
+    r.estado = static_cast<EstadoRespuesta>(tomarEntero(p, 1));
+    tomarEntero(p, 2);
+    r.id = static_cast<std::uint32_t>(tomarEntero(p, 4));
+    r.centavos = static_cast<std::int64_t>(tomarEntero(p, 8));
+    r.stock = static_cast<std::int32_t>(static_cast<std::uint32_t>(tomarEntero(p, 4)));
+    r.folio = tomarEntero(p, 8);
+    size_t texto = static_cast<size_t>(tomarEntero(p, 2));
+    if (4 + kFijoRespuesta + texto != total) {
+        return kTramaInvalida;
+    }
+    r.texto.assign(p, texto);
+    return total;
+}
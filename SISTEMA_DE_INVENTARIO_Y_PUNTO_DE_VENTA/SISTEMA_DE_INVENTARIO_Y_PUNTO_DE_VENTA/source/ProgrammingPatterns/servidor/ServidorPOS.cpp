@@ -0,0 +1,832 @@
+﻿/**
+ * @file ServidorPOS.cpp
+ * @brief Ciclo de eventos con epoll y atención de las solicitudes de las cajas.
+ *
+ * @date 2026-10-19
+ * @version 1.0
+ * @author Ari
+ */
+#include "ProgrammingPatterns/servidor/ServidorPOS.h"
+#include "ProgrammingPatterns/modelos/Inventario.h"
+#include "ProgrammingPatterns/gasolinera/Gasolinera.h"
+#include "ProgrammingPatterns/facade/SistemaFacade.h"
+#include "ProgrammingPatterns/facade/SistemaGasolineraFacade.h"
+#include "ProgrammingPatterns/replicacion/ProtocoloReplicacion.h"
+#include <algorithm>
+#include <cstring>
+#include <filesystem>
+#include <iostream>
+#ifndef _WIN32
+#include <arpa/inet.h>
+#include <cerrno>
+#include <fcntl.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <sys/epoll.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+#endif
+
+/// Tiempo máximo de espera de epoll, para revisar `detener()`.
+static constexpr int kEsperaMs = 200;
+
+/// Bytes que se leen de un socket por evento.
+static constexpr size_t kBloqueLectura = 64 * 1024;
+
+ServidorPOS::ServidorPOS(Inventario& inventario, Gasolinera& gasolinera, SistemaFacade& facade,
+    SistemaGasolineraFacade& gasFacade)
+    : inventario(inventario), gasolinera(gasolinera), facade(facade), gasFacade(gasFacade) {}
+
+ServidorPOS::~ServidorPOS() {
+    cerrarTodo();
+    if (diarioCajas != nullptr) {
+        std::fclose(diarioCajas);
+    }
+}
+
+bool ServidorPOS::abrirVentasCajas(const std::string& archivo) {
+    // Un registro a medias al final se descarta
+    size_t leidas = 0;
+    if (std::FILE* f = std::fopen(archivo.c_str(), "rb")) {
+        VentaCajaAtendida v;
+        while (std::fread(&v, sizeof(v), 1, f) == 1) {
+            RespuestaPOS r;
+            r.tipo = TipoSolicitud::Venta;
+            r.id = v.numero;
+            r.estado = static_cast<EstadoRespuesta>(v.estado);
+            r.centavos = v.centavos;
+            r.stock = v.stock;
+            r.folio = v.folio;
+            recordarVenta(ventasCajas[std::string(v.caja, strnlen(v.caja, sizeof(v.caja)))], r);
+            leidas++;
+        }
+        std::fclose(f);
+    }
+
+    // Se reescribe solo lo que se recuerda; el último registro de cada caja
+    // trae su número más alto
+    std::string temporal = archivo + ".tmp";
+    diarioCajas = std::fopen(temporal.c_str(), "wb");
+    if (diarioCajas == nullptr) {
+        std::cerr << "No se pudo escribir " << temporal << ": las ventas reenviadas despues de reiniciar podrian repetirse.\n";
+        return false;
+    }
+    size_t recordadas = 0;
+    for (const auto& par : ventasCajas) {
+        for (std::uint32_t numero : par.second.orden) {
+            anotarVentaCaja(par.first, par.second.respuestas.at(numero));
+            recordadas++;
+        }
+    }
+    std::fclose(diarioCajas);
+    diarioCajasPendiente = false;
+
+    std::error_code error;
+    std::filesystem::rename(temporal, archivo, error);
+    diarioCajas = error ? nullptr : std::fopen(archivo.c_str(), "ab");
+    if (diarioCajas == nullptr) {
+        std::cerr << "No se pudo abrir " << archivo << ": las ventas reenviadas despues de reiniciar podrian repetirse.\n";
+        return false;
+    }
+    if (leidas > 0) {
+        std::cerr << "Ventas de cajas recuperadas: " << recordadas << " de " << ventasCajas.size() << " caja(s).\n";
+    }
+    return true;
+}
+
+RespuestaPOS ServidorPOS::atender(const SolicitudPOS& s) {
+    RespuestaPOS r;
+    r.tipo = s.tipo;
+    r.id = s.id;
+    estadisticas.solicitudes++;
+
+    // Una réplica solo contesta consultas: las escrituras van al líder
+    if (seguidor && s.tipo != TipoSolicitud::Ping && s.tipo != TipoSolicitud::Consulta &&
+        s.tipo != TipoSolicitud::Catalogo && s.tipo != TipoSolicitud::Identificar) {
+        r.estado = EstadoRespuesta::Rechazada;
+        return r;
+    }
+
+    switch (s.tipo) {
+    case TipoSolicitud::Ping:
+        break;
+
+    case TipoSolicitud::Consulta: {
+        const Producto* producto = inventario.buscarProducto(s.texto);
+        if (producto == nullptr) {
+            r.estado = EstadoRespuesta::NoEncontrado;
+            break;
+        }
+        r.centavos = producto->getPrecio().getCentavos();
+        r.stock = producto->getCantidad();
+        r.texto = producto->getNombre();
+        break;
+    }
+
+    case TipoSolicitud::Venta: {
+        const Producto* producto = inventario.buscarProducto(s.texto);
+        if (s.cantidad <= 0 || s.pago < 1 || s.pago > 3 || s.marca > 3) {
+            r.estado = EstadoRespuesta::Invalida;
+            break;
+        }
+        if (producto == nullptr) {
+            r.estado = EstadoRespuesta::NoEncontrado;
+            break;
+        }
+        if (producto->getCantidad() < s.cantidad) {
+            r.estado = EstadoRespuesta::SinStock;
+            r.stock = producto->getCantidad();
+            break;
+        }
+        Dinero total = producto->getPrecio() * s.cantidad;
+        PagoVariante pago = crearPago(s.pago, static_cast<MarcaTarjeta>(s.marca));
+        r.folio = facade.procesarVenta(inventario, s.texto, s.cantidad, pago);
+        if (r.folio == 0) {
+            r.estado = EstadoRespuesta::Rechazada;
+        }
+        else {
+            r.centavos = total.getCentavos();
+            generacionInventario++;
+        }
+        r.stock = producto->getCantidad();
+        break;
+    }
+
+    case TipoSolicitud::Reposicion: {
+        const Producto* producto = inventario.buscarProducto(s.texto);
+        if (s.cantidad <= 0) {
+            r.estado = EstadoRespuesta::Invalida;
+            break;
+        }
+        if (producto == nullptr) {
+            r.estado = EstadoRespuesta::NoEncontrado;
+            break;
+        }
+        inventario.comprarProducto(s.texto, s.cantidad);
+        r.stock = producto->getCantidad();
+        generacionInventario++;
+        break;
+    }
+
+    case TipoSolicitud::Carga: {
+        if (s.cantidad <= 0 || s.pago < 1 || s.pago > 3 || s.marca > 3 || s.texto.empty()) {
+            r.estado = EstadoRespuesta::Invalida;
+            break;
+        }
+        // La gasolinera no devuelve el resultado: la carga entró si creció el historial
+        size_t antes = gasolinera.getHistorial().size();
+        PagoVariante pago = crearPago(s.pago, static_cast<MarcaTarjeta>(s.marca));
+        gasFacade.procesarCarga(gasolinera, s.cantidad / 1000.0, s.texto, &comoMetodoPago(pago));
+        if (gasolinera.getHistorial().size() == antes) {
+            r.estado = EstadoRespuesta::Rechazada;
+            break;
+        }
+        r.centavos = gasolinera.getHistorial().back().totalPagado.getCentavos();
+        generacionGasolinera++;
+        break;
+    }
+
+    case TipoSolicitud::Identificar:
+        if (s.texto.empty() || s.texto.size() > kMaxNombreCaja) {
+            r.estado = EstadoRespuesta::Invalida;
+        }
+        break;
+
+    case TipoSolicitud::Catalogo: {
+        const auto& productos = inventario.getProductos();
+        r.folio = productos.size();
+        if (s.cantidad < 0 || static_cast<size_t>(s.cantidad) >= productos.size()) {
+            r.estado = EstadoRespuesta::NoEncontrado;
+            break;
+        }
+        const Producto& p = *productos[static_cast<size_t>(s.cantidad)];
+        r.centavos = p.getPrecio().getCentavos();
+        r.stock = p.getCantidad();
+        r.texto.reserve(p.getCodigo().size() + 1 + p.getNombre().size());
+        r.texto.append(p.getCodigo()).append(1, '\t').append(p.getNombre());
+        break;
+    }
+
+    case TipoSolicitud::Precio: {
+        if (s.cantidad <= 0) {
+            r.estado = EstadoRespuesta::Invalida;
+            break;
+        }
+        if (!inventario.cambiarPrecio(s.texto, Dinero::desdeCentavos(s.cantidad))) {
+            r.estado = EstadoRespuesta::NoEncontrado;
+            break;
+        }
+        r.centavos = s.cantidad;
+        r.stock = inventario.buscarProducto(s.texto)->getCantidad();
+        generacionInventario++;
+        break;
+    }
+
+    default:
+        r.estado = EstadoRespuesta::Invalida;
+        break;
+    }
+    return r;
+}
+
+RespuestaPOS ServidorPOS::atenderCaja(const SolicitudPOS& s, Conexion& c) {
+    if (s.tipo == TipoSolicitud::Identificar) {
+        RespuestaPOS r = atender(s);
+        if (r.estado == EstadoRespuesta::Ok) {
+            c.caja = s.texto;
+        }
+        return r;
+    }
+    if (s.tipo != TipoSolicitud::Venta || c.caja.empty()) {
+        return atender(s);
+    }
+
+    // Venta reenviada (a la caja no le llegó la respuesta): la original, sin volver a vender
+    VentasCaja& ventas = ventasCajas[c.caja];
+    auto it = ventas.respuestas.find(s.id);
+    if (it != ventas.respuestas.end()) {
+        estadisticas.solicitudes++;
+        estadisticas.ventasRepetidas++;
+        return it->second;
+    }
+
+    // Ya atendida pero su respuesta no se recuerda: tampoco se vuelve a vender
+    if (s.id <= ventas.ultima) {
+        estadisticas.solicitudes++;
+        estadisticas.ventasRepetidas++;
+        RespuestaPOS r;
+        r.tipo = s.tipo;
+        r.id = s.id;
+        r.estado = EstadoRespuesta::Repetida;
+        if (const Producto* producto = inventario.buscarProducto(s.texto)) {
+            r.stock = producto->getCantidad();
+        }
+        return r;
+    }
+
+    RespuestaPOS r = atender(s);
+    recordarVenta(ventas, r);
+    anotarVentaCaja(c.caja, r);
+    return r;
+}
+
+void ServidorPOS::recordarVenta(VentasCaja& ventas, const RespuestaPOS& r) {
+    if (ventas.orden.size() >= kVentasRecordadas) {
+        ventas.respuestas.erase(ventas.orden.front());
+        ventas.orden.pop_front();
+    }
+    ventas.respuestas.emplace(r.id, r);
+    ventas.orden.push_back(r.id);
+    ventas.ultima = std::max(ventas.ultima, r.id);
+}
+
+void ServidorPOS::anotarVentaCaja(const std::string& caja, const RespuestaPOS& r) {
+    if (diarioCajas == nullptr) {
+        return;
+    }
+    VentaCajaAtendida v;
+    std::memcpy(v.caja, caja.data(), std::min(caja.size(), kMaxNombreCaja));
+    v.folio = r.folio;
+    v.centavos = r.centavos;
+    v.numero = r.id;
+    v.stock = r.stock;
+    v.estado = static_cast<std::uint8_t>(r.estado);
+    std::fwrite(&v, sizeof(v), 1, diarioCajas);
+    diarioCajasPendiente = true;
+}
+
+size_t ServidorPOS::procesar(const char* datos, size_t n, Conexion& c) {
+    size_t consumido = 0;
+    if (c.tipo == TipoConexion::Lider) {
+        const SeguidorReplicacion::Estadisticas& e = seguidor->getEstadisticas();
+        unsigned long long antes = e.movimientos + e.fotos;
+        consumido = seguidor->procesar(datos, n);
+        if (consumido == ProtocoloReplicacion::kMensajeInvalido) {
+            estadisticas.tramasInvalidas++;
+            return Protocolo::kTramaInvalida;
+        }
+        if (e.movimientos + e.fotos != antes) {
+            generacionInventario++;
+        }
+        return consumido;
+    }
+    if (c.tipo == TipoConexion::Seguidor) {
+        // Después del saludo la réplica ya no envía nada
+        if (c.saludo) {
+            return n;
+        }
+        consumido = lider->atenderSeguidor(datos, n, c.salida);
+        if (consumido == ProtocoloReplicacion::kMensajeInvalido) {
+            estadisticas.tramasInvalidas++;
+            return Protocolo::kTramaInvalida;
+        }
+        c.saludo = consumido > 0;
+        return c.saludo ? n : 0;
+    }
+    if (c.tipo == TipoConexion::Caja) {
+        SolicitudPOS solicitud;
+        while (c.salida.size() - c.enviado < kMaxSalidaPendiente) {
+            size_t usados = Protocolo::leer(datos + consumido, n - consumido, solicitud);
+            if (usados == 0) {
+                break;
+            }
+            if (usados == Protocolo::kTramaInvalida) {
+                estadisticas.tramasInvalidas++;
+                return Protocolo::kTramaInvalida;
+            }
+            consumido += usados;
+            Protocolo::escribir(atenderCaja(solicitud, c), c.salida);
+        }
+        return consumido;
+    }
+
+    // HTTP: varias solicitudes seguidas se contestan en orden
+    SolicitudHttp solicitud;
+    while (!c.cerrarAlEnviar && c.salida.size() - c.enviado < kMaxSalidaPendiente) {
+        size_t usados = Http::leer(datos + consumido, n - consumido, solicitud);
+        if (usados == 0) {
+            break;
+        }
+        if (usados == Http::kSolicitudInvalida) {
+            estadisticas.tramasInvalidas++;
+            Http::escribir(400, "{\"error\":\"Solicitud invalida\"}", false, c.salida);
+            c.cerrarAlEnviar = true;
+            return n;
+        }
+        consumido += usados;
+        api->atender(solicitud, c.salida);
+        if (!solicitud.mantener) {
+            // Lo que venga después de un Connection: close se descarta
+            c.cerrarAlEnviar = true;
+            return n;
+        }
+    }
+    return consumido;
+}
+
+#ifdef _WIN32
+
+bool ServidorPOS::escuchar(const std::string&) {
+    std::cerr << "El modo servidor solo esta disponible en Linux.\n";
+    return false;
+}
+
+bool ServidorPOS::escucharHttp(const std::string& direccion) {
+    return escuchar(direccion);
+}
+
+bool ServidorPOS::escucharReplicas(const std::string& direccion) {
+    return escuchar(direccion);
+}
+
+bool ServidorPOS::seguir(const std::string& direccion) {
+    return escuchar(direccion);
+}
+
+bool ServidorPOS::ejecutar() {
+    return false;
+}
+
+void ServidorPOS::cerrarTodo() {}
+
+#else
+
+/**
+ * @brief Pone un socket en modo no bloqueante.
+ */
+static bool noBloqueante(int fd) {
+    int banderas = fcntl(fd, F_GETFL, 0);
+    return banderas >= 0 && fcntl(fd, F_SETFL, banderas | O_NONBLOCK) == 0;
+}
+
+bool ServidorPOS::escuchar(const std::string& direccion) {
+    int fd = abrirEscucha(direccion);
+    if (fd < 0) {
+        return false;
+    }
+    escuchas.push_back({ fd, TipoConexion::Caja });
+    return true;
+}
+
+bool ServidorPOS::escucharHttp(const std::string& direccion) {
+    int fd = abrirEscucha(direccion);
+    if (fd < 0) {
+        return false;
+    }
+    if (!api) {
+        api = std::make_unique<ApiHttp>(*this, inventario, gasolinera);
+    }
+    escuchas.push_back({ fd, TipoConexion::Http });
+    return true;
+}
+
+bool ServidorPOS::escucharReplicas(const std::string& direccion) {
+    if (seguidor) {
+        std::cerr << "Una replica no puede ser lider de otras replicas.\n";
+        return false;
+    }
+    int fd = abrirEscucha(direccion);
+    if (fd < 0) {
+        return false;
+    }
+    if (!lider) {
+        lider = std::make_unique<LiderReplicacion>(inventario);
+    }
+    escuchas.push_back({ fd, TipoConexion::Seguidor });
+    return true;
+}
+
+bool ServidorPOS::seguir(const std::string& direccion) {
+    DireccionPOS d;
+    if (!DireccionPOS::leer(direccion, d)) {
+        std::cerr << "Direccion invalida: " << direccion << " (use unix:/ruta, tcp:puerto o tcp:host:puerto)\n";
+        return false;
+    }
+    if (lider) {
+        std::cerr << "Un lider no puede seguir a otro servidor.\n";
+        return false;
+    }
+    direccionLider = direccion;
+    seguidor = std::make_unique<SeguidorReplicacion>(inventario);
+    return true;
+}
+
+bool ServidorPOS::conectarLider() {
+    ultimoIntento = std::chrono::steady_clock::now();
+    DireccionPOS direccion;
+    DireccionPOS::leer(direccionLider, direccion);
+
+    // Conexión bloqueante (el líder está en la misma máquina); después no bloqueante
+    int fd = -1;
+    int resultado = -1;
+    if (direccion.local) {
+        sockaddr_un dir{};
+        if (direccion.ruta.size() < sizeof(dir.sun_path)) {
+            dir.sun_family = AF_UNIX;
+            std::memcpy(dir.sun_path, direccion.ruta.c_str(), direccion.ruta.size() + 1);
+            fd = socket(AF_UNIX, SOCK_STREAM | SOCK_CLOEXEC, 0);
+            if (fd >= 0) {
+                resultado = connect(fd, reinterpret_cast<sockaddr*>(&dir), sizeof(dir));
+            }
+        }
+    }
+    else {
+        sockaddr_in dir{};
+        dir.sin_family = AF_INET;
+        dir.sin_port = htons(direccion.puerto);
+        if (inet_pton(AF_INET, direccion.host.c_str(), &dir.sin_addr) == 1) {
+            fd = socket(AF_INET, SOCK_STREAM | SOCK_CLOEXEC, 0);
+            if (fd >= 0) {
+                int uno = 1;
+                setsockopt(fd, IPPROTO_TCP, TCP_NODELAY, &uno, sizeof(uno));
+                resultado = connect(fd, reinterpret_cast<sockaddr*>(&dir), sizeof(dir));
+            }
+        }
+    }
+
+    epoll_event evento{};
+    evento.events = EPOLLIN;
+    evento.data.fd = fd;
+    if (resultado != 0 || !noBloqueante(fd) || epoll_ctl(epoll, EPOLL_CTL_ADD, fd, &evento) != 0) {
+        // Se avisa una vez; los reintentos siguen en silencio
+        if (!falloConexionLider) {
+            std::cerr << "No se pudo conectar al lider " << direccionLider << ": " << std::strerror(errno)
+                << ". Se reintenta cada " << kReintentoMs / 1000 << " s.\n";
+            falloConexionLider = true;
+        }
+        if (fd >= 0) {
+            close(fd);
+        }
+        return false;
+    }
+
+    Conexion& c = conexiones[fd];
+    c.tipo = TipoConexion::Lider;
+    seguidor->saludar(c.salida);
+    seguidor->conectado();
+    fdLider = fd;
+    falloConexionLider = false;
+    std::cerr << "Conectado al lider " << direccionLider << ".\n";
+    if (!enviar(fd, c)) {
+        cerrar(fd);
+        return false;
+    }
+    return true;
+}
+
+void ServidorPOS::atenderReplicacion() {
+    auto ahora = std::chrono::steady_clock::now();
+    if (seguidor && fdLider < 0 && ahora - ultimoIntento >= std::chrono::milliseconds(kReintentoMs)) {
+        conectarLider();
+    }
+    if (!lider) {
+        return;
+    }
+    if (ahora - ultimoLatido >= std::chrono::milliseconds(kLatidoMs)) {
+        lider->latido();
+        ultimoLatido = ahora;
+    }
+
+    // Los movimientos de toda la vuelta salen en un solo envío por réplica
+    for (size_t i = replicas.size(); i-- > 0;) {
+        int fd = replicas[i];
+        Conexion& c = conexiones[fd];
+        // La foto se rellena a medida que el socket la vacía; si el envío
+        // queda a medias, EPOLLOUT vuelve a pasar por aquí
+        bool foto = lider->enviandoFoto(c.salida);
+        bool sigue = true;
+        while (sigue && foto && c.salida.size() - c.enviado < kBloqueFoto) {
+            lider->continuarFoto(c.salida, kBloqueFoto - (c.salida.size() - c.enviado));
+            foto = lider->enviandoFoto(c.salida);
+            sigue = c.escribiendo || enviar(fd, c);
+        }
+        // Si epoll ya espera para escribir, él se encarga del envío
+        sigue = sigue && (c.escribiendo || c.enviado == c.salida.size() || enviar(fd, c));
+        if (sigue && !foto && c.salida.size() - c.enviado > kMaxSalidaReplica) {
+            std::cerr << "Replica demasiado atrasada: se desconecta.\n";
+            sigue = false;
+        }
+        if (!sigue) {
+            cerrar(fd);
+        }
+    }
+}
+
+int ServidorPOS::abrirEscucha(const std::string& texto) {
+    DireccionPOS direccion;
+    if (!DireccionPOS::leer(texto, direccion)) {
+        std::cerr << "Direccion invalida: " << texto << " (use unix:/ruta, tcp:puerto o tcp:host:puerto)\n";
+        return -1;
+    }
+
+    int fd = -1;
+    if (direccion.local) {
+        sockaddr_un dir{};
+        if (direccion.ruta.size() >= sizeof(dir.sun_path)) {
+            std::cerr << "Ruta de socket demasiado larga: " << direccion.ruta << "\n";
+            return -1;
+        }
+        dir.sun_family = AF_UNIX;
+        std::memcpy(dir.sun_path, direccion.ruta.c_str(), direccion.ruta.size() + 1);
+        // Un socket de una ejecución anterior impediría el bind
+        unlink(direccion.ruta.c_str());
+        fd = socket(AF_UNIX, SOCK_STREAM | SOCK_CLOEXEC, 0);
+        if (fd < 0 || bind(fd, reinterpret_cast<sockaddr*>(&dir), sizeof(dir)) != 0) {
+            std::cerr << "No se pudo abrir " << texto << ": " << std::strerror(errno) << "\n";
+            if (fd >= 0) {
+                close(fd);
+            }
+            return -1;
+        }
+        rutasUnix.push_back(direccion.ruta);
+    }
+    else {
+        sockaddr_in dir{};
+        dir.sin_family = AF_INET;
+        dir.sin_port = htons(direccion.puerto);
+        if (inet_pton(AF_INET, direccion.host.c_str(), &dir.sin_addr) != 1) {
+            std::cerr << "Host invalido: " << direccion.host << "\n";
+            return -1;
+        }
+        fd = socket(AF_INET, SOCK_STREAM | SOCK_CLOEXEC, 0);
+        int uno = 1;
+        if (fd >= 0) {
+            setsockopt(fd, SOL_SOCKET, SO_REUSEADDR, &uno, sizeof(uno));
+        }
+        if (fd < 0 || bind(fd, reinterpret_cast<sockaddr*>(&dir), sizeof(dir)) != 0) {
+            std::cerr << "No se pudo abrir " << texto << ": " << std::strerror(errno) << "\n";
+            if (fd >= 0) {
+                close(fd);
+            }
+            return -1;
+        }
+    }
+
+    if (listen(fd, SOMAXCONN) != 0 || !noBloqueante(fd)) {
+        std::cerr << "No se pudo escuchar en " << texto << ": " << std::strerror(errno) << "\n";
+        close(fd);
+        return -1;
+    }
+    return fd;
+}
+
+void ServidorPOS::aceptar(const Escucha& escucha) {
+    // Se aceptan todas las conexiones en espera
+    while (true) {
+        int fd = accept4(escucha.fd, nullptr, nullptr, SOCK_NONBLOCK | SOCK_CLOEXEC);
+        if (fd < 0) {
+            if (errno != EAGAIN && errno != EWOULDBLOCK && errno != EINTR) {
+                std::cerr << "Error al aceptar una conexion: " << std::strerror(errno) << "\n";
+            }
+            return;
+        }
+        // Respuestas pequeñas: sin Nagle para no esperar a llenar un paquete
+        int uno = 1;
+        setsockopt(fd, IPPROTO_TCP, TCP_NODELAY, &uno, sizeof(uno));
+
+        epoll_event evento{};
+        evento.events = EPOLLIN;
+        evento.data.fd = fd;
+        if (epoll_ctl(epoll, EPOLL_CTL_ADD, fd, &evento) != 0) {
+            close(fd);
+            continue;
+        }
+        conexiones[fd].tipo = escucha.tipo;
+        if (escucha.tipo == TipoConexion::Seguidor) {
+            replicas.push_back(fd);
+        }
+        estadisticas.conexiones++;
+    }
+}
+
+bool ServidorPOS::leer(int fd, Conexion& c) {
+    char bloque[kBloqueLectura];
+    ssize_t n = read(fd, bloque, sizeof(bloque));
+    if (n <= 0) {
+        return n < 0 && (errno == EAGAIN || errno == EWOULDBLOCK || errno == EINTR);
+    }
+
+    // Sin restos del read anterior las tramas se leen directo del bloque
+    const char* datos = bloque;
+    size_t total = static_cast<size_t>(n);
+    if (!c.entrada.empty()) {
+        c.entrada.append(bloque, total);
+        datos = c.entrada.data();
+        total = c.entrada.size();
+    }
+
+    // Todas las solicitudes completas; lo que sobre espera al siguiente read
+    size_t consumido = procesar(datos, total, c);
+    if (consumido == Protocolo::kTramaInvalida) {
+        return false;
+    }
+    if (datos == bloque) {
+        c.entrada.assign(bloque + consumido, total - consumido);
+    }
+    else {
+        c.entrada.erase(0, consumido);
+    }
+    return enviar(fd, c);
+}
+
+bool ServidorPOS::enviar(int fd, Conexion& c) {
+    while (true) {
+        while (c.enviado < c.salida.size()) {
+            ssize_t n = send(fd, c.salida.data() + c.enviado, c.salida.size() - c.enviado, MSG_NOSIGNAL);
+            if (n < 0) {
+                if (errno == EINTR) {
+                    continue;
+                }
+                if (errno == EAGAIN || errno == EWOULDBLOCK) {
+                    break;
+                }
+                return false;
+            }
+            c.enviado += static_cast<size_t>(n);
+        }
+        if (c.enviado < c.salida.size()) {
+            break;
+        }
+        c.salida.clear();
+        c.enviado = 0;
+        if (c.cerrarAlEnviar) {
+            return false;
+        }
+
+        // Solicitudes que se quedaron en espera por la contrapresión
+        size_t consumido = c.entrada.empty() ? 0 : procesar(c.entrada.data(), c.entrada.size(), c);
+        if (consumido == Protocolo::kTramaInvalida) {
+            return false;
+        }
+        c.entrada.erase(0, consumido);
+        if (c.salida.empty()) {
+            break;
+        }
+    }
+    actualizarInteres(fd, c);
+    return true;
+}
+
+void ServidorPOS::actualizarInteres(int fd, Conexion& c) {
+    bool escribir = c.enviado < c.salida.size();
+    bool leer = !c.cerrarAlEnviar && c.salida.size() - c.enviado < kMaxSalidaPendiente;
+    if (escribir == c.escribiendo && leer == c.leyendo) {
+        return;
+    }
+    epoll_event evento{};
+    evento.events = (leer ? EPOLLIN : 0u) | (escribir ? EPOLLOUT : 0u);
+    evento.data.fd = fd;
+    epoll_ctl(epoll, EPOLL_CTL_MOD, fd, &evento);
+    c.escribiendo = escribir;
+    c.leyendo = leer;
+}
+
+void ServidorPOS::cerrar(int fd) {
+    auto it = conexiones.find(fd);
+    if (it != conexiones.end() && it->second.tipo == TipoConexion::Seguidor) {
+        lider->quitarSeguidor(it->second.salida);
+        replicas.erase(std::remove(replicas.begin(), replicas.end(), fd), replicas.end());
+    }
+    else if (it != conexiones.end() && it->second.tipo == TipoConexion::Lider) {
+        std::cerr << "Se perdio la conexion con el lider; se reintenta.\n";
+        fdLider = -1;
+        ultimoIntento = std::chrono::steady_clock::now();
+    }
+    epoll_ctl(epoll, EPOLL_CTL_DEL, fd, nullptr);
+    close(fd);
+    conexiones.erase(fd);
+}
+
+bool ServidorPOS::ejecutar() {
+    epoll = epoll_create1(EPOLL_CLOEXEC);
+    if (epoll < 0 || escuchas.empty()) {
+        std::cerr << "No hay sockets de escucha o no se pudo crear epoll.\n";
+        return false;
+    }
+    for (const Escucha& e : escuchas) {
+        epoll_event evento{};
+        evento.events = EPOLLIN;
+        evento.data.fd = e.fd;
+        epoll_ctl(epoll, EPOLL_CTL_ADD, e.fd, &evento);
+    }
+
+    activo.store(true);
+    if (seguidor) {
+        conectarLider();
+    }
+    epoll_event eventos[256];
+    bool correcto = true;
+    while (activo.load()) {
+        int n = epoll_wait(epoll, eventos, 256, lider ? kLatidoMs : kEsperaMs);
+        if (n < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            std::cerr << "epoll_wait: " << std::strerror(errno) << "\n";
+            correcto = false;
+            break;
+        }
+        for (int i = 0; i < n; i++) {
+            int fd = eventos[i].data.fd;
+            auto escucha = std::find_if(escuchas.begin(), escuchas.end(),
+                [fd](const Escucha& e) { return e.fd == fd; });
+            if (escucha != escuchas.end()) {
+                aceptar(*escucha);
+                continue;
+            }
+            auto it = conexiones.find(fd);
+            if (it == conexiones.end()) {
+                continue;
+            }
+            // Con EPOLLHUP aún puede haber solicitudes por leer; el read que
+            // devuelva 0 cierra la conexión
+            unsigned int ocurrido = eventos[i].events;
+            bool sigue = (ocurrido & EPOLLERR) == 0 && (ocurrido & (EPOLLIN | EPOLLOUT)) != 0;
+            if (sigue && (ocurrido & EPOLLOUT)) {
+                sigue = enviar(fd, it->second);
+            }
+            if (sigue && (ocurrido & EPOLLIN)) {
+                sigue = leer(fd, it->second);
+            }
+            if (!sigue) {
+                cerrar(fd);
+            }
+        }
+        atenderReplicacion();
+
+        // Las ventas de las cajas de toda la vuelta van a disco juntas
+        if (diarioCajasPendiente) {
+            std::fflush(diarioCajas);
+            diarioCajasPendiente = false;
+        }
+    }
+    cerrarTodo();
+    return correcto;
+}
+
+void ServidorPOS::cerrarTodo() {
+    for (auto& par : conexiones) {
+        if (par.second.tipo == TipoConexion::Seguidor) {
+            lider->quitarSeguidor(par.second.salida);
+        }
+        close(par.first);
+    }
+    conexiones.clear();
+    replicas.clear();
+    fdLider = -1;
+    for (const Escucha& e : escuchas) {
+        close(e.fd);
+    }
+    escuchas.clear();
+    for (const auto& ruta : rutasUnix) {
+        unlink(ruta.c_str());
+    }
+    rutasUnix.clear();
+    if (epoll >= 0) {
+        close(epoll);
+        epoll = -1;
+    }
+}
+
+#endif
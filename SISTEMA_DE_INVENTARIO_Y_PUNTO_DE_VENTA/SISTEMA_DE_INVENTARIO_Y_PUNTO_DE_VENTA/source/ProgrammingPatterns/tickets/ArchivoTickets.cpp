@@ -0,0 +1,431 @@
+﻿/**
+ * @file ArchivoTickets.cpp
+ * @brief Segmentos de tickets, índice por folio e índice por día.
+ *
+ * @date 2026-10-19
+ * @version 1.0
+ * @author Ari
+ */
+#include "ProgrammingPatterns/tickets/ArchivoTickets.h"
+#include "ProgrammingPatterns/tiempo/Reloj.h"
+#include <algorithm>
+#include <filesystem>
+#include <iostream>
+#ifdef _WIN32
+#include <io.h>
+#else
+#include <sys/uio.h>
+#include <unistd.h>
+#endif
+
+/**
+ * @brief Convierte una fecha al día local AAAAMMDD.
+ *
+ * @param fecha Instante a convertir.
+ * @return int Día en formato AAAAMMDD.
+ */
+static int diaDe(time_t fecha) {
+    return Reloj::local(fecha).aaaammdd;
+}
+
+ArchivoTickets::~ArchivoTickets() {
+    if (segmento != nullptr) {
+        std::fclose(segmento);
+    }
+    if (archivoIndice != nullptr) {
+        std::fclose(archivoIndice);
+    }
+}
+
+/**
+ * @brief Instancia compartida del archivo de tickets.
+ * @return ArchivoTickets& Archivo del sistema.
+ */
+ArchivoTickets& ArchivoTickets::instancia() {
+    static ArchivoTickets archivo;
+    return archivo;
+}
+
+std::string ArchivoTickets::rutaSegmento(std::uint32_t numero) const {
+    char nombre[32];
+    std::snprintf(nombre, sizeof(nombre), "segmento_%06u.txt", static_cast<unsigned>(numero));
+    return directorio + "/" + nombre;
+}
+
+bool ArchivoTickets::abrirSegmento(std::uint32_t numero) {
+    if (segmento != nullptr) {
+        std::fclose(segmento);
+    }
+    std::string ruta = rutaSegmento(numero);
+    segmento = std::fopen(ruta.c_str(), "ab");
+    if (segmento == nullptr) {
+        std::cout << "No se pudo abrir el segmento " << ruta << "\n";
+        return false;
+    }
+    std::fseek(segmento, 0, SEEK_END);
+    numeroSegmento = numero;
+    tamanoSegmento = static_cast<std::uint64_t>(std::ftell(segmento));
+    return true;
+}
+
+void ArchivoTickets::indexar(const EntradaIndiceTicket& entrada) {
+    if (entrada.folio == 0) {
+        return;
+    }
+    if (indice.size() < entrada.folio) {
+        indice.resize(static_cast<size_t>(entrada.folio));
+    }
+    indice[static_cast<size_t>(entrada.folio - 1)] = entrada;
+
+    auto it = indicePorDia.find(diaDe(static_cast<time_t>(entrada.fecha)));
+    if (it == indicePorDia.end()) {
+        indicePorDia[diaDe(static_cast<time_t>(entrada.fecha))] = { entrada.folio, entrada.folio };
+    }
+    else {
+        it->second.first = std::min(it->second.first, entrada.folio);
+        it->second.second = std::max(it->second.second, entrada.folio);
+    }
+}
+
+/**
+ * @brief Lee el índice existente y abre el último segmento.
+ *
+ * @param carpeta Carpeta del archivo.
+ * @return true si quedó listo para archivar.
+ */
+bool ArchivoTickets::abrir(const std::string& carpeta) {
+    std::lock_guard<std::mutex> lock(mutexArchivo);
+
+    std::error_code error;
+    std::filesystem::create_directories(carpeta, error);
+    directorio = carpeta;
+
+    std::string rutaIndice = directorio + "/indice.dat";
+    std::uint32_t ultimoSegmento = 1;
+    std::uint64_t ultimoFolio = 0;
+    size_t leidas = 0;
+
+    if (std::FILE* f = std::fopen(rutaIndice.c_str(), "rb")) {
+        EntradaIndiceTicket entrada;
+        while (std::fread(&entrada, sizeof(entrada), 1, f) == 1) {
+            indexar(entrada);
+            ultimoSegmento = std::max(ultimoSegmento, entrada.segmento);
+            ultimoFolio = std::max(ultimoFolio, entrada.folio);
+            leidas++;
+        }
+        std::fclose(f);
+
+        // Una entrada a medias desalinearía todas las que se agreguen después
+        std::uint64_t completas = static_cast<std::uint64_t>(leidas) * sizeof(EntradaIndiceTicket);
+        if (std::filesystem::file_size(rutaIndice, error) != completas && !error) {
+            std::filesystem::resize_file(rutaIndice, completas, error);
+            if (error) {
+                std::cout << "No se pudo recortar la entrada incompleta de " << rutaIndice << "\n";
+                return false;
+            }
+            std::cout << " Se descarto una entrada incompleta al final de " << rutaIndice << "\n";
+        }
+    }
+
+    archivoIndice = std::fopen(rutaIndice.c_str(), "ab");
+    if (archivoIndice == nullptr || !abrirSegmento(ultimoSegmento)) {
+        std::cout << "No se pudo abrir el archivo de tickets en " << directorio << "\n";
+        return false;
+    }
+    // Sin búfer: lo que fwrite reporta como escrito es lo que quedó en el archivo
+    std::setvbuf(archivoIndice, nullptr, _IONBF, 0);
+
+    // Nunca reutilizar un folio ya archivado
+    unsigned long long actual = siguiente.load();
+    while (actual <= ultimoFolio && !siguiente.compare_exchange_weak(actual, ultimoFolio + 1)) {
+    }
+
+    std::cout << " Archivo de tickets en " << directorio << " (" << leidas << " tickets)\n";
+    return true;
+}
+
+/**
+ * @brief Agrega un ticket al segmento vigente y registra su ubicación.
+ *
+ * @param folio Folio del ticket.
+ * @param fecha Fecha del ticket.
+ * @param texto Texto renderizado.
+ * @return true si se archivó.
+ */
+bool ArchivoTickets::guardar(unsigned long long folio, time_t fecha, std::string_view texto) {
+    TicketPorArchivar ticket;
+    ticket.folio = folio;
+    ticket.fecha = fecha;
+    ticket.texto = texto;
+    return guardarLote(&ticket, 1) == 1;
+}
+
+/**
+ * @brief Escribe varios textos seguidos en un archivo con una sola llamada.
+ *
+ * @param f Archivo destino (sin datos pendientes en su búfer de stdio).
+ * @param tickets Tickets a escribir.
+ * @param n Número de tickets.
+ * @return true si se escribió todo.
+ */
+static bool escribirVectorizado(std::FILE* f, const TicketPorArchivar* tickets, size_t n) {
+#ifdef _WIN32
+    for (size_t i = 0; i < n; i++) {
+        if (std::fwrite(tickets[i].texto.data(), 1, tickets[i].texto.size(), f) != tickets[i].texto.size()) {
+            return false;
+        }
+    }
+    return std::fflush(f) == 0;
+#else
+    iovec partes[256];
+    int fd = fileno(f);
+    size_t hecho = 0;
+    while (hecho < n) {
+        size_t k = std::min(n - hecho, sizeof(partes) / sizeof(partes[0]));
+        size_t esperado = 0;
+        for (size_t i = 0; i < k; i++) {
+            partes[i].iov_base = const_cast<char*>(tickets[hecho + i].texto.data());
+            partes[i].iov_len = tickets[hecho + i].texto.size();
+            esperado += partes[i].iov_len;
+        }
+        // Una escritura corta es rara en archivos regulares; se completa por partes
+        ssize_t escrito = writev(fd, partes, static_cast<int>(k));
+        if (escrito < 0) {
+            return false;
+        }
+        size_t resto = static_cast<size_t>(escrito);
+        for (size_t i = 0; i < k && resto < esperado; i++) {
+            const std::string_view& t = tickets[hecho + i].texto;
+            if (resto >= t.size()) {
+                resto -= t.size();
+                continue;
+            }
+            size_t falta = t.size() - resto;
+            if (write(fd, t.data() + resto, falta) != static_cast<ssize_t>(falta)) {
+                return false;
+            }
+            resto = 0;
+        }
+        hecho += k;
+    }
+    return true;
+#endif
+}
+
+/**
+ * @brief Agrega un lote de tickets, partiéndolo donde haya cambio de segmento.
+ *
+ * @param tickets Tickets a archivar.
+ * @param n Número de tickets.
+ * @return size_t Tickets archivados.
+ */
+size_t ArchivoTickets::guardarLote(const TicketPorArchivar* tickets, size_t n) {
+    std::lock_guard<std::mutex> lock(mutexArchivo);
+    if (segmento == nullptr || archivoIndice == nullptr) {
+        return 0;
+    }
+
+    std::vector<EntradaIndiceTicket> entradas;
+    entradas.reserve(n);
+    size_t inicio = 0;
+    while (inicio < n) {
+        if (tamanoSegmento > 0 && tamanoSegmento + tickets[inicio].texto.size() > kTamanoSegmento) {
+            if (!abrirSegmento(numeroSegmento + 1)) {
+                break;
+            }
+        }
+
+        // Tramo del lote que cabe en el segmento vigente
+        size_t fin = inicio;
+        std::uint64_t posicion = tamanoSegmento;
+        while (fin < n && (fin == inicio || posicion + tickets[fin].texto.size() <= kTamanoSegmento)) {
+            EntradaIndiceTicket entrada;
+            entrada.folio = tickets[fin].folio;
+            entrada.fecha = static_cast<std::int64_t>(tickets[fin].fecha);
+            entrada.posicion = posicion;
+            entrada.segmento = numeroSegmento;
+            entrada.longitud = static_cast<std::uint32_t>(tickets[fin].texto.size());
+            entradas.push_back(entrada);
+            posicion += tickets[fin].texto.size();
+            fin++;
+        }
+
+        if (!escribirVectorizado(segmento, tickets + inicio, fin - inicio)) {
+            std::cout << "No se pudo archivar el ticket " << tickets[inicio].folio << "\n";
+            entradas.resize(inicio);
+
+            // Lo escrito a medias se recorta para que las posiciones sigan cuadrando
+            std::fflush(segmento);
+            std::error_code error;
+            std::string ruta = rutaSegmento(numeroSegmento);
+            std::filesystem::resize_file(ruta, tamanoSegmento, error);
+            if (error) {
+                std::uint64_t real = std::filesystem::file_size(ruta, error);
+                if (!error) {
+                    tamanoSegmento = real;
+                }
+            }
+            break;
+        }
+        tamanoSegmento = posicion;
+        inicio = fin;
+    }
+
+    if (!entradas.empty()) {
+        size_t escritas = std::fwrite(entradas.data(), sizeof(EntradaIndiceTicket), entradas.size(), archivoIndice);
+        if (escritas != entradas.size()) {
+            std::cout << "No se pudo indexar el ticket " << entradas[escritas].folio << "\n";
+            std::clearerr(archivoIndice);
+
+            // Una entrada a medias desalinearía las siguientes (igual que al abrir)
+            std::error_code error;
+            std::string rutaIndice = directorio + "/indice.dat";
+            std::uint64_t tamano = std::filesystem::file_size(rutaIndice, error);
+            if (!error && tamano % sizeof(EntradaIndiceTicket) != 0) {
+                std::filesystem::resize_file(rutaIndice, tamano - tamano % sizeof(EntradaIndiceTicket), error);
+            }
+            entradas.resize(escritas);
+        }
+        for (const auto& e : entradas) {
+            indexar(e);
+        }
+    }
+    return entradas.size();
+}
+
+/**
+ * @brief Lleva a disco el segmento vigente y el índice.
+ */
+void ArchivoTickets::sincronizar() {
+    std::lock_guard<std::mutex> lock(mutexArchivo);
+    for (std::FILE* f : { segmento, archivoIndice }) {
+        if (f == nullptr) {
+            continue;
+        }
+        std::fflush(f);
+#ifdef _WIN32
+        _commit(_fileno(f));
+#else
+        fsync(fileno(f));
+#endif
+    }
+}
+
+/**
+ * @brief Lee un ticket de un segmento ya abierto.
+ *
+ * @param f Segmento abierto para lectura.
+ * @param entrada Ubicación del ticket.
+ * @param texto Salida: contenido.
+ * @return true si se leyó completo.
+ */
+static bool leerDe(std::FILE* f, const EntradaIndiceTicket& entrada, std::string& texto) {
+    texto.resize(entrada.longitud);
+    return std::fseek(f, static_cast<long>(entrada.posicion), SEEK_SET) == 0 &&
+        std::fread(&texto[0], 1, texto.size(), f) == texto.size();
+}
+
+bool ArchivoTickets::leer(const EntradaIndiceTicket& entrada, std::string& texto) const {
+    std::string ruta = rutaSegmento(entrada.segmento);
+    std::FILE* f = std::fopen(ruta.c_str(), "rb");
+    if (f == nullptr) {
+        return false;
+    }
+    bool ok = leerDe(f, entrada, texto);
+    std::fclose(f);
+    return ok;
+}
+
+/**
+ * @brief Busca el folio en el índice y muestra el ticket.
+ *
+ * @param folio Folio a reimprimir.
+ * @return true si se encontró.
+ */
+bool ArchivoTickets::reimprimir(unsigned long long folio) const {
+    std::lock_guard<std::mutex> lock(mutexArchivo);
+    if (folio == 0 || folio > indice.size() || indice[static_cast<size_t>(folio - 1)].folio == 0) {
+        std::cout << "No existe el ticket " << folio << ".\n";
+        return false;
+    }
+
+    std::string texto;
+    if (!leer(indice[static_cast<size_t>(folio - 1)], texto)) {
+        std::cout << "No se pudo leer el ticket " << folio << ".\n";
+        return false;
+    }
+    std::cout << "\n" << texto;
+    return true;
+}
+
+/**
+ * @brief Exporta los tickets de los días indicados, en orden de folio.
+ *
+ * Cerca de la medianoche los rangos de folios de dos días pueden encimarse
+ * (un ticket de las 23:59 se archiva después de uno de las 00:00), así que
+ * se recorre una sola vez la unión de los rangos y cada folio se exporta a lo
+ * más una vez.
+ *
+ * @param desde Primer día (AAAAMMDD).
+ * @param hasta Último día (AAAAMMDD).
+ * @param destino Archivo de salida.
+ * @return size_t Tickets exportados.
+ */
+size_t ArchivoTickets::exportarRango(int desde, int hasta, const std::string& destino) const {
+    std::lock_guard<std::mutex> lock(mutexArchivo);
+
+    std::FILE* salida = std::fopen(destino.c_str(), "wb");
+    if (salida == nullptr) {
+        std::cout << "No se pudo crear " << destino << "\n";
+        return 0;
+    }
+
+    // Los folios consecutivos comparten segmento: se mantiene abierto el último
+    std::FILE* abierto = nullptr;
+    std::uint32_t segmentoAbierto = 0;
+    size_t exportados = 0;
+    std::string texto;
+    std::uint64_t primero = 0;
+    std::uint64_t ultimo = 0;
+    for (auto it = indicePorDia.lower_bound(desde); it != indicePorDia.end() && it->first <= hasta; ++it) {
+        primero = primero == 0 ? it->second.first : std::min(primero, it->second.first);
+        ultimo = std::max(ultimo, it->second.second);
+    }
+    for (std::uint64_t f = primero; f != 0 && f <= ultimo; f++) {
+        const EntradaIndiceTicket& entrada = indice[static_cast<size_t>(f - 1)];
+        int dia = diaDe(static_cast<time_t>(entrada.fecha));
+        if (entrada.folio == 0 || dia < desde || dia > hasta) {
+            continue;
+        }
+        if (abierto == nullptr || segmentoAbierto != entrada.segmento) {
+            if (abierto != nullptr) {
+                std::fclose(abierto);
+            }
+            abierto = std::fopen(rutaSegmento(entrada.segmento).c_str(), "rb");
+            segmentoAbierto = entrada.segmento;
+            if (abierto == nullptr) {
+                continue;
+            }
+        }
+        if (leerDe(abierto, entrada, texto)) {
+            std::fwrite(texto.data(), 1, texto.size(), salida);
+            exportados++;
+        }
+    }
+    if (abierto != nullptr) {
+        std::fclose(abierto);
+    }
+    std::fclose(salida);
+
+    std::cout << exportados << " ticket(s) exportados a " << destino << "\n";
+    return exportados;
+}
+
+size_t ArchivoTickets::totalTickets() const {
+    std::lock_guard<std::mutex> lock(mutexArchivo);
+    size_t total = 0;
+    for (const auto& e : indice) {
+        total += e.folio != 0 ? 1 : 0;
+    }
+    return total;
+}
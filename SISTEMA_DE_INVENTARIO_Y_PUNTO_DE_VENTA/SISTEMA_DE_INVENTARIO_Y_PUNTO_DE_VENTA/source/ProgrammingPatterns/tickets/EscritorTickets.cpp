@@ -0,0 +1,168 @@
+﻿/**
+ * @file EscritorTickets.cpp
+ * @brief Hilo escritor: lotes de tickets, `fsync` periódico y vaciado al cerrar.
+ *
+ * @date 2026-10-19
+ * @version 1.0
+ * @author Ari
+ */
+#include "ProgrammingPatterns/tickets/EscritorTickets.h"
+#include "ProgrammingPatterns/metricas/Traza.h"
+#include <cstring>
+#include <iostream>
+
+/**
+ * @brief Instancia compartida del escritor.
+ * @return EscritorTickets& Escritor del sistema.
+ */
+EscritorTickets& EscritorTickets::instancia() {
+    static EscritorTickets escritor;
+    return escritor;
+}
+
+EscritorTickets::~EscritorTickets() {
+    detener();
+}
+
+/**
+ * @brief Reserva la cola y arranca el hilo (no hace nada si ya está activo).
+ */
+void EscritorTickets::iniciar() {
+    std::lock_guard<std::mutex> lock(mutexCola);
+    if (activo) {
+        return;
+    }
+    if (!ranuras) {
+        ranuras.reset(new Ranura[kRanuras]);
+    }
+    activo = true;
+    detenerSolicitado = false;
+    hilo = std::thread(&EscritorTickets::escribir, this);
+}
+
+/**
+ * @brief Deja de aceptar tickets, espera a que se escriban los pendientes y
+ * sincroniza a disco.
+ */
+void EscritorTickets::detener() {
+    {
+        std::lock_guard<std::mutex> lock(mutexCola);
+        if (!activo) {
+            return;
+        }
+        activo = false;
+        detenerSolicitado = true;
+    }
+    hayTickets.notify_all();
+    hayEspacio.notify_all();
+    hilo.join();
+}
+
+/**
+ * @brief Copia el ticket o documento a la siguiente ranura libre.
+ *
+ * Solo copia memoria; la escritura a disco la hace el hilo escritor.
+ *
+ * @param folio Folio del ticket.
+ * @param fecha Fecha del ticket.
+ * @param ruta Archivo de un documento suelto (vacío para tickets).
+ * @param texto Texto renderizado.
+ * @return true si quedó encolado.
+ */
+bool EscritorTickets::encolarRanura(unsigned long long folio, time_t fecha, std::string_view ruta,
+    std::string_view texto) {
+    std::unique_lock<std::mutex> lock(mutexCola);
+    if (activo && cabeza - cola >= kRanuras) {
+        // Cola llena: la caja espera al disco y la espera queda en la traza
+        POS_TRAZA("Esperar ranura de ticket");
+        hayEspacio.wait(lock, [this] { return !activo || cabeza - cola < kRanuras; });
+    }
+    if (!activo) {
+        return false;
+    }
+
+    Ranura& r = ranuras[cabeza % kRanuras];
+    r.folio = folio;
+    r.fecha = fecha;
+    std::memcpy(r.ruta, ruta.data(), ruta.size());
+    r.ruta[ruta.size()] = '\0';
+    r.longitud = texto.size() < sizeof(r.texto) ? texto.size() : sizeof(r.texto);
+    std::memcpy(r.texto, texto.data(), r.longitud);
+    cabeza++;
+
+    lock.unlock();
+    hayTickets.notify_one();
+    return true;
+}
+
+/**
+ * @brief Toma todas las ranuras listas y las escribe como un solo lote.
+ *
+ * Las ranuras entre `cola` y `cabeza` no las toca ninguna caja, así que se
+ * escriben sin tener el candado.
+ */
+void EscritorTickets::escribir() {
+    Traza::instancia().nombrarHilo("EscritorTickets");
+    TicketPorArchivar lote[kRanuras];
+    auto ultimoSync = std::chrono::steady_clock::now();
+    bool pendienteSync = false;
+
+    while (true) {
+        size_t desde;
+        size_t hasta;
+        {
+            std::unique_lock<std::mutex> lock(mutexCola);
+            hayTickets.wait_for(lock, kIntervaloSync, [this] { return detenerSolicitado || cabeza != cola; });
+            desde = cola;
+            hasta = cabeza;
+            if (desde == hasta && detenerSolicitado) {
+                break;
+            }
+        }
+
+        if (desde != hasta) {
+            POS_TRAZA("Escribir lote de tickets");
+            size_t n = 0;
+            for (size_t i = desde; i < hasta; i++) {
+                const Ranura& r = ranuras[i % kRanuras];
+                if (r.ruta[0] != '\0') {
+                    // Documento suelto: va directo a su archivo
+                    if (!RenderizadorTicket::escribir(r.ruta, std::string_view(r.texto, r.longitud))) {
+                        std::cout << "No se pudo escribir " << r.ruta << "\n";
+                    }
+                    continue;
+                }
+                lote[n].folio = r.folio;
+                lote[n].fecha = r.fecha;
+                lote[n].texto = std::string_view(r.texto, r.longitud);
+                n++;
+            }
+
+            if (n > 0) {
+                ArchivoTickets::instancia().guardarLote(lote, n);
+
+                // ticket_compra.txt conserva el último ticket, como antes
+                RenderizadorTicket::escribir("ticket_compra.txt", lote[n - 1].texto);
+                pendienteSync = true;
+            }
+
+            {
+                std::lock_guard<std::mutex> lock(mutexCola);
+                cola = hasta;
+            }
+            hayEspacio.notify_all();
+        }
+
+        auto ahora = std::chrono::steady_clock::now();
+        if (pendienteSync && ahora - ultimoSync >= kIntervaloSync) {
+            POS_TRAZA("Sincronizar tickets a disco");
+            ArchivoTickets::instancia().sincronizar();
+            pendienteSync = false;
+            ultimoSync = ahora;
+        }
+    }
+
+    if (pendienteSync) {
+        ArchivoTickets::instancia().sincronizar();
+    }
+}
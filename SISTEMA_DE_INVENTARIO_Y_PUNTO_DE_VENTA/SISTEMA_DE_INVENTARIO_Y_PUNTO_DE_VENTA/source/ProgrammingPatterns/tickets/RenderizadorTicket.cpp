@@ -0,0 +1,161 @@
+﻿/**
+ * @file RenderizadorTicket.cpp
+ * @brief Formato del ticket con `std::to_chars` sobre un búfer fijo.
+ *
+ * @date 2026-10-19
+ * @version 1.0
+ * @author Ari
+ */
+#include "ProgrammingPatterns/tickets/RenderizadorTicket.h"
+#include "ProgrammingPatterns/tiempo/Reloj.h"
+#include <charconv>
+#include <cstdio>
+#include <cstring>
+
+// Partes fijas del formato del ticket
+static constexpr std::string_view kEncabezado =
+    "*************** TIENDA DE LA ESQUINA ****************\n"
+    "               RECIBO DE COMPRA\n"
+    "-------------------------------------------\n\n"
+    "Ticket No: ";
+static constexpr std::string_view kFecha = "Fecha: ";
+static constexpr std::string_view kHora = "   Hora: ";
+static constexpr std::string_view kColumnas =
+    "Descripción                          Precio \n"
+    "-------------------------------------------\n";
+static constexpr std::string_view kCantidad = "Cantidad: ";
+static constexpr std::string_view kSeparadorTotales = "-------------------------------------------\n\n";
+static constexpr std::string_view kSubtotal = "Subtotal:                           $";
+static constexpr std::string_view kIva = "IVA (16%):                          $";
+static constexpr std::string_view kTotal = "TOTAL:                              $";
+static constexpr std::string_view kMetodo = "Método de pago: ";
+static constexpr std::string_view kPie =
+    "-------------------------------------------\n"
+    "   Gracias por su compra. Vuelva pronto :)\n"
+    "*******************************************\n";
+
+/// Columna (antes del '$') en la que se alinea el precio unitario.
+static constexpr size_t kColumnaPrecio = 34;
+
+/// Dígitos mínimos del número de ticket.
+static constexpr int kDigitosFolio = 6;
+
+void RenderizadorTicket::agregar(std::string_view texto) {
+    size_t n = texto.size() < kCapacidad - usado ? texto.size() : kCapacidad - usado;
+    std::memcpy(buffer + usado, texto.data(), n);
+    usado += n;
+}
+
+void RenderizadorTicket::agregarEntero(unsigned long long valor, int ancho) {
+    char digitos[24];
+    std::to_chars_result r = std::to_chars(digitos, digitos + sizeof(digitos), valor);
+    size_t n = static_cast<size_t>(r.ptr - digitos);
+    for (size_t i = n; i < static_cast<size_t>(ancho); i++) {
+        agregar("0");
+    }
+    agregar(std::string_view(digitos, n));
+}
+
+void RenderizadorTicket::agregarDinero(Dinero monto) {
+    long long centavos = monto.getCentavos();
+    if (centavos < 0) {
+        agregar("-");
+        centavos = -centavos;
+    }
+    agregarEntero(static_cast<unsigned long long>(centavos / 100));
+    agregar(".");
+    agregarEntero(static_cast<unsigned long long>(centavos % 100), 2);
+}
+
+void RenderizadorTicket::agregarEspacios(size_t n) {
+    static constexpr std::string_view kEspacios = "                                                ";
+    while (n > 0) {
+        size_t k = n < kEspacios.size() ? n : kEspacios.size();
+        agregar(kEspacios.substr(0, k));
+        n -= k;
+    }
+}
+
+/**
+ * @brief Renderizador reutilizable del hilo actual.
+ * @return RenderizadorTicket& Renderizador del hilo.
+ */
+RenderizadorTicket& RenderizadorTicket::local() {
+    thread_local RenderizadorTicket renderizador;
+    return renderizador;
+}
+
+/**
+ * @brief Arma el ticket con el mismo formato que el recibo original.
+ *
+ * @param datos Campos del ticket.
+ * @return std::string_view Texto del ticket.
+ */
+std::string_view RenderizadorTicket::renderizar(const DatosTicket& datos) {
+    usado = 0;
+
+    const InstanteLocal& local = Reloj::local(datos.fecha);
+
+    // IVA como diferencia, así subtotal + IVA = total exacto
+    Dinero subtotal = datos.total.escalar(100, 116);
+    Dinero iva = datos.total - subtotal;
+
+    agregar(kEncabezado);
+    agregarEntero(datos.folio, kDigitosFolio);
+    agregar("\n");
+
+    agregar(kFecha);
+    agregar(local.textoFecha);
+    agregar(kHora);
+    agregar(local.textoHora);
+    agregar("\n\n");
+
+    agregar(kColumnas);
+    agregar(datos.producto);
+    if (datos.producto.size() < kColumnaPrecio) {
+        agregarEspacios(kColumnaPrecio - datos.producto.size());
+    }
+    agregar("$");
+    agregarDinero(datos.precioUnitario);
+    agregar("\n");
+
+    agregar(kCantidad);
+    agregarEntero(static_cast<unsigned long long>(datos.cantidad < 0 ? 0 : datos.cantidad));
+    agregar("\n");
+    agregar(kSeparadorTotales);
+
+    agregar(kSubtotal);
+    agregarDinero(subtotal);
+    agregar("\n");
+    agregar(kIva);
+    agregarDinero(iva);
+    agregar("\n");
+    agregar(kTotal);
+    agregarDinero(datos.total);
+    agregar("\n\n");
+
+    agregar(kMetodo);
+    agregar(datos.metodoPago);
+    agregar("\n");
+    agregar(kPie);
+
+    return std::string_view(buffer, usado);
+}
+
+/**
+ * @brief Escribe el ticket completo con una sola llamada a `fwrite`.
+ *
+ * @param archivo Ruta del archivo.
+ * @param texto Contenido a escribir.
+ * @return true si se escribió completo.
+ */
+bool RenderizadorTicket::escribir(const char* archivo, std::string_view texto) {
+    std::FILE* f = std::fopen(archivo, "wb");
+    if (f == nullptr) {
+        return false;
+    }
+    std::setvbuf(f, nullptr, _IONBF, 0);
+    bool ok = std::fwrite(texto.data(), 1, texto.size(), f) == texto.size();
+    std::fclose(f);
+    return ok;
+}
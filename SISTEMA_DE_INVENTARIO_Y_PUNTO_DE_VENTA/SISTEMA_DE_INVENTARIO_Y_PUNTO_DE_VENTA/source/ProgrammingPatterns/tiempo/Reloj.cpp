@@ -0,0 +1,132 @@
+﻿/**
+ * @file Reloj.cpp
+ * @brief Caché por hilo de la hora local y sus textos.
+ *
+ * @date 2026-10-19
+ * @version 1.0
+ * @author Ari
+ */
+#include "ProgrammingPatterns/tiempo/Reloj.h"
+
+/**
+ * @brief Escribe un número de dos dígitos con cero a la izquierda.
+ */
+static void escribirDos(char* destino, int valor) {
+    destino[0] = static_cast<char>('0' + valor / 10);
+    destino[1] = static_cast<char>('0' + valor % 10);
+}
+
+/**
+ * @brief Reescribe los textos de minutos y segundos.
+ */
+static void formatearMinutos(InstanteLocal& l) {
+    escribirDos(l.textoHora + 3, l.minuto);
+    escribirDos(l.textoHora + 6, l.segundo);
+    escribirDos(l.textoIso + 14, l.minuto);
+    escribirDos(l.textoIso + 17, l.segundo);
+}
+
+/**
+ * @brief Llena todos los campos a partir de `localtime_r`.
+ */
+static void desglosar(InstanteLocal& l, time_t instante) {
+    tm t{};
+#ifdef _WIN32
+    localtime_s(&t, &instante);
+#else
+    localtime_r(&instante, &t);
+#endif
+    l.anio = t.tm_year + 1900;
+    l.mes = t.tm_mon + 1;
+    l.dia = t.tm_mday;
+    l.hora = t.tm_hour;
+    l.minuto = t.tm_min;
+    l.segundo = t.tm_sec;
+    l.diaSemana = t.tm_wday;
+    l.diasDesdeEpoca = diasDesdeCivil(l.anio, l.mes, l.dia);
+    l.aaaammdd = l.anio * 10000 + l.mes * 100 + l.dia;
+
+    long long comoUtc = static_cast<long long>(l.diasDesdeEpoca) * 86400 + l.hora * 3600 + l.minuto * 60 + l.segundo;
+    l.desfaseMinutos = static_cast<int>((comoUtc - static_cast<long long>(instante)) / 60);
+
+    // DD/MM/AAAA
+    escribirDos(l.textoFecha, l.dia);
+    l.textoFecha[2] = '/';
+    escribirDos(l.textoFecha + 3, l.mes);
+    l.textoFecha[5] = '/';
+    escribirDos(l.textoFecha + 6, l.anio / 100 % 100);
+    escribirDos(l.textoFecha + 8, l.anio % 100);
+    l.textoFecha[10] = '\0';
+
+    // HH:MM:SS
+    escribirDos(l.textoHora, l.hora);
+    l.textoHora[2] = ':';
+    l.textoHora[5] = ':';
+    l.textoHora[8] = '\0';
+
+    // AAAA-MM-DDTHH:MM:SS
+    escribirDos(l.textoIso, l.anio / 100 % 100);
+    escribirDos(l.textoIso + 2, l.anio % 100);
+    l.textoIso[4] = '-';
+    escribirDos(l.textoIso + 5, l.mes);
+    l.textoIso[7] = '-';
+    escribirDos(l.textoIso + 8, l.dia);
+    l.textoIso[10] = 'T';
+    escribirDos(l.textoIso + 11, l.hora);
+    l.textoIso[13] = ':';
+    l.textoIso[16] = ':';
+    l.textoIso[19] = '\0';
+
+    formatearMinutos(l);
+}
+
+/**
+ * @brief Devuelve la hora local desde la caché del hilo.
+ *
+ * - Mismo segundo que la llamada anterior: sin cálculo.
+ * - Misma hora: minutos y segundos por aritmética.
+ * - Otra hora: `localtime_r` (la zona horaria solo cambia en horas completas).
+ *
+ * @param instante Segundo a convertir.
+ * @return const InstanteLocal& Hora local del hilo.
+ */
+const InstanteLocal& Reloj::local(time_t instante) {
+    thread_local InstanteLocal cache;
+    thread_local time_t inicioHora = 1;
+    thread_local time_t finHora = 0;
+
+    if (instante == cache.instante && inicioHora < finHora) {
+        return cache;
+    }
+
+    if (instante >= inicioHora && instante < finHora) {
+        int resto = static_cast<int>(instante - inicioHora);
+        cache.minuto = resto / 60;
+        cache.segundo = resto % 60;
+        formatearMinutos(cache);
+    }
+    else {
+        desglosar(cache, instante);
+        inicioHora = instante - (cache.minuto * 60 + cache.segundo);
+        finHora = inicioHora + 3600;
+    }
+    cache.instante = instante;
+    return cache;
+}
+
+void Reloj::limitesDelDia(time_t instante, time_t& desde, time_t& hasta) {
+    const InstanteLocal& l = local(instante);
+    tm t{};
+    t.tm_year = l.anio - 1900;
+    t.tm_mon = l.mes - 1;
+    t.tm_mday = l.dia;
+    t.tm_isdst = -1;
+    desde = mktime(&t);
+
+    t = tm{};
+    t.tm_year = l.anio - 1900;
+    t.tm_mon = l.mes - 1;
+    t.tm_mday = l.dia + 1;
+    t.tm_isdst = -1;
+    hasta = mktime(&t);
+}
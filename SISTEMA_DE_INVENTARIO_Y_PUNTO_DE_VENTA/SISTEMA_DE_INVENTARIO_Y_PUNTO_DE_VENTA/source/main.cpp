@@ -13,16 +13,33 @@
  * generación de ticket/factura, registro de cargas de gasolina y persistencia en JSON.
  */
 #include "Prerequisites.h"
-#include "programmingPatterns/modelos/Inventario.h"
-#include "programmingPatterns/factory/ProductoFactory.h"
-#include "programmingPatterns/observer/AlertaStockBajo.h"
-#include "programmingPatterns/strategy/PagoCredito.h"
-#include "programmingPatterns/strategy/PagoDebito.h"
-#include "programmingPatterns/strategy/PagoEfectivo.h"
-#include "programmingPatterns/gasolinera/Gasolinera.h"
-#include "programmingPatterns/facade/SistemaFacade.h"
-#include "programmingPatterns/facade/SistemaGasolineraFacade.h"
+#include "ProgrammingPatterns/modelos/Inventario.h"
+#include "ProgrammingPatterns/factory/ProductoFactory.h"
+#include "ProgrammingPatterns/observer/AlertaStockBajo.h"
+#include "ProgrammingPatterns/strategy/PagoCredito.h"
+#include "ProgrammingPatterns/strategy/PagoDebito.h"
+#include "ProgrammingPatterns/strategy/PagoEfectivo.h"
+#include "ProgrammingPatterns/strategy/PagoVariante.h"
+#include "ProgrammingPatterns/gasolinera/Gasolinera.h"
+#include "ProgrammingPatterns/facade/SistemaFacade.h"
+#include "ProgrammingPatterns/facade/SistemaGasolineraFacade.h"
+#include "ProgrammingPatterns/pagos/MotorComisiones.h"
+#include "ProgrammingPatterns/pagos/PasarelaPagos.h"
+#include "ProgrammingPatterns/pagos/AutorizadorPagos.h"
+#include "ProgrammingPatterns/pagos/Liquidaciones.h"
+#include "ProgrammingPatterns/tickets/ArchivoTickets.h"
+#include "ProgrammingPatterns/tickets/EscritorTickets.h"
+#include "ProgrammingPatterns/facturas/GeneradorFacturas.h"
+#include "ProgrammingPatterns/correo/ColaCorreos.h"
+#include "ProgrammingPatterns/script/ReproductorTransacciones.h"
+#include "ProgrammingPatterns/servidor/ServidorPOS.h"
+#include "ProgrammingPatterns/caja/CajaRemota.h"
+#include "ProgrammingPatterns/metricas/MetricasEtapas.h"
+#include "ProgrammingPatterns/metricas/PerfilArranque.h"
+#include <csignal>
+#include <fstream>
 #include <limits>
+#include <thread>
 
  /**
   * @brief Limpia la entrada estándar para evitar problemas al mezclar `cin >>` con `getline`.
@@ -32,6 +49,384 @@ static void limpiarEntrada() {
     std::cin.ignore(std::numeric_limits<std::streamsize>::max(), '\n');
 }
 
+/**
+ * @brief Pregunta la marca de la tarjeta cuando el pago no es en efectivo.
+ *
+ * @param metodoPago Opción de pago elegida (1 = efectivo).
+ * @return MarcaTarjeta Marca capturada (Generica si no aplica o no se reconoce).
+ */
+static MarcaTarjeta leerMarcaTarjeta(int metodoPago) {
+    if (metodoPago == 1) {
+        return MarcaTarjeta::Generica;
+    }
+    std::cout << "Marca de tarjeta: 0-Otra 1-Visa 2-Mastercard 3-Amex: ";
+    int marca;
+    if (!(std::cin >> marca) || marca < 0 || marca > 3) {
+        marca = 0;
+    }
+    limpiarEntrada();
+    return static_cast<MarcaTarjeta>(marca);
+}
+
+/**
+ * @brief Pregunta el correo del cliente para enviarle el ticket.
+ *
+ * @return std::string Correo capturado, o vacío si no se quiere o no es válido.
+ */
+static std::string leerCorreoCliente() {
+    std::cout << "Correo del cliente (Enter para omitir): ";
+    std::string correo;
+    std::getline(std::cin, correo);
+    if (!correo.empty() && correo.find('@') == std::string::npos) {
+        std::cout << "Correo invalido, el ticket no se enviara.\n";
+        correo.clear();
+    }
+    return correo;
+}
+
+/**
+ * @brief Captura los pagos de una venta dividida.
+ *
+ * Se piden pagos hasta que el usuario deja el monto en cero ("el resto") o
+ * elige terminar.
+ *
+ * @param pagos Salida: pagos capturados en orden.
+ */
+static void leerPagosDivididos(PagosVenta& pagos) {
+    while (true) {
+        std::cout << "Pago " << pagos.size() + 1 << " - metodo: 1-Efectivo 2-Debito 3-Credito (0 para terminar): ";
+        int mp;
+        if (!(std::cin >> mp) || mp < 0 || mp > 3) {
+            limpiarEntrada();
+            std::cout << "Metodo invalido.\n";
+            continue;
+        }
+        limpiarEntrada();
+        if (mp == 0) {
+            return;
+        }
+        MarcaTarjeta marca = leerMarcaTarjeta(mp);
+
+        std::cout << "Monto (0 = el resto): ";
+        std::string texto;
+        std::getline(std::cin, texto);
+        Dinero monto;
+        if (!Dinero::desdeTexto(texto, monto)) {
+            monto = Dinero();
+        }
+
+        pagos.push_back({ crearPago(mp, marca), monto });
+        if (monto <= Dinero()) {
+            return;
+        }
+    }
+}
+
+/// Filas por página de los listados del menú.
+static const size_t kFilasPorPagina = 50;
+
+/**
+ * @brief Muestra un listado por páginas con un filtro opcional.
+ *
+ * @param pregunta Texto con el que se pide el filtro.
+ * @param listar Función que muestra una página (Inventario o Gasolinera).
+ */
+template <typename Listado>
+static void listarPorPaginas(const char* pregunta, Listado listar) {
+    FiltroReporte filtro;
+    std::cout << pregunta;
+    std::getline(std::cin, filtro.texto);
+    filtro.filasPorPagina = kFilasPorPagina;
+
+    while (true) {
+        ResultadoReporte resultado = listar(filtro);
+        if (filtro.pagina >= resultado.paginas) {
+            return;
+        }
+        std::cout << "Enter = siguiente pagina, 0 = salir: ";
+        std::string respuesta;
+        if (!std::getline(std::cin, respuesta) || respuesta == "0") {
+            return;
+        }
+        filtro.pagina++;
+    }
+}
+
+/**
+ * @brief Ejecuta un guion de transacciones sin menú y muestra el rendimiento.
+ *
+ * @param ruta Archivo del guion, o "-" para leerlo de la entrada estándar.
+ * @param inventario Inventario del sistema.
+ * @param gasolinera Gasolinera del sistema.
+ * @param facade Fachada de ventas.
+ * @param gasFacade Fachada de la gasolinera.
+ * @param consola Salida original de `std::cout` (se restaura para el resumen).
+ * @return int 0 si todas las líneas fueron válidas, 1 si no se pudo leer el
+ * guion, 2 si hubo líneas inválidas.
+ */
+static int reproducirGuion(const std::string& ruta, Inventario& inventario, Gasolinera& gasolinera,
+    SistemaFacade& facade, SistemaGasolineraFacade& gasFacade, std::streambuf* consola) {
+
+    std::ifstream archivo;
+    std::istream* entrada = &std::cin;
+    if (ruta != "-") {
+        archivo.open(ruta);
+        if (!archivo) {
+            std::cout.rdbuf(consola);
+            std::cout.clear();
+            std::cout << "No se pudo abrir el guion " << ruta << "\n";
+            return 1;
+        }
+        entrada = &archivo;
+    }
+
+    ReproductorTransacciones reproductor(inventario, gasolinera, facade, gasFacade);
+    std::ostream reportes(consola);
+    reproductor.setSalidaReportes(&reportes);
+    ReproductorTransacciones::Resumen resumen = reproductor.reproducir(*entrada);
+
+    // Terminar las escrituras en segundo plano antes de informar
+    EscritorTickets::instancia().detener();
+    ColaCorreos::instancia().detener();
+    RegistroLiquidaciones::instancia().detener();
+    RegistroVentas::instancia().guardar();
+
+    std::cout.rdbuf(consola);
+    std::cout.clear();
+    ReproductorTransacciones::imprimirResumen(resumen, std::cout);
+    return resumen.errores == 0 ? 0 : 2;
+}
+
+/**
+ * @struct OpcionesServidor
+ * @brief Direcciones del modo servidor (las vacías no se abren).
+ */
+struct OpcionesServidor {
+    std::string direccion;
+    std::string http;
+    std::string replicas;
+    std::string lider;
+};
+
+/// Servidor en ejecución, para detenerlo desde el manejador de señales.
+static ServidorPOS* servidorActivo = nullptr;
+
+static void alRecibirSenal(int) {
+    if (servidorActivo != nullptr) {
+        servidorActivo->detener();
+    }
+}
+
+/**
+ * @brief Atiende a las cajas por socket hasta recibir SIGINT o SIGTERM.
+ *
+ * Al terminar guarda todo igual que la opción Salir del menú. Los mensajes de
+ * las fachadas se descartan; el servidor informa por la salida de errores.
+ *
+ * @param opciones Direcciones de las cajas, la API HTTP y la replicación.
+ * @param inventario Inventario del sistema.
+ * @param gasolinera Gasolinera del sistema.
+ * @param facade Fachada de ventas.
+ * @param gasFacade Fachada de la gasolinera.
+ * @param consola Salida original de `std::cout`.
+ * @return int 0 si terminó por una señal, 1 si no se pudo escuchar o epoll falló.
+ */
+static int ejecutarServidor(const OpcionesServidor& opciones, Inventario& inventario, Gasolinera& gasolinera,
+    SistemaFacade& facade, SistemaGasolineraFacade& gasFacade, std::streambuf* consola) {
+
+    ServidorPOS servidor(inventario, gasolinera, facade, gasFacade);
+    if (!servidor.escuchar(opciones.direccion) ||
+        (!opciones.http.empty() && !servidor.escucharHttp(opciones.http)) ||
+        (!opciones.replicas.empty() && !servidor.escucharReplicas(opciones.replicas)) ||
+        (!opciones.lider.empty() && !servidor.seguir(opciones.lider))) {
+        return 1;
+    }
+    servidor.abrirVentasCajas("VentasCajas.dat");
+    servidorActivo = &servidor;
+    std::signal(SIGINT, alRecibirSenal);
+    std::signal(SIGTERM, alRecibirSenal);
+
+    std::cerr << "Servidor escuchando en " << opciones.direccion;
+    if (!opciones.http.empty()) {
+        std::cerr << ", API HTTP en " << opciones.http;
+    }
+    if (!opciones.replicas.empty()) {
+        std::cerr << ", replicas en " << opciones.replicas;
+    }
+    if (!opciones.lider.empty()) {
+        std::cerr << ", replica de solo lectura de " << opciones.lider;
+    }
+    std::cerr << " (" << inventario.totalProductos() << " productos). Ctrl+C para terminar.\n";
+    bool correcto = servidor.ejecutar();
+    servidorActivo = nullptr;
+
+    EscritorTickets::instancia().detener();
+    ColaCorreos::instancia().detener();
+    RegistroLiquidaciones::instancia().detener();
+    RegistroVentas::instancia().guardar();
+    inventario.guardarAJson("Productos.json");
+    gasolinera.guardarHistorialJson("HistorialGas.json");
+    gasolinera.guardarTanquesJson("Tanques.json");
+    gasolinera.getTablaPrecios().guardarJson("PreciosCombustible.json");
+
+    std::cout.rdbuf(consola);
+    std::cout.clear();
+    const ServidorPOS::Estadisticas& e = servidor.getEstadisticas();
+    std::cerr << "Servidor detenido: " << e.conexiones << " conexion(es), " << e.solicitudes
+        << " solicitud(es), " << e.tramasInvalidas << " trama(s) invalida(s).\n";
+    if (ApiHttp* api = servidor.getApiHttp()) {
+        const ApiHttp::Estadisticas& a = api->getEstadisticas();
+        std::cerr << "API HTTP: " << a.solicitudes << " solicitud(es), " << a.aciertosCache
+            << " desde la cache, " << a.fallosCache << " calculada(s).\n";
+    }
+    if (const LiderReplicacion* lider = servidor.getLider()) {
+        const LiderReplicacion::Estadisticas& l = lider->getEstadisticas();
+        std::cerr << "Lider: " << l.movimientos << " movimiento(s), " << l.fotos << " foto(s) y "
+            << l.colas << " cola(s) enviadas a las replicas.\n";
+    }
+    if (const SeguidorReplicacion* seguidor = servidor.getSeguidor()) {
+        const SeguidorReplicacion::Estadisticas& s = seguidor->getEstadisticas();
+        std::cerr << "Replica: " << s.movimientos << " movimiento(s), " << s.fotos << " foto(s), secuencia "
+            << inventario.getSecuencia() << " de " << s.secuenciaLider << "; retraso p50 "
+            << seguidor->percentilRetrasoUs(50) << " us, p99 " << seguidor->percentilRetrasoUs(99)
+            << " us, maximo " << s.retrasoMaximoUs << " us.\n";
+    }
+    return correcto ? 0 : 1;
+}
+
+/**
+ * @brief Caja sin inventario propio: vende con su copia del catálogo y envía las ventas al servidor.
+ *
+ * Vende aunque no haya conexión; las ventas quedan en `VentasPendientes.dat`
+ * hasta que el servidor las confirma (ver `CajaRemota`). Cada vuelta del menú
+ * intenta enviar la cola si pasaron `kIntervaloSincronizacion` desde el último
+ * intento.
+ *
+ * @param nombre Nombre de la caja.
+ * @param direccion Dirección del servidor.
+ * @return int 0 si todas las ventas quedaron confirmadas, 1 si quedaron pendientes.
+ */
+static int ejecutarCaja(const std::string& nombre, const std::string& direccion) {
+    static const std::chrono::seconds kIntervaloSincronizacion(10);
+
+    CajaRemota caja(nombre, direccion);
+    caja.abrir("CatalogoCaja.json", "VentasPendientes.dat", "ConflictosCaja.json");
+    if (caja.getCatalogo().totalProductos() == 0 && !caja.actualizarCatalogo("CatalogoCaja.json")) {
+        std::cout << "No hay catalogo local y el servidor no responde; no se puede vender todavia.\n";
+    }
+
+    bool activa = true;
+    while (activa) {
+        caja.sincronizarSiToca(kIntervaloSincronizacion);
+
+        std::cout << "\n-----------------------------------\n";
+        std::cout << "\nCAJA " << caja.getNombre() << " (" << (caja.enLinea() ? "en linea" : "sin conexion")
+            << ", " << caja.pendientes() << " venta(s) por enviar)\n";
+        std::cout << "1. Vender Producto\n";
+        std::cout << "2. Consultar Producto\n";
+        std::cout << "3. Enviar Ventas Pendientes\n";
+        std::cout << "4. Actualizar Catalogo\n";
+        std::cout << "5. Ver Conflictos\n";
+        std::cout << "6. Salir\n";
+        std::cout << "Seleccione una opcion: ";
+
+        int opcion;
+        if (!(std::cin >> opcion)) {
+            if (std::cin.eof()) {
+                break;
+            }
+            std::cin.clear();
+            limpiarEntrada();
+            continue;
+        }
+        limpiarEntrada();
+
+        switch (opcion) {
+        case 1: {
+            std::string codigo;
+            std::cout << "Codigo del producto: ";
+            std::getline(std::cin, codigo);
+            int cantidad;
+            std::cout << "Cantidad: ";
+            if (!(std::cin >> cantidad) || cantidad <= 0) {
+                std::cin.clear();
+                limpiarEntrada();
+                std::cout << "Cantidad invalida.\n";
+                break;
+            }
+            int mp;
+            std::cout << "Metodo de pago: 1-Efectivo 2-Debito 3-Credito: ";
+            if (!(std::cin >> mp) || mp < 1 || mp > 3) {
+                std::cin.clear();
+                limpiarEntrada();
+                std::cout << "Metodo de pago invalido.\n";
+                break;
+            }
+            limpiarEntrada();
+            MarcaTarjeta marca = leerMarcaTarjeta(mp);
+            Dinero total = caja.vender(codigo, cantidad, static_cast<std::uint8_t>(mp), static_cast<std::uint8_t>(marca));
+            if (total.getCentavos() == 0) {
+                std::cout << "Producto no encontrado o stock insuficiente.\n";
+            }
+            else {
+                std::cout << "Total cobrado: $" << total << "\n";
+            }
+            break;
+        }
+        case 2: {
+            std::string codigo;
+            std::cout << "Codigo del producto: ";
+            std::getline(std::cin, codigo);
+            const Producto* p = caja.getCatalogo().buscarProducto(codigo);
+            if (p == nullptr) {
+                std::cout << "Producto no encontrado.\n";
+            }
+            else {
+                std::cout << p->getNombre() << ": $" << p->getPrecio() << ", " << p->getCantidad()
+                    << " disponible(s) segun el catalogo local.\n";
+            }
+            break;
+        }
+        case 3: {
+            CajaRemota::ResumenSincronizacion r = caja.sincronizar();
+            std::cout << r.confirmadas << " venta(s) confirmada(s), " << r.conflictos << " conflicto(s); "
+                << caja.pendientes() << " por enviar.\n";
+            break;
+        }
+        case 4:
+            if (caja.actualizarCatalogo("CatalogoCaja.json")) {
+                std::cout << "Catalogo actualizado: " << caja.getCatalogo().totalProductos() << " producto(s).\n";
+            }
+            else {
+                std::cout << "No se pudo descargar el catalogo; se conserva la copia local.\n";
+            }
+            break;
+        case 5:
+            if (caja.getConflictos().empty()) {
+                std::cout << "Sin conflictos.\n";
+            }
+            for (const ConflictoVenta& c : caja.getConflictos()) {
+                std::cout << "Venta " << c.numero << " (" << c.codigo << " x" << c.cantidad << "): " << c.motivo
+                    << "; disponibles " << c.disponibles << ", caja $" << c.totalCaja
+                    << ", servidor $" << c.totalServidor << "\n";
+            }
+            break;
+        case 6:
+            activa = false;
+            break;
+        default:
+            std::cout << "Opcion invalida.\n";
+        }
+    }
+
+    caja.sincronizar();
+    if (caja.pendientes() > 0) {
+        std::cout << "Quedan " << caja.pendientes() << " venta(s) sin enviar; se enviaran al volver a abrir la caja.\n";
+        return 1;
+    }
+    return 0;
+}
+
 /**
  * @brief Función principal del sistema.
  *
@@ -43,9 +438,101 @@ static void limpiarEntrada() {
  *  - Registrar cargas de gasolina
  *  - Mostrar historial de la gasolinera
  *
+ * Con `--script <archivo>` (o `--script -` para la entrada estándar) no se
+ * muestra el menú: se ejecuta el guion de transacciones sin mensajes y al final
+ * se informa el rendimiento (ver `ReproductorTransacciones`).
+ *
+ * Con `--servidor <direccion>` (por ejemplo `unix:/tmp/pos.sock` o `tcp:7070`)
+ * tampoco hay menú: un solo inventario y una sola gasolinera atienden a varias
+ * cajas por socket (ver `ServidorPOS`). Con `--http <direccion>` además se abre
+ * la API HTTP/JSON para la oficina y los verificadores de precios (ver `ApiHttp`).
+ * Con `--replicas <direccion>` el servidor es líder y envía cada movimiento del
+ * inventario a sus réplicas; con `--seguir <direccion>` es una réplica de solo
+ * lectura de ese líder.
+ *
+ * En Linux, `kill -USR1 <pid>` imprime en la salida de errores los tiempos de
+ * cada etapa de la venta y la carga en cualquier modo (ver `MetricasEtapas`) y
+ * `kill -USR2 <pid>` escribe la traza de los últimos tramos de cada hilo en
+ * `Traza.json` (ver `Traza`).
+ *
+ * Con `--caja <nombre> <direccion>` el programa es una caja sin inventario
+ * propio: vende con una copia local del catálogo, aunque se caiga la conexión,
+ * y envía sus ventas al servidor por lotes (ver `CajaRemota`).
+ *
+ * En cualquier modo, `--perfil-arranque` muestra en la salida de errores el
+ * tiempo, los bytes leídos y las reservas de cada fase del arranque (ver
+ * `PerfilArranque`), y `--arranque-rapido` carga el historial de la gasolinera
+ * en otro hilo mientras se carga el catálogo y no imprime el historial ni el
+ * catálogo completos al iniciar.
+ *
+ * @param argc Número de argumentos.
+ * @param argv Argumentos de la línea de comandos.
  * @return int Código de salida.
  */
-int main() {
+int main(int argc, char* argv[]) {
+    // Opciones de arranque: valen en cualquier modo y se quitan antes de leer las demás
+    bool perfilArranque = false;
+    bool arranqueRapido = false;
+    std::vector<char*> argumentos;
+    for (int i = 0; i < argc; i++) {
+        std::string argumento = argv[i];
+        if (i > 0 && argumento == "--perfil-arranque") {
+            perfilArranque = true;
+        }
+        else if (i > 0 && argumento == "--arranque-rapido") {
+            arranqueRapido = true;
+        }
+        else {
+            argumentos.push_back(argv[i]);
+        }
+    }
+    argc = static_cast<int>(argumentos.size());
+    argumentos.push_back(nullptr);
+    argv = argumentos.data();
+
+    PerfilArranque& perfil = PerfilArranque::instancia();
+    if (perfilArranque) {
+        perfil.activar();
+    }
+
+    // La caja remota no usa el inventario, la gasolinera ni los pagos locales
+    if (argc >= 4 && std::string(argv[1]) == "--caja") {
+        return ejecutarCaja(argv[2], argv[3]);
+    }
+
+    // Informe de tiempos por etapa con SIGUSR1 y traza con SIGUSR2 (antes de crear cualquier hilo)
+    MetricasEtapas::instancia().atenderSenal();
+    Traza::instancia().nombrarHilo("Principal");
+
+    // Modo guion o servidor: toda la salida normal se descarta
+    std::string guion;
+    OpcionesServidor servidor;
+    if (argc >= 3 && std::string(argv[1]) == "--script") {
+        guion = argv[2];
+    }
+    else if (argc >= 3 && std::string(argv[1]) == "--servidor") {
+        servidor.direccion = argv[2];
+        for (int i = 3; i + 1 < argc; i += 2) {
+            std::string opcion = argv[i];
+            if (opcion == "--http") {
+                servidor.http = argv[i + 1];
+            }
+            else if (opcion == "--replicas") {
+                servidor.replicas = argv[i + 1];
+            }
+            else if (opcion == "--seguir") {
+                servidor.lider = argv[i + 1];
+            }
+            else {
+                std::cerr << "Opcion desconocida: " << opcion << "\n";
+                return 1;
+            }
+        }
+    }
+    std::streambuf* consola = std::cout.rdbuf();
+    if (!guion.empty() || !servidor.direccion.empty()) {
+        std::cout.rdbuf(nullptr);
+    }
 
     // Inicialización del inventario y el observador de stock bajo
     Inventario inventario;
@@ -55,17 +542,102 @@ int main() {
     // Inicialización de la gasolinera + fachada
     Gasolinera gasolinera;
     SistemaGasolineraFacade gasFacade;
-    gasolinera.cargarHistorialJson("HistorialGas.json");
-	gasolinera.mostrarHistorial();
+
+    // En el arranque rápido el historial se carga mientras se prepara lo demás
+    // (solo toca el historial, que nadie más usa hasta terminar el arranque)
+    std::thread hiloHistorial;
+    if (arranqueRapido) {
+        hiloHistorial = std::thread([&perfil, &gasolinera]() {
+            Traza::instancia().nombrarHilo("Historial");
+            perfil.medir("Cargar historial", [&gasolinera]() {
+                gasolinera.cargarHistorialJson("HistorialGas.json");
+            });
+        });
+    }
+    else {
+        perfil.fase("Cargar historial");
+        gasolinera.cargarHistorialJson("HistorialGas.json");
+        perfil.fase("Mostrar historial");
+        gasolinera.mostrarHistorial();
+    }
+
+    // Tanques de combustible (si no hay archivo, se inicia con tanques llenos)
+    perfil.fase("Tanques y precios");
+    gasolinera.cargarTanquesJson("Tanques.json");
+    if (!gasolinera.tieneTanques()) {
+        gasolinera.agregarTanque("Magna", 40000, 40000, 4000);
+        gasolinera.agregarTanque("Premium", 30000, 30000, 3000);
+        gasolinera.agregarTanque("Diesel", 30000, 30000, 3000);
+    }
+    gasolinera.agregarObservadorTanques(&alerta);
+
+    // Precios por litro (si no hay archivo, se publican precios iniciales)
+    gasolinera.getTablaPrecios().cargarJson("PreciosCombustible.json");
+    if (gasolinera.getTablaPrecios().totalVersiones() == 0) {
+        time_t ahora = time(nullptr);
+        gasolinera.getTablaPrecios().programarCambio({ "Magna", Dinero::desdeCentavos(2350), ahora });
+        gasolinera.getTablaPrecios().programarCambio({ "Premium", Dinero::desdeCentavos(2590), ahora });
+        gasolinera.getTablaPrecios().programarCambio({ "Diesel", Dinero::desdeCentavos(2530), ahora });
+    }
+
+    // Comisiones por método de pago (tabla configurable)
+    perfil.fase("Comisiones y liquidaciones");
+    MotorComisiones::instancia().cargarJson("Comisiones.json");
+
+    // Diario de liquidaciones (un registro por cobro)
+    RegistroLiquidaciones::instancia().abrir("Liquidaciones.dat");
+
+    // Archivo de tickets (folios únicos y reimpresión)
+    perfil.fase("Archivo de tickets");
+    ArchivoTickets::instancia().abrir("Tickets");
+    EscritorTickets::instancia().iniciar();
+
+    // Diario de ventas facturables
+    perfil.fase("Diario de ventas");
+    RegistroVentas::instancia().abrir("Ventas.dat");
+
+    // Cola de correos: los tickets se entregan en el buzón local Correo/ (como maildir)
+    perfil.fase("Cola de correos");
+    ColaCorreos::instancia().iniciar("Correo", std::make_unique<BuzonMaildir>("Correo"));
+
+    // Autorización de tarjetas en segundo plano (pasarela simulada: ~300 ms, 5% de rechazos)
+    perfil.fase("Pagos");
+    PasarelaSimulada pasarela(300, 200, 0.05);
+    AutorizadorPagos autorizador(pasarela, 4);
+    SistemaFacade facade;
 
     // Cargar inventario desde archivo
+    perfil.fase("Cargar catalogo");
     inventario.cargarDesdeJson("Productos.json");
-    inventario.listarProductos();
+    if (!arranqueRapido) {
+        perfil.fase("Listar catalogo");
+        inventario.listarProductos();
+    }
+    if (hiloHistorial.joinable()) {
+        perfil.fase("Esperar historial");
+        hiloHistorial.join();
+    }
+
+    // Desde aquí la caja ya puede vender
+    perfil.terminar();
+    if (perfilArranque) {
+        perfil.imprimir(std::cerr);
+    }
+
+    if (!guion.empty()) {
+        return reproducirGuion(guion, inventario, gasolinera, facade, gasFacade, consola);
+    }
+    if (!servidor.direccion.empty()) {
+        return ejecutarServidor(servidor, inventario, gasolinera, facade, gasFacade, consola);
+    }
 
     bool activo = true;
 
     // ----------------- MENÚ PRINCIPAL ------------------
     while (activo) {
+        // Resultados de autorizaciones que llegaron mientras se capturaba
+        autorizador.atenderCompletadas();
+
 		std::cout << "\n-----------------------------------\n";
         std::cout << "\nSISTEMA DE INVENTARIO Y VENTAS\n";
         std::cout << "1. Lista Productos\n";
@@ -75,7 +647,17 @@ int main() {
         std::cout << "5. Vender con ticket y factura\n";
         std::cout << "6. Gasolinera (Registrar carga)\n";
         std::cout << "7. Ver historial de gasolinera\n";
-        std::cout << "8. Salir\n";
+        std::cout << "8. Recibir entrega de combustible (pipa)\n";
+        std::cout << "9. Ver nivel de tanques\n";
+        std::cout << "10. Precios de combustible\n";
+        std::cout << "11. Auditoria de precios\n";
+        std::cout << "12. Tabla de comisiones\n";
+        std::cout << "13. Cierre del dia (liquidacion)\n";
+        std::cout << "14. Archivo de tickets\n";
+        std::cout << "15. Facturas\n";
+        std::cout << "16. Tiempos por etapa (venta y carga)\n";
+        std::cout << "17. Exportar traza (Perfetto)\n";
+        std::cout << "18. Salir\n";
         std::cout << "\n-----------------------------------\n";
         std::cout << "Selecciona una opcion: ";
 		
@@ -92,7 +674,9 @@ int main() {
 
             // -------- Opción 1: Mostrar productos --------
         case 1:
-            inventario.listarProductos();
+            listarPorPaginas("Buscar codigo o nombre (Enter = todos): ", [&inventario](const FiltroReporte& filtro) {
+                return inventario.listarProductos(filtro);
+            });
             break;
 
             // -------- Opción 2: Venta simple --------
@@ -145,20 +729,24 @@ int main() {
             std::cin >> cantidad;
             limpiarEntrada();
 
-            std::cout << "Metodo de pago: 1-Efectivo 2-Debito 3-Credito: ";
+            std::cout << "Metodo de pago: 1-Efectivo 2-Debito 3-Credito 4-Dividido: ";
             int mp;
             std::cin >> mp;
             limpiarEntrada();
 
-            MetodoPago* metodo = nullptr;
-            if (mp == 1) metodo = new PagoEfectivo();
-            else if (mp == 2) metodo = new PagoDebito();
-            else metodo = new PagoCredito();
+            std::string correo = leerCorreoCliente();
+
+            if (mp == 4) {
+                PagosVenta pagos;
+                leerPagosDivididos(pagos);
+                facade.procesarVentaDividida(inventario, codigo, cantidad, pagos, correo);
+                break;
+            }
 
-            SistemaFacade facade;
-            facade.procesarVenta(inventario, codigo, cantidad, metodo);
+            PagoVariante pago = crearPago(mp, leerMarcaTarjeta(mp));
 
-            delete metodo;
+            facade.procesarVentaAsincrona(inventario, codigo, cantidad, pago, autorizador, correo);
+            autorizador.atenderCompletadas();
             break;
         }
 
@@ -167,7 +755,6 @@ int main() {
         case 6: {  
             double litros;
             std::string tipo;
-            double precio;
 
             std::cout << "Litros a cargar: ";
             std::cin >> litros;
@@ -176,34 +763,197 @@ int main() {
             std::cout << "Tipo de gasolina (Magna/Premium/Diesel): ";
             std::getline(std::cin, tipo);
 
-            std::cout << "Precio por litro: ";
-            std::cin >> precio;
-
             std::cout << "Metodo de pago: 1-Efectivo 2-Debito 3-Credito: ";
             int mp;
             std::cin >> mp;
             limpiarEntrada();
 
-            MetodoPago* metodo = nullptr;
-            if (mp == 1) metodo = new PagoEfectivo();
-            else if (mp == 2) metodo = new PagoDebito();
-            else metodo = new PagoCredito();
+            PagoVariante pago = crearPago(mp, leerMarcaTarjeta(mp));
 
-            gasFacade.procesarCarga(gasolinera, litros, tipo, precio, metodo);
-
-            delete metodo;
+            gasFacade.procesarCargaAsincrona(gasolinera, litros, tipo, pago, autorizador);
+            autorizador.atenderCompletadas();
             break;
         }
 
               // -------- Opción 7: Mostrar historial --------
         case 7: 
-            gasolinera.mostrarHistorial();
+            listarPorPaginas("Tipo de combustible (Enter = todos): ", [&gasolinera](const FiltroReporte& filtro) {
+                return gasolinera.mostrarHistorial(filtro);
+            });
+            break;
+
+            // -------- Opción 8: Entrega de combustible --------
+        case 8: {
+            EntregaCombustible entrega;
+
+            std::cout << "Tipo de gasolina (Magna/Premium/Diesel): ";
+            std::getline(std::cin, entrega.tipo);
+
+            std::cout << "Litros entregados: ";
+            std::cin >> entrega.litros;
+            limpiarEntrada();
+
+            std::cout << "Proveedor: ";
+            std::getline(std::cin, entrega.proveedor);
+
+            Fecha fecha;
+            fecha.getFecha();
+            entrega.fecha = fecha.toString();
+            std::cout << "Fecha actual: " << entrega.fecha << "\n";
+
+            gasolinera.registrarEntrega(entrega);
+            break;
+        }
+
+              // -------- Opción 9: Nivel de tanques --------
+        case 9:
+            gasolinera.mostrarTanques();
             break;
 
-            // -------- Opción 8: Salir del sistema --------
-        case 8: 
+            // -------- Opción 10: Precios de combustible --------
+        case 10: {
+            gasolinera.getTablaPrecios().mostrar();
+
+            CambioPrecio cambio;
+            std::string precioTexto;
+            int minutos;
+
+            std::cout << "Tipo de gasolina a cambiar (vacio para salir): ";
+            std::getline(std::cin, cambio.tipo);
+            if (cambio.tipo.empty()) {
+                break;
+            }
+
+            std::cout << "Nuevo precio por litro: ";
+            std::getline(std::cin, precioTexto);
+            if (!Dinero::desdeTexto(precioTexto, cambio.precio) || cambio.precio <= Dinero()) {
+                std::cout << "Precio invalido.\n";
+                break;
+            }
+
+            std::cout << "Minutos para que entre en vigor (0 = inmediato): ";
+            std::cin >> minutos;
+            limpiarEntrada();
+            if (minutos < 0) {
+                std::cout << "Minutos invalidos.\n";
+                break;
+            }
+
+            cambio.vigenteDesde = time(nullptr) + static_cast<time_t>(minutos) * 60;
+            unsigned int version = gasolinera.getTablaPrecios().programarCambio(cambio);
+            const InstanteLocal& inicio = Reloj::local(cambio.vigenteDesde);
+            std::cout << "Cambio de precio registrado como version " << version << ", vigente desde "
+                << inicio.textoFecha << " " << inicio.textoHora << (minutos == 0 ? " (inmediato)" : "") << ".\n";
+            break;
+        }
+
+              // -------- Opción 11: Auditoría de precios --------
+        case 11:
+            gasolinera.auditarPrecios();
+            break;
+
+            // -------- Opción 12: Tabla de comisiones --------
+        case 12:
+            MotorComisiones::instancia().mostrar();
+            break;
+
+            // -------- Opción 13: Cierre del día --------
+        case 13:
+            autorizador.esperarTodas();
+            RegistroLiquidaciones::instancia().cerrarDia(time(nullptr));
+            RegistroVentas::instancia().guardar();
+            break;
+
+            // -------- Opción 14: Reimprimir o exportar tickets --------
+        case 14: {
+            std::cout << "Tickets archivados: " << ArchivoTickets::instancia().totalTickets() << "\n";
+            std::cout << "1-Reimprimir por folio 2-Exportar por fechas: ";
+            int accion;
+            std::cin >> accion;
+            limpiarEntrada();
+
+            if (accion == 1) {
+                unsigned long long folio;
+                std::cout << "Folio: ";
+                std::cin >> folio;
+                limpiarEntrada();
+                ArchivoTickets::instancia().reimprimir(folio);
+            }
+            else if (accion == 2) {
+                int desde, hasta;
+                std::cout << "Desde (AAAAMMDD): ";
+                std::cin >> desde;
+                std::cout << "Hasta (AAAAMMDD): ";
+                std::cin >> hasta;
+                limpiarEntrada();
+                ArchivoTickets::instancia().exportarRango(desde, hasta,
+                    "Tickets_" + std::to_string(desde) + "_" + std::to_string(hasta) + ".txt");
+            }
+            break;
+        }
+
+            // -------- Opción 15: Facturas por folio o lote del día --------
+        case 15: {
+            std::cout << "1-Factura de un folio 2-Lote de facturas del dia: ";
+            int accion;
+            std::cin >> accion;
+            limpiarEntrada();
+
+            if (accion == 1) {
+                unsigned long long folio;
+                std::cout << "Folio: ";
+                std::cin >> folio;
+                limpiarEntrada();
+                VentaFacturable venta;
+                if (!RegistroVentas::instancia().buscar(folio, venta)) {
+                    std::cout << "No hay una venta con el folio " << folio << ".\n";
+                }
+                else if (GeneradorFacturas::facturar(venta)) {
+                    std::cout << "Factura del folio " << folio << " generada en " << GeneradorFacturas::kCarpeta << ".\n";
+                }
+            }
+            else if (accion == 2) {
+                autorizador.esperarTodas();
+                GeneradorFacturas::facturarDia(time(nullptr));
+            }
+            break;
+        }
+
+            // -------- Opción 16: Percentiles de cada etapa de la venta y la carga --------
+        case 16:
+            MetricasEtapas::instancia().imprimir(std::cout);
+            break;
+
+            // -------- Opción 17: Traza de ejecución para ui.perfetto.dev --------
+        case 17: {
+            size_t eventos = Traza::instancia().exportar("Traza.json");
+            if (eventos == 0) {
+                std::cout << "No se pudo escribir Traza.json.\n";
+            }
+            else {
+                std::cout << eventos << " evento(s) en Traza.json (abrir en https://ui.perfetto.dev).\n";
+            }
+            break;
+        }
+
+            // -------- Opción 18: Salir del sistema --------
+        case 18: 
+            if (autorizador.totalPendientes() > 0) {
+                std::cout << "Esperando " << autorizador.totalPendientes() << " autorizacion(es) pendiente(s)...\n";
+                autorizador.esperarTodas();
+            }
+            EscritorTickets::instancia().detener();
+            ColaCorreos::instancia().detener();
+            if (ColaCorreos::instancia().totalPendientes() > 0) {
+                std::cout << ColaCorreos::instancia().totalPendientes()
+                    << " correo(s) sin entregar; se reintentan al volver a abrir el sistema.\n";
+            }
+            RegistroLiquidaciones::instancia().detener();
+            RegistroVentas::instancia().guardar();
             inventario.guardarAJson("Productos.json");
             gasolinera.guardarHistorialJson("HistorialGas.json");
+            gasolinera.guardarTanquesJson("Tanques.json");
+            gasolinera.getTablaPrecios().guardarJson("PreciosCombustible.json");
             std::cout << "Saliendo del sistema...\n";
             activo = false;
             break;